@@ -17,6 +17,7 @@ constexpr int SPEED_MAP[] =
 
 using Pekan::PekanEngine;
 using Pekan::KeyCode;
+using Pekan::InputSnapshot;
 using namespace Pekan::Graphics;
 
 namespace Demo
@@ -100,19 +101,20 @@ namespace Demo
 		{
 			m_frames++;
 
-			if (PekanEngine::isKeyPressed(KeyCode::KEY_W))
+			const InputSnapshot& input = PekanEngine::getInputSnapshot();
+			if (input.isKeyPressed(KeyCode::KEY_W))
 			{
 				m_direction = { 0, -1 };
 			}
-			else if (PekanEngine::isKeyPressed(KeyCode::KEY_A))
+			else if (input.isKeyPressed(KeyCode::KEY_A))
 			{
 				m_direction = { -1, 0 };
 			}
-			else if (PekanEngine::isKeyPressed(KeyCode::KEY_S))
+			else if (input.isKeyPressed(KeyCode::KEY_S))
 			{
 				m_direction = { 0, 1 };
 			}
-			else if (PekanEngine::isKeyPressed(KeyCode::KEY_D))
+			else if (input.isKeyPressed(KeyCode::KEY_D))
 			{
 				m_direction = { 1, 0 };
 			}
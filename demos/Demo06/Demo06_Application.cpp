@@ -2,6 +2,7 @@
 
 #include "Demo06_Scene.h"
 #include "Demo06_GUIWindow.h"
+#include "ProfilerGUIWindow.h"
 
 #include "PekanEngine.h"
 using Pekan::PekanEngine;
@@ -24,6 +25,9 @@ namespace Demo
 		layerStack.pushLayer(demoScene);
 		layerStack.pushLayer(demoGuiWindow);
 
+		// Add a profiler window, showing where frame time goes
+		layerStack.pushLayer(std::make_shared<Pekan::GUI::ProfilerGUIWindow>(this));
+
 		// Set scene's parent to be GUI window
 		// because we need some default GUI values to initialize the scene
 		demoScene->setParent(demoGuiWindow);
@@ -38,6 +42,7 @@ namespace Demo
 		props.windowProperties.title = getName();
 		props.windowProperties.width = 1720;
 		props.windowProperties.height = 980;
+		props.antiAliasingMode = m_antiAliasingMode;
 		props.numberOfSamples = 16;
 		return props;
 	}
@@ -10,6 +10,15 @@ namespace Demo
 		bool _fillLayerStack(Pekan::LayerStack& layerStack) override;
 		std::string getName() const override { return "Random Shapes"; }
 		Pekan::ApplicationProperties getProperties() const override;
+
+	public:
+
+		// Sets anti-aliasing mode to be used by the application. Must be called before init().
+		void setAntiAliasingMode(Pekan::AntiAliasingMode antiAliasingMode) { m_antiAliasingMode = antiAliasingMode; }
+
+	private: /* variables */
+
+		Pekan::AntiAliasingMode m_antiAliasingMode = Pekan::AntiAliasingMode::Multisample;
 	};
 
 } // namespace Demo
\ No newline at end of file
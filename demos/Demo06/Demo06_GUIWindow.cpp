@@ -19,6 +19,7 @@ namespace Demo
 		gui.showLinesWidget->create(this, "Show Lines", true);
 		gui.ppsLabel->create(this, "Post-Processing Shader");
 		gui.ppsComboBoxWidget->create(this, { "Identity", "Sharpen", "Blur", "Edge Detection", "Emboss" });
+		gui.antiAliasingLabel->create(this, "Anti-Aliasing");
 		gui.fpsDisplayWidget->create(this);
 
 		return true;
@@ -27,7 +28,7 @@ namespace Demo
 	GUIWindowProperties Demo06_GUIWindow::getProperties() const
 	{
 		GUIWindowProperties props;
-		props.size = { 300, 420 };
+		props.size = { 300, 445 };
 		props.name = "Demo06";
 		return props;
 	}
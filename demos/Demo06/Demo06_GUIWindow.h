@@ -33,6 +33,9 @@ namespace Demo
 		// Returns index of selected post-processing shader
 		int getPpsIndex() const { return gui.ppsComboBoxWidget->getIndex(); }
 
+		// Sets text of the label showing anti-aliasing mode and time
+		void setAntiAliasingLabel(const char* text) { gui.antiAliasingLabel->setText(text); }
+
 	private: /* functions */
 
 		Pekan::GUI::GUIWindowProperties getProperties() const override;
@@ -50,6 +53,7 @@ namespace Demo
 			Pekan::GUI::CheckboxWidget_Ptr showLinesWidget =            std::make_shared<Pekan::GUI::CheckboxWidget>();
 			Pekan::GUI::ComboBoxWidget_Ptr ppsComboBoxWidget =          std::make_shared<Pekan::GUI::ComboBoxWidget>();
 			Pekan::GUI::TextWidget_Ptr ppsLabel =                       std::make_shared<Pekan::GUI::TextWidget>();
+			Pekan::GUI::TextWidget_Ptr antiAliasingLabel =              std::make_shared<Pekan::GUI::TextWidget>();
 			Pekan::GUI::FPSDisplayWidget_Ptr fpsDisplayWidget =         std::make_shared<Pekan::GUI::FPSDisplayWidget>();
 		} gui;
 	};
@@ -6,7 +6,6 @@
 #include "RenderState.h"
 #include "PostProcessor.h"
 #include "Shader.h"
-#include "ShaderPreprocessor.h"
 
 #include "CameraComponent2D.h"
 #include "TransformComponent2D.h"
@@ -20,9 +19,9 @@
 #include "Events/KeyEvents.h"
 
 #include <algorithm>
+#include <cstdio>
 
 #define POST_PROCESSING_SHADER_FILEPATH_PKSHAD "Shaders/PostProcessingShader.pkshad"
-#define POST_PROCESSING_SHADER_FILEPATH_GLSL "Shaders/PostProcessingShader.glsl"
 
 using namespace Pekan;
 using namespace Pekan::Graphics;
@@ -155,16 +154,17 @@ namespace Demo
 		createCameras();
 		createShapes();
 
-		ShaderPreprocessor::preprocess
+		// Preprocess post-processing shader in memory, straight into the shader cache
+		Shader* postProcessingShader = PostProcessor::getPassShaderPermutation
 		(
 			POST_PROCESSING_SHADER_FILEPATH_PKSHAD,
+			{},
 			{
 				{ "NEIGHBORS_SAMPLE_OFFSET_INVERSE_X", std::to_string(PekanEngine::getWindow().getSize().x / 3) },
 				{ "NEIGHBORS_SAMPLE_OFFSET_INVERSE_Y", std::to_string(PekanEngine::getWindow().getSize().y / 3) }
 			}
 		);
-
-		PostProcessor::setPostProcessingShader(POST_PROCESSING_SHADER_FILEPATH_GLSL);
+		PostProcessor::setPostProcessingShader(postProcessingShader);
 
 		// Initialize previous enabled states of shape types,
 		// set them to opposite of current states so that in the first update() call,
@@ -214,6 +214,7 @@ namespace Demo
 
 		updateShapes(float(dt), perShapeTypeCountChanged);
 		updatePps();
+		updateAntiAliasingLabel();
 
 		t += float(dt);
 	}
@@ -635,6 +636,21 @@ namespace Demo
 		postProcessorShader->setUniform1fv("kernel", 9, kernel);
 	}
 
+	void Demo06_Scene::updateAntiAliasingLabel()
+	{
+		const ApplicationProperties properties = m_application->getProperties();
+		char label[64];
+		if (properties.antiAliasingMode == AntiAliasingMode::Fxaa)
+		{
+			snprintf(label, sizeof(label), "Anti-Aliasing: FXAA, %.3f ms", PostProcessor::getAntiAliasingTime());
+		}
+		else
+		{
+			snprintf(label, sizeof(label), "Anti-Aliasing: MSAA x%d, %.3f ms", properties.numberOfSamples, PostProcessor::getAntiAliasingTime());
+		}
+		m_guiWindow->setAntiAliasingLabel(label);
+	}
+
 	bool Demo06_Scene::onKeyPressed(const Pekan::KeyPressedEvent& event)
 	{
 		if (event.getKeyCode() == KeyCode::KEY_C)
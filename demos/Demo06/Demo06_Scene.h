@@ -60,6 +60,9 @@ namespace Demo
 		// Updates post-processing shader
 		void updatePps();
 
+		// Updates label in GUI showing anti-aliasing mode and GPU time spent on anti-aliasing
+		void updateAntiAliasingLabel();
+
 		bool onKeyPressed(const Pekan::KeyPressedEvent& event) override;
 
 	private: /* variables */
@@ -6,13 +6,22 @@
 
 #include "Demo06_Application.h"
 
-int main(void)
+#include <cstring>
+
+// Run with "--fxaa" to use FXAA instead of MSAA.
+// Running the demo once with and once without it compares the two side by side,
+// with GPU time spent on anti-aliasing shown in demo's GUI window.
+int main(int argc, char* argv[])
 {
 	PEKAN_INCLUDE_SUBSYSTEM_GRAPHICS;
 	PEKAN_INCLUDE_SUBSYSTEM_RENDERER2D;
 	PEKAN_INCLUDE_SUBSYSTEM_GUI;
 
 	Demo::Demo06_Application application;
+	if (argc > 1 && strcmp(argv[1], "--fxaa") == 0)
+	{
+		application.setAntiAliasingMode(Pekan::AntiAliasingMode::Fxaa);
+	}
 	if (!application.init())
 	{
 		PK_LOG_ERROR("Application failed to initialize.", "Pekan");
@@ -9,6 +9,8 @@
 #include "CameraComponent2D.h"
 #include "TransformComponent2D.h"
 #include "SpriteComponent.h"
+#include "SpriteAnimationComponent.h"
+#include "SpriteAnimationSystem.h"
 #include "RectangleGeometryComponent.h"
 #include "SolidColorMaterialComponent.h"
 
@@ -29,8 +31,8 @@ namespace Demo
 	// and named "00.png", "01.png", "02.png", etc.
 	constexpr int TEXTURES_COUNT = 44;
 
-	// Number of textures to be used for the animation sprite.
-	// Textures will be loaded from .png files that are expected to be under "resources" directory
+	// Number of frames of the animation sprite.
+	// Frames will be loaded from .png files that are expected to be under "resources" directory
 	// and named "anim00.png", "anim01.png", "anim02.png", etc.
 	constexpr int ANIMATION_LENGTH = 10;
 
@@ -61,13 +63,14 @@ namespace Demo
 		}
 	}
 
-	// Loads textures to be used for the animation sprite.
+	// Loads images to be used for the animation sprite into a texture atlas,
+	// and fills in the list of their names in the atlas, in animation order.
 	//
-	// NOTE: this works only for two-digit filenames, so it supports at most 100 textures (00 to 99).
-	static void loadAnimTextures(std::vector<Texture2D_Ptr>& textures)
+	// NOTE: this works only for two-digit filenames, so it supports at most 100 frames (00 to 99).
+	static void loadAnimAtlas(TextureAtlas& atlas, std::vector<std::string>& frameNames)
 	{
-		textures.clear();
-		textures.resize(ANIMATION_LENGTH);
+		frameNames.clear();
+		frameNames.resize(ANIMATION_LENGTH);
 		for (size_t i = 0; i < ANIMATION_LENGTH; i++)
 		{
 			// Generate image file's name
@@ -77,12 +80,12 @@ namespace Demo
 				filename += "0";
 			}
 			filename += std::to_string(i) + ".png";
-			// Load image
+			// Load image and add it to the atlas
 			Image image(filename.c_str());
-			// Create texture
-			textures[i] = std::make_shared<Texture2D>();
-			textures[i]->create(image);
+			atlas.addImage(filename, image);
+			frameNames[i] = filename;
 		}
+		atlas.build();
 	}
 
 	bool Demo08_Scene::_init()
@@ -114,11 +117,12 @@ namespace Demo
 
 	void Demo08_Scene::_exit()
 	{
-		destroyEntity(m_animSprite);
-		for (int i = 0; i < m_animTextures.size(); i++)
+		if (m_animSprite != entt::null)
 		{
-			m_animTextures[i]->destroy();
+			destroyEntity(m_animSprite);
+			m_animSprite = entt::null;
 		}
+		m_animAtlas.clear();
 		destroyEntity(m_centerSquare);
 		for (int i = 0; i < m_sprites.size(); i++)
 		{
@@ -134,6 +138,7 @@ namespace Demo
 
 		updateSprites(float(dt));
 		updateAnimSprite(float(dt));
+		SpriteAnimationSystem::update(m_registry, float(dt));
 
 		t += float(dt);
 	}
@@ -204,13 +209,20 @@ namespace Demo
 
 	void Demo08_Scene::createAnimSprite()
 	{
-		// Load animation textures
-		loadAnimTextures(m_animTextures);
+		// Load animation frames into an atlas and create an animation from them.
+		// Each frame lasts 1 second, so animation component's speed is the number of frames per second.
+		std::vector<std::string> frameNames;
+		loadAnimAtlas(m_animAtlas, frameNames);
+		const SpriteAnimation_Ptr animation = SpriteAnimationSystem::createAnimation(m_animAtlas, frameNames, 1.0f);
+		if (animation == nullptr)
+		{
+			PK_LOG_ERROR("Failed to create animation from animation frames. Animated sprite will not be created.", "Demo08");
+			return;
+		}
 
 		m_animSprite = createEntity();
 
 		const float spriteSize = m_windowSize.x * ANIMATION_SIZE_FACTOR;
-		m_currAnimTextureIndex = 0;
 		// Add transform component to sprite entity
 		{
 			TransformComponent2D transform;
@@ -222,9 +234,16 @@ namespace Demo
 			SpriteComponent spriteComponent;
 			spriteComponent.width = spriteSize;
 			spriteComponent.height = spriteSize;
-			spriteComponent.texture = m_animTextures[m_currAnimTextureIndex];
+			spriteComponent.texture = animation->texture;
 			m_registry.emplace<SpriteComponent>(m_animSprite, spriteComponent);
 		}
+		// Add sprite animation component to sprite entity
+		{
+			SpriteAnimationComponent animationComponent;
+			animationComponent.animation = animation;
+			animationComponent.speed = m_guiWindow->getAnimSpeed();
+			m_registry.emplace<SpriteAnimationComponent>(m_animSprite, animationComponent);
+		}
 	}
 
 	void Demo08_Scene::updateSprites(float dt)
@@ -284,15 +303,13 @@ namespace Demo
 
 	void Demo08_Scene::updateAnimSprite(float dt)
 	{
-		m_timeTilAnimUpdate -= dt;
-		if (m_timeTilAnimUpdate <= 0.0f)
+		// Set animation speed according to animation speed parameter in GUI.
+		// The animation itself is advanced by the SpriteAnimationSystem.
+		if (m_animSprite == entt::null)
 		{
-			// Change sprite's texture to be the next texture of the animation
-			m_currAnimTextureIndex = (m_currAnimTextureIndex + 1) % m_animTextures.size();
-			m_registry.get<SpriteComponent>(m_animSprite).texture = m_animTextures[m_currAnimTextureIndex];
-			// Set time until next animation update according to animation speed parameter in GUI
-			m_timeTilAnimUpdate = 1.0f / m_guiWindow->getAnimSpeed();
+			return;
 		}
+		m_registry.get<SpriteAnimationComponent>(m_animSprite).speed = m_guiWindow->getAnimSpeed();
 	}
 
 } // namespace Demo
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "Scene2D.h"
 #include "Texture2D.h"
+#include "TextureAtlas.h"
 
 #include <vector>
 
@@ -40,8 +41,7 @@ namespace Demo
 		entt::entity m_centerSquare = entt::null;
 
 		entt::entity m_animSprite = entt::null;
-		std::vector<Pekan::Graphics::Texture2D_Ptr> m_animTextures;
-		int m_currAnimTextureIndex = 0;
+		Pekan::Renderer2D::TextureAtlas m_animAtlas;
 
 		entt::entity m_camera = entt::null;
 
@@ -52,9 +52,6 @@ namespace Demo
 
 		float t = 0.0f;
 
-		// Time until the next update of the animation sprite
-		float m_timeTilAnimUpdate = 0.0f;
-
 		// Cached window size
 		glm::vec2 m_windowSize = { 0.0f, 0.0f };
 
@@ -17,7 +17,6 @@
 #include "Renderer2DSubsystem.h"
 #include "PostProcessor.h"
 #include "Shader.h"
-#include "ShaderPreprocessor.h"
 #include "PekanEngine.h"
 #include "PekanLogger.h"
 
@@ -32,7 +31,6 @@ using namespace Pekan;
 #define PIG_IMAGE_FILEPATH "resources/Piglet_animation_without_shadow.png"
 
 #define POST_PROCESSING_SHADER_FILEPATH_PKSHAD "Shaders/PostProcessingShader.pkshad"
-#define POST_PROCESSING_SHADER_FILEPATH_GLSL "Shaders/PostProcessingShader.glsl"
 
 namespace Demo
 {
@@ -574,16 +572,17 @@ namespace Demo
 
 	bool Demo09_Scene::initPps()
 	{
-		ShaderPreprocessor::preprocess
+		// Preprocess post-processing shader in memory, straight into the shader cache
+		Shader* postProcessingShader = PostProcessor::getPassShaderPermutation
 		(
 			POST_PROCESSING_SHADER_FILEPATH_PKSHAD,
+			{},
 			{
 				{ "NEIGHBORS_SAMPLE_OFFSET_INVERSE_X", std::to_string(PekanEngine::getWindow().getSize().x / 3) },
 				{ "NEIGHBORS_SAMPLE_OFFSET_INVERSE_Y", std::to_string(PekanEngine::getWindow().getSize().y / 3) }
 			}
 		);
-
-		PostProcessor::setPostProcessingShader(POST_PROCESSING_SHADER_FILEPATH_GLSL);
+		PostProcessor::setPostProcessingShader(postProcessingShader);
 
 		return true;
 	}
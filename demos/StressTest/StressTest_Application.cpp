@@ -0,0 +1,66 @@
+#include "StressTest_Application.h"
+
+#include "StressTest_Scene.h"
+
+#include "PekanEngine.h"
+using Pekan::ApplicationProperties;
+using Pekan::LayerStack;
+
+namespace Demo
+{
+
+	bool StressTest_Application::_init()
+	{
+		// Measure each frame, and stop running after the last one
+		registerOnFrameBeginCallback([this]() { m_report.onFrameBegin(); });
+		registerOnFrameEndCallback
+		(
+			[this]()
+			{
+				m_report.onFrameEnd();
+				if (getFrameIndex() + 1 >= m_properties.warmupFramesCount + m_properties.framesCount)
+				{
+					stopRunning();
+				}
+			}
+		);
+		return true;
+	}
+
+	bool StressTest_Application::_fillLayerStack(LayerStack& layerStack)
+	{
+		m_scene = std::make_shared<StressTest_Scene>(this, m_properties);
+		layerStack.pushLayer(m_scene);
+		return true;
+	}
+
+	ApplicationProperties StressTest_Application::getProperties() const
+	{
+		ApplicationProperties props;
+		props.windowProperties.title = getName();
+		props.windowProperties.width = 1600;
+		props.windowProperties.height = 900;
+
+		// Render frames as fast as possible, so that measured frame times reflect the actual cost of a frame
+		props.fps = 0.0;
+		props.useVSync = false;
+
+		if (m_properties.offscreen || m_properties.headless)
+		{
+			props.offscreenProperties.enabled = true;
+			props.offscreenProperties.framesCount = m_properties.warmupFramesCount + m_properties.framesCount;
+			props.offscreenProperties.outputFilepath = "StressTestFrame.tga";
+			// The Null backend renders nothing, so there is no need for GLFW or an OpenGL context
+			props.offscreenProperties.headless = m_properties.headless;
+		}
+		return props;
+	}
+
+	bool StressTest_Application::writeReport()
+	{
+		m_report.finish();
+		const long long entitiesCount = (m_scene != nullptr) ? (long long)(m_scene->getEntities().size()) : 0;
+		return m_report.write(m_properties, entitiesCount);
+	}
+
+} // namespace Demo
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "PekanApplication.h"
+
+#include "StressTest_Properties.h"
+#include "StressTest_Report.h"
+
+namespace Demo
+{
+
+	class StressTest_Scene;
+
+	// An application rendering a large procedurally built scene for a fixed number of frames,
+	// and reporting frame times, draw calls and memory at the end.
+	// Serves as a reference workload for measuring performance of the renderer and the ECS.
+	class StressTest_Application : public Pekan::PekanApplication
+	{
+		bool _init() override;
+		bool _fillLayerStack(Pekan::LayerStack& layerStack) override;
+		std::string getName() const override { return "Stress Test"; }
+		Pekan::ApplicationProperties getProperties() const override;
+
+	public:
+
+		StressTest_Application(const StressTestProperties& properties) : m_properties(properties) {}
+
+		// Prints report of the last run, and writes it to the report file.
+		// To be called after run() returns.
+		// Returns false if report couldn't be written.
+		bool writeReport();
+
+	private: /* variables */
+
+		StressTestProperties m_properties;
+
+		StressTest_Report m_report;
+
+		std::shared_ptr<StressTest_Scene> m_scene;
+	};
+
+} // namespace Demo
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "StressTest_Properties.h"
+
+namespace Demo
+{
+
+	// All scenarios, together with their names as used on the command line
+	static const struct { StressTestScenario scenario; const char* name; } SCENARIOS[] =
+	{
+		{ StressTestScenario::Shapes, "shapes" },
+		{ StressTestScenario::Sprites, "sprites" },
+		{ StressTestScenario::Lines, "lines" },
+		{ StressTestScenario::Hierarchies, "hierarchies" },
+		{ StressTestScenario::Mixed, "mixed" }
+	};
+
+	const char* getScenarioName(StressTestScenario scenario)
+	{
+		for (const auto& entry : SCENARIOS)
+		{
+			if (entry.scenario == scenario)
+			{
+				return entry.name;
+			}
+		}
+		return "unknown";
+	}
+
+	bool getScenarioFromName(const std::string& name, StressTestScenario& scenario)
+	{
+		for (const auto& entry : SCENARIOS)
+		{
+			if (name == entry.name)
+			{
+				scenario = entry.scenario;
+				return true;
+			}
+		}
+		return false;
+	}
+
+} // namespace Demo
\ No newline at end of file
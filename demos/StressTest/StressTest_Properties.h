@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+
+namespace Demo
+{
+
+	// Type of scene that the stress test builds
+	enum class StressTestScenario
+	{
+		// Rectangles, circles, triangles and polygons with a solid color material
+		Shapes,
+		// Sprites using a few different textures
+		Sprites,
+		// Lines
+		Lines,
+		// Chains of rectangles, where each rectangle is a child of the previous one, and chains' roots rotate every frame
+		Hierarchies,
+		// An equal mix of all of the above
+		Mixed
+	};
+
+	// Properties of a stress test run
+	struct StressTestProperties
+	{
+		StressTestScenario scenario = StressTestScenario::Mixed;
+
+		// Number of entities to be generated, not counting the camera
+		int entitiesCount = 100000;
+
+		// Number of frames that are measured and reported
+		int framesCount = 600;
+
+		// Number of frames rendered before measuring starts, which are not reported
+		int warmupFramesCount = 60;
+
+		// Flag indicating if frames should be rendered offscreen, without showing a window
+		bool offscreen = false;
+
+		// Flag indicating if the Null graphics backend should be used, so that only CPU cost of rendering is measured.
+		// Implies offscreen, and runs without a window or an OpenGL context.
+		bool headless = false;
+
+		// Path of the JSON file where report will be written
+		std::string reportFilepath = "StressTestReport.json";
+	};
+
+	// Returns name of a given scenario, as used on the command line
+	const char* getScenarioName(StressTestScenario scenario);
+
+	// Finds a scenario with a given name, as used on the command line.
+	// Returns false if there is no such scenario.
+	bool getScenarioFromName(const std::string& name, StressTestScenario& scenario);
+
+} // namespace Demo
\ No newline at end of file
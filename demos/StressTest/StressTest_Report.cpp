@@ -0,0 +1,227 @@
+#include "StressTest_Report.h"
+
+#include "GraphicsBackend.h"
+#include "PekanLogger.h"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#endif
+
+using json = nlohmann::ordered_json;
+
+using Pekan::Graphics::GraphicsBackend;
+using Pekan::Graphics::GraphicsBackendStats;
+
+namespace Demo
+{
+
+	// Memory used by the process, in bytes.
+	// Zero if it can't be determined on the current platform.
+	struct ProcessMemory
+	{
+		// Memory currently resident in physical memory (working set)
+		long long currentBytes = 0;
+		// Maximum memory that has been resident in physical memory at the same time
+		long long peakBytes = 0;
+	};
+
+	static ProcessMemory getProcessMemory()
+	{
+		ProcessMemory memory;
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		{
+			memory.currentBytes = (long long)(counters.WorkingSetSize);
+			memory.peakBytes = (long long)(counters.PeakWorkingSetSize);
+		}
+#elif defined(__linux__)
+		// Read resident set size and its peak from /proc, where they are given in kB
+		FILE* file = std::fopen("/proc/self/status", "r");
+		if (file != nullptr)
+		{
+			char line[256];
+			while (std::fgets(line, sizeof(line), file) != nullptr)
+			{
+				long long value = 0;
+				if (std::sscanf(line, "VmRSS: %lld kB", &value) == 1)
+				{
+					memory.currentBytes = value * 1024;
+				}
+				else if (std::sscanf(line, "VmHWM: %lld kB", &value) == 1)
+				{
+					memory.peakBytes = value * 1024;
+				}
+			}
+			std::fclose(file);
+		}
+#endif
+		return memory;
+	}
+
+	// Returns the value at a given percentile of a sorted list of values, using the nearest-rank method
+	template<typename T>
+	static T getPercentile(const std::vector<T>& sortedValues, double percentile)
+	{
+		if (sortedValues.empty())
+		{
+			return T();
+		}
+		const size_t rank = size_t(std::ceil(percentile / 100.0 * double(sortedValues.size())));
+		return sortedValues[std::clamp(rank, size_t(1), sortedValues.size()) - 1];
+	}
+
+	template<typename T>
+	static double getMean(const std::vector<T>& values)
+	{
+		return values.empty() ? 0.0 : double(std::accumulate(values.begin(), values.end(), T())) / double(values.size());
+	}
+
+	// Returns a JSON object with percentiles, mean and max of a given list of values.
+	// Given list is sorted in the process.
+	template<typename T>
+	static json getDistribution(std::vector<T>& values, double scale = 1.0)
+	{
+		std::sort(values.begin(), values.end());
+		return
+		{
+			{ "p50", double(getPercentile(values, 50.0)) * scale },
+			{ "p90", double(getPercentile(values, 90.0)) * scale },
+			{ "p95", double(getPercentile(values, 95.0)) * scale },
+			{ "p99", double(getPercentile(values, 99.0)) * scale },
+			{ "max", values.empty() ? 0.0 : double(values.back()) * scale },
+			{ "mean", getMean(values) * scale }
+		};
+	}
+
+	void StressTest_Report::onFrameBegin()
+	{
+		finishCurrentFrame();
+
+		const GraphicsBackendStats& stats = GraphicsBackend::getStats();
+		m_frameBeginDrawCallsCount = stats.drawCallsCount;
+		m_frameBeginDrawnElementsCount = stats.drawnElementsCount;
+		m_frameBeginUploadedBytes = stats.uploadedBytes;
+
+		m_frameBeginTime = std::chrono::steady_clock::now();
+		m_frameEndTime = m_frameBeginTime;
+		m_isFrameStarted = true;
+	}
+
+	void StressTest_Report::onFrameEnd()
+	{
+		m_frameEndTime = std::chrono::steady_clock::now();
+	}
+
+	void StressTest_Report::finish()
+	{
+		finishCurrentFrame();
+	}
+
+	void StressTest_Report::finishCurrentFrame()
+	{
+		if (!m_isFrameStarted)
+		{
+			return;
+		}
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		const GraphicsBackendStats& stats = GraphicsBackend::getStats();
+
+		StressTestFrame frame;
+		frame.frameTime = std::chrono::duration<double>(now - m_frameBeginTime).count();
+		frame.updateAndRenderTime = std::chrono::duration<double>(m_frameEndTime - m_frameBeginTime).count();
+		frame.drawCallsCount = stats.drawCallsCount - m_frameBeginDrawCallsCount;
+		frame.drawnElementsCount = stats.drawnElementsCount - m_frameBeginDrawnElementsCount;
+		frame.uploadedBytes = stats.uploadedBytes - m_frameBeginUploadedBytes;
+		m_frames.push_back(frame);
+
+		m_isFrameStarted = false;
+	}
+
+	bool StressTest_Report::write(const StressTestProperties& properties, long long entitiesCount) const
+	{
+		// Skip warmup frames
+		const size_t firstFrame = std::min(size_t(std::max(properties.warmupFramesCount, 0)), m_frames.size());
+		const size_t framesCount = m_frames.size() - firstFrame;
+		if (framesCount == 0)
+		{
+			PK_LOG_ERROR("Cannot write stress test report because no frames were measured after the warmup frames.", "StressTest");
+			return false;
+		}
+
+		std::vector<double> frameTimes, updateAndRenderTimes;
+		std::vector<long long> drawCalls, drawnElements, uploadedBytes;
+		for (size_t i = firstFrame; i < m_frames.size(); i++)
+		{
+			frameTimes.push_back(m_frames[i].frameTime);
+			updateAndRenderTimes.push_back(m_frames[i].updateAndRenderTime);
+			drawCalls.push_back(m_frames[i].drawCallsCount);
+			drawnElements.push_back(m_frames[i].drawnElementsCount);
+			uploadedBytes.push_back(m_frames[i].uploadedBytes);
+		}
+		const double totalTime = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0);
+
+		const ProcessMemory memory = getProcessMemory();
+		const GraphicsBackendStats& stats = GraphicsBackend::getStats();
+
+		const json report =
+		{
+			{ "scenario", getScenarioName(properties.scenario) },
+			{ "entitiesCount", entitiesCount },
+			{ "framesCount", framesCount },
+			{ "warmupFramesCount", properties.warmupFramesCount },
+			{ "offscreen", properties.offscreen || properties.headless },
+			{ "headless", properties.headless },
+			{ "averageFps", (totalTime > 0.0) ? double(framesCount) / totalTime : 0.0 },
+			{ "frameTimeMs", getDistribution(frameTimes, 1000.0) },
+			{ "updateAndRenderTimeMs", getDistribution(updateAndRenderTimes, 1000.0) },
+			{ "drawCallsPerFrame", getDistribution(drawCalls) },
+			{ "drawnElementsPerFrame", getDistribution(drawnElements) },
+			{ "uploadedBytesPerFrame", getDistribution(uploadedBytes) },
+			{ "memory",
+				{
+					{ "currentBytes", memory.currentBytes },
+					{ "peakBytes", memory.peakBytes },
+					{ "liveGpuResourcesCount", stats.createdResourcesCount - stats.destroyedResourcesCount }
+				}
+			}
+		};
+
+		// Print a summary to the console
+		const json& frameTime = report["frameTimeMs"];
+		const json& drawCallsPerFrame = report["drawCallsPerFrame"];
+		std::printf("Stress test: scenario %s, %lld entities, %zu frames%s\n",
+			getScenarioName(properties.scenario), entitiesCount, framesCount, properties.headless ? " (headless)" : "");
+		std::printf("  Average FPS:           %.1f\n", report["averageFps"].get<double>());
+		std::printf("  Frame time (ms):       p50 %.3f | p90 %.3f | p95 %.3f | p99 %.3f | max %.3f\n",
+			frameTime["p50"].get<double>(), frameTime["p90"].get<double>(), frameTime["p95"].get<double>(),
+			frameTime["p99"].get<double>(), frameTime["max"].get<double>());
+		std::printf("  Draw calls per frame:  mean %.1f | max %.0f\n",
+			drawCallsPerFrame["mean"].get<double>(), drawCallsPerFrame["max"].get<double>());
+		std::printf("  Memory (MB):           current %.1f | peak %.1f\n",
+			double(memory.currentBytes) / (1024.0 * 1024.0), double(memory.peakBytes) / (1024.0 * 1024.0));
+
+		// Write the full report to a file
+		std::ofstream file(properties.reportFilepath);
+		if (!file.is_open())
+		{
+			PK_LOG_ERROR("Failed to open file " << properties.reportFilepath << " for writing stress test report.", "StressTest");
+			return false;
+		}
+		file << report.dump(4) << "\n";
+		PK_LOG_INFO("Stress test report written to " << properties.reportFilepath, "StressTest");
+		return file.good();
+	}
+
+} // namespace Demo
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "StressTest_Properties.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Demo
+{
+
+	// Measurements of a single frame
+	struct StressTestFrame
+	{
+		// Time between the beginning of this frame and the beginning of the next one, in seconds.
+		// Includes everything that happens in a frame, like swapping buffers.
+		double frameTime = 0.0;
+
+		// Time between the beginning and the end of the frame callbacks, in seconds,
+		// which is the time spent on updating and rendering all layers.
+		double updateAndRenderTime = 0.0;
+
+		long long drawCallsCount = 0;
+		long long drawnElementsCount = 0;
+		long long uploadedBytes = 0;
+	};
+
+	// A class gathering measurements of each frame of a stress test,
+	// and reporting percentiles of frame times, draw calls and memory at the end.
+	class StressTest_Report
+	{
+	public:
+
+		// Functions to be called at the beginning and at the end of each frame
+		void onFrameBegin();
+		void onFrameEnd();
+
+		// Finishes measuring the last frame. To be called after the application stops running.
+		void finish();
+
+		// Prints report to the console, and writes it as JSON to the report file given in properties.
+		// Only frames after the warmup frames are reported.
+		// Returns false if report couldn't be written.
+		bool write(const StressTestProperties& properties, long long entitiesCount) const;
+
+	private: /* functions */
+
+		// Finishes measuring the current frame, if there is one, and adds it to the list of measured frames
+		void finishCurrentFrame();
+
+	private: /* variables */
+
+		// All measured frames, in order
+		std::vector<StressTestFrame> m_frames;
+
+		// Frame that is currently being measured, and a flag indicating if there is one
+		StressTestFrame m_currentFrame;
+		bool m_isFrameStarted = false;
+
+		// Time points of the beginning and end of the current frame
+		std::chrono::steady_clock::time_point m_frameBeginTime;
+		std::chrono::steady_clock::time_point m_frameEndTime;
+
+		// Graphics stats at the beginning of the current frame
+		long long m_frameBeginDrawCallsCount = 0;
+		long long m_frameBeginDrawnElementsCount = 0;
+		long long m_frameBeginUploadedBytes = 0;
+	};
+
+} // namespace Demo
\ No newline at end of file
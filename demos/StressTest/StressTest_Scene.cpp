@@ -0,0 +1,291 @@
+#include "StressTest_Scene.h"
+
+#include "PekanEngine.h"
+#include "PekanApplication.h"
+#include "PekanLogger.h"
+#include "Image.h"
+#include "RenderState.h"
+#include "CameraComponent2D.h"
+#include "TransformComponent2D.h"
+#include "SpriteComponent.h"
+#include "LineComponent.h"
+#include "RectangleGeometryComponent.h"
+#include "CircleGeometryComponent.h"
+#include "TriangleGeometryComponent.h"
+#include "PolygonGeometryComponent.h"
+#include "SolidColorMaterialComponent.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Pekan;
+using namespace Pekan::Graphics;
+using namespace Pekan::Renderer2D;
+
+namespace Demo
+{
+
+	// Distance between neighbouring cells of the grid that entities are placed on, in world space
+	constexpr float GRID_CELL_SIZE = 2.0f;
+
+	// Number of entities in each hierarchy (chain of rectangles)
+	constexpr int HIERARCHY_DEPTH = 8;
+
+	// Rotation speed of hierarchies' roots, in radians per second
+	constexpr float HIERARCHY_ROTATION_SPEED = 0.5f;
+
+	// Number of textures used by sprites, and size of each texture, in pixels
+	constexpr int TEXTURES_COUNT = 8;
+	constexpr int TEXTURE_SIZE = 32;
+
+	// Height of the smallest area that camera sees along its path, in world space.
+	// At the other extreme camera sees the whole grid.
+	constexpr float CAMERA_MIN_VIEW_HEIGHT = 20.0f;
+
+	bool StressTest_Scene::_init()
+	{
+		RenderState::enableBlending();
+		RenderState::setBlendFunction(BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha);
+
+		const int count = m_properties.entitiesCount;
+		// In the hierarchies scenario, count is rounded down to a whole number of hierarchies,
+		// and each hierarchy takes a single grid cell.
+		const int cellsCount = (m_properties.scenario == StressTestScenario::Hierarchies) ? std::max(count / HIERARCHY_DEPTH, 1) : count;
+		m_gridSize = std::max(int(std::ceil(std::sqrt(double(cellsCount)))), 1);
+		m_nextGridIndex = 0;
+
+		createTextures();
+		createCamera();
+
+		switch (m_properties.scenario)
+		{
+			case StressTestScenario::Shapes:         createShapes(count); break;
+			case StressTestScenario::Sprites:        createSprites(count); break;
+			case StressTestScenario::Lines:          createLines(count); break;
+			case StressTestScenario::Hierarchies:    createHierarchies(count); break;
+			case StressTestScenario::Mixed:
+			{
+				createShapes(count / 4);
+				createSprites(count / 4);
+				createLines(count / 4);
+				createHierarchies(count - 3 * (count / 4));
+				break;
+			}
+		}
+
+		PK_LOG_INFO("Stress test scene created with " << getEntities().size() << " entities.", "StressTest");
+		return true;
+	}
+
+	void StressTest_Scene::_exit()
+	{
+		clear();
+		for (const Texture2D_Ptr& texture : m_textures)
+		{
+			texture->destroy();
+		}
+		m_textures.clear();
+		m_hierarchyRoots.clear();
+		m_camera = entt::null;
+	}
+
+	void StressTest_Scene::update(double deltaTime)
+	{
+		updateHierarchies(float(deltaTime));
+		updateCamera();
+	}
+
+	void StressTest_Scene::createTextures()
+	{
+		// Generate checkerboard textures, each one with a different color
+		std::vector<unsigned char> pixels(TEXTURE_SIZE * TEXTURE_SIZE * 4);
+		m_textures.resize(TEXTURES_COUNT);
+		for (int i = 0; i < TEXTURES_COUNT; i++)
+		{
+			const unsigned char r = (unsigned char)(64 + 191 * ((i >> 0) & 1));
+			const unsigned char g = (unsigned char)(64 + 191 * ((i >> 1) & 1));
+			const unsigned char b = (unsigned char)(64 + 191 * ((i >> 2) & 1));
+			for (int y = 0; y < TEXTURE_SIZE; y++)
+			{
+				for (int x = 0; x < TEXTURE_SIZE; x++)
+				{
+					const bool isLight = ((x / 8) + (y / 8)) % 2 == 0;
+					unsigned char* pixel = &pixels[(y * TEXTURE_SIZE + x) * 4];
+					pixel[0] = isLight ? r : r / 2;
+					pixel[1] = isLight ? g : g / 2;
+					pixel[2] = isLight ? b : b / 2;
+					pixel[3] = 255;
+				}
+			}
+
+			const Image image(pixels.data(), TEXTURE_SIZE, TEXTURE_SIZE, 4);
+			m_textures[i] = std::make_shared<Texture2D>();
+			m_textures[i]->create(image);
+		}
+	}
+
+	void StressTest_Scene::createCamera()
+	{
+		m_camera = createEntity();
+		CameraComponent2D camera;
+		// Camera follows a scripted path, so it must not be controlled with the mouse
+		camera.isControllable = false;
+		m_registry.emplace<CameraComponent2D>(m_camera, camera);
+		updateCamera();
+	}
+
+	void StressTest_Scene::createShapes(int count)
+	{
+		std::uniform_real_distribution<float> colorDistribution(0.2f, 1.0f);
+		std::uniform_real_distribution<float> rotationDistribution(0.0f, glm::two_pi<float>());
+		for (int i = 0; i < count; i++)
+		{
+			const entt::entity entity = createEntity();
+
+			TransformComponent2D transform;
+			transform.position = getNextGridPosition();
+			transform.rotation = rotationDistribution(m_randomGenerator);
+			m_registry.emplace<TransformComponent2D>(entity, transform);
+
+			switch (i % 4)
+			{
+				case 0: m_registry.emplace<RectangleGeometryComponent>(entity, 1.5f, 1.0f); break;
+				case 1: m_registry.emplace<CircleGeometryComponent>(entity, 0.7f, 16); break;
+				case 2: m_registry.emplace<TriangleGeometryComponent>(entity); break;
+				case 3:
+				{
+					PolygonGeometryComponent polygon;
+					polygon.vertexPositions = { { -0.7f, -0.7f }, { 0.7f, -0.7f }, { 0.7f, 0.7f }, { 0.0f, 0.2f }, { -0.7f, 0.7f } };
+					m_registry.emplace<PolygonGeometryComponent>(entity, polygon);
+					break;
+				}
+			}
+
+			const glm::vec4 color =
+			{
+				colorDistribution(m_randomGenerator),
+				colorDistribution(m_randomGenerator),
+				colorDistribution(m_randomGenerator),
+				1.0f
+			};
+			m_registry.emplace<SolidColorMaterialComponent>(entity, color);
+		}
+	}
+
+	void StressTest_Scene::createSprites(int count)
+	{
+		std::uniform_int_distribution<int> textureDistribution(0, TEXTURES_COUNT - 1);
+		std::uniform_real_distribution<float> sizeDistribution(0.8f, 1.6f);
+		for (int i = 0; i < count; i++)
+		{
+			const entt::entity entity = createEntity();
+
+			TransformComponent2D transform;
+			transform.position = getNextGridPosition();
+			m_registry.emplace<TransformComponent2D>(entity, transform);
+
+			SpriteComponent sprite;
+			sprite.width = sizeDistribution(m_randomGenerator);
+			sprite.height = sizeDistribution(m_randomGenerator);
+			sprite.texture = m_textures[textureDistribution(m_randomGenerator)];
+			m_registry.emplace<SpriteComponent>(entity, sprite);
+		}
+	}
+
+	void StressTest_Scene::createLines(int count)
+	{
+		std::uniform_real_distribution<float> pointDistribution(-0.9f, 0.9f);
+		std::uniform_real_distribution<float> colorDistribution(0.2f, 1.0f);
+		for (int i = 0; i < count; i++)
+		{
+			const entt::entity entity = createEntity();
+
+			TransformComponent2D transform;
+			transform.position = getNextGridPosition();
+			m_registry.emplace<TransformComponent2D>(entity, transform);
+
+			LineComponent line;
+			line.pointA = { pointDistribution(m_randomGenerator), pointDistribution(m_randomGenerator) };
+			line.pointB = { pointDistribution(m_randomGenerator), pointDistribution(m_randomGenerator) };
+			line.color = { colorDistribution(m_randomGenerator), colorDistribution(m_randomGenerator), colorDistribution(m_randomGenerator), 1.0f };
+			m_registry.emplace<LineComponent>(entity, line);
+		}
+	}
+
+	void StressTest_Scene::createHierarchies(int count)
+	{
+		const int hierarchiesCount = count / HIERARCHY_DEPTH;
+		m_hierarchyRoots.reserve(m_hierarchyRoots.size() + hierarchiesCount);
+		for (int i = 0; i < hierarchiesCount; i++)
+		{
+			entt::entity parent = entt::null;
+			for (int j = 0; j < HIERARCHY_DEPTH; j++)
+			{
+				const entt::entity entity = createEntity();
+
+				// Root is placed on the grid, and each child is placed relative to its parent,
+				// a bit further away, a bit rotated and a bit smaller.
+				TransformComponent2D transform;
+				if (j == 0)
+				{
+					transform.position = getNextGridPosition();
+					m_hierarchyRoots.push_back(entity);
+				}
+				else
+				{
+					transform.position = { 0.4f, 0.0f };
+					transform.rotation = 0.4f;
+					transform.scaleFactor = { 0.85f, 0.85f };
+					transform.parent = parent;
+				}
+				m_registry.emplace<TransformComponent2D>(entity, transform);
+
+				m_registry.emplace<RectangleGeometryComponent>(entity, 0.5f, 0.2f);
+				m_registry.emplace<SolidColorMaterialComponent>(entity, glm::vec4(1.0f, float(j) / float(HIERARCHY_DEPTH), 0.3f, 1.0f));
+
+				parent = entity;
+			}
+		}
+	}
+
+	glm::vec2 StressTest_Scene::getNextGridPosition()
+	{
+		const int index = m_nextGridIndex++;
+		const float offset = float(m_gridSize - 1) / 2.0f;
+		return { (float(index % m_gridSize) - offset) * GRID_CELL_SIZE, (float(index / m_gridSize) - offset) * GRID_CELL_SIZE };
+	}
+
+	void StressTest_Scene::updateCamera()
+	{
+		CameraComponent2D& camera = m_registry.get<CameraComponent2D>(m_camera);
+
+		// Progress along the path, from 0 at the first frame to 1 at the last frame.
+		// Path depends only on the frame index, so that every run renders the same frames, no matter how fast.
+		const int totalFramesCount = std::max(m_properties.warmupFramesCount + m_properties.framesCount, 1);
+		const float t = float(m_application->getFrameIndex() % totalFramesCount) / float(totalFramesCount);
+
+		// Camera sweeps over the grid along a figure-eight,
+		// and zooms in and out twice, from a close view to a view of the whole grid.
+		const float gridExtent = float(m_gridSize) * GRID_CELL_SIZE;
+		const float pathRadius = 0.4f * gridExtent;
+		camera.position = { pathRadius * std::sin(glm::two_pi<float>() * t), pathRadius * std::sin(2.0f * glm::two_pi<float>() * t) };
+
+		const float zoom = 0.5f - 0.5f * std::cos(2.0f * glm::two_pi<float>() * t);
+		const float viewHeight = glm::mix(CAMERA_MIN_VIEW_HEIGHT, std::max(gridExtent, CAMERA_MIN_VIEW_HEIGHT), zoom);
+		const glm::vec2 windowSize = glm::vec2(PekanEngine::getWindow().getSize());
+		const float aspectRatio = (windowSize.y > 0.0f) ? windowSize.x / windowSize.y : 1.0f;
+		camera.size = { viewHeight * aspectRatio, viewHeight };
+		camera.rotation = 0.1f * std::sin(glm::two_pi<float>() * t);
+	}
+
+	void StressTest_Scene::updateHierarchies(float deltaTime)
+	{
+		for (entt::entity root : m_hierarchyRoots)
+		{
+			m_registry.get<TransformComponent2D>(root).rotate(HIERARCHY_ROTATION_SPEED * deltaTime);
+		}
+	}
+
+} // namespace Demo
\ No newline at end of file
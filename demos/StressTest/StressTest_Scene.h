@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Scene2D.h"
+#include "Texture2D.h"
+
+#include "StressTest_Properties.h"
+
+#include <random>
+#include <vector>
+
+namespace Demo
+{
+
+	// A scene procedurally built out of a large number of entities, depending on the stress test scenario.
+	// Scene's camera moves along a scripted path that depends only on the frame index,
+	// so that every run renders exactly the same frames.
+	class StressTest_Scene : public Pekan::Renderer2D::Scene2D
+	{
+		bool _init() override;
+		void _exit() override;
+		void update(double deltaTime) override;
+
+	public:
+
+		StressTest_Scene(Pekan::PekanApplication* application, const StressTestProperties& properties)
+			: Pekan::Renderer2D::Scene2D(application), m_properties(properties) {}
+
+	private: /* functions */
+
+		void createTextures();
+		void createCamera();
+
+		// Functions creating a given number of entities of each kind
+		void createShapes(int count);
+		void createSprites(int count);
+		void createLines(int count);
+		void createHierarchies(int count);
+
+		// Returns position of the next free cell of the grid that entities are placed on
+		glm::vec2 getNextGridPosition();
+
+		// Moves camera to its position on the scripted path for the current frame
+		void updateCamera();
+
+		// Rotates the root of each hierarchy
+		void updateHierarchies(float deltaTime);
+
+	private: /* variables */
+
+		StressTestProperties m_properties;
+
+		// Random number generator with a fixed seed, so that every run generates the same scene
+		std::mt19937 m_randomGenerator{ 1234 };
+
+		// Textures used by sprites
+		std::vector<Pekan::Graphics::Texture2D_Ptr> m_textures;
+
+		// Roots of all hierarchies
+		std::vector<entt::entity> m_hierarchyRoots;
+
+		entt::entity m_camera = entt::null;
+
+		// Entities are placed on a square grid, one entity per cell, in the order they are created.
+		// Number of cells in each row of the grid, and index of the next free cell.
+		int m_gridSize = 1;
+		int m_nextGridIndex = 0;
+
+		// Cached ECS registry reference
+		entt::registry& m_registry = getRegistry();
+	};
+
+} // namespace Demo
\ No newline at end of file
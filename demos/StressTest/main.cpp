@@ -0,0 +1,104 @@
+#include "GraphicsSubsystem.h"
+#include "Renderer2DSubsystem.h"
+
+#include "PekanLogger.h"
+
+#include "StressTest_Application.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Demo;
+
+static void printUsage()
+{
+	const StressTestProperties defaults;
+	std::printf
+	(
+		"Usage: StressTest [options]\n"
+		"  --scenario <name>     shapes, sprites, lines, hierarchies or mixed (default %s)\n"
+		"  --count <n>           Number of entities, e.g. 10000 to 1000000 (default %d)\n"
+		"  --frames <n>          Number of measured frames (default %d)\n"
+		"  --warmup <n>          Number of warmup frames, not measured (default %d)\n"
+		"  --offscreen           Render offscreen, without showing a window\n"
+		"  --headless            Use the Null graphics backend without a window or an OpenGL context,\n"
+		"                        measuring only CPU cost of rendering (implies --offscreen)\n"
+		"  --report <filepath>   Path of the JSON report file (default %s)\n",
+		getScenarioName(defaults.scenario), defaults.entitiesCount, defaults.framesCount, defaults.warmupFramesCount,
+		defaults.reportFilepath.c_str()
+	);
+}
+
+// Parses command line arguments into given properties.
+// Returns false if arguments are invalid.
+static bool parseArguments(int argc, char* argv[], StressTestProperties& properties)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const bool takesValue = strcmp(arg, "--scenario") == 0 || strcmp(arg, "--count") == 0
+			|| strcmp(arg, "--frames") == 0 || strcmp(arg, "--warmup") == 0 || strcmp(arg, "--report") == 0;
+		const char* value = (takesValue && i + 1 < argc) ? argv[++i] : nullptr;
+		if (takesValue && value == nullptr)
+		{
+			PK_LOG_ERROR("Missing value for argument " << arg << ".", "StressTest");
+			return false;
+		}
+
+		if (strcmp(arg, "--scenario") == 0)
+		{
+			if (!getScenarioFromName(value, properties.scenario))
+			{
+				PK_LOG_ERROR("Unknown stress test scenario " << value << ".", "StressTest");
+				return false;
+			}
+		}
+		else if (strcmp(arg, "--count") == 0)     { properties.entitiesCount = std::atoi(value); }
+		else if (strcmp(arg, "--frames") == 0)    { properties.framesCount = std::atoi(value); }
+		else if (strcmp(arg, "--warmup") == 0)    { properties.warmupFramesCount = std::atoi(value); }
+		else if (strcmp(arg, "--report") == 0)    { properties.reportFilepath = value; }
+		else if (strcmp(arg, "--offscreen") == 0) { properties.offscreen = true; }
+		else if (strcmp(arg, "--headless") == 0)  { properties.headless = true; }
+		else
+		{
+			PK_LOG_ERROR("Unknown argument " << arg << ".", "StressTest");
+			return false;
+		}
+	}
+
+	if (properties.entitiesCount < 0 || properties.framesCount <= 0 || properties.warmupFramesCount < 0)
+	{
+		PK_LOG_ERROR("Invalid stress test properties. Count and warmup must not be negative, and frames must be positive.", "StressTest");
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char* argv[])
+{
+	PEKAN_INCLUDE_SUBSYSTEM_GRAPHICS;
+	PEKAN_INCLUDE_SUBSYSTEM_RENDERER2D;
+
+	StressTestProperties properties;
+	if (!parseArguments(argc, argv, properties))
+	{
+		printUsage();
+		return -1;
+	}
+
+	if (properties.headless)
+	{
+		Pekan::Graphics::GraphicsSubsystem::setBackend(Pekan::Graphics::GraphicsBackendType::Null);
+	}
+
+	StressTest_Application application(properties);
+	if (!application.init())
+	{
+		PK_LOG_ERROR("Application failed to initialize.", "Pekan");
+		return -1;
+	}
+	application.run();
+
+	return application.writeReport() ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "Benchmark.h"
+
+#include "PekanLogger.h"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+using json = nlohmann::ordered_json;
+
+namespace Pekan
+{
+namespace Benchmarks
+{
+
+	// A sink that values passed to doNotOptimize() are written to.
+	// Being volatile, writes to it can't be optimized away.
+	static const void* volatile g_doNotOptimizeSink = nullptr;
+
+	void doNotOptimize(const void* value)
+	{
+		g_doNotOptimizeSink = value;
+	}
+
+	// Returns the value at a given percentile of a sorted list of values, using the nearest-rank method
+	static double getPercentile(const std::vector<double>& sortedValues, double percentile)
+	{
+		PK_ASSERT_QUICK(!sortedValues.empty());
+
+		const double rank = std::ceil(percentile / 100.0 * double(sortedValues.size()));
+		const size_t index = size_t(std::clamp(rank, 1.0, double(sortedValues.size()))) - 1;
+		return sortedValues[index];
+	}
+
+	// Returns the median of a sorted list of values
+	static double getMedian(const std::vector<double>& sortedValues)
+	{
+		PK_ASSERT_QUICK(!sortedValues.empty());
+
+		const size_t middle = sortedValues.size() / 2;
+		if (sortedValues.size() % 2 == 0)
+		{
+			return (sortedValues[middle - 1] + sortedValues[middle]) / 2.0;
+		}
+		return sortedValues[middle];
+	}
+
+	void BenchmarkContext::measure(const std::function<void()>& body)
+	{
+		PK_ASSERT(!m_isMeasured, "Trying to call measure() more than once in the same benchmark.", "Pekan");
+		m_isMeasured = true;
+
+		// Find number of iterations per repetition,
+		// doubling it until a single repetition takes at least the minimum repetition time.
+		// This also serves as the first warmup repetition.
+		const double minRepetitionTime = m_properties.minRepetitionTime * 1e9;
+		long long iterations = 1;
+		while (runIterations(body, iterations) < minRepetitionTime && iterations < (1ll << 40))
+		{
+			iterations *= 2;
+		}
+
+		// Run the rest of the warmup repetitions
+		for (int i = 1; i < m_properties.warmupRepetitions; i++)
+		{
+			runIterations(body, iterations);
+		}
+
+		// Run measured repetitions, keeping the time per iteration of each of them
+		std::vector<double> times;
+		times.reserve(m_properties.repetitions);
+		for (int i = 0; i < m_properties.repetitions; i++)
+		{
+			times.push_back(runIterations(body, iterations) / double(iterations));
+		}
+		std::sort(times.begin(), times.end());
+
+		m_result.repetitions = m_properties.repetitions;
+		m_result.iterationsPerRepetition = iterations;
+		if (!times.empty())
+		{
+			m_result.minTime = times.front();
+			m_result.medianTime = getMedian(times);
+			m_result.p99Time = getPercentile(times, 99.0);
+			m_result.meanTime = std::accumulate(times.begin(), times.end(), 0.0) / double(times.size());
+		}
+	}
+
+	double BenchmarkContext::runIterations(const std::function<void()>& body, long long iterations)
+	{
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (long long i = 0; i < iterations; i++)
+		{
+			body();
+		}
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		return double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+	}
+
+	void BenchmarkRunner::add(const char* name, BenchmarkFunction function)
+	{
+		PK_ASSERT(name != nullptr && function != nullptr, "Trying to add a benchmark without a name or a function.", "Pekan");
+		m_benchmarks.push_back({ name, function });
+	}
+
+	bool BenchmarkRunner::run(const BenchmarkProperties& properties, const std::string& filter)
+	{
+		PK_ASSERT(properties.repetitions > 0, "Trying to run benchmarks with no repetitions.", "Pekan");
+
+		m_properties = properties;
+		m_results.clear();
+
+		bool success = true;
+		for (const Benchmark& benchmark : m_benchmarks)
+		{
+			if (!filter.empty() && std::string(benchmark.name).find(filter) == std::string::npos)
+			{
+				continue;
+			}
+
+			BenchmarkResult result;
+			result.name = benchmark.name;
+			BenchmarkContext context(m_properties, result);
+			benchmark.function(context);
+			if (!context.m_isMeasured)
+			{
+				PK_LOG_ERROR("Benchmark \"" << benchmark.name << "\" didn't measure anything.", "Pekan");
+				success = false;
+				continue;
+			}
+			m_results.push_back(std::move(result));
+		}
+		return success;
+	}
+
+	void BenchmarkRunner::printNames() const
+	{
+		for (const Benchmark& benchmark : m_benchmarks)
+		{
+			std::printf("%s\n", benchmark.name);
+		}
+	}
+
+	void BenchmarkRunner::printResults() const
+	{
+		std::printf("%-48s %14s %14s %14s %14s %12s\n", "Benchmark", "min (ns)", "median (ns)", "p99 (ns)", "mean (ns)", "iterations");
+		for (const BenchmarkResult& result : m_results)
+		{
+			std::printf
+			(
+				"%-48s %14.1f %14.1f %14.1f %14.1f %12lld\n",
+				result.name.c_str(), result.minTime, result.medianTime, result.p99Time, result.meanTime,
+				result.iterationsPerRepetition
+			);
+		}
+	}
+
+	bool BenchmarkRunner::writeJson(const char* filepath) const
+	{
+		json resultsData = json::array();
+		for (const BenchmarkResult& result : m_results)
+		{
+			resultsData.push_back
+			({
+				{ "name", result.name },
+				{ "repetitions", result.repetitions },
+				{ "iterationsPerRepetition", result.iterationsPerRepetition },
+				{ "minNs", result.minTime },
+				{ "medianNs", result.medianTime },
+				{ "p99Ns", result.p99Time },
+				{ "meanNs", result.meanTime }
+			});
+		}
+
+		const json data =
+		{
+			{ "properties",
+				{
+					{ "warmupRepetitions", m_properties.warmupRepetitions },
+					{ "repetitions", m_properties.repetitions },
+					{ "minRepetitionTime", m_properties.minRepetitionTime }
+				}
+			},
+			{ "benchmarks", std::move(resultsData) }
+		};
+
+		std::ofstream file(filepath);
+		if (!file.is_open())
+		{
+			PK_LOG_ERROR("Failed to open file " << filepath << " for writing benchmark results.", "Pekan");
+			return false;
+		}
+		file << data.dump(4) << "\n";
+		return file.good();
+	}
+
+} // namespace Benchmarks
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Pekan
+{
+namespace Benchmarks
+{
+
+	// Properties used for running benchmarks
+	struct BenchmarkProperties
+	{
+		// Number of repetitions to run before measuring, to warm up caches and allocators
+		int warmupRepetitions = 3;
+
+		// Number of measured repetitions
+		int repetitions = 31;
+
+		// Minimum time, in seconds, that a single repetition should take.
+		// Fast benchmarks run their body multiple times per repetition until this time is reached,
+		// so that the overhead of reading the clock doesn't dominate the measurement.
+		double minRepetitionTime = 0.001;
+	};
+
+	// Result of running a single benchmark.
+	// All times are per iteration (a single run of benchmark's body), in nanoseconds.
+	struct BenchmarkResult
+	{
+		std::string name;
+
+		// Number of measured repetitions, and number of iterations in each repetition
+		int repetitions = 0;
+		long long iterationsPerRepetition = 0;
+
+		double minTime = 0.0;
+		double medianTime = 0.0;
+		double p99Time = 0.0;
+		double meanTime = 0.0;
+	};
+
+	// A context passed to each benchmark function.
+	//
+	// A benchmark function does its setup, which is not measured,
+	// and then calls measure() with the body to be measured.
+	class BenchmarkContext
+	{
+		friend class BenchmarkRunner;
+
+	public:
+
+		// Runs a given body for warmup repetitions, and then for measured repetitions, timing each of them.
+		// Must be called exactly once per benchmark function.
+		void measure(const std::function<void()>& body);
+
+	private: /* functions */
+
+		BenchmarkContext(const BenchmarkProperties& properties, BenchmarkResult& result)
+			: m_properties(properties), m_result(result) {}
+
+		// Runs a given body a given number of times, and returns elapsed time in nanoseconds
+		static double runIterations(const std::function<void()>& body, long long iterations);
+
+	private: /* variables */
+
+		const BenchmarkProperties& m_properties;
+
+		// Result where measurement is written
+		BenchmarkResult& m_result;
+
+		// Flag indicating if measure() has been called
+		bool m_isMeasured = false;
+	};
+
+	// A benchmark function, doing its setup and then calling context.measure() with the body to be measured
+	typedef void (*BenchmarkFunction)(BenchmarkContext& context);
+
+	// A class holding a list of named benchmarks, running them and reporting their results
+	class BenchmarkRunner
+	{
+	public:
+
+		// Adds a benchmark with a given name.
+		// Names are expected to have the form "Group/Name", so that related benchmarks can be filtered together.
+		void add(const char* name, BenchmarkFunction function);
+
+		// Runs all benchmarks whose name contains a given filter, or all benchmarks if filter is empty.
+		// Results of previous runs are discarded.
+		// Returns false if a benchmark didn't measure anything.
+		bool run(const BenchmarkProperties& properties, const std::string& filter = {});
+
+		// Prints names of all benchmarks to the console
+		void printNames() const;
+
+		// Prints results of the last run to the console, as a table
+		void printResults() const;
+
+		// Writes properties and results of the last run to a JSON file at a given path.
+		// Returns true on success.
+		bool writeJson(const char* filepath) const;
+
+		const std::vector<BenchmarkResult>& getResults() const { return m_results; }
+
+	private: /* variables */
+
+		struct Benchmark
+		{
+			const char* name = nullptr;
+			BenchmarkFunction function = nullptr;
+		};
+
+		// Benchmarks in the order they were added
+		std::vector<Benchmark> m_benchmarks;
+
+		// Properties and results of the last run
+		BenchmarkProperties m_properties;
+		std::vector<BenchmarkResult> m_results;
+	};
+
+	// Makes sure that a value is considered used by the compiler,
+	// so that code computing it is not optimized away.
+	void doNotOptimize(const void* value);
+
+	template<typename T>
+	void doNotOptimize(const T& value) { doNotOptimize(static_cast<const void*>(&value)); }
+
+} // namespace Benchmarks
+} // namespace Pekan
\ No newline at end of file
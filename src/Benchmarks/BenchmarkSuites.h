@@ -0,0 +1,20 @@
+#pragma once
+
+namespace Pekan
+{
+namespace Benchmarks
+{
+
+	class BenchmarkRunner;
+
+	// Functions adding all benchmarks of a given area to a benchmark runner.
+	// All of these benchmarks are GL-free, so they can run headless.
+	void addMathBenchmarks(BenchmarkRunner& runner);
+	void addTransformBenchmarks(BenchmarkRunner& runner);
+	void addGeometryBenchmarks(BenchmarkRunner& runner);
+	void addSceneBenchmarks(BenchmarkRunner& runner);
+	void addEventBenchmarks(BenchmarkRunner& runner);
+	void addLoggerBenchmarks(BenchmarkRunner& runner);
+
+} // namespace Benchmarks
+} // namespace Pekan
\ No newline at end of file
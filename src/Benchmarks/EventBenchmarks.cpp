@@ -0,0 +1,127 @@
+#include "BenchmarkSuites.h"
+#include "Benchmark.h"
+
+#include "LayerStack.h"
+#include "Events/KeyEvents.h"
+#include "Events/MouseEvents.h"
+#include "Events/EventQueue.h"
+
+#include <memory>
+
+namespace Pekan
+{
+namespace Benchmarks
+{
+
+	// EventListener's event functions are protected,
+	// so pointers to them can only be formed inside of a class derived from EventListener.
+	class EventFunctions : public EventListener
+	{
+	public:
+		static constexpr bool (EventListener::*ON_KEY_PRESSED)(const KeyPressedEvent&) = &EventFunctions::onKeyPressed;
+		static constexpr bool (EventListener::*ON_MOUSE_MOVED)(const MouseMovedEvent&) = &EventFunctions::onMouseMoved;
+	};
+
+	// A layer that receives key-pressed and mouse-moved events, and optionally handles them
+	class BenchmarkLayer : public Layer
+	{
+	public:
+
+		BenchmarkLayer(bool handlesEvents) : Layer(nullptr), m_handlesEvents(handlesEvents) {}
+
+		std::string getLayerName() const override { return "benchmark_layer"; }
+
+		int getReceivedEventsCount() const { return m_receivedEventsCount; }
+
+	private: /* functions */
+
+		bool onKeyPressed(const KeyPressedEvent& event) override
+		{
+			m_receivedEventsCount++;
+			return m_handlesEvents;
+		}
+
+		bool onMouseMoved(const MouseMovedEvent& event) override
+		{
+			m_receivedEventsCount++;
+			return m_handlesEvents;
+		}
+
+	private: /* variables */
+
+		bool m_handlesEvents = false;
+		int m_receivedEventsCount = 0;
+	};
+
+	// Creates a layer stack with a given number of layers, where only the bottom layer handles events,
+	// so events travel through all layers before being handled.
+	static LayerStack createLayerStack(int layersCount)
+	{
+		LayerStack layerStack;
+		for (int i = 0; i < layersCount; i++)
+		{
+			layerStack.pushLayer(std::make_shared<BenchmarkLayer>(i == 0));
+		}
+		return layerStack;
+	}
+
+	// Measures creating a mouse-moved event and dispatching it to a layer stack,
+	// the same way that PekanApplication does it for each event coming from the window.
+	template<int LayersCount>
+	static void benchmarkDispatchMouseMoved(BenchmarkContext& context)
+	{
+		LayerStack layerStack = createLayerStack(LayersCount);
+		float x = 0.0f;
+
+		context.measure([&]()
+		{
+			x += 1.0f;
+			const MouseMovedEvent event(x, 100.0f);
+			const bool handled = layerStack.dispatchEvent(event, EventFunctions::ON_MOUSE_MOVED);
+			doNotOptimize(handled);
+		});
+	}
+
+	// Measures creating a key-pressed event and dispatching it to a layer stack
+	template<int LayersCount>
+	static void benchmarkDispatchKeyPressed(BenchmarkContext& context)
+	{
+		LayerStack layerStack = createLayerStack(LayersCount);
+
+		context.measure([&]()
+		{
+			const KeyPressedEvent event(KeyCode::KEY_SPACE, false);
+			const bool handled = layerStack.dispatchEvent(event, EventFunctions::ON_KEY_PRESSED);
+			doNotOptimize(handled);
+		});
+	}
+
+	// Measures pushing a frame's worth of unhandled mouse-moved events to an event queue and clearing it,
+	// the same way that PekanApplication does it for events that no layer and no listener handled.
+	static void benchmarkEventQueueMouseMoved(BenchmarkContext& context)
+	{
+		EventQueue eventQueue;
+		float x = 0.0f;
+
+		context.measure([&]()
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				x += 1.0f;
+				eventQueue.push(MouseMovedEvent(x, 100.0f));
+			}
+			doNotOptimize(eventQueue.size());
+			eventQueue.clear();
+		});
+	}
+
+	void addEventBenchmarks(BenchmarkRunner& runner)
+	{
+		runner.add("Events/dispatch/MouseMoved/Layers1", benchmarkDispatchMouseMoved<1>);
+		runner.add("Events/dispatch/MouseMoved/Layers8", benchmarkDispatchMouseMoved<8>);
+		runner.add("Events/dispatch/KeyPressed/Layers8", benchmarkDispatchKeyPressed<8>);
+		runner.add("Events/queue/MouseMoved/16", benchmarkEventQueueMouseMoved);
+	}
+
+} // namespace Benchmarks
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "BenchmarkSuites.h"
+#include "Benchmark.h"
+
+#include "TransformComponent2D.h"
+#include "RectangleGeometryComponent.h"
+#include "RectangleGeometrySystem.h"
+#include "CircleGeometryComponent.h"
+#include "CircleGeometrySystem.h"
+#include "TriangleGeometryComponent.h"
+#include "TriangleGeometrySystem.h"
+#include "PolygonGeometryComponent.h"
+#include "PolygonGeometrySystem.h"
+#include "LineGeometryComponent.h"
+#include "LineGeometrySystem.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <entt/entt.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define ENTITIES_COUNT 1024
+
+namespace Pekan
+{
+namespace Benchmarks
+{
+
+	using namespace Renderer2D;
+
+	// A vertex with the same layout as the vertices that RenderSystem2D generates for shapes
+	struct BenchmarkVertex
+	{
+		glm::vec2 position;
+		uint32_t color;
+	};
+
+	// Creates a given number of entities with a transform in a given registry,
+	// each of them with a given component emplaced on it.
+	template<typename ComponentT>
+	static std::vector<entt::entity> generateEntities(entt::registry& registry, int entitiesCount, const ComponentT& component)
+	{
+		std::vector<entt::entity> entities(entitiesCount);
+		for (int i = 0; i < entitiesCount; i++)
+		{
+			entities[i] = registry.create();
+			TransformComponent2D& transform = registry.emplace<TransformComponent2D>(entities[i]);
+			transform.position = { float(i % 32), float(i / 32) };
+			transform.rotation = 0.01f * float(i);
+			registry.emplace<ComponentT>(entities[i], component);
+		}
+		return entities;
+	}
+
+	// Measures generating world vertex positions of shapes with a fixed number of vertices (rectangles, triangles, lines)
+	template<typename ComponentT, int VerticesCount, auto GetVertexPositionsFunc>
+	static void benchmarkFixedShape(BenchmarkContext& context)
+	{
+		entt::registry registry;
+		const std::vector<entt::entity> entities = generateEntities(registry, ENTITIES_COUNT, ComponentT{});
+		std::vector<BenchmarkVertex> vertices(VerticesCount);
+
+		context.measure([&]()
+		{
+			for (entt::entity entity : entities)
+			{
+				GetVertexPositionsFunc(registry, entity, vertices.data(), sizeof(BenchmarkVertex), offsetof(BenchmarkVertex, position));
+			}
+			doNotOptimize(vertices.data());
+		});
+	}
+
+	// Measures generating vertex positions and indices of circles with a given number of segments
+	template<int SegmentsCount, bool World>
+	static void benchmarkCircle(BenchmarkContext& context)
+	{
+		CircleGeometryComponent circle;
+		circle.segmentsCount = SegmentsCount;
+
+		entt::registry registry;
+		const std::vector<entt::entity> entities = generateEntities(registry, ENTITIES_COUNT, circle);
+		std::vector<BenchmarkVertex> vertices(SegmentsCount);
+		std::vector<unsigned> indices;
+
+		context.measure([&]()
+		{
+			for (entt::entity entity : entities)
+			{
+				if constexpr (World)
+				{
+					CircleGeometrySystem::getVertexPositionsAndIndicesWorld
+					(
+						registry, entity,
+						vertices.data(), SegmentsCount, sizeof(BenchmarkVertex), offsetof(BenchmarkVertex, position),
+						indices
+					);
+				}
+				else
+				{
+					CircleGeometrySystem::getVertexPositionsAndIndicesLocal
+					(
+						registry, entity,
+						vertices.data(), SegmentsCount, sizeof(BenchmarkVertex), offsetof(BenchmarkVertex, position),
+						indices
+					);
+				}
+			}
+			doNotOptimize(vertices.data());
+			doNotOptimize(indices.data());
+		});
+	}
+
+	// Measures generating world vertex positions and indices of star-shaped (concave) polygons with a given number of vertices
+	template<int VerticesCount>
+	static void benchmarkPolygon(BenchmarkContext& context)
+	{
+		PolygonGeometryComponent polygon;
+		for (int i = 0; i < VerticesCount; i++)
+		{
+			const float angle = glm::two_pi<float>() * float(i) / float(VerticesCount);
+			const float radius = (i % 2 == 0) ? 1.0f : 0.5f;
+			polygon.vertexPositions.push_back({ radius * std::cos(angle), radius * std::sin(angle) });
+		}
+
+		entt::registry registry;
+		const std::vector<entt::entity> entities = generateEntities(registry, ENTITIES_COUNT, polygon);
+		std::vector<BenchmarkVertex> vertices(VerticesCount);
+		std::vector<unsigned> indices;
+
+		context.measure([&]()
+		{
+			for (entt::entity entity : entities)
+			{
+				PolygonGeometrySystem::getVertexPositionsAndIndicesWorld
+				(
+					registry, entity,
+					vertices.data(), VerticesCount, sizeof(BenchmarkVertex), offsetof(BenchmarkVertex, position),
+					indices
+				);
+			}
+			doNotOptimize(vertices.data());
+			doNotOptimize(indices.data());
+		});
+	}
+
+	void addGeometryBenchmarks(BenchmarkRunner& runner)
+	{
+		// Each benchmark generates vertices for 1024 entities
+		runner.add("Geometry/Rectangle/World", benchmarkFixedShape<RectangleGeometryComponent, 4, RectangleGeometrySystem::getVertexPositionsWorld>);
+		runner.add("Geometry/Triangle/World", benchmarkFixedShape<TriangleGeometryComponent, 3, TriangleGeometrySystem::getVertexPositionsWorld>);
+		runner.add("Geometry/Line/World", benchmarkFixedShape<LineGeometryComponent, 4, LineGeometrySystem::getVertexPositionsWorld>);
+		runner.add("Geometry/Circle32/Local", benchmarkCircle<32, false>);
+		runner.add("Geometry/Circle32/World", benchmarkCircle<32, true>);
+		runner.add("Geometry/Circle128/World", benchmarkCircle<128, true>);
+		runner.add("Geometry/Polygon16/World", benchmarkPolygon<16>);
+	}
+
+} // namespace Benchmarks
+} // namespace Pekan
\ No newline at end of file
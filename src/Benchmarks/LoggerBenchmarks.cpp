@@ -0,0 +1,157 @@
+#include "BenchmarkSuites.h"
+#include "Benchmark.h"
+
+#include "PekanLogger.h"
+
+#include <iostream>
+#include <streambuf>
+
+namespace Pekan
+{
+namespace Benchmarks
+{
+
+	// A stream buffer that discards everything written to it
+	class NullStreamBuffer : public std::streambuf
+	{
+	protected:
+		int overflow(int c) override { return traits_type::not_eof(c); }
+		std::streamsize xsputn(const char* s, std::streamsize n) override { return n; }
+	};
+
+	// Redirects std::cout to a null stream buffer for as long as it's alive,
+	// so that logging benchmarks measure the logger itself and not the terminal.
+	class ScopedConsoleSilencer
+	{
+	public:
+		ScopedConsoleSilencer() : m_previousBuffer(std::cout.rdbuf(&m_nullBuffer)) {}
+		~ScopedConsoleSilencer() { std::cout.rdbuf(m_previousBuffer); }
+
+	private:
+		NullStreamBuffer m_nullBuffer;
+		std::streambuf* m_previousBuffer = nullptr;
+	};
+
+	// Enables/disables rate limiting of log messages for as long as it's alive.
+	// Benchmarks log the same message many times from the same call site,
+	// so without disabling rate limiting they would mostly measure suppressed messages.
+	class ScopedRateLimit
+	{
+	public:
+		explicit ScopedRateLimit(bool enabled) : m_wasEnabled(Logger::isRateLimitEnabled()) { Logger::setRateLimitEnabled(enabled); }
+		~ScopedRateLimit() { Logger::setRateLimitEnabled(m_wasEnabled); }
+
+	private:
+		bool m_wasEnabled = false;
+	};
+
+	// Measures an info message logged to the console, with a few formatted values
+	static void benchmarkLogInfo(BenchmarkContext& context)
+	{
+		ScopedConsoleSilencer silencer;
+		ScopedRateLimit rateLimit(false);
+		int value = 0;
+
+		context.measure([&]()
+		{
+			value++;
+			PK_LOG_INFO("Benchmark message with value " << value << " and position (" << 1.5f << ", " << 2.5f << ")", "Pekan");
+		});
+	}
+
+	// Measures an info message logged to the console in async mode, with a few formatted values.
+	// This is the cost paid by the calling thread, the message is written by logger's background thread.
+	static void benchmarkLogInfoAsync(BenchmarkContext& context)
+	{
+		ScopedConsoleSilencer silencer;
+		ScopedRateLimit rateLimit(false);
+		const bool wasAsyncEnabled = Logger::isAsyncEnabled();
+		const Logger::AsyncOverflowPolicy previousPolicy = Logger::getAsyncOverflowPolicy();
+		Logger::setAsyncEnabled(true);
+		// Wait for the background thread when the queue is full, so that dropped messages don't make this look cheaper
+		Logger::setAsyncOverflowPolicy(Logger::AsyncOverflowPolicy::Block);
+		int value = 0;
+
+		context.measure([&]()
+		{
+			value++;
+			PK_LOG_INFO("Benchmark message with value " << value << " and position (" << 1.5f << ", " << 2.5f << ")", "Pekan");
+		});
+
+		Logger::flush();
+		Logger::setAsyncOverflowPolicy(previousPolicy);
+		Logger::setAsyncEnabled(wasAsyncEnabled);
+	}
+
+	// Measures a debug message with a few formatted values.
+	// Debug messages are disabled by default, so this measures the cost of a log that's not shown.
+	static void benchmarkLogDisabledDebug(BenchmarkContext& context)
+	{
+		ScopedConsoleSilencer silencer;
+		ScopedRateLimit rateLimit(false);
+		int value = 0;
+
+		context.measure([&]()
+		{
+			value++;
+			PK_LOG_DEBUG("Benchmark message with value " << value << " and position (" << 1.5f << ", " << 2.5f << ")", "Pekan");
+		});
+	}
+
+	// Measures an info message logged to the console with a PK_LOGF_* macro, with a few formatted values
+	static void benchmarkLogInfoFormatted(BenchmarkContext& context)
+	{
+		ScopedConsoleSilencer silencer;
+		ScopedRateLimit rateLimit(false);
+		int value = 0;
+
+		context.measure([&]()
+		{
+			value++;
+			PK_LOGF_INFO("Benchmark message with value {} and position ({}, {})", "Pekan", value, 1.5f, 2.5f);
+		});
+	}
+
+	// Measures a disabled debug message logged with a PK_LOGF_* macro, with a few formatted values
+	static void benchmarkLogDisabledDebugFormatted(BenchmarkContext& context)
+	{
+		ScopedConsoleSilencer silencer;
+		ScopedRateLimit rateLimit(false);
+		int value = 0;
+
+		context.measure([&]()
+		{
+			value++;
+			PK_LOGF_DEBUG("Benchmark message with value {} and position ({}, {})", "Pekan", value, 1.5f, 2.5f);
+		});
+		doNotOptimize(value);
+	}
+
+	// Measures an info message logged over and over from the same call site, with rate limiting enabled,
+	// so that almost all messages are suppressed, like a message logged once per entity per frame
+	static void benchmarkLogInfoRateLimited(BenchmarkContext& context)
+	{
+		ScopedConsoleSilencer silencer;
+		ScopedRateLimit rateLimit(true);
+		int value = 0;
+
+		context.measure([&]()
+		{
+			value++;
+			PK_LOG_INFO("Benchmark message with value " << value << " and position (" << 1.5f << ", " << 2.5f << ")", "Pekan");
+		});
+		doNotOptimize(value);
+	}
+
+	void addLoggerBenchmarks(BenchmarkRunner& runner)
+	{
+		runner.add("Logger/Info", benchmarkLogInfo);
+		runner.add("Logger/InfoAsync", benchmarkLogInfoAsync);
+		runner.add("Logger/DisabledDebug", benchmarkLogDisabledDebug);
+		runner.add("Logger/InfoFormatted", benchmarkLogInfoFormatted);
+		runner.add("Logger/DisabledDebugFormatted", benchmarkLogDisabledDebugFormatted);
+		runner.add("Logger/InfoRateLimited", benchmarkLogInfoRateLimited);
+	}
+
+} // namespace Benchmarks
+} // namespace Pekan
\ No newline at end of file
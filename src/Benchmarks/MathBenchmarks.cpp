@@ -0,0 +1,82 @@
+#include "BenchmarkSuites.h"
+#include "Benchmark.h"
+
+#include "Utils/MathUtils.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace Pekan
+{
+namespace Benchmarks
+{
+
+	// Returns vertices of a regular polygon with a given number of vertices, in CCW order
+	static std::vector<glm::vec2> generateConvexPolygon(int verticesCount)
+	{
+		std::vector<glm::vec2> vertices(verticesCount);
+		for (int i = 0; i < verticesCount; i++)
+		{
+			const float angle = glm::two_pi<float>() * float(i) / float(verticesCount);
+			vertices[i] = { std::cos(angle), std::sin(angle) };
+		}
+		return vertices;
+	}
+
+	// Returns vertices of a star-shaped (concave) polygon with a given number of vertices, in CCW order.
+	// Every other vertex is pulled towards the center, so half of the vertices are reflex,
+	// which is the hard case for ear clipping.
+	static std::vector<glm::vec2> generateConcavePolygon(int verticesCount)
+	{
+		std::vector<glm::vec2> vertices(verticesCount);
+		for (int i = 0; i < verticesCount; i++)
+		{
+			const float angle = glm::two_pi<float>() * float(i) / float(verticesCount);
+			const float radius = (i % 2 == 0) ? 1.0f : 0.5f;
+			vertices[i] = { radius * std::cos(angle), radius * std::sin(angle) };
+		}
+		return vertices;
+	}
+
+	template<int VerticesCount, bool IsConvex>
+	static void benchmarkTriangulatePolygon(BenchmarkContext& context)
+	{
+		const std::vector<glm::vec2> vertices = IsConvex ? generateConvexPolygon(VerticesCount) : generateConcavePolygon(VerticesCount);
+		std::vector<unsigned> indices;
+
+		context.measure([&]()
+		{
+			indices.clear();
+			MathUtils::triangulatePolygon(vertices, indices);
+			doNotOptimize(indices.data());
+		});
+	}
+
+	template<int VerticesCount, bool IsConvex>
+	static void benchmarkIsPolygonConvex(BenchmarkContext& context)
+	{
+		const std::vector<glm::vec2> vertices = IsConvex ? generateConvexPolygon(VerticesCount) : generateConcavePolygon(VerticesCount);
+
+		context.measure([&]()
+		{
+			const bool isConvex = MathUtils::isPolygonConvex(vertices);
+			doNotOptimize(isConvex);
+		});
+	}
+
+	void addMathBenchmarks(BenchmarkRunner& runner)
+	{
+		runner.add("Math/triangulatePolygon/Convex16", benchmarkTriangulatePolygon<16, true>);
+		runner.add("Math/triangulatePolygon/Convex256", benchmarkTriangulatePolygon<256, true>);
+		runner.add("Math/triangulatePolygon/Concave16", benchmarkTriangulatePolygon<16, false>);
+		runner.add("Math/triangulatePolygon/Concave256", benchmarkTriangulatePolygon<256, false>);
+		runner.add("Math/isPolygonConvex/Convex16", benchmarkIsPolygonConvex<16, true>);
+		runner.add("Math/isPolygonConvex/Convex256", benchmarkIsPolygonConvex<256, true>);
+		runner.add("Math/isPolygonConvex/Concave256", benchmarkIsPolygonConvex<256, false>);
+	}
+
+} // namespace Benchmarks
+} // namespace Pekan
\ No newline at end of file
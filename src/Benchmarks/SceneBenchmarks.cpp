@@ -0,0 +1,136 @@
+#include "BenchmarkSuites.h"
+#include "Benchmark.h"
+
+#include "Scene2D.h"
+#include "Scene2DSerializer.h"
+#include "TransformComponent2D.h"
+#include "RectangleGeometryComponent.h"
+#include "CircleGeometryComponent.h"
+#include "PolygonGeometryComponent.h"
+#include "SolidColorMaterialComponent.h"
+#include "RenderOrderComponent2D.h"
+#include "Entity/NameComponent.h"
+#include "PekanLogger.h"
+
+#include <string>
+
+namespace Pekan
+{
+namespace Benchmarks
+{
+
+	using namespace Renderer2D;
+
+	// A Scene2D that can be filled with generated entities, without being part of an application
+	class BenchmarkScene : public Scene2D
+	{
+	public:
+
+		BenchmarkScene() : Scene2D(nullptr) {}
+
+		using Scene2D::clear;
+
+		// Fills the scene with a given number of generated entities.
+		// Entities are a mix of rectangles, circles and polygons with a solid color material,
+		// and every 4 consecutive entities form a small hierarchy.
+		void generate(int entitiesCount)
+		{
+			entt::registry& registry = getRegistry();
+			entt::entity parent = entt::null;
+			for (int i = 0; i < entitiesCount; i++)
+			{
+				const entt::entity entity = createEntity();
+				registry.emplace<NameComponent>(entity, "Entity" + std::to_string(i));
+
+				TransformComponent2D& transform = registry.emplace<TransformComponent2D>(entity);
+				transform.position = { float(i % 32), float(i / 32) };
+				transform.rotation = 0.01f * float(i);
+				transform.parent = (i % 4 == 0) ? entt::null : parent;
+				if (i % 4 == 0)
+				{
+					parent = entity;
+				}
+
+				switch (i % 3)
+				{
+					case 0: registry.emplace<RectangleGeometryComponent>(entity, 2.0f, 1.0f); break;
+					case 1: registry.emplace<CircleGeometryComponent>(entity, 0.5f, 32); break;
+					case 2:
+					{
+						PolygonGeometryComponent& polygon = registry.emplace<PolygonGeometryComponent>(entity);
+						polygon.vertexPositions = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.5f, 0.5f }, { 0.0f, 1.0f } };
+						break;
+					}
+				}
+
+				registry.emplace<SolidColorMaterialComponent>(entity, glm::vec4(float(i % 5) / 5.0f, 0.5f, 0.5f, 1.0f));
+				registry.emplace<RenderOrderComponent2D>(entity, i % 3, 0.5f);
+			}
+		}
+	};
+
+	// A serializer that parses the whole scene file and creates all entities,
+	// but skips their components.
+	//
+	// Scene2DSerializer can't deserialize components yet,
+	// so this is used to measure the scene-type-independent part of deserialization.
+	class EntitiesOnlySerializer : public SceneSerializer
+	{
+		std::string getSceneType() const override { return "scene2d"; }
+
+		nlohmann::ordered_json serializeComponents(entt::entity entity, const entt::registry& registry) const override
+		{
+			return nlohmann::ordered_json::object();
+		}
+
+		bool deserializeComponents(const nlohmann::ordered_json& componentsJson, entt::entity entity, entt::registry& registry) const override
+		{
+			return true;
+		}
+	};
+
+	template<int EntitiesCount>
+	static void benchmarkSerialize(BenchmarkContext& context)
+	{
+		BenchmarkScene scene;
+		scene.generate(EntitiesCount);
+		const Scene2DSerializer serializer;
+
+		context.measure([&]()
+		{
+			const std::string jsonText = serializer.serialize(scene);
+			doNotOptimize(jsonText.data());
+		});
+	}
+
+	template<int EntitiesCount>
+	static void benchmarkDeserialize(BenchmarkContext& context)
+	{
+		BenchmarkScene sourceScene;
+		sourceScene.generate(EntitiesCount);
+		const std::string jsonText = Scene2DSerializer().serialize(sourceScene);
+
+		BenchmarkScene scene;
+		const EntitiesOnlySerializer serializer;
+
+		context.measure([&]()
+		{
+			scene.clear();
+			if (!serializer.deserialize(jsonText, scene))
+			{
+				PK_LOG_ERROR("Failed to deserialize a generated scene.", "Pekan");
+			}
+			doNotOptimize(scene.getEntities().data());
+		});
+	}
+
+	void addSceneBenchmarks(BenchmarkRunner& runner)
+	{
+		runner.add("Scene/serialize/Entities100", benchmarkSerialize<100>);
+		runner.add("Scene/serialize/Entities1000", benchmarkSerialize<1000>);
+		runner.add("Scene/deserialize/Entities100", benchmarkDeserialize<100>);
+		runner.add("Scene/deserialize/Entities1000", benchmarkDeserialize<1000>);
+	}
+
+} // namespace Benchmarks
+} // namespace Pekan
\ No newline at end of file
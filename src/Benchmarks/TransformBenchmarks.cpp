@@ -0,0 +1,73 @@
+#include "BenchmarkSuites.h"
+#include "Benchmark.h"
+
+#include "TransformComponent2D.h"
+#include "TransformSystem2D.h"
+
+#include <glm/glm.hpp>
+#include <entt/entt.hpp>
+
+#include <vector>
+
+namespace Pekan
+{
+namespace Benchmarks
+{
+
+	using namespace Renderer2D;
+
+	// Creates a given number of entities with a transform in a given registry,
+	// where the parent of each entity is the entity created a given number of entities before it.
+	// - With parentStride = 1 entities form a single chain, as deep as the number of entities.
+	// - With a bigger parentStride entities form parentStride independent chains.
+	// - With parentStride = 0 all entities are roots.
+	static std::vector<entt::entity> generateHierarchy(entt::registry& registry, int entitiesCount, int parentStride)
+	{
+		std::vector<entt::entity> entities(entitiesCount);
+		for (int i = 0; i < entitiesCount; i++)
+		{
+			entities[i] = registry.create();
+			TransformComponent2D& transform = registry.emplace<TransformComponent2D>(entities[i]);
+			transform.position = { float(i % 7), float(i % 11) };
+			transform.rotation = 0.01f * float(i);
+			transform.scaleFactor = { 1.01f, 0.99f };
+			if (parentStride > 0 && i >= parentStride)
+			{
+				transform.parent = entities[i - parentStride];
+			}
+		}
+		return entities;
+	}
+
+	// Measures computing world matrices of all entities of a hierarchy
+	template<int EntitiesCount, int ParentStride>
+	static void benchmarkGetWorldMatrix(BenchmarkContext& context)
+	{
+		entt::registry registry;
+		const std::vector<entt::entity> entities = generateHierarchy(registry, EntitiesCount, ParentStride);
+
+		context.measure([&]()
+		{
+			glm::mat3 sum(0.0f);
+			for (entt::entity entity : entities)
+			{
+				sum += TransformSystem2D::getWorldMatrix(registry, entity);
+			}
+			doNotOptimize(sum);
+		});
+	}
+
+	void addTransformBenchmarks(BenchmarkRunner& runner)
+	{
+		// 1024 entities, each of them a root
+		runner.add("Transform/getWorldMatrix/Flat1024", benchmarkGetWorldMatrix<1024, 0>);
+		// 1024 entities in 128 chains of depth 8
+		runner.add("Transform/getWorldMatrix/Depth8x128", benchmarkGetWorldMatrix<1024, 128>);
+		// 1024 entities in 32 chains of depth 32
+		runner.add("Transform/getWorldMatrix/Depth32x32", benchmarkGetWorldMatrix<1024, 32>);
+		// 256 entities in a single chain of depth 256
+		runner.add("Transform/getWorldMatrix/Depth256x1", benchmarkGetWorldMatrix<256, 1>);
+	}
+
+} // namespace Benchmarks
+} // namespace Pekan
\ No newline at end of file
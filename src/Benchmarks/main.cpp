@@ -0,0 +1,86 @@
+#include "Benchmark.h"
+#include "BenchmarkSuites.h"
+
+#include "PekanLogger.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace Pekan::Benchmarks;
+
+static void printUsage()
+{
+	std::printf
+	(
+		"Usage: PekanBenchmarks [options]\n"
+		"  --filter <text>       Run only benchmarks whose name contains <text>\n"
+		"  --json <filepath>     Write results to a JSON file\n"
+		"  --repetitions <n>     Number of measured repetitions (default %d)\n"
+		"  --warmup <n>          Number of warmup repetitions (default %d)\n"
+		"  --min-time <seconds>  Minimum time of a single repetition (default %g)\n"
+		"  --list                List all benchmarks and exit\n",
+		BenchmarkProperties().repetitions, BenchmarkProperties().warmupRepetitions, BenchmarkProperties().minRepetitionTime
+	);
+}
+
+int main(int argc, char* argv[])
+{
+	BenchmarkRunner runner;
+	addMathBenchmarks(runner);
+	addTransformBenchmarks(runner);
+	addGeometryBenchmarks(runner);
+	addSceneBenchmarks(runner);
+	addEventBenchmarks(runner);
+	addLoggerBenchmarks(runner);
+
+	BenchmarkProperties properties;
+	std::string filter;
+	const char* jsonFilepath = nullptr;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+		const bool takesValue = strcmp(arg, "--filter") == 0 || strcmp(arg, "--json") == 0
+			|| strcmp(arg, "--repetitions") == 0 || strcmp(arg, "--warmup") == 0 || strcmp(arg, "--min-time") == 0;
+		if (takesValue && value == nullptr)
+		{
+			PK_LOG_ERROR("Missing value for argument " << arg << ".", "Pekan");
+			printUsage();
+			return -1;
+		}
+
+		if (strcmp(arg, "--filter") == 0)              { filter = value; i++; }
+		else if (strcmp(arg, "--json") == 0)           { jsonFilepath = value; i++; }
+		else if (strcmp(arg, "--repetitions") == 0)    { properties.repetitions = std::atoi(value); i++; }
+		else if (strcmp(arg, "--warmup") == 0)         { properties.warmupRepetitions = std::atoi(value); i++; }
+		else if (strcmp(arg, "--min-time") == 0)       { properties.minRepetitionTime = std::atof(value); i++; }
+		else if (strcmp(arg, "--list") == 0)
+		{
+			runner.printNames();
+			return 0;
+		}
+		else
+		{
+			printUsage();
+			return (strcmp(arg, "--help") == 0) ? 0 : -1;
+		}
+	}
+
+	if (properties.repetitions <= 0 || properties.warmupRepetitions < 0 || properties.minRepetitionTime < 0.0)
+	{
+		PK_LOG_ERROR("Invalid benchmark properties. Repetitions must be positive, warmup repetitions and minimum time must not be negative.", "Pekan");
+		return -1;
+	}
+
+	const bool success = runner.run(properties, filter);
+	runner.printResults();
+
+	if (jsonFilepath != nullptr && !runner.writeJson(jsonFilepath))
+	{
+		return -1;
+	}
+	return success ? 0 : -1;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "KeyEvents.h"
+#include "MouseEvents.h"
+#include "WindowEvents.h"
+
+#include <variant>
+#include <vector>
+
+namespace Pekan
+{
+
+	// A tagged union that can hold an event of any type.
+	// Used for storing events by value, so that storing them doesn't need a heap allocation per event.
+	using AnyEvent = std::variant
+	<
+		KeyPressedEvent,
+		KeyReleasedEvent,
+		MouseMovedEvent,
+		MouseScrolledEvent,
+		MouseButtonPressedEvent,
+		MouseButtonReleasedEvent,
+		WindowResizedEvent,
+		WindowClosedEvent
+	>;
+
+	// A queue of events
+	// where events are pushed when they happen
+	// and can be handled later, usually once per frame,
+	// by popping them one by one from the queue.
+	//
+	// Events are stored by value, and memory is reused once the queue is emptied,
+	// so after the first few frames pushing events doesn't allocate.
+	class EventQueue
+	{
+	public:
+
+		// Pushes an event to the event queue
+		template<typename EventT>
+		void push(const EventT& event)
+		{
+			m_events.emplace_back(std::in_place_type<EventT>, event);
+		}
+
+		// Checks if the event queue is empty
+		bool empty() const
+		{
+			return m_frontIndex >= m_events.size();
+		}
+
+		// Returns event queue's size
+		int size() const
+		{
+			return int(m_events.size() - m_frontIndex);
+		}
+
+		// Returns the event at the front of the event queue, the one that will be popped next.
+		// Use std::visit() or std::get_if() on it to get the event as its concrete type.
+		const AnyEvent& front() const
+		{
+			return m_events[m_frontIndex];
+		}
+
+		// Pops an event from the front of the event queue
+		void pop()
+		{
+			m_frontIndex++;
+			if (empty())
+			{
+				clear();
+			}
+		}
+
+		// Removes all events from the event queue, keeping its memory for reuse
+		void clear()
+		{
+			m_events.clear();
+			m_frontIndex = 0;
+		}
+
+	private:
+
+		// Underlying storage of events. Events before the front index are already popped.
+		std::vector<AnyEvent> m_events;
+		// Index of the event at the front of the queue
+		size_t m_frontIndex = 0;
+	};
+
+	// Returns a given event, stored in an AnyEvent, as a reference to the base Event class
+	inline const Event& getEvent(const AnyEvent& event)
+	{
+		return std::visit([](const Event& e) -> const Event& { return e; }, event);
+	}
+
+} // namespace Pekan
\ No newline at end of file
@@ -12,17 +12,22 @@ namespace Pekan
 	class MouseMovedEvent : public Event
 	{
 	public:
-		MouseMovedEvent(float x, float y)
-			: m_mouseX(x), m_mouseY(y)
+		MouseMovedEvent(float x, float y, float deltaX = 0.0f, float deltaY = 0.0f)
+			: m_mouseX(x), m_mouseY(y), m_deltaX(deltaX), m_deltaY(deltaY)
 		{}
 
 		float getX() const { return m_mouseX; }
 		float getY() const { return m_mouseY; }
 
+		// Returns how much the mouse has moved since the previous mouse-moved event.
+		// If mouse events are coalesced, this is the accumulated movement of all coalesced events.
+		float getDeltaX() const { return m_deltaX; }
+		float getDeltaY() const { return m_deltaY; }
+
 		std::string toString() const override
 		{
 			std::stringstream ss;
-			ss << "MouseMovedEvent { mouseX: " << m_mouseX << ", mouseY: " << m_mouseY << " }";
+			ss << "MouseMovedEvent { mouseX: " << m_mouseX << ", mouseY: " << m_mouseY << ", deltaX: " << m_deltaX << ", deltaY: " << m_deltaY << " }";
 			return ss.str();
 		}
 
@@ -30,9 +35,11 @@ namespace Pekan
 		EVENT_CLASS_CATEGORY(EventCategoryMouse | EventCategoryInput)
 	private:
 		float m_mouseX, m_mouseY;
+		float m_deltaX, m_deltaY;
 	};
 
-	// A type of event that occurs when the scroll wheel of the mouse is scrolled
+	// A type of event that occurs when the scroll wheel of the mouse is scrolled.
+	// If mouse events are coalesced, offsets are the sum of offsets of all coalesced events.
 	class MouseScrolledEvent : public Event
 	{
 	public:
@@ -0,0 +1,104 @@
+#include "InputSnapshot.h"
+
+namespace Pekan
+{
+
+	// Returns a pointer to the state at a given index in a given array of states,
+	// or null if index is outside of the array.
+	static unsigned char* getState(unsigned char* states, int count, int index)
+	{
+		if (index < 0 || index >= count)
+		{
+			return nullptr;
+		}
+		return &states[index];
+	}
+
+	void InputSnapshot::recordKeyPressed(KeyCode key, bool isRepeating)
+	{
+		unsigned char* state = getState(m_keyStates, KEYS_COUNT, int(key));
+		if (state == nullptr)
+		{
+			return;
+		}
+		if (isRepeating)
+		{
+			*state |= STATE_DOWN | STATE_REPEATING;
+		}
+		else
+		{
+			*state |= STATE_DOWN | STATE_PRESSED_THIS_FRAME;
+		}
+	}
+
+	void InputSnapshot::recordKeyReleased(KeyCode key)
+	{
+		unsigned char* state = getState(m_keyStates, KEYS_COUNT, int(key));
+		if (state == nullptr)
+		{
+			return;
+		}
+		*state &= ~(STATE_DOWN | STATE_REPEATING);
+		*state |= STATE_RELEASED_THIS_FRAME;
+	}
+
+	void InputSnapshot::recordMouseButtonPressed(MouseButton button)
+	{
+		unsigned char* state = getState(m_mouseButtonStates, MOUSE_BUTTONS_COUNT, int(button));
+		if (state == nullptr)
+		{
+			return;
+		}
+		*state |= STATE_DOWN | STATE_PRESSED_THIS_FRAME;
+	}
+
+	void InputSnapshot::recordMouseButtonReleased(MouseButton button)
+	{
+		unsigned char* state = getState(m_mouseButtonStates, MOUSE_BUTTONS_COUNT, int(button));
+		if (state == nullptr)
+		{
+			return;
+		}
+		*state &= ~STATE_DOWN;
+		*state |= STATE_RELEASED_THIS_FRAME;
+	}
+
+	void InputSnapshot::recordMouseMoved(glm::vec2 mousePosition)
+	{
+		m_mouseDelta += mousePosition - m_mousePosition;
+		m_mousePosition = mousePosition;
+	}
+
+	void InputSnapshot::recordMouseScrolled(glm::vec2 offset)
+	{
+		m_scrollDelta += offset;
+	}
+
+	void InputSnapshot::beginFrame()
+	{
+		constexpr unsigned char HELD_STATE_MASK = STATE_DOWN | STATE_REPEATING;
+		for (unsigned char& state : m_keyStates)
+		{
+			state &= HELD_STATE_MASK;
+		}
+		for (unsigned char& state : m_mouseButtonStates)
+		{
+			state &= HELD_STATE_MASK;
+		}
+		m_mouseDelta = glm::vec2(0.0f);
+		m_scrollDelta = glm::vec2(0.0f);
+	}
+
+	unsigned char InputSnapshot::getKeyState(KeyCode key) const
+	{
+		const int index = int(key);
+		return (index >= 0 && index < KEYS_COUNT) ? m_keyStates[index] : 0;
+	}
+
+	unsigned char InputSnapshot::getMouseButtonState(MouseButton button) const
+	{
+		const int index = int(button);
+		return (index >= 0 && index < MOUSE_BUTTONS_COUNT) ? m_mouseButtonStates[index] : 0;
+	}
+
+} // namespace Pekan
\ No newline at end of file
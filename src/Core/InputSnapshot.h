@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Events/KeyEvents_Enums.h"
+#include "Events/MouseEvents_Enums.h"
+
+#include <glm/glm.hpp>
+
+namespace Pekan
+{
+
+	// State of keyboard and mouse input, captured once per frame, right after window's events are polled.
+	//
+	// Querying a snapshot only reads memory, so it's cheap to do as often as needed.
+	// Besides whether a key/button is currently held down, a snapshot knows if it was pressed/released during the last frame,
+	// so a key that was both pressed and released within a single frame is not missed.
+	//
+	// Current application's snapshot can be accessed with PekanEngine::getInputSnapshot()
+	class InputSnapshot
+	{
+		// PekanApplication is a friend so that it can record input events into a snapshot
+		friend class PekanApplication;
+
+	public:
+
+		// Checks if a given key from the keyboard is held down or not.
+		// A key is repeating if it had been pressed and held down for a bit, like half a second.
+		bool isKeyPressed(KeyCode key) const { return getKeyState(key) & STATE_DOWN; }
+		bool isKeyReleased(KeyCode key) const { return !isKeyPressed(key); }
+		bool isKeyRepeating(KeyCode key) const { return getKeyState(key) & STATE_REPEATING; }
+		// Checks if a given key was pressed/released during the last frame
+		bool wasKeyPressedThisFrame(KeyCode key) const { return getKeyState(key) & STATE_PRESSED_THIS_FRAME; }
+		bool wasKeyReleasedThisFrame(KeyCode key) const { return getKeyState(key) & STATE_RELEASED_THIS_FRAME; }
+
+		// Checks if a given mouse button is held down or not
+		bool isMouseButtonPressed(MouseButton button) const { return getMouseButtonState(button) & STATE_DOWN; }
+		bool isMouseButtonReleased(MouseButton button) const { return !isMouseButtonPressed(button); }
+		// Checks if a given mouse button was pressed/released during the last frame
+		bool wasMouseButtonPressedThisFrame(MouseButton button) const { return getMouseButtonState(button) & STATE_PRESSED_THIS_FRAME; }
+		bool wasMouseButtonReleasedThisFrame(MouseButton button) const { return getMouseButtonState(button) & STATE_RELEASED_THIS_FRAME; }
+
+		// Returns mouse position, in pixels, relative to window's top-left corner
+		glm::vec2 getMousePosition() const { return m_mousePosition; }
+		// Returns how much the mouse has moved during the last frame, in pixels
+		glm::vec2 getMouseDelta() const { return m_mouseDelta; }
+		// Returns how much the scroll wheel of the mouse was scrolled during the last frame
+		glm::vec2 getScrollDelta() const { return m_scrollDelta; }
+
+	private: /* functions */
+
+		// Functions recording input events into the snapshot
+		void recordKeyPressed(KeyCode key, bool isRepeating);
+		void recordKeyReleased(KeyCode key);
+		void recordMouseButtonPressed(MouseButton button);
+		void recordMouseButtonReleased(MouseButton button);
+		void recordMouseMoved(glm::vec2 mousePosition);
+		void recordMouseScrolled(glm::vec2 offset);
+
+		// Sets mouse position without recording a movement
+		void setMousePosition(glm::vec2 mousePosition) { m_mousePosition = mousePosition; }
+
+		// Prepares the snapshot for recording a new frame's input,
+		// clearing pressed/released-this-frame flags and mouse deltas, but keeping which keys and buttons are held down.
+		void beginFrame();
+
+		unsigned char getKeyState(KeyCode key) const;
+		unsigned char getMouseButtonState(MouseButton button) const;
+
+	private: /* variables */
+
+		// Flags making up the state of a key or a mouse button
+		static constexpr unsigned char STATE_DOWN = 1 << 0;
+		static constexpr unsigned char STATE_REPEATING = 1 << 1;
+		static constexpr unsigned char STATE_PRESSED_THIS_FRAME = 1 << 2;
+		static constexpr unsigned char STATE_RELEASED_THIS_FRAME = 1 << 3;
+
+		static constexpr int KEYS_COUNT = int(KeyCode::KEY_MENU) + 1;
+		static constexpr int MOUSE_BUTTONS_COUNT = 8;
+
+		// State of each key, indexed by key code
+		unsigned char m_keyStates[KEYS_COUNT] = {};
+		// State of each mouse button, indexed by button
+		unsigned char m_mouseButtonStates[MOUSE_BUTTONS_COUNT] = {};
+
+		glm::vec2 m_mousePosition = glm::vec2(0.0f);
+		glm::vec2 m_mouseDelta = glm::vec2(0.0f);
+		glm::vec2 m_scrollDelta = glm::vec2(0.0f);
+	};
+
+} // namespace Pekan
\ No newline at end of file
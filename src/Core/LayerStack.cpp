@@ -1,6 +1,7 @@
 #include "LayerStack.h"
 
 #include "PekanLogger.h"
+#include "Profiler.h"
 
 namespace Pekan
 {
@@ -33,6 +34,8 @@ namespace Pekan
 
 	void LayerStack::renderAll()
 	{
+		PK_PROFILE_FUNCTION();
+
 		for (Layer_Ptr layer : m_layers)
 		{
 			if (layer != nullptr)
@@ -44,6 +47,8 @@ namespace Pekan
 
 	void LayerStack::updateAll(double deltaTime)
 	{
+		PK_PROFILE_FUNCTION();
+
 		for (Layer_Ptr layer : m_layers)
 		{
 			if (layer != nullptr)
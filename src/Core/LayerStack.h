@@ -34,7 +34,7 @@ namespace Pekan
 		template<typename EventT>
 		bool dispatchEvent
 		(
-			std::unique_ptr<EventT>& event,
+			const EventT& event,
 			bool (EventListener::* onEventFunc)(const EventT&)
 		);
 
@@ -53,14 +53,14 @@ namespace Pekan
 	template<typename EventT>
 	bool LayerStack::dispatchEvent
 	(
-		std::unique_ptr<EventT>& event,
+		const EventT& event,
 		bool (EventListener::* onEventFunc)(const EventT&)
 	)
 	{
 		for (auto it = m_layers.rbegin(); it != m_layers.rend(); ++it)
 		{
 			EventListener* layer = static_cast<EventListener*>((*it).get());
-			if (layer != nullptr && (layer->*onEventFunc)(*event.get()))
+			if (layer != nullptr && (layer->*onEventFunc)(event))
 			{
 				return true;
 			}
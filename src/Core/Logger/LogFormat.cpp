@@ -0,0 +1,160 @@
+#include "LogFormat.h"
+
+#include <charconv>
+
+namespace Pekan
+{
+namespace Logger
+{
+
+	// A class writing characters to a fixed-size output, silently dropping whatever doesn't fit
+	class LogMessageOutput
+	{
+	public:
+
+		LogMessageOutput(char* data, size_t capacity) : m_data(data), m_capacity(capacity) {}
+
+		void append(std::string_view s)
+		{
+			const size_t length = (s.size() < m_capacity - m_size) ? s.size() : (m_capacity - m_size);
+			std::memcpy(m_data + m_size, s.data(), length);
+			m_size += length;
+		}
+
+		void append(char c)
+		{
+			if (m_size < m_capacity)
+			{
+				m_data[m_size++] = c;
+			}
+		}
+
+		size_t getSize() const { return m_size; }
+
+	private:
+
+		char* m_data = nullptr;
+		size_t m_capacity = 0;
+		size_t m_size = 0;
+	};
+
+	// Reads a value of type T from a payload at a given offset, and advances the offset
+	template <typename T>
+	static T readValue(const unsigned char* payload, size_t& offset)
+	{
+		T value;
+		std::memcpy(&value, payload + offset, sizeof(T));
+		offset += sizeof(T);
+		return value;
+	}
+
+	// Formats a floating-point number, with a given precision, or in the shortest form if precision is negative
+	template <typename T>
+	static void appendFloatingPoint(LogMessageOutput& output, T value, int precision)
+	{
+		char buffer[64];
+		const std::to_chars_result result = (precision >= 0)
+			? std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision)
+			: std::to_chars(buffer, buffer + sizeof(buffer), value);
+		output.append(std::string_view(buffer, (result.ec == std::errc()) ? size_t(result.ptr - buffer) : 0));
+	}
+
+	// Formats an integer, in hexadecimal if "isHex" is true
+	template <typename T>
+	static void appendInteger(LogMessageOutput& output, T value, bool isHex)
+	{
+		char buffer[32];
+		const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value, isHex ? 16 : 10);
+		output.append(std::string_view(buffer, size_t(result.ptr - buffer)));
+	}
+
+	// Formats the next argument from a payload at a given offset, and advances the offset.
+	// If there are no more arguments in the payload, because they didn't fit in it, writes "{?}".
+	static void appendArgument(LogMessageOutput& output, const unsigned char* payload, size_t payloadSize, size_t& offset, std::string_view spec)
+	{
+		if (offset >= payloadSize)
+		{
+			output.append("{?}");
+			return;
+		}
+
+		const bool isHex = (spec == ":x");
+		int precision = -1;
+		if (spec.size() > 2 && spec[1] == '.')
+		{
+			precision = 0;
+			for (size_t i = 2; i < spec.size(); i++)
+			{
+				precision = precision * 10 + (spec[i] - '0');
+			}
+		}
+
+		const LogArgType type = LogArgType(payload[offset++]);
+		switch (type)
+		{
+			case LogArgType::Bool:
+				output.append(readValue<bool>(payload, offset) ? "true" : "false");
+				break;
+			case LogArgType::Char:
+				output.append(readValue<char>(payload, offset));
+				break;
+			case LogArgType::Int:
+				appendInteger(output, readValue<long long>(payload, offset), isHex);
+				break;
+			case LogArgType::UInt:
+				appendInteger(output, readValue<unsigned long long>(payload, offset), isHex);
+				break;
+			case LogArgType::Float:
+				appendFloatingPoint(output, readValue<float>(payload, offset), precision);
+				break;
+			case LogArgType::Double:
+				appendFloatingPoint(output, readValue<double>(payload, offset), precision);
+				break;
+			case LogArgType::String:
+			{
+				const unsigned short length = readValue<unsigned short>(payload, offset);
+				output.append(std::string_view((const char*)(payload + offset), length));
+				offset += length;
+				break;
+			}
+			case LogArgType::Pointer:
+				output.append("0x");
+				appendInteger(output, readValue<uintptr_t>(payload, offset), true);
+				break;
+		}
+	}
+
+	size_t formatLogMessage(std::string_view format, const unsigned char* payload, size_t payloadSize, char* output, size_t capacity)
+	{
+		LogMessageOutput out(output, capacity);
+		size_t offset = 0;
+		for (size_t i = 0; i < format.size(); i++)
+		{
+			const char c = format[i];
+			if (c == '{' && i + 1 < format.size() && format[i + 1] == '{')
+			{
+				out.append('{');
+				i++;
+			}
+			else if (c == '}' && i + 1 < format.size() && format[i + 1] == '}')
+			{
+				out.append('}');
+				i++;
+			}
+			else if (c == '{')
+			{
+				// Format strings are checked at compile time, so a placeholder is always closed
+				const size_t end = format.find('}', i);
+				appendArgument(out, payload, payloadSize, offset, format.substr(i + 1, end - i - 1));
+				i = end;
+			}
+			else
+			{
+				out.append(c);
+			}
+		}
+		return out.getSize();
+	}
+
+} // namespace Logger
+} // namespace Pekan
\ No newline at end of file
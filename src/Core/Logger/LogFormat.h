@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Pekan
+{
+namespace Logger
+{
+
+	// Returns number of placeholders in a given format string, or -1 if format string is invalid.
+	//
+	// Format strings use a subset of std::format's syntax:
+	//     {}      is replaced by the next argument
+	//     {:x}    is replaced by the next argument, an integer, in hexadecimal
+	//     {:.N}   is replaced by the next argument, a floating-point number, with N digits after the decimal point
+	//     {{ }}   are replaced by { and }
+	constexpr int _countLogFormatPlaceholders(std::string_view format)
+	{
+		int count = 0;
+		for (size_t i = 0; i < format.size(); i++)
+		{
+			if (format[i] == '{')
+			{
+				if (i + 1 < format.size() && format[i + 1] == '{')
+				{
+					i++;
+					continue;
+				}
+				const size_t end = format.find('}', i);
+				if (end == std::string_view::npos)
+				{
+					return -1;
+				}
+				const std::string_view spec = format.substr(i + 1, end - i - 1);
+				if (!spec.empty() && spec != ":x")
+				{
+					// Only a precision is supported, like ":.3"
+					if (spec.size() < 3 || spec[0] != ':' || spec[1] != '.')
+					{
+						return -1;
+					}
+					for (size_t j = 2; j < spec.size(); j++)
+					{
+						if (spec[j] < '0' || spec[j] > '9')
+						{
+							return -1;
+						}
+					}
+				}
+				count++;
+				i = end;
+			}
+			else if (format[i] == '}')
+			{
+				if (i + 1 >= format.size() || format[i + 1] != '}')
+				{
+					return -1;
+				}
+				i++;
+			}
+		}
+		return count;
+	}
+
+	// Not a constexpr function, so calling it while checking a format string at compile time fails compilation
+	inline void _invalidLogFormatStringOrWrongNumberOfArguments() {}
+
+	// A format string for given types of arguments, checked at compile time.
+	// Compilation fails if format string is invalid or if its number of placeholders doesn't match the number of arguments.
+	template <typename... Args>
+	struct LogFormatString
+	{
+		template <typename S>
+			requires std::is_convertible_v<const S&, std::string_view>
+		consteval LogFormatString(const S& s)
+			: str(s)
+		{
+			if (_countLogFormatPlaceholders(str) != int(sizeof...(Args)))
+			{
+				_invalidLogFormatStringOrWrongNumberOfArguments();
+			}
+		}
+
+		std::string_view str;
+	};
+
+	// Types of arguments that can be captured in a log payload
+	enum class LogArgType : unsigned char
+	{
+		Bool,
+		Char,
+		Int,
+		UInt,
+		Float,
+		Double,
+		String,
+		Pointer
+	};
+
+	// A class capturing arguments of a log message into a compact binary payload, without allocating.
+	// Each argument is written as its type followed by its value. Strings are copied, prefixed by their length.
+	//
+	// Supported arguments are booleans, characters, integers, enums, floating-point numbers,
+	// strings (const char*, std::string, std::string_view) and pointers.
+	// If payload's capacity is reached, the last string that doesn't fit is truncated, and any following arguments are skipped.
+	class LogArgsWriter
+	{
+	public:
+
+		LogArgsWriter(unsigned char* data, size_t capacity)
+			: m_data(data)
+			, m_capacity(capacity)
+		{}
+
+		template <typename T>
+		void write(const T& arg)
+		{
+			using Type = std::decay_t<T>;
+			if constexpr (std::is_same_v<Type, bool>)
+			{
+				writeValue(LogArgType::Bool, arg);
+			}
+			else if constexpr (std::is_same_v<Type, char>)
+			{
+				writeValue(LogArgType::Char, arg);
+			}
+			else if constexpr (std::is_enum_v<Type>)
+			{
+				writeValue(LogArgType::Int, (long long)(arg));
+			}
+			else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>)
+			{
+				writeValue(LogArgType::Int, (long long)(arg));
+			}
+			else if constexpr (std::is_integral_v<Type>)
+			{
+				writeValue(LogArgType::UInt, (unsigned long long)(arg));
+			}
+			else if constexpr (std::is_same_v<Type, float>)
+			{
+				writeValue(LogArgType::Float, arg);
+			}
+			else if constexpr (std::is_floating_point_v<Type>)
+			{
+				writeValue(LogArgType::Double, double(arg));
+			}
+			else if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>)
+			{
+				writeString((arg != nullptr) ? std::string_view(arg) : std::string_view("(null)"));
+			}
+			else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+			{
+				writeString(std::string_view(arg));
+			}
+			else if constexpr (std::is_pointer_v<Type>)
+			{
+				writeValue(LogArgType::Pointer, uintptr_t(arg));
+			}
+			else
+			{
+				static_assert(sizeof(T) == 0, "Unsupported type of a log argument. Use PK_LOG_* macros for logging values of other types.");
+			}
+		}
+
+		// Returns number of bytes written so far
+		size_t getSize() const { return m_size; }
+
+	private: /* functions */
+
+		template <typename T>
+		void writeValue(LogArgType type, const T& value)
+		{
+			if (m_isFull || m_size + 1 + sizeof(T) > m_capacity)
+			{
+				m_isFull = true;
+				return;
+			}
+			m_data[m_size] = (unsigned char)(type);
+			std::memcpy(m_data + m_size + 1, &value, sizeof(T));
+			m_size += 1 + sizeof(T);
+		}
+
+		void writeString(std::string_view s)
+		{
+			if (m_isFull || m_size + 1 + sizeof(unsigned short) > m_capacity)
+			{
+				m_isFull = true;
+				return;
+			}
+			const size_t maxLength = m_capacity - m_size - 1 - sizeof(unsigned short);
+			if (s.size() > maxLength)
+			{
+				s = s.substr(0, maxLength);
+				m_isFull = true;
+			}
+			const unsigned short length = (unsigned short)(s.size());
+			m_data[m_size] = (unsigned char)(LogArgType::String);
+			std::memcpy(m_data + m_size + 1, &length, sizeof(length));
+			std::memcpy(m_data + m_size + 1 + sizeof(length), s.data(), length);
+			m_size += 1 + sizeof(length) + length;
+		}
+
+	private: /* variables */
+
+		unsigned char* m_data = nullptr;
+		size_t m_capacity = 0;
+		size_t m_size = 0;
+		// Flag indicating if an argument didn't fit, so no more arguments are written
+		bool m_isFull = false;
+	};
+
+	// Formats a message from a format string and a payload of arguments written by a LogArgsWriter.
+	// Writes at most "capacity" characters to given output, without a null terminator.
+	// Returns number of characters written.
+	size_t formatLogMessage(std::string_view format, const unsigned char* payload, size_t payloadSize, char* output, size_t capacity);
+
+} // namespace Logger
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "PekanLogger.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace Pekan
+{
+namespace Logger
+{
+
+	// A bounded lock-free queue with multiple producers and a single consumer (MPSC).
+	//
+	// Elements live in a ring of slots allocated once, in the constructor, so pushing and popping never allocate.
+	// Each slot has a sequence number telling if the slot is free to be written at a given position,
+	// or if it holds an element published at a given position and ready to be read (Dmitry Vyukov's bounded queue).
+	// Producers claim positions with a compare-and-swap, so they never wait for each other.
+	// If the queue is full, tryPush() fails instead of waiting, and it's up to the caller what to do.
+	//
+	// NOTE: tryPop() MUST NOT be called from more than one thread at a time.
+	template <typename T>
+	class MpscRingBuffer
+	{
+	public:
+
+		// Creates a ring buffer with a given capacity, which MUST be a power of two
+		explicit MpscRingBuffer(size_t capacity)
+			: m_slots(new Slot[capacity])
+			, m_mask(capacity - 1)
+		{
+			// Positions are mapped to slots with a mask, which works only with a power of two
+			PK_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0, "Capacity of an MpscRingBuffer must be a power of two.", "Pekan");
+			for (size_t i = 0; i < capacity; i++)
+			{
+				m_slots[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		MpscRingBuffer(const MpscRingBuffer&) = delete;
+		MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+
+		// Tries to push an element to the queue.
+		// A free slot is claimed and a given function is called with a reference to slot's element, to fill it in.
+		// Returns false, without calling the function, if the queue is full.
+		template <typename WriteFunction>
+		bool tryPush(WriteFunction&& write)
+		{
+			size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+			Slot* slot = nullptr;
+			while (true)
+			{
+				slot = &m_slots[position & m_mask];
+				const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+				const ptrdiff_t difference = ptrdiff_t(sequence) - ptrdiff_t(position);
+				if (difference == 0)
+				{
+					// Slot is free at this position, so try to claim it.
+					// On failure, position is updated to the current one and we try again.
+					if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					// Slot still holds an element from one lap ago, that is not yet popped, so the queue is full
+					return false;
+				}
+				else
+				{
+					// Another producer claimed this position meanwhile
+					position = m_enqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			write(slot->element);
+			// Publish the element to the consumer
+			slot->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		// Tries to pop an element from the queue.
+		// If there is a published element at the front of the queue,
+		// a given function is called with a (const) reference to it, and then its slot is freed.
+		// Returns false, without calling the function, if there is no such element.
+		template <typename ReadFunction>
+		bool tryPop(ReadFunction&& read)
+		{
+			Slot& slot = m_slots[m_dequeuePosition & m_mask];
+			const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+			if (sequence != m_dequeuePosition + 1)
+			{
+				return false;
+			}
+
+			read(static_cast<const T&>(slot.element));
+			// Free the slot for the producer that will write it one lap later
+			slot.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+			m_dequeuePosition++;
+			return true;
+		}
+
+		size_t getCapacity() const { return m_mask + 1; }
+
+	private: /* variables */
+
+		struct Slot
+		{
+			std::atomic<size_t> sequence;
+			T element;
+		};
+
+		// Slots of the ring
+		std::unique_ptr<Slot[]> m_slots;
+		// Capacity minus one, used to map a position to a slot index
+		const size_t m_mask;
+
+		// Position where the next element will be pushed.
+		// Kept on a separate cache line from the consumer's position, so producers and the consumer don't contend for it.
+		alignas(64) std::atomic<size_t> m_enqueuePosition = 0;
+
+		// Position where the next element will be popped. Only accessed by the consumer.
+		alignas(64) size_t m_dequeuePosition = 0;
+	};
+
+} // namespace Logger
+} // namespace Pekan
\ No newline at end of file
@@ -1,8 +1,33 @@
 #include "PekanLogger.h"
 
+#include "MpscRingBuffer.h"
+
 #include <iostream>
 #include <filesystem>
 #include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <csignal>
+#include <cerrno>
+#include <charconv>
+#include <exception>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #define SPACES_STR(N) std::string(N, ' ')
 
@@ -223,6 +248,720 @@ namespace Logger
 	static bool isFileEnabled = _isFileEnabled();
 #endif // PK_LOGGER_FILE_SUPPORT
 
+	// Time of logger's start, used as a reference for timestamps
+	static const std::chrono::steady_clock::time_point g_startTime = std::chrono::steady_clock::now();
+
+	// Returns current time in nanoseconds since logger's start
+	static long long getTimestamp()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_startTime).count();
+	}
+
+#if PK_LOGGER_ASYNC_SUPPORT
+
+	// Max length of a sender stored in an async record. Longer senders are truncated.
+	#define ASYNC_MAX_SENDER_LENGTH 31
+	// Max length of a message stored in an async record.
+	// Longer messages don't fit in a record, so they are written right away, after everything already in the queue.
+	#define ASYNC_MAX_MESSAGE_LENGTH 416
+	// Max time for which the background thread sleeps between writing batches of records
+	#define ASYNC_SINK_THREAD_INTERVAL std::chrono::milliseconds(20)
+	// Max number of records written in one batch, so that a flood of messages doesn't delay writing forever
+	#define ASYNC_MAX_BATCH_SIZE PK_LOGGER_ASYNC_QUEUE_CAPACITY
+
+	enum class LogSink : unsigned char
+	{
+		Console,
+		File
+	};
+
+	// A fixed-size record of a single log message, as pushed to the async queue
+	struct LogRecord
+	{
+		// Time when message was logged, in nanoseconds since logger's start
+		long long timestamp = 0;
+
+		LogLevel level = LogLevel::Error;
+		LogSink sink = LogSink::Console;
+
+		// Name and line of the source file where message was logged.
+		// Name is empty if source file is not included in message.
+		// NOTE: Name is not copied. It always comes from __FILE__ so it lives for the whole program.
+		std::string_view sourceFileName;
+		int sourceFileLine = 0;
+
+		char sender[ASYNC_MAX_SENDER_LENGTH + 1] = {};
+
+		// Format string of the message, if it was logged with a PK_LOGF_* macro.
+		// If not empty, message is not text, but a payload of arguments to be formatted with the format string.
+		// NOTE: Format string is not copied. It's checked at compile time, so it's always a string literal.
+		std::string_view format;
+
+		unsigned short messageLength = 0;
+		char message[ASYNC_MAX_MESSAGE_LENGTH] = {};
+	};
+
+	// Checks if async logging is enabled by default,
+	// either by an environment variable or by its default state.
+	static bool _isAsyncEnabledByDefault()
+	{
+		bool envVarExists = false;
+		const bool envVarValue = getEnvVarBool("PEKAN_LOGGER_ASYNC_ENABLED", envVarExists);
+		if (envVarExists)
+		{
+			return envVarValue;
+		}
+		return DEFAULT_PEKAN_LOGGER_ASYNC_ENABLED;
+	}
+	static std::atomic<bool> isAsyncEnabledFlag = _isAsyncEnabledByDefault();
+
+	// Returns the overflow policy set by an environment variable,
+	// or the default overflow policy if environment variable is not set or has an invalid value.
+	static AsyncOverflowPolicy _getDefaultAsyncOverflowPolicy()
+	{
+		std::string s = getEnvVar("PEKAN_LOGGER_ASYNC_OVERFLOW_POLICY");
+		if (s != "block" && s != "drop" && s != "count")
+		{
+			s = DEFAULT_PEKAN_LOGGER_ASYNC_OVERFLOW_POLICY;
+		}
+		if (s == "block")
+		{
+			return AsyncOverflowPolicy::Block;
+		}
+		if (s == "drop")
+		{
+			return AsyncOverflowPolicy::Drop;
+		}
+		return AsyncOverflowPolicy::CountDrops;
+	}
+	static std::atomic<AsyncOverflowPolicy> g_asyncOverflowPolicy = _getDefaultAsyncOverflowPolicy();
+
+	// Queue of records waiting to be written by the background thread
+	static_assert((PK_LOGGER_ASYNC_QUEUE_CAPACITY & (PK_LOGGER_ASYNC_QUEUE_CAPACITY - 1)) == 0, "PK_LOGGER_ASYNC_QUEUE_CAPACITY must be a power of two.");
+	static MpscRingBuffer<LogRecord> g_queue(PK_LOGGER_ASYNC_QUEUE_CAPACITY);
+
+	// Total number of dropped messages, and number of dropped messages not yet reported by a log message
+	static std::atomic<long long> g_droppedMessagesCount = 0;
+	static std::atomic<long long> g_unreportedDroppedMessagesCount = 0;
+
+	// Mutex taken while records are popped from the queue and written.
+	// Whoever holds it is the single consumer of the queue, be it the background thread or a thread calling flush().
+	static std::mutex g_drainMutex;
+	// Flag set while records are popped from the queue.
+	// A crash signal handler can't take the drain mutex, so it uses this flag instead to make sure it's the only consumer.
+	static std::atomic_flag g_isDraining = ATOMIC_FLAG_INIT;
+	// Text waiting to be written to the console and to the log file. Only accessed while holding the drain mutex.
+	static std::string g_consoleBuffer;
+#if PK_LOGGER_FILE_SUPPORT
+	static std::string g_fileBuffer;
+	// Log file, kept open while async logging is used, instead of being opened for each message
+	static std::ofstream g_logFile;
+#endif
+
+	// Mutex and condition variable used to wake up the background thread
+	static std::mutex g_wakeupMutex;
+	static std::condition_variable g_wakeupCondition;
+	// Flag indicating if the background thread has already been asked to wake up since it last woke up
+	static std::atomic<bool> g_isWakeupRequested = false;
+	// Flag indicating if the background thread should stop once it writes all records
+	static bool g_shouldStop = false;
+
+	static std::thread g_sinkThread;
+	static std::once_flag g_sinkThreadStartFlag;
+	// Flag indicating if the background thread is running and records can be pushed to the queue
+	static std::atomic<bool> g_isSinkThreadRunning = false;
+
+	// Crash handlers that were installed before ours, to be called after ours
+	static std::terminate_handler g_previousTerminateHandler = nullptr;
+	static const int CRASH_SIGNALS[] = { SIGSEGV, SIGABRT, SIGFPE, SIGILL };
+	static void (*g_previousSignalHandlers[std::size(CRASH_SIGNALS)])(int) = {};
+
+	// File descriptor of the log file, opened ahead of time so that a crash signal handler can write to it,
+	// or -1 if it's not open
+	static std::atomic<int> g_crashLogFileFd = -1;
+	// Buffers where a crash signal handler formats lines, preallocated because a signal handler can't allocate
+	static char g_crashFormattedMessage[PK_LOGGER_MAX_FORMATTED_MESSAGE_LENGTH];
+	static char g_crashLine[PK_LOGGER_MAX_FORMATTED_MESSAGE_LENGTH + 256];
+	static size_t g_crashLineLength = 0;
+
+	static const char* getLogLevelName(LogLevel level)
+	{
+		switch (level)
+		{
+			case LogLevel::Error:   return "ERROR";
+			case LogLevel::Warning: return "WARNING";
+			case LogLevel::Info:    return "INFO";
+			case LogLevel::Debug:   return "DEBUG";
+		}
+		return "";
+	}
+
+	// Appends a log line to a given buffer, in the same format as the one of synchronous logging.
+	// If timestamp is non-negative, line is prefixed with it, in seconds since logger's start.
+	static void appendLine
+	(
+		std::string& buffer,
+		long long timestamp,
+		LogLevel level,
+		std::string_view sourceFileName,
+		int sourceFileLine,
+		const char* sender,
+		std::string_view message
+	)
+	{
+		char prefix[128];
+		int prefixLength = 0;
+		if (timestamp >= 0)
+		{
+			prefixLength = std::snprintf(prefix, sizeof(prefix), "[%.6f] ", double(timestamp) / 1e9);
+		}
+		buffer.append(prefix, prefixLength);
+
+		buffer += "[";
+		buffer += getLogLevelName(level);
+		if (!sourceFileName.empty())
+		{
+			buffer += " in ";
+			buffer += sourceFileName;
+			buffer += ":";
+			buffer += std::to_string(sourceFileLine);
+		}
+		buffer += "](";
+		buffer += sender;
+		buffer += "): ";
+		buffer += message;
+		buffer += "\n";
+	}
+
+	// Appends a line for a given record to the buffer of record's sink
+	static void appendRecord(const LogRecord& record)
+	{
+		std::string_view message(record.message, record.messageLength);
+		char formattedMessage[PK_LOGGER_MAX_FORMATTED_MESSAGE_LENGTH];
+		if (!record.format.empty())
+		{
+			const unsigned char* payload = (const unsigned char*)(record.message);
+			const size_t length = formatLogMessage(record.format, payload, record.messageLength, formattedMessage, sizeof(formattedMessage));
+			message = std::string_view(formattedMessage, length);
+		}
+		if (record.sink == LogSink::Console)
+		{
+			appendLine(g_consoleBuffer, -1, record.level, record.sourceFileName, record.sourceFileLine, record.sender, message);
+		}
+#if PK_LOGGER_FILE_SUPPORT
+		else
+		{
+			// Records are written later than when they are logged, so lines in log file include the time of logging
+			appendLine(g_fileBuffer, record.timestamp, record.level, record.sourceFileName, record.sourceFileLine, record.sender, message);
+		}
+#endif
+	}
+
+	// Writes buffered text to the console and to the log file, and flushes them.
+	// Must be called while holding the drain mutex.
+	static void writeBuffers()
+	{
+		if (!g_consoleBuffer.empty())
+		{
+			std::cout.write(g_consoleBuffer.data(), std::streamsize(g_consoleBuffer.size()));
+			std::cout.flush();
+			g_consoleBuffer.clear();
+		}
+#if PK_LOGGER_FILE_SUPPORT
+		if (!g_fileBuffer.empty())
+		{
+			if (!g_logFile.is_open())
+			{
+				g_logFile.open(logFilePath, std::ios_base::app);
+			}
+			if (g_logFile.is_open())
+			{
+				g_logFile.write(g_fileBuffer.data(), std::streamsize(g_fileBuffer.size()));
+				g_logFile.flush();
+			}
+			else
+			{
+				std::cout << "[ERROR](Pekan): Failed to open log file " << logFilePath << ". These messages were not written to it:\n" << g_fileBuffer << std::flush;
+			}
+			g_fileBuffer.clear();
+		}
+#endif
+	}
+
+	// Pops records from the queue and writes them, until the queue is empty.
+	// Must be called while holding the drain mutex.
+	static void drainQueue()
+	{
+		// Only a crash signal handler can be draining while we hold the mutex, and then the program is going down anyway
+		if (g_isDraining.test_and_set(std::memory_order_acquire))
+		{
+			return;
+		}
+
+		bool isQueueEmpty = false;
+		while (!isQueueEmpty)
+		{
+			int batchSize = 0;
+			while (batchSize < ASYNC_MAX_BATCH_SIZE && g_queue.tryPop(appendRecord))
+			{
+				batchSize++;
+			}
+			isQueueEmpty = (batchSize < ASYNC_MAX_BATCH_SIZE);
+
+			const long long droppedMessagesCount = g_unreportedDroppedMessagesCount.exchange(0);
+			if (droppedMessagesCount > 0)
+			{
+				const std::string message = std::to_string(droppedMessagesCount) + " log messages were dropped because the async log queue was full.";
+				appendLine(g_consoleBuffer, -1, LogLevel::Warning, {}, 0, "Pekan", message);
+#if PK_LOGGER_FILE_SUPPORT
+				if (isFileEnabled)
+				{
+					appendLine(g_fileBuffer, getTimestamp(), LogLevel::Warning, {}, 0, "Pekan", message);
+				}
+#endif
+			}
+
+			writeBuffers();
+		}
+
+		g_isDraining.clear(std::memory_order_release);
+	}
+
+	// Tries to write all records in the queue when std::terminate() is called.
+	// Records are written only if the drain mutex can be taken within a short time,
+	// because the terminating thread itself might be holding it.
+	static void drainQueueOnTerminate()
+	{
+		for (int i = 0; i < 50; i++)
+		{
+			if (g_drainMutex.try_lock())
+			{
+				drainQueue();
+				g_drainMutex.unlock();
+				return;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+	}
+
+	// Writes given bytes to a file descriptor, using only async-signal-safe functions
+	static void writeToFd(int fd, const char* data, size_t size)
+	{
+		while (size > 0)
+		{
+#ifdef _WIN32
+			const int written = _write(fd, data, unsigned(size));
+#else
+			const ssize_t written = ::write(fd, data, size);
+#endif
+			if (written < 0 && errno == EINTR)
+			{
+				continue;
+			}
+			if (written <= 0)
+			{
+				return;
+			}
+			data += written;
+			size -= size_t(written);
+		}
+	}
+
+	// Appends given text to the crash line, truncating it if it doesn't fit
+	static void appendToCrashLine(std::string_view text)
+	{
+		const size_t length = std::min(text.size(), sizeof(g_crashLine) - g_crashLineLength);
+		std::memcpy(g_crashLine + g_crashLineLength, text.data(), length);
+		g_crashLineLength += length;
+	}
+
+	// Appends given number to the crash line, padded with zeros to a given minimum number of digits
+	static void appendToCrashLine(long long number, int minDigits = 1)
+	{
+		char digits[24];
+		const std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), number);
+		const int digitsCount = int(result.ptr - digits);
+		for (int i = digitsCount; i < minDigits; i++)
+		{
+			appendToCrashLine("0");
+		}
+		appendToCrashLine(std::string_view(digits, size_t(digitsCount)));
+	}
+
+	// Writes a line for a given record to the console or to the log file, in the same format as appendRecord().
+	// Only async-signal-safe functions are used, and nothing is allocated, so it can be called from a signal handler.
+	static void writeRecordOnCrashSignal(const LogRecord& record)
+	{
+		std::string_view message(record.message, record.messageLength);
+		if (!record.format.empty())
+		{
+			const unsigned char* payload = (const unsigned char*)(record.message);
+			const size_t length = formatLogMessage(record.format, payload, record.messageLength, g_crashFormattedMessage, sizeof(g_crashFormattedMessage));
+			message = std::string_view(g_crashFormattedMessage, length);
+		}
+
+		const bool isFileRecord = (record.sink == LogSink::File);
+		g_crashLineLength = 0;
+		if (isFileRecord)
+		{
+			appendToCrashLine("[");
+			appendToCrashLine(record.timestamp / 1000000000);
+			appendToCrashLine(".");
+			appendToCrashLine((record.timestamp % 1000000000) / 1000, 6);
+			appendToCrashLine("] ");
+		}
+		appendToCrashLine("[");
+		appendToCrashLine(getLogLevelName(record.level));
+		if (!record.sourceFileName.empty())
+		{
+			appendToCrashLine(" in ");
+			appendToCrashLine(record.sourceFileName);
+			appendToCrashLine(":");
+			appendToCrashLine(record.sourceFileLine);
+		}
+		appendToCrashLine("](");
+		appendToCrashLine(record.sender);
+		appendToCrashLine("): ");
+		appendToCrashLine(message);
+		appendToCrashLine("\n");
+
+		const int fd = isFileRecord ? g_crashLogFileFd.load() : 1;
+		if (fd >= 0)
+		{
+			writeToFd(fd, g_crashLine, g_crashLineLength);
+		}
+	}
+
+	// Writes all records in the queue when the program is crashing because of a signal.
+	// Only async-signal-safe functions are used, and nothing is allocated or locked.
+	// Records are written only if no one else is draining the queue, which might be the crashing thread itself.
+	static void drainQueueOnCrashSignal()
+	{
+		if (g_isDraining.test_and_set(std::memory_order_acquire))
+		{
+			return;
+		}
+		while (g_queue.tryPop(writeRecordOnCrashSignal)) {}
+
+		const long long droppedMessagesCount = g_unreportedDroppedMessagesCount.exchange(0);
+		if (droppedMessagesCount > 0)
+		{
+			g_crashLineLength = 0;
+			appendToCrashLine("[WARNING](Pekan): ");
+			appendToCrashLine(droppedMessagesCount);
+			appendToCrashLine(" log messages were dropped because the async log queue was full.\n");
+			writeToFd(1, g_crashLine, g_crashLineLength);
+		}
+		// Queue is left marked as being drained, since the program is going down
+	}
+
+	static void onTerminate()
+	{
+		drainQueueOnTerminate();
+		if (g_previousTerminateHandler != nullptr)
+		{
+			g_previousTerminateHandler();
+		}
+		std::abort();
+	}
+
+	static void onCrashSignal(int signal)
+	{
+		drainQueueOnCrashSignal();
+		// Restore previous handler and raise the signal again, so that the crash proceeds as if we were not here
+		for (size_t i = 0; i < std::size(CRASH_SIGNALS); i++)
+		{
+			if (CRASH_SIGNALS[i] == signal)
+			{
+				std::signal(signal, (g_previousSignalHandlers[i] != SIG_ERR) ? g_previousSignalHandlers[i] : SIG_DFL);
+			}
+		}
+		std::raise(signal);
+	}
+
+	// Main function of the background thread
+	static void runSinkThread()
+	{
+		while (true)
+		{
+			bool shouldStop = false;
+			{
+				std::unique_lock<std::mutex> lock(g_wakeupMutex);
+				g_wakeupCondition.wait_for(lock, ASYNC_SINK_THREAD_INTERVAL, []() { return g_isWakeupRequested.load() || g_shouldStop; });
+				shouldStop = g_shouldStop;
+			}
+			// Clear the flag before draining, so that records pushed while draining wake us up again
+			g_isWakeupRequested.store(false);
+
+			{
+				std::lock_guard<std::mutex> lock(g_drainMutex);
+				drainQueue();
+			}
+
+			if (shouldStop)
+			{
+				return;
+			}
+		}
+	}
+
+	// Starts the background thread and installs crash handlers that write records left in the queue
+	static void startSinkThread()
+	{
+		g_consoleBuffer.reserve(64 * 1024);
+#if PK_LOGGER_FILE_SUPPORT
+		g_fileBuffer.reserve(64 * 1024);
+#endif
+
+#if PK_LOGGER_FILE_SUPPORT
+		// Open the log file ahead of time, since a crash signal handler can only use a file descriptor that's already open
+		if (isFileEnabled)
+		{
+#ifdef _WIN32
+			g_crashLogFileFd.store(_open(logFilePath.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE));
+#else
+			g_crashLogFileFd.store(::open(logFilePath.c_str(), O_WRONLY | O_APPEND | O_CREAT, 0644));
+#endif
+		}
+#endif
+
+		g_previousTerminateHandler = std::set_terminate(onTerminate);
+		for (size_t i = 0; i < std::size(CRASH_SIGNALS); i++)
+		{
+			g_previousSignalHandlers[i] = std::signal(CRASH_SIGNALS[i], onCrashSignal);
+		}
+
+		g_sinkThread = std::thread(runSinkThread);
+		g_isSinkThreadRunning.store(true);
+	}
+
+	// Stops the background thread after it writes all records, and closes the log file
+	static void stopSinkThread()
+	{
+		if (!g_isSinkThreadRunning.exchange(false))
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(g_wakeupMutex);
+			g_shouldStop = true;
+		}
+		g_wakeupCondition.notify_all();
+		g_sinkThread.join();
+
+		// Write records pushed while the thread was stopping
+		std::lock_guard<std::mutex> lock(g_drainMutex);
+		drainQueue();
+#if PK_LOGGER_FILE_SUPPORT
+		g_logFile.close();
+#endif
+		const int crashLogFileFd = g_crashLogFileFd.exchange(-1);
+		if (crashLogFileFd >= 0)
+		{
+#ifdef _WIN32
+			_close(crashLogFileFd);
+#else
+			::close(crashLogFileFd);
+#endif
+		}
+	}
+
+	// Stops the background thread on program exit, before the queue and the buffers are destroyed
+	static struct AsyncLoggerShutdown
+	{
+		~AsyncLoggerShutdown() { stopSinkThread(); }
+	} g_asyncLoggerShutdown;
+
+	static void wakeUpSinkThread()
+	{
+		if (!g_isWakeupRequested.exchange(true))
+		{
+			g_wakeupCondition.notify_one();
+		}
+	}
+
+	// Checks if async logging is enabled and records can be pushed to the queue.
+	// Starts the background thread the first time it's called with async logging enabled.
+	static bool canLogAsync()
+	{
+		if (!isAsyncEnabledFlag.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+		std::call_once(g_sinkThreadStartFlag, startSinkThread);
+		// Background thread might have already been stopped on program exit
+		return g_isSinkThreadRunning.load(std::memory_order_acquire);
+	}
+
+	// Pushes a record to the async queue, handling a full queue according to the overflow policy.
+	// Record's data is either message's text, or a payload of arguments if a format string is given.
+	// Data MUST fit in a record.
+	static void pushRecord
+	(
+		long long timestamp,
+		LogLevel level,
+		LogSink sink,
+		const char* sender,
+		std::string_view sourceFileName,
+		int sourceFileLine,
+		std::string_view format,
+		const void* data,
+		size_t dataSize
+	)
+	{
+		const auto writeRecord = [&](LogRecord& record)
+		{
+			record.timestamp = timestamp;
+			record.level = level;
+			record.sink = sink;
+			record.sourceFileName = sourceFileName;
+			record.sourceFileLine = sourceFileLine;
+			const size_t senderLength = std::min(std::strlen(sender), size_t(ASYNC_MAX_SENDER_LENGTH));
+			std::memcpy(record.sender, sender, senderLength);
+			record.sender[senderLength] = '\0';
+			record.format = format;
+			record.messageLength = (unsigned short)(dataSize);
+			std::memcpy(record.message, data, dataSize);
+		};
+
+		while (!g_queue.tryPush(writeRecord))
+		{
+			switch (g_asyncOverflowPolicy.load(std::memory_order_relaxed))
+			{
+				case AsyncOverflowPolicy::Block:
+					// Make sure background thread is awake to make room, and try again
+					wakeUpSinkThread();
+					std::this_thread::yield();
+					break;
+				case AsyncOverflowPolicy::Drop:
+					g_droppedMessagesCount++;
+					return;
+				case AsyncOverflowPolicy::CountDrops:
+					g_droppedMessagesCount++;
+					g_unreportedDroppedMessagesCount++;
+					return;
+			}
+		}
+
+		wakeUpSinkThread();
+	}
+
+	// If async logging is enabled, pushes a message to the async queue and returns true.
+	// Otherwise returns false, and message should be written synchronously by the caller.
+	static bool logAsync(LogLevel level, LogSink sink, const char* msg, const char* sender, std::string_view sourceFileName = {}, int sourceFileLine = 0)
+	{
+		if (!canLogAsync())
+		{
+			return false;
+		}
+
+		const long long timestamp = getTimestamp();
+		const size_t messageLength = std::strlen(msg);
+
+		// If message doesn't fit in a record, write it right away, after everything already in the queue
+		if (messageLength > ASYNC_MAX_MESSAGE_LENGTH)
+		{
+			std::lock_guard<std::mutex> lock(g_drainMutex);
+			drainQueue();
+#if PK_LOGGER_FILE_SUPPORT
+			std::string& buffer = (sink == LogSink::Console) ? g_consoleBuffer : g_fileBuffer;
+#else
+			std::string& buffer = g_consoleBuffer;
+#endif
+			appendLine(buffer, (sink == LogSink::Console) ? -1 : timestamp, level, sourceFileName, sourceFileLine, sender, msg);
+			writeBuffers();
+			return true;
+		}
+
+		pushRecord(timestamp, level, sink, sender, sourceFileName, sourceFileLine, {}, msg, messageLength);
+		return true;
+	}
+
+	// If async logging is enabled and a given payload of arguments fits in a record,
+	// pushes a message with the payload to the async queue, once for each enabled sink, and returns true.
+	// Otherwise returns false, and message should be formatted and written synchronously by the caller.
+	static bool logPayloadAsync
+	(
+		LogLevel level,
+		const char* sender,
+		std::string_view sourceFileName,
+		int sourceFileLine,
+		std::string_view format,
+		const unsigned char* payload,
+		size_t payloadSize
+	)
+	{
+		if (payloadSize > ASYNC_MAX_MESSAGE_LENGTH || !canLogAsync())
+		{
+			return false;
+		}
+
+		const long long timestamp = getTimestamp();
+#if PK_LOGGER_CONSOLE_SUPPORT
+		if (isConsoleEnabled)
+		{
+			pushRecord(timestamp, level, LogSink::Console, sender, sourceFileName, sourceFileLine, format, payload, payloadSize);
+		}
+#endif
+#if PK_LOGGER_FILE_SUPPORT
+		if (isFileEnabled)
+		{
+			pushRecord(timestamp, level, LogSink::File, sender, sourceFileName, sourceFileLine, format, payload, payloadSize);
+		}
+#endif
+		return true;
+	}
+
+	void setAsyncEnabled(bool enabled)
+	{
+		isAsyncEnabledFlag.store(enabled);
+		if (!enabled)
+		{
+			flush();
+		}
+	}
+
+	bool isAsyncEnabled()
+	{
+		return isAsyncEnabledFlag.load();
+	}
+
+	void setAsyncOverflowPolicy(AsyncOverflowPolicy policy)
+	{
+		g_asyncOverflowPolicy.store(policy);
+	}
+
+	AsyncOverflowPolicy getAsyncOverflowPolicy()
+	{
+		return g_asyncOverflowPolicy.load();
+	}
+
+	long long getDroppedMessagesCount()
+	{
+		return g_droppedMessagesCount.load();
+	}
+
+	// Writes all records in the async queue, if background thread is running
+	static void flushAsyncQueue()
+	{
+		if (!g_isSinkThreadRunning.load())
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> lock(g_drainMutex);
+		drainQueue();
+	}
+
+	// Returns from current function if a message is logged asynchronously
+	#define RETURN_IF_LOGGED_ASYNC(...) if (logAsync(__VA_ARGS__)) { return; }
+
+#else
+
+	#define RETURN_IF_LOGGED_ASYNC(...)
+
+#endif // PK_LOGGER_ASYNC_SUPPORT
+
 #if PK_LOGGER_CONSOLE_SUPPORT
 
 #if PK_LOGGER_ERROR_SUPPORT
@@ -230,6 +969,7 @@ namespace Logger
 	{
 		if (isConsoleEnabled && isErrorEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Error, LogSink::Console, msg, sender);
 			std::cout << "[ERROR](" << sender << "): " << msg << std::endl;
 		}
 	}
@@ -238,6 +978,7 @@ namespace Logger
 	{
 		if (isConsoleEnabled && isErrorEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Error, LogSink::Console, msg, sender, sourceFileName, sourceFileLine);
 			std::cout << "[ERROR in " << sourceFileName << ":" << sourceFileLine << "](" << sender << "): " << msg << std::endl;
 		}
 	}
@@ -247,6 +988,7 @@ namespace Logger
 	{
 		if (isConsoleEnabled && isWarningEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Warning, LogSink::Console, msg, sender);
 			std::cout << "[WARNING](" << sender << "): " << msg << std::endl;
 		}
 	}
@@ -255,6 +997,7 @@ namespace Logger
 	{
 		if (isConsoleEnabled && isWarningEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Warning, LogSink::Console, msg, sender, sourceFileName, sourceFileLine);
 			std::cout << "[WARNING in " << sourceFileName << ":" << sourceFileLine << "](" << sender << "): " << msg << std::endl;
 		}
 	}
@@ -264,6 +1007,7 @@ namespace Logger
 	{
 		if (isConsoleEnabled && isInfoEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Info, LogSink::Console, msg, sender);
 			std::cout << "[INFO](" << sender << "): " << msg << std::endl;
 		}
 	}
@@ -272,6 +1016,7 @@ namespace Logger
 	{
 		if (isConsoleEnabled && isInfoEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Info, LogSink::Console, msg, sender, sourceFileName, sourceFileLine);
 			std::cout << "[INFO in " << sourceFileName << ":" << sourceFileLine << "](" << sender << "): " << msg << std::endl;
 		}
 	}
@@ -281,6 +1026,7 @@ namespace Logger
 	{
 		if (isConsoleEnabled && isDebugEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Debug, LogSink::Console, msg, sender);
 			std::cout << "[DEBUG](" << sender << "): " << msg << std::endl;
 		}
 	}
@@ -289,6 +1035,7 @@ namespace Logger
 	{
 		if (isConsoleEnabled && isDebugEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Debug, LogSink::Console, msg, sender, sourceFileName, sourceFileLine);
 			std::cout << "[DEBUG in " << sourceFileName << ":" << sourceFileLine << "](" << sender << "): " << msg << std::endl;
 		}
 	}
@@ -303,6 +1050,7 @@ namespace Logger
 	{
 		if (isFileEnabled && isErrorEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Error, LogSink::File, msg, sender);
 			std::ofstream logFile(logFilePath, std::ios_base::app);
 			if (!logFile.is_open())
 			{
@@ -324,6 +1072,7 @@ namespace Logger
 	{
 		if (isFileEnabled && isErrorEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Error, LogSink::File, msg, sender, sourceFileName, sourceFileLine);
 			std::ofstream logFile(logFilePath, std::ios_base::app);
 			if (!logFile.is_open())
 			{
@@ -346,6 +1095,7 @@ namespace Logger
 	{
 		if (isFileEnabled && isWarningEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Warning, LogSink::File, msg, sender);
 			std::ofstream logFile(logFilePath, std::ios_base::app);
 			if (!logFile.is_open())
 			{
@@ -367,6 +1117,7 @@ namespace Logger
 	{
 		if (isFileEnabled && isWarningEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Warning, LogSink::File, msg, sender, sourceFileName, sourceFileLine);
 			std::ofstream logFile(logFilePath, std::ios_base::app);
 			if (!logFile.is_open())
 			{
@@ -389,6 +1140,7 @@ namespace Logger
 	{
 		if (isFileEnabled && isInfoEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Info, LogSink::File, msg, sender);
 			std::ofstream logFile(logFilePath, std::ios_base::app);
 			if (!logFile.is_open())
 			{
@@ -410,6 +1162,7 @@ namespace Logger
 	{
 		if (isFileEnabled && isInfoEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Info, LogSink::File, msg, sender, sourceFileName, sourceFileLine);
 			std::ofstream logFile(logFilePath, std::ios_base::app);
 			if (!logFile.is_open())
 			{
@@ -432,6 +1185,7 @@ namespace Logger
 	{
 		if (isFileEnabled && isDebugEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Debug, LogSink::File, msg, sender);
 			std::ofstream logFile(logFilePath, std::ios_base::app);
 			if (!logFile.is_open())
 			{
@@ -451,6 +1205,8 @@ namespace Logger
 
 	void _logAssertToConsole(const char* msg, const char* sender, const char* condition)
 	{
+		// Write messages still waiting in the async queue, so that they appear before the assert
+		flush();
 		if (isConsoleEnabled)
 		{
 			std::cout << "(" << sender << "): " << "Assertion failed: " << condition << std::endl;
@@ -461,6 +1217,8 @@ namespace Logger
 
 	void _logAssertToConsole(const char* condition)
 	{
+		// Write messages still waiting in the async queue, so that they appear before the assert
+		flush();
 		if (isConsoleEnabled)
 		{
 			std::cout << "Assertion failed: " << condition << std::endl;
@@ -471,6 +1229,7 @@ namespace Logger
 	{
 		if (isFileEnabled && isDebugEnabled)
 		{
+			RETURN_IF_LOGGED_ASYNC(LogLevel::Debug, LogSink::File, msg, sender, sourceFileName, sourceFileLine);
 			std::ofstream logFile(logFilePath, std::ios_base::app);
 			if (!logFile.is_open())
 			{
@@ -491,7 +1250,302 @@ namespace Logger
 
 #endif // PK_LOGGER_FILE_SUPPORT
 
+	// Returns senders disabled by an environment variable, which is a comma-separated list of senders
+	static std::vector<std::string> _getDisabledSendersByDefault()
+	{
+		std::vector<std::string> senders;
+		const std::string s = getEnvVar("PEKAN_LOGGER_DISABLED_SENDERS");
+		size_t begin = 0;
+		while (begin < s.size())
+		{
+			size_t end = s.find(',', begin);
+			if (end == std::string::npos)
+			{
+				end = s.size();
+			}
+			if (end > begin)
+			{
+				senders.push_back(s.substr(begin, end - begin));
+			}
+			begin = end + 1;
+		}
+		return senders;
+	}
+
+	// Senders whose messages are disabled, and a mutex protecting them
+	static std::mutex g_disabledSendersMutex;
+	static std::vector<std::string> g_disabledSenders = _getDisabledSendersByDefault();
+
+	void setSenderEnabled(const char* sender, bool enabled)
+	{
+		{
+			std::lock_guard<std::mutex> lock(g_disabledSendersMutex);
+			const auto it = std::find(g_disabledSenders.begin(), g_disabledSenders.end(), sender);
+			if (enabled && it != g_disabledSenders.end())
+			{
+				g_disabledSenders.erase(it);
+			}
+			else if (!enabled && it == g_disabledSenders.end())
+			{
+				g_disabledSenders.push_back(sender);
+			}
+		}
+		// Make all call sites check logger's filters again
+		_filtersGeneration++;
+	}
+
+	bool isSenderEnabled(const char* sender)
+	{
+		std::lock_guard<std::mutex> lock(g_disabledSendersMutex);
+		return std::find(g_disabledSenders.begin(), g_disabledSenders.end(), sender) == g_disabledSenders.end();
+	}
+
+	// Checks if messages of a given level are enabled, and written to at least one sink
+	static bool isLevelEnabled(LogLevel level)
+	{
+		bool isAnySinkEnabled = false;
+#if PK_LOGGER_CONSOLE_SUPPORT
+		isAnySinkEnabled = isAnySinkEnabled || isConsoleEnabled;
+#endif
+#if PK_LOGGER_FILE_SUPPORT
+		isAnySinkEnabled = isAnySinkEnabled || isFileEnabled;
+#endif
+		if (!isAnySinkEnabled)
+		{
+			return false;
+		}
+
+		switch (level)
+		{
+#if PK_LOGGER_ERROR_SUPPORT
+			case LogLevel::Error:   return isErrorEnabled;
+#endif
+#if PK_LOGGER_WARNING_SUPPORT
+			case LogLevel::Warning: return isWarningEnabled;
+#endif
+#if PK_LOGGER_INFO_SUPPORT
+			case LogLevel::Info:    return isInfoEnabled;
+#endif
+#if PK_LOGGER_DEBUG_SUPPORT
+			case LogLevel::Debug:   return isDebugEnabled;
+#endif
+			default:                return false;
+		}
+	}
+
+	bool _LogCallSite::updateState()
+	{
+		const unsigned generation = _filtersGeneration.load();
+		const bool isEnabled = isLevelEnabled(level) && isSenderEnabled(sender);
+		m_state.store((generation << 1) | unsigned(isEnabled), std::memory_order_relaxed);
+		return isEnabled;
+	}
+
+	// Returns a given source file name if messages of a given level include source file, or an empty string otherwise
+	static std::string_view getIncludedSourceFileName(LogLevel level, std::string_view sourceFileName)
+	{
+		switch (level)
+		{
+			case LogLevel::Error:   return PK_LOGGER_ERRORS_INCLUDE_SOURCE_FILE ? sourceFileName : std::string_view();
+			case LogLevel::Warning: return PK_LOGGER_WARNINGS_INCLUDE_SOURCE_FILE ? sourceFileName : std::string_view();
+			case LogLevel::Info:    return PK_LOGGER_INFOS_INCLUDE_SOURCE_FILE ? sourceFileName : std::string_view();
+			case LogLevel::Debug:   return PK_LOGGER_DEBUGS_INCLUDE_SOURCE_FILE ? sourceFileName : std::string_view();
+		}
+		return std::string_view();
+	}
+
+	// Calls a given log function, with source file if source file name is not empty, or without it otherwise
+	#define LOG_WITH(FUNCTION) if (sourceFileName.empty()) { FUNCTION(msg, sender); } else { FUNCTION(msg, sender, sourceFileName, sourceFileLine); }
+
+	// Writes a message of a given level to all enabled sinks
+	static void logMessage(LogLevel level, const char* msg, const char* sender, std::string_view sourceFileName, int sourceFileLine)
+	{
+		switch (level)
+		{
+			case LogLevel::Error:
+#if PK_LOGGER_ERROR_SUPPORT && PK_LOGGER_CONSOLE_SUPPORT
+				LOG_WITH(_logErrorToConsole);
+#endif
+#if PK_LOGGER_ERROR_SUPPORT && PK_LOGGER_FILE_SUPPORT
+				LOG_WITH(_logErrorToFile);
+#endif
+				break;
+			case LogLevel::Warning:
+#if PK_LOGGER_WARNING_SUPPORT && PK_LOGGER_CONSOLE_SUPPORT
+				LOG_WITH(_logWarningToConsole);
+#endif
+#if PK_LOGGER_WARNING_SUPPORT && PK_LOGGER_FILE_SUPPORT
+				LOG_WITH(_logWarningToFile);
+#endif
+				break;
+			case LogLevel::Info:
+#if PK_LOGGER_INFO_SUPPORT && PK_LOGGER_CONSOLE_SUPPORT
+				LOG_WITH(_logInfoToConsole);
+#endif
+#if PK_LOGGER_INFO_SUPPORT && PK_LOGGER_FILE_SUPPORT
+				LOG_WITH(_logInfoToFile);
+#endif
+				break;
+			case LogLevel::Debug:
+#if PK_LOGGER_DEBUG_SUPPORT && PK_LOGGER_CONSOLE_SUPPORT
+				LOG_WITH(_logDebugToConsole);
+#endif
+#if PK_LOGGER_DEBUG_SUPPORT && PK_LOGGER_FILE_SUPPORT
+				LOG_WITH(_logDebugToFile);
+#endif
+				break;
+		}
+	}
+
+	void _logPayload(const _LogCallSite& callSite, std::string_view format, const unsigned char* payload, size_t payloadSize)
+	{
+		const std::string_view sourceFileName = getIncludedSourceFileName(callSite.level, callSite.sourceFileName);
+#if PK_LOGGER_ASYNC_SUPPORT
+		if (logPayloadAsync(callSite.level, callSite.sender, sourceFileName, callSite.sourceFileLine, format, payload, payloadSize))
+		{
+			return;
+		}
+#endif
+
+		// Format into a buffer reused by all messages logged from the same thread
+		static thread_local char t_message[PK_LOGGER_MAX_FORMATTED_MESSAGE_LENGTH + 1];
+		const size_t length = formatLogMessage(format, payload, payloadSize, t_message, PK_LOGGER_MAX_FORMATTED_MESSAGE_LENGTH);
+		t_message[length] = '\0';
+
+		logMessage(callSite.level, t_message, callSite.sender, sourceFileName, callSite.sourceFileLine);
+	}
+
+#if PK_LOGGER_RATE_LIMIT_SUPPORT
+
+	// Interval of rate limiting, in nanoseconds
+	#define RATE_LIMIT_INTERVAL_NS (long long)(PK_LOGGER_RATE_LIMIT_INTERVAL * 1e9)
+
+	// Checks if rate limiting is enabled by default,
+	// either by an environment variable or by its default state.
+	static bool _isRateLimitEnabledByDefault()
+	{
+		bool envVarExists = false;
+		const bool envVarValue = getEnvVarBool("PEKAN_LOGGER_RATE_LIMIT_ENABLED", envVarExists);
+		if (envVarExists)
+		{
+			return envVarValue;
+		}
+		return DEFAULT_PEKAN_LOGGER_RATE_LIMIT_ENABLED;
+	}
+	static std::atomic<bool> isRateLimitEnabledFlag = _isRateLimitEnabledByDefault();
+
+	// Head of a list of all call sites that have ever suppressed a message
+	static std::atomic<_LogCallSite*> g_suppressingCallSites = nullptr;
+
+	void setRateLimitEnabled(bool enabled)
+	{
+		isRateLimitEnabledFlag.store(enabled);
+	}
+
+	bool isRateLimitEnabled()
+	{
+		return isRateLimitEnabledFlag.load();
+	}
+
+	bool _LogCallSite::passesRateLimit()
+	{
+		if (level == LogLevel::Error || !isRateLimitEnabledFlag.load(std::memory_order_relaxed))
+		{
+			return true;
+		}
+
+		const long long now = getTimestamp();
+		const long long lastMessageTime = m_lastMessageTime.exchange(now, std::memory_order_relaxed);
+		if (now - lastMessageTime >= RATE_LIMIT_INTERVAL_NS)
+		{
+			// Call site has been quiet for a while, so it may log a whole burst again
+			m_burstCount.store(0, std::memory_order_relaxed);
+		}
+
+		// Log messages of current burst
+		if (m_burstCount.load(std::memory_order_relaxed) < PK_LOGGER_RATE_LIMIT_BURST)
+		{
+			const int burstCount = m_burstCount.fetch_add(1, std::memory_order_relaxed) + 1;
+			if (burstCount <= PK_LOGGER_RATE_LIMIT_BURST)
+			{
+				if (burstCount == PK_LOGGER_RATE_LIMIT_BURST)
+				{
+					m_lastSummaryTime.store(now, std::memory_order_relaxed);
+				}
+				// Report messages suppressed by a previous burst, before the call site went quiet
+				reportSuppressedMessages();
+				return true;
+			}
+		}
+
+		// Once burst is used up, log one message every interval, with a summary of suppressed messages
+		long long lastSummaryTime = m_lastSummaryTime.load(std::memory_order_relaxed);
+		if (now - lastSummaryTime >= RATE_LIMIT_INTERVAL_NS && m_lastSummaryTime.compare_exchange_strong(lastSummaryTime, now, std::memory_order_relaxed))
+		{
+			reportSuppressedMessages();
+			return true;
+		}
+
+		// Suppress message, adding call site to the list of call sites with suppressed messages if not already there
+		m_suppressedCount.fetch_add(1, std::memory_order_relaxed);
+		if (!m_isSuppressing.exchange(true))
+		{
+			m_nextSuppressingCallSite = g_suppressingCallSites.load();
+			while (!g_suppressingCallSites.compare_exchange_weak(m_nextSuppressingCallSite, this));
+		}
+		return false;
+	}
+
+	void _LogCallSite::reportSuppressedMessages()
+	{
+		const long long suppressedCount = m_suppressedCount.exchange(0, std::memory_order_relaxed);
+		if (suppressedCount <= 0)
+		{
+			return;
+		}
+
+		char summary[128];
+		std::snprintf(summary, sizeof(summary), "%lld messages from here were suppressed by rate limiting.", suppressedCount);
+		// Always include source file, since summary refers to it
+		logMessage(level, summary, sender, sourceFileName, sourceFileLine);
+	}
+
+	void _LogCallSite::reportAllSuppressedMessages()
+	{
+		for (_LogCallSite* callSite = g_suppressingCallSites.load(); callSite != nullptr; callSite = callSite->m_nextSuppressingCallSite)
+		{
+			callSite->reportSuppressedMessages();
+		}
+	}
+
+#endif // PK_LOGGER_RATE_LIMIT_SUPPORT
+
+	void flush()
+	{
+#if PK_LOGGER_RATE_LIMIT_SUPPORT
+		_LogCallSite::reportAllSuppressedMessages();
+#endif
+#if PK_LOGGER_ASYNC_SUPPORT
+		flushAsyncQueue();
+#endif
+	}
+
 #endif // PK_LOGGER_SUPPORT
 
+#if !PK_LOGGER_SUPPORT
+	void flush()
+	{
+	}
+
+	void setSenderEnabled(const char* sender, bool enabled)
+	{
+	}
+
+	bool isSenderEnabled(const char* sender)
+	{
+		return true;
+	}
+#endif
+
 } // namespace Logger
 } // namespace Pekan
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "PekanEngine.h"
+#include "LogFormat.h"
+#include <atomic>
 #include <sstream>
 #include <string_view>
 
@@ -48,6 +50,36 @@
 #define PK_LOGGER_CONSOLE_SUPPORT 1
 #define PK_LOGGER_FILE_SUPPORT 1
 
+// Toggle this macro on/off to enable/disable support for asynchronous logging.
+//
+// In async mode, log messages are not written on the calling thread.
+// Instead they are pushed as fixed-size records to a lock-free queue,
+// and a background thread writes them to the console and/or the log file, in batches.
+// This way a burst of log messages doesn't stall the calling thread, e.g. the render loop.
+//
+// NOTE: For user-level control we support environment variables
+//           PEKAN_LOGGER_ASYNC_ENABLED
+//           PEKAN_LOGGER_ASYNC_OVERFLOW_POLICY
+//       where the overflow policy is one of "block", "drop" or "count" (see AsyncOverflowPolicy).
+#define PK_LOGGER_ASYNC_SUPPORT 1
+
+// Toggle this macro on/off to enable/disable support for rate limiting of log messages.
+//
+// Rate limiting protects frame time and disk from messages logged in hot loops, like once per entity per frame.
+// Messages are limited per call site, meaning per use of a logging macro in code.
+// A call site may log PK_LOGGER_RATE_LIMIT_BURST messages in a row.
+// After that, its messages are suppressed, except for one message every PK_LOGGER_RATE_LIMIT_INTERVAL seconds,
+// which is preceded by a summary of how many messages were suppressed meanwhile.
+// Once a call site hasn't logged anything for PK_LOGGER_RATE_LIMIT_INTERVAL seconds, it may log a whole burst again.
+// Errors are never rate limited, since each one of them may be the one explaining a failure.
+// Only warnings, info and debug messages are.
+//
+// NOTE: For user-level control we support environment variable
+//           PEKAN_LOGGER_RATE_LIMIT_ENABLED
+#define PK_LOGGER_RATE_LIMIT_SUPPORT 1
+#define PK_LOGGER_RATE_LIMIT_BURST 10
+#define PK_LOGGER_RATE_LIMIT_INTERVAL 5.0
+
 // Default values for the environment variables
 //     PEKAN_LOGGER_ERROR_ENABLED
 //     PEKAN_LOGGER_WARNING_ENABLED
@@ -73,6 +105,24 @@
 #define DEFAULT_PEKAN_LOGGER_CONSOLE_ENABLED 1
 #define DEFAULT_PEKAN_LOGGER_FILE_ENABLED 0
 
+// Default values for the environment variables
+//     PEKAN_LOGGER_ASYNC_ENABLED
+//     PEKAN_LOGGER_ASYNC_OVERFLOW_POLICY
+#define DEFAULT_PEKAN_LOGGER_ASYNC_ENABLED 0
+#define DEFAULT_PEKAN_LOGGER_ASYNC_OVERFLOW_POLICY "count"
+
+// Default value for the environment variable
+//     PEKAN_LOGGER_RATE_LIMIT_ENABLED
+#define DEFAULT_PEKAN_LOGGER_RATE_LIMIT_ENABLED 1
+
+// Number of records in the queue used for async logging. MUST be a power of two.
+#define PK_LOGGER_ASYNC_QUEUE_CAPACITY 4096
+
+// Max size, in bytes, of arguments captured by a PK_LOGF_* macro, and max length of a message formatted from them.
+// Longer strings are truncated.
+#define PK_LOGGER_MAX_PAYLOAD_SIZE 1024
+#define PK_LOGGER_MAX_FORMATTED_MESSAGE_LENGTH 2048
+
 // Toggle these macros on/off to include/exclude source file's name from different types of log messages.
 #define PK_LOGGER_ERRORS_INCLUDE_SOURCE_FILE 1
 #define PK_LOGGER_WARNINGS_INCLUDE_SOURCE_FILE 1
@@ -151,6 +201,58 @@ namespace Logger
 	void _logAssertToConsole(const char* msg, const char* sender, const char* condition);
 	void _logAssertToConsole(const char* condition);
 
+#if PK_LOGGER_ASYNC_SUPPORT
+	// Policies for what happens to a message logged in async mode while the queue is full
+	enum class AsyncOverflowPolicy
+	{
+		// Wait until the background thread makes room in the queue.
+		// No messages are lost, but the calling thread may stall.
+		Block,
+		// Discard the message
+		Drop,
+		// Discard the message, but count it, and log how many messages were dropped once there is room again
+		CountDrops
+	};
+
+	// Enables/disables async logging.
+	// When disabling, all messages already in the queue are written before returning.
+	void setAsyncEnabled(bool enabled);
+	bool isAsyncEnabled();
+
+	void setAsyncOverflowPolicy(AsyncOverflowPolicy policy);
+	AsyncOverflowPolicy getAsyncOverflowPolicy();
+
+	// Returns total number of messages dropped so far because the queue was full
+	long long getDroppedMessagesCount();
+#endif
+
+#if PK_LOGGER_RATE_LIMIT_SUPPORT
+	// Enables/disables rate limiting of log messages
+	void setRateLimitEnabled(bool enabled);
+	bool isRateLimitEnabled();
+#endif
+
+	// Logs summaries of messages suppressed by rate limiting that are not yet reported,
+	// then writes all messages that are waiting in the async queue, and flushes the console and the log file.
+	// When this function returns, all messages logged by the calling thread before calling it are written.
+	void flush();
+
+	enum class LogLevel : unsigned char
+	{
+		Error,
+		Warning,
+		Info,
+		Debug
+	};
+
+	// Enables/disables all log messages from a given sender.
+	// Senders can also be disabled with the environment variable
+	//     PEKAN_LOGGER_DISABLED_SENDERS
+	// set to a comma-separated list of senders, e.g.
+	//     set PEKAN_LOGGER_DISABLED_SENDERS=OpenGL,Demo
+	void setSenderEnabled(const char* sender, bool enabled);
+	bool isSenderEnabled(const char* sender);
+
 #if PK_LOGGER_SUPPORT
 	#if PK_LOGGER_USE_FILEPATH_FOR_SOURCE_FILE
 		// Filepath of current source file where logger is used
@@ -168,31 +270,139 @@ namespace Logger
 	#endif
 #endif
 
+#if PK_LOGGER_SUPPORT
+	// Generation of logger's filters, meaning enabled levels, sinks and senders.
+	// Incremented each time they change, so that call sites know to check again if they are enabled.
+	inline std::atomic<unsigned> _filtersGeneration = 1;
+
+	// A call site of a log message, meaning a single use of a logging macro.
+	// Caches if messages logged from it pass logger's filters,
+	// so that the check done before formatting a message is a single load and compare.
+	//
+	// NOTE: Sender is expected to be the same each time a message is logged from a call site, like a string literal.
+	class _LogCallSite
+	{
+	public:
+
+		constexpr _LogCallSite(LogLevel level, const char* sender, std::string_view sourceFileName, int sourceFileLine)
+			: level(level)
+			, sender(sender)
+			, sourceFileName(sourceFileName)
+			, sourceFileLine(sourceFileLine)
+		{}
+
+		// Checks if messages logged from this call site pass logger's filters
+		bool isEnabled()
+		{
+			const unsigned state = m_state.load(std::memory_order_relaxed);
+			if ((state >> 1) == _filtersGeneration.load(std::memory_order_relaxed))
+			{
+				return state & 1;
+			}
+			return updateState();
+		}
+
+#if PK_LOGGER_RATE_LIMIT_SUPPORT
+		// Checks if a message may be logged from this call site now, according to rate limiting.
+		// If it may and messages were suppressed before it, logs a summary of them first.
+		// Always true for errors, which are not rate limited.
+		bool passesRateLimit();
+#else
+		bool passesRateLimit() { return true; }
+#endif
+
+		const LogLevel level;
+		const char* const sender;
+		const std::string_view sourceFileName;
+		const int sourceFileLine;
+
+	private: /* functions */
+
+		// Checks logger's filters, caches the result for their current generation, and returns it
+		bool updateState();
+
+#if PK_LOGGER_RATE_LIMIT_SUPPORT
+		// Logs a summary of messages suppressed so far by rate limiting, if there are any
+		void reportSuppressedMessages();
+
+		// Logs summaries of suppressed messages of all call sites that have suppressed messages
+		static void reportAllSuppressedMessages();
+
+		friend void flush();
+#endif
+
+	private: /* variables */
+
+		// Generation of filters for which the result is cached, shifted left by one bit, with the result in the lowest bit
+		std::atomic<unsigned> m_state = 0;
+
+#if PK_LOGGER_RATE_LIMIT_SUPPORT
+		// Time of the last message logged or suppressed, and time of the last message logged after the burst was used up,
+		// in nanoseconds since logger's start
+		std::atomic<long long> m_lastMessageTime = 0;
+		std::atomic<long long> m_lastSummaryTime = 0;
+		// Number of messages logged in current burst
+		std::atomic<int> m_burstCount = 0;
+		// Number of messages suppressed since the last summary
+		std::atomic<long long> m_suppressedCount = 0;
+
+		// Next call site in a list of all call sites that have ever suppressed a message,
+		// and a flag indicating if this call site is already in that list
+		_LogCallSite* m_nextSuppressingCallSite = nullptr;
+		std::atomic<bool> m_isSuppressing = false;
+#endif
+	};
+
+	// Logs a message from a given call site, with a payload of arguments to be formatted with a given format string.
+	// In async mode the payload is pushed to the queue as is, and formatted on logger's background thread.
+	// Otherwise it's formatted into a thread-local buffer and written right away.
+	void _logPayload(const _LogCallSite& callSite, std::string_view format, const unsigned char* payload, size_t payloadSize);
+
+	// Logs a message from a given call site, formatted from a format string and arguments.
+	// Arguments are captured into a payload on the stack, so logging doesn't allocate.
+	template <typename... Args>
+	void _logFormatted(const _LogCallSite& callSite, LogFormatString<std::type_identity_t<Args>...> format, const Args&... args)
+	{
+		unsigned char payload[PK_LOGGER_MAX_PAYLOAD_SIZE];
+		LogArgsWriter writer(payload, sizeof(payload));
+		(writer.write(args), ...);
+		_logPayload(callSite, format.str, payload, writer.getSize());
+	}
+#endif
+
 } // namespace Logger
 } // namespace Pekan
 
 #define PK_STR(MSG) std::ostringstream mOss; mOss << MSG; const std::string m = mOss.str();
 
+#if PK_LOGGER_SUPPORT
+	// Declares a call site of a log message with a given level and sender
+	#define _PK_LOG_CALL_SITE(LEVEL, SND) static Pekan::Logger::_LogCallSite _pkLogCallSite(Pekan::Logger::LogLevel::LEVEL, SND, PK_SOURCE_FILE, __LINE__)
+	// Logs a message with a given level and sender, formatted from a format string and arguments,
+	// if it passes logger's filters and rate limiting. Otherwise arguments are not even evaluated.
+	#define _PK_LOGF(LEVEL, FMT, SND, ...) do { _PK_LOG_CALL_SITE(LEVEL, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { Pekan::Logger::_logFormatted(_pkLogCallSite, FMT __VA_OPT__(,) __VA_ARGS__); } } while (false)
+#endif
+
 // PK_LOG_ERROR logs an error message to the console and/or syslog file
 #if PK_LOGGER_ERROR_SUPPORT
 	#if PK_LOGGER_CONSOLE_SUPPORT && PK_LOGGER_FILE_SUPPORT
 		#if PK_LOGGER_ERRORS_INCLUDE_SOURCE_FILE
 			// MSG = message, SND = sender
-			#define PK_LOG_ERROR(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logErrorToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); Pekan::Logger::_logErrorToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_ERROR(MSG, SND) { _PK_LOG_CALL_SITE(Error, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logErrorToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); Pekan::Logger::_logErrorToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_ERROR(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logErrorToConsole(m.c_str(), SND); Pekan::Logger::_logErrorToFile(m.c_str(), SND); }
+			#define PK_LOG_ERROR(MSG, SND) { _PK_LOG_CALL_SITE(Error, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logErrorToConsole(m.c_str(), SND); Pekan::Logger::_logErrorToFile(m.c_str(), SND); } }
 		#endif
 	#elif PK_LOGGER_CONSOLE_SUPPORT
 		#if PK_LOGGER_ERRORS_INCLUDE_SOURCE_FILE
-			#define PK_LOG_ERROR(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logErrorToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_ERROR(MSG, SND) { _PK_LOG_CALL_SITE(Error, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logErrorToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_ERROR(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logErrorToConsole(m.c_str(), SND); }
+			#define PK_LOG_ERROR(MSG, SND) { _PK_LOG_CALL_SITE(Error, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logErrorToConsole(m.c_str(), SND); } }
 		#endif
 	#elif PK_LOGGER_FILE_SUPPORT
 		#if PK_LOGGER_ERRORS_INCLUDE_SOURCE_FILE
-			#define PK_LOG_ERROR(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logErrorToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_ERROR(MSG, SND) { _PK_LOG_CALL_SITE(Error, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logErrorToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_ERROR(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logErrorToFile(m.c_str(), SND); }
+			#define PK_LOG_ERROR(MSG, SND) { _PK_LOG_CALL_SITE(Error, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logErrorToFile(m.c_str(), SND); } }
 		#endif
 	#else
 		#define PK_LOG_ERROR(MSG, SND)
@@ -206,21 +416,21 @@ namespace Logger
 	#if PK_LOGGER_CONSOLE_SUPPORT && PK_LOGGER_FILE_SUPPORT
 		#if PK_LOGGER_WARNINGS_INCLUDE_SOURCE_FILE
 			// MSG = message, SND = sender
-			#define PK_LOG_WARNING(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logWarningToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); Pekan::Logger::_logWarningToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_WARNING(MSG, SND) { _PK_LOG_CALL_SITE(Warning, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logWarningToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); Pekan::Logger::_logWarningToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_WARNING(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logWarningToConsole(m.c_str(), SND); Pekan::Logger::_logWarningToFile(m.c_str(), SND); }
+			#define PK_LOG_WARNING(MSG, SND) { _PK_LOG_CALL_SITE(Warning, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logWarningToConsole(m.c_str(), SND); Pekan::Logger::_logWarningToFile(m.c_str(), SND); } }
 		#endif
 	#elif PK_LOGGER_CONSOLE_SUPPORT
 		#if PK_LOGGER_WARNINGS_INCLUDE_SOURCE_FILE
-			#define PK_LOG_WARNING(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logWarningToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_WARNING(MSG, SND) { _PK_LOG_CALL_SITE(Warning, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logWarningToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_WARNING(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logWarningToConsole(m.c_str(), SND); }
+			#define PK_LOG_WARNING(MSG, SND) { _PK_LOG_CALL_SITE(Warning, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logWarningToConsole(m.c_str(), SND); } }
 		#endif
 	#elif PK_LOGGER_FILE_SUPPORT
 		#if PK_LOGGER_WARNINGS_INCLUDE_SOURCE_FILE
-			#define PK_LOG_WARNING(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logWarningToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_WARNING(MSG, SND) { _PK_LOG_CALL_SITE(Warning, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logWarningToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_WARNING(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logWarningToFile(m.c_str(), SND); }
+			#define PK_LOG_WARNING(MSG, SND) { _PK_LOG_CALL_SITE(Warning, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logWarningToFile(m.c_str(), SND); } }
 		#endif
 	#else
 		#define PK_LOG_WARNING(MSG, SND)
@@ -234,21 +444,21 @@ namespace Logger
 	#if PK_LOGGER_CONSOLE_SUPPORT && PK_LOGGER_FILE_SUPPORT
 		#if PK_LOGGER_INFOS_INCLUDE_SOURCE_FILE
 			// MSG = message, SND = sender
-			#define PK_LOG_INFO(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logInfoToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); Pekan::Logger::_logInfoToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_INFO(MSG, SND) { _PK_LOG_CALL_SITE(Info, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logInfoToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); Pekan::Logger::_logInfoToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_INFO(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logInfoToConsole(m.c_str(), SND); Pekan::Logger::_logInfoToFile(m.c_str(), SND); }
+			#define PK_LOG_INFO(MSG, SND) { _PK_LOG_CALL_SITE(Info, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logInfoToConsole(m.c_str(), SND); Pekan::Logger::_logInfoToFile(m.c_str(), SND); } }
 		#endif
 	#elif PK_LOGGER_CONSOLE_SUPPORT
 		#if PK_LOGGER_INFOS_INCLUDE_SOURCE_FILE
-			#define PK_LOG_INFO(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logInfoToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_INFO(MSG, SND) { _PK_LOG_CALL_SITE(Info, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logInfoToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_INFO(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logInfoToConsole(m.c_str(), SND); }
+			#define PK_LOG_INFO(MSG, SND) { _PK_LOG_CALL_SITE(Info, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logInfoToConsole(m.c_str(), SND); } }
 		#endif
 	#elif PK_LOGGER_FILE_SUPPORT
 		#if PK_LOGGER_INFOS_INCLUDE_SOURCE_FILE
-			#define PK_LOG_INFO(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logInfoToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_INFO(MSG, SND) { _PK_LOG_CALL_SITE(Info, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logInfoToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_INFO(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logInfoToFile(m.c_str(), SND); }
+			#define PK_LOG_INFO(MSG, SND) { _PK_LOG_CALL_SITE(Info, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logInfoToFile(m.c_str(), SND); } }
 		#endif
 	#else
 		#define PK_LOG_INFO(MSG, SND)
@@ -262,21 +472,21 @@ namespace Logger
 	#if PK_LOGGER_CONSOLE_SUPPORT && PK_LOGGER_FILE_SUPPORT
 		#if PK_LOGGER_DEBUGS_INCLUDE_SOURCE_FILE
 			// MSG = message, SND = sender
-			#define PK_LOG_DEBUG(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logDebugToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); Pekan::Logger::_logDebugToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_DEBUG(MSG, SND) { _PK_LOG_CALL_SITE(Debug, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logDebugToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); Pekan::Logger::_logDebugToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_DEBUG(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logDebugToConsole(m.c_str(), SND); Pekan::Logger::_logDebugToFile(m.c_str(), SND); }
+			#define PK_LOG_DEBUG(MSG, SND) { _PK_LOG_CALL_SITE(Debug, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logDebugToConsole(m.c_str(), SND); Pekan::Logger::_logDebugToFile(m.c_str(), SND); } }
 		#endif
 	#elif PK_LOGGER_CONSOLE_SUPPORT
 		#if PK_LOGGER_DEBUGS_INCLUDE_SOURCE_FILE
-			#define PK_LOG_DEBUG(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logDebugToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_DEBUG(MSG, SND) { _PK_LOG_CALL_SITE(Debug, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logDebugToConsole(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_DEBUG(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logDebugToConsole(m.c_str(), SND); }
+			#define PK_LOG_DEBUG(MSG, SND) { _PK_LOG_CALL_SITE(Debug, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logDebugToConsole(m.c_str(), SND); } }
 		#endif
 	#elif PK_LOGGER_FILE_SUPPORT
 		#if PK_LOGGER_DEBUGS_INCLUDE_SOURCE_FILE
-			#define PK_LOG_DEBUG(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logDebugToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); }
+			#define PK_LOG_DEBUG(MSG, SND) { _PK_LOG_CALL_SITE(Debug, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logDebugToFile(m.c_str(), SND, PK_SOURCE_FILE, __LINE__); } }
 		#else
-			#define PK_LOG_DEBUG(MSG, SND) { PK_STR(MSG); Pekan::Logger::_logDebugToFile(m.c_str(), SND); }
+			#define PK_LOG_DEBUG(MSG, SND) { _PK_LOG_CALL_SITE(Debug, SND); if (_pkLogCallSite.isEnabled() && _pkLogCallSite.passesRateLimit()) { PK_STR(MSG); Pekan::Logger::_logDebugToFile(m.c_str(), SND); } }
 		#endif
 	#else
 		#define PK_LOG_DEBUG(MSG, SND)
@@ -285,6 +495,32 @@ namespace Logger
 	#define PK_LOG_DEBUG(MSG, SND)
 #endif
 
+// PK_LOGF_ERROR, PK_LOGF_WARNING, PK_LOGF_INFO and PK_LOGF_DEBUG log a message formatted from a format string and arguments,
+// checked at compile time, with std::format-style placeholders (see _countLogFormatPlaceholders()), e.g.
+//     PK_LOGF_WARNING("Texture {} has size {}x{} which is not a power of two.", "Pekan", filepath, width, height);
+// Unlike PK_LOG_* macros they don't allocate, and in async mode formatting is done on logger's background thread.
+// FMT = format string, SND = sender, followed by arguments, so that the order is the same as in PK_LOG_* macros
+#if PK_LOGGER_ERROR_SUPPORT && (PK_LOGGER_CONSOLE_SUPPORT || PK_LOGGER_FILE_SUPPORT)
+	#define PK_LOGF_ERROR(FMT, SND, ...) _PK_LOGF(Error, FMT, SND __VA_OPT__(,) __VA_ARGS__)
+#else
+	#define PK_LOGF_ERROR(FMT, SND, ...)
+#endif
+#if PK_LOGGER_WARNING_SUPPORT && (PK_LOGGER_CONSOLE_SUPPORT || PK_LOGGER_FILE_SUPPORT)
+	#define PK_LOGF_WARNING(FMT, SND, ...) _PK_LOGF(Warning, FMT, SND __VA_OPT__(,) __VA_ARGS__)
+#else
+	#define PK_LOGF_WARNING(FMT, SND, ...)
+#endif
+#if PK_LOGGER_INFO_SUPPORT && (PK_LOGGER_CONSOLE_SUPPORT || PK_LOGGER_FILE_SUPPORT)
+	#define PK_LOGF_INFO(FMT, SND, ...) _PK_LOGF(Info, FMT, SND __VA_OPT__(,) __VA_ARGS__)
+#else
+	#define PK_LOGF_INFO(FMT, SND, ...)
+#endif
+#if PK_LOGGER_DEBUG_SUPPORT && (PK_LOGGER_CONSOLE_SUPPORT || PK_LOGGER_FILE_SUPPORT)
+	#define PK_LOGF_DEBUG(FMT, SND, ...) _PK_LOGF(Debug, FMT, SND __VA_OPT__(,) __VA_ARGS__)
+#else
+	#define PK_LOGF_DEBUG(FMT, SND, ...)
+#endif
+
 //////////////////
 ///// ASSERT /////
 //////////////////
@@ -2,6 +2,7 @@
 #include "PekanLogger.h"
 #include "PekanEngine.h"
 #include "Time/FpsLimiter.h"
+#include "Profiler.h"
 
 #include "Events/KeyEvents.h"
 #include "Events/MouseEvents.h"
@@ -26,6 +27,14 @@ namespace Pekan
 			return false;
 		}
 
+		// Start recording input from where the mouse currently is, so that the first mouse-moved event doesn't have a huge delta
+		if (PekanEngine::s_window.getGlfwWindow() != nullptr)
+		{
+			m_lastMousePosition = PekanEngine::s_window.getMousePosition();
+			m_nextInputSnapshot.setMousePosition(m_lastMousePosition);
+			PekanEngine::s_inputSnapshot = m_nextInputSnapshot;
+		}
+
 		// Initialize derived application
 		if (!_init())
 		{
@@ -55,6 +64,14 @@ namespace Pekan
 		PK_ASSERT(isValid(), "Trying to run a PekanApplication that is not yet initialized.", "Pekan");
 
 		const ApplicationProperties properties = getProperties();
+		if (properties.offscreenProperties.enabled)
+		{
+			runOffscreen(properties.offscreenProperties);
+			return;
+		}
+
+		m_coalesceMouseEvents = properties.coalesceMouseEvents;
+
 		const double fps = properties.fps;
 		const bool useVSync = properties.useVSync;
 
@@ -69,39 +86,89 @@ namespace Pekan
 		Window& window = PekanEngine::s_window;
 		while (!window.shouldBeClosed())
 		{
-			// Process all pending events, calling the handler function of each one.
-			glfwPollEvents();
-			// Process all remaining events - those that were not handled by their handler function,
-			// and instead were added to the event queue.
-			handleEventQueue();
-
-			// Handle window resizing
-			const glm::ivec2 frameBufferSize = window.getFrameBufferSize();
-			glViewport(0, 0, frameBufferSize.x, frameBufferSize.y);
+#if PEKAN_ENABLE_PROFILER
+			Profiler::beginFrame();
+#endif
+			{
+				PK_PROFILE_SCOPE("Events");
+				pruneEventListeners();
+				// Process all pending events, calling the handler function of each one.
+				glfwPollEvents();
+				// Dispatch the last coalesced mouse event, if mouse events are coalesced
+				flushCoalescedMouseEvent();
+				// Publish input recorded while processing events
+				updateInputSnapshot();
+				// Process all remaining events - those that were not handled by their handler function,
+				// and instead were added to the event queue.
+				handleEventQueue();
+			}
 
 			// Get delta time - time passed since last frame
 			const double deltaTime = m_deltaTimer.getDeltaTime();
 
-			callOnFrameBeginCallbacks();
-
-			// Update all registered recurring callbacks
-			updateRecurringCallbacks(float(deltaTime));
-
-			// Update and render all layers of the layer stack
-			m_layerStack.updateAll(deltaTime);
-			m_layerStack.renderAll();
+			runFrame(deltaTime);
 
-			callOnFrameEndCallbacks();
-
-			// Swap buffers to show the new frame on screen.
-			// If we are using VSync this function will automatically wait
-			// the correct amount of time before the next screen update.
-			window.swapBuffers();
+			{
+				PK_PROFILE_SCOPE("SwapBuffers");
+				// Swap buffers to show the new frame on screen.
+				// If we are using VSync this function will automatically wait
+				// the correct amount of time before the next screen update.
+				window.swapBuffers();
+			}
 			// If there is a target FPS, then we need to manually wait some amount of time
 			if (fps > 0.0)
 			{
+				PK_PROFILE_SCOPE("FpsLimiter");
 				fpsLimiter.wait();
 			}
+#if PEKAN_ENABLE_PROFILER
+			Profiler::endFrame();
+#endif
+		}
+	}
+
+	void PekanApplication::runFrame(double deltaTime)
+	{
+		PK_PROFILE_FUNCTION();
+
+		// Handle window resizing. A headless window has no OpenGL context, so it has no viewport either.
+		if (!PekanEngine::s_window.isHeadless())
+		{
+			const glm::ivec2 frameBufferSize = PekanEngine::s_window.getFrameBufferSize();
+			glViewport(0, 0, frameBufferSize.x, frameBufferSize.y);
+		}
+
+		callOnFrameBeginCallbacks();
+
+		// Update all registered recurring callbacks
+		updateRecurringCallbacks(float(deltaTime));
+
+		// Update and render all layers of the layer stack
+		m_layerStack.updateAll(deltaTime);
+		m_layerStack.renderAll();
+
+		callOnFrameEndCallbacks();
+
+		m_frameIndex++;
+	}
+
+	void PekanApplication::runOffscreen(const OffscreenProperties& offscreenProperties)
+	{
+		// There is nothing on screen, so there is no need for VSync, an FPS limiter, swapping buffers or polling window events.
+		// Frames are rendered one after another as fast as possible, each one with the same fixed delta time.
+		// A headless window has no GLFW window at all, so frames are driven only by this loop.
+		Window& window = PekanEngine::s_window;
+		for (int i = 0; i < offscreenProperties.framesCount && !window.shouldBeClosed(); i++)
+		{
+#if PEKAN_ENABLE_PROFILER
+			Profiler::beginFrame();
+#endif
+			pruneEventListeners();
+			handleEventQueue();
+			runFrame(offscreenProperties.deltaTime);
+#if PEKAN_ENABLE_PROFILER
+			Profiler::endFrame();
+#endif
 		}
 	}
 
@@ -127,26 +194,48 @@ namespace Pekan
 			PK_LOG_ERROR("Trying to register a NULL event listener in PekanApplication. It will be ignored.", "Pekan");
 			return;
 		}
-		m_eventListeners.push_back(listener);
+		RegisteredEventListener registeredListener;
+		registeredListener.weakPtr = listener;
+		registeredListener.ptr = listener.get();
+		m_eventListeners.push_back(std::move(registeredListener));
 	}
 
 	void PekanApplication::unregisterEventListener(const std::shared_ptr<EventListener>& listener)
 	{
 		PK_ASSERT(m_initState != InitState::NotInitialized, "Trying to unregister an event listener from a PekanApplication that is not yet initialized.", "Pekan");
 
+		// Listeners are not removed right away, because we might be in the middle of dispatching an event to them.
+		// Instead they are marked as unregistered, and later pruned.
+		for (RegisteredEventListener& otherListener : m_eventListeners)
+		{
+			if (otherListener.ptr == listener.get())
+			{
+				otherListener.ptr = nullptr;
+				m_needsPruneEventListeners = true;
+			}
+		}
+	}
+
+	void PekanApplication::pruneEventListeners()
+	{
+		if (!m_needsPruneEventListeners)
+		{
+			return;
+		}
+
 		m_eventListeners.erase
 		(
 			std::remove_if
 			(
 				m_eventListeners.begin(), m_eventListeners.end(),
-				[&listener](const std::weak_ptr<EventListener>& otherListener)
+				[](const RegisteredEventListener& listener)
 				{
-					// Check if both pointers point to the same object
-					return !otherListener.owner_before(listener) && !listener.owner_before(otherListener);
+					return listener.ptr == nullptr || listener.weakPtr.expired();
 				}
 			),
 			m_eventListeners.end()
 		);
+		m_needsPruneEventListeners = false;
 	}
 
 	void PekanApplication::registerRecurringCallback
@@ -183,24 +272,11 @@ namespace Pekan
 		PekanEngine::s_window.setShouldBeClosed(true);
 	}
 
-	// Sends an event of a given type to layers of the layer stack,
-	// one by one, until a layer successfully handles the event.
-	// If no layer successfully handles the event, then the event is sent to all registered event listeners.
-	// If event is still not handled, it will be pushed to the event queue.
-	//
-	// WARNING: Leaves the original event object in an invalid state. Make sure you DON'T use it after calling this function.
 	template<typename EventT>
-	static void _dispatchEvent
-	(
-		std::unique_ptr<EventT>& event,
-		LayerStack& layerStack,
-		std::vector<std::weak_ptr<EventListener>> eventListeners,
-		EventQueue& eventQueue,
-		bool (EventListener::*onEventFunc)(const EventT&)
-	)
+	void PekanApplication::dispatchEvent(const EventT& event, bool (EventListener::*onEventFunc)(const EventT&))
 	{
 		// Dispatch event to the layer stack
-		if (layerStack.dispatchEvent(event, onEventFunc))
+		if (m_layerStack.dispatchEvent(event, onEventFunc))
 		{
 			return;
 		}
@@ -208,28 +284,29 @@ namespace Pekan
 		bool handled = false;
 
 		// If event was not handled by the layer stack,
-		// call the onEventFunc on all registered event listeners
-		for (auto it = eventListeners.begin(); it != eventListeners.end(); )
+		// call the onEventFunc on all registered event listeners.
+		// Listeners registered while dispatching are not called for this event.
+		// The list is indexed on each iteration, because registering a listener might reallocate it.
+		const size_t listenersCount = m_eventListeners.size();
+		for (size_t i = 0; i < listenersCount; i++)
 		{
-			if (auto listener = it->lock())
+			EventListener* listener = m_eventListeners[i].ptr;
+			if (listener == nullptr || m_eventListeners[i].weakPtr.expired())
 			{
-				if ((listener.get()->*onEventFunc)(*event.get()))
-				{
-					handled = true;
-				}
-				++it;
+				// Listener is unregistered or expired, so it will be pruned later
+				m_needsPruneEventListeners = true;
+				continue;
 			}
-			else
+			if ((listener->*onEventFunc)(event))
 			{
-				// Listener is expired, so remove it
-				it = eventListeners.erase(it);
+				handled = true;
 			}
 		}
 
 		// If event is still not handled, add it to event queue
 		if (!handled)
 		{
-			eventQueue.push(std::move(event));
+			m_eventQueue.push(event);
 		}
 	}
 
@@ -237,24 +314,29 @@ namespace Pekan
 	{
 		PK_ASSERT(isValid(), "Trying to handle key event in a PekanApplication that is not yet initialized.", "Pekan");
 
+		flushCoalescedMouseEvent();
+
 		switch (action)
 		{
 			case GLFW_PRESS:
 			{
-				std::unique_ptr<KeyPressedEvent> event = std::make_unique<KeyPressedEvent>(key, false);
-				_dispatchEvent(event, m_layerStack, m_eventListeners, m_eventQueue, &EventListener::onKeyPressed);
+				m_nextInputSnapshot.recordKeyPressed(key, false);
+				const KeyPressedEvent event(key, false);
+				dispatchEvent(event, &EventListener::onKeyPressed);
 				break;
 			}
 			case GLFW_RELEASE:
 			{
-				std::unique_ptr<KeyReleasedEvent> event = std::make_unique<KeyReleasedEvent>(key);
-				_dispatchEvent(event, m_layerStack, m_eventListeners, m_eventQueue, &EventListener::onKeyReleased);
+				m_nextInputSnapshot.recordKeyReleased(key);
+				const KeyReleasedEvent event(key);
+				dispatchEvent(event, &EventListener::onKeyReleased);
 				break;
 			}
 			case GLFW_REPEAT:
 			{
-				std::unique_ptr<KeyPressedEvent> event = std::make_unique<KeyPressedEvent>(key, true);
-				_dispatchEvent(event, m_layerStack, m_eventListeners, m_eventQueue, &EventListener::onKeyPressed);
+				m_nextInputSnapshot.recordKeyPressed(key, true);
+				const KeyPressedEvent event(key, true);
+				dispatchEvent(event, &EventListener::onKeyPressed);
 				break;
 			}
 		}
@@ -264,34 +346,66 @@ namespace Pekan
 	{
 		PK_ASSERT(isValid(), "Trying to handle a mouse-moved event in a PekanApplication that is not yet initialized.", "Pekan");
 
-		std::unique_ptr<MouseMovedEvent> event = std::make_unique<MouseMovedEvent>(float(xPos), float(yPos));
-		_dispatchEvent(event, m_layerStack, m_eventListeners, m_eventQueue, &EventListener::onMouseMoved);
+		const glm::vec2 mousePosition = { float(xPos), float(yPos) };
+		m_nextInputSnapshot.recordMouseMoved(mousePosition);
+
+		if (m_coalesceMouseEvents)
+		{
+			if (m_coalescedEventType != CoalescedEventType::MouseMoved)
+			{
+				flushCoalescedMouseEvent();
+				m_coalescedEventType = CoalescedEventType::MouseMoved;
+			}
+			// Only the last position matters, delta is calculated from last dispatched position when dispatching
+			m_coalescedMousePosition = mousePosition;
+			return;
+		}
+
+		dispatchMouseMovedEvent(mousePosition);
 	}
 
 	void PekanApplication::handleMouseScrolledEvent(double xOffset, double yOffset)
 	{
 		PK_ASSERT(isValid(), "Trying to handle a mouse-scrolled event in a PekanApplication that is not yet initialized.", "Pekan");
 
-		std::unique_ptr<MouseScrolledEvent> event = std::make_unique<MouseScrolledEvent>(float(xOffset), float(yOffset));
-		_dispatchEvent(event, m_layerStack, m_eventListeners, m_eventQueue, &EventListener::onMouseScrolled);
+		const glm::vec2 offset = { float(xOffset), float(yOffset) };
+		m_nextInputSnapshot.recordMouseScrolled(offset);
+
+		if (m_coalesceMouseEvents)
+		{
+			if (m_coalescedEventType != CoalescedEventType::MouseScrolled)
+			{
+				flushCoalescedMouseEvent();
+				m_coalescedEventType = CoalescedEventType::MouseScrolled;
+			}
+			m_coalescedScrollOffset += offset;
+			return;
+		}
+
+		const MouseScrolledEvent event(offset.x, offset.y);
+		dispatchEvent(event, &EventListener::onMouseScrolled);
 	}
 
 	void PekanApplication::handleMouseButtonEvent(MouseButton button, int action, int mods)
 	{
 		PK_ASSERT(isValid(), "Trying to handle a mouse button event in a PekanApplication that is not yet initialized.", "Pekan");
 
+		flushCoalescedMouseEvent();
+
 		switch (action)
 		{
 			case GLFW_PRESS:
 			{
-				std::unique_ptr<MouseButtonPressedEvent> event = std::make_unique<MouseButtonPressedEvent>(button);
-				_dispatchEvent(event, m_layerStack, m_eventListeners, m_eventQueue, &EventListener::onMouseButtonPressed);
+				m_nextInputSnapshot.recordMouseButtonPressed(button);
+				const MouseButtonPressedEvent event(button);
+				dispatchEvent(event, &EventListener::onMouseButtonPressed);
 				break;
 			}
 			case GLFW_RELEASE:
 			{
-				std::unique_ptr<MouseButtonReleasedEvent> event = std::make_unique<MouseButtonReleasedEvent>(button);
-				_dispatchEvent(event, m_layerStack, m_eventListeners, m_eventQueue, &EventListener::onMouseButtonReleased);
+				m_nextInputSnapshot.recordMouseButtonReleased(button);
+				const MouseButtonReleasedEvent event(button);
+				dispatchEvent(event, &EventListener::onMouseButtonReleased);
 				break;
 			}
 		}
@@ -301,16 +415,59 @@ namespace Pekan
 	{
 		PK_ASSERT(isValid(), "Trying to handle a window-resized event in a PekanApplication that is not yet initialized.", "Pekan");
 
-		std::unique_ptr<WindowResizedEvent> event = std::make_unique<WindowResizedEvent>(width, height);
-		_dispatchEvent(event, m_layerStack, m_eventListeners, m_eventQueue, &EventListener::onWindowResized);
+		flushCoalescedMouseEvent();
+
+		const WindowResizedEvent event(width, height);
+		dispatchEvent(event, &EventListener::onWindowResized);
 	}
 
 	void PekanApplication::handleWindowClosedEvent()
 	{
 		PK_ASSERT(isValid(), "Trying to handle a window-closed event in a PekanApplication that is not yet initialized.", "Pekan");
 
-		std::unique_ptr<WindowClosedEvent> event = std::make_unique<WindowClosedEvent>();
-		_dispatchEvent(event, m_layerStack, m_eventListeners, m_eventQueue, &EventListener::onWindowClosed);
+		flushCoalescedMouseEvent();
+
+		const WindowClosedEvent event;
+		dispatchEvent(event, &EventListener::onWindowClosed);
+	}
+
+	void PekanApplication::flushCoalescedMouseEvent()
+	{
+		switch (m_coalescedEventType)
+		{
+			case CoalescedEventType::None:
+			{
+				return;
+			}
+			case CoalescedEventType::MouseMoved:
+			{
+				dispatchMouseMovedEvent(m_coalescedMousePosition);
+				break;
+			}
+			case CoalescedEventType::MouseScrolled:
+			{
+				const MouseScrolledEvent event(m_coalescedScrollOffset.x, m_coalescedScrollOffset.y);
+				m_coalescedScrollOffset = glm::vec2(0.0f);
+				dispatchEvent(event, &EventListener::onMouseScrolled);
+				break;
+			}
+		}
+		m_coalescedEventType = CoalescedEventType::None;
+	}
+
+	void PekanApplication::dispatchMouseMovedEvent(glm::vec2 mousePosition)
+	{
+		const glm::vec2 delta = mousePosition - m_lastMousePosition;
+		m_lastMousePosition = mousePosition;
+
+		const MouseMovedEvent event(mousePosition.x, mousePosition.y, delta.x, delta.y);
+		dispatchEvent(event, &EventListener::onMouseMoved);
+	}
+
+	void PekanApplication::updateInputSnapshot()
+	{
+		PekanEngine::s_inputSnapshot = m_nextInputSnapshot;
+		m_nextInputSnapshot.beginFrame();
 	}
 
 	void PekanApplication::updateRecurringCallbacks(float deltaTime)
@@ -1,10 +1,11 @@
 #pragma once
 
-#include "Events/Event.h"
+#include "Events/EventQueue.h"
 #include "Events/EventListener.h"
 #include "LayerStack.h"
 #include "Time/DeltaTimer.h"
 #include "Window.h"
+#include "InputSnapshot.h"
 #include "Time/RecurringCallback.h"
 
 #include <string>
@@ -18,12 +19,96 @@ namespace Pekan
 	typedef std::function<void()> OnFrameBeginCallback;
 	typedef std::function<void()> OnFrameEndCallback;
 
+	// Properties of an application running offscreen.
+	//
+	// An offscreen application doesn't show anything on screen. It renders a fixed number of frames,
+	// as fast as possible, into a frame buffer, and writes rendered frames to image files.
+	// Window's width and height are used as the size of rendered frames.
+	struct OffscreenProperties
+	{
+		// Flag indicating if application should run offscreen
+		bool enabled = false;
+
+		// Number of frames to render before application stops running
+		int framesCount = 1;
+
+		// Fixed time between frames, in seconds, used instead of the real time passed,
+		// so that rendered frames don't depend on how fast they are rendered.
+		double deltaTime = 1.0 / 60.0;
+
+		// Path of the image file where the last rendered frame will be written, in TGA format
+		std::string outputFilepath = "frame.tga";
+
+		// Flag indicating if all rendered frames should be written, instead of only the last one.
+		// Each frame is written to outputFilepath, with frame's index appended to file's name.
+		bool writeAllFrames = false;
+
+		// Flag indicating if application should run without a window and without an OpenGL context, not initializing GLFW at all.
+		// Can be used only with a headless graphics backend (Null or Recording), since there is nothing to render with.
+		// Nothing is rendered, so no frames are written either.
+		bool headless = false;
+	};
+
+	// Properties of dynamic resolution scaling.
+	//
+	// With dynamic resolution scaling, scenes are rendered at a fraction of window's resolution, and then upscaled to the window.
+	// The fraction, called resolution scale, is lowered when frames take longer than a target frame time,
+	// and raised again when they are comfortably faster, trading sharpness for a stable frame rate.
+	// GUI is always rendered at window's native resolution.
+	struct DynamicResolutionProperties
+	{
+		// Flag indicating if dynamic resolution scaling should be used
+		bool enabled = false;
+
+		// Bounds of resolution scale, as a fraction of window's resolution, in range (0, 1]
+		float minResolutionScale = 0.5f;
+		float maxResolutionScale = 1.0f;
+
+		// Target frame time, in seconds
+		double targetFrameTime = 1.0 / 60.0;
+
+		// Resolution scale is lowered when smoothed frame time gets above this fraction of target frame time,
+		// and raised when it gets below this fraction of target frame time.
+		// The gap between them prevents resolution from oscillating when frame time is close to the target.
+		double scaleDownThreshold = 0.95;
+		double scaleUpThreshold = 0.75;
+
+		// Amount by which resolution scale changes at once
+		float resolutionScaleStep = 0.05f;
+
+		// Minimum number of frames between two changes of resolution scale,
+		// giving smoothed frame time a chance to reflect the previous change
+		int framesBetweenChanges = 15;
+
+		// Weight of the latest frame time in smoothed frame time, in range (0, 1].
+		// Lower values react slower but ignore single spikes.
+		double smoothingFactor = 0.1;
+	};
+
+	// Method used for anti-aliasing rendered frames
+	enum class AntiAliasingMode
+	{
+		// Multisample Anti-Aliasing (MSAA).
+		// Frames are rendered with multiple samples per pixel, see ApplicationProperties::numberOfSamples.
+		Multisample,
+		// Fast Approximate Anti-Aliasing (FXAA).
+		// Frames are rendered with a single sample per pixel, and then smoothed by a single fullscreen post-processing pass
+		// that blurs pixels along detected edges. Much cheaper than MSAA, especially at high resolutions, but a bit blurrier.
+		Fxaa
+	};
+
 	// Properties of a Pekan application, grouped together in a struct
 	struct ApplicationProperties
 	{
 		// Properties of the window where application will run
 		WindowProperties windowProperties;
 
+		// Properties used if application runs offscreen
+		OffscreenProperties offscreenProperties;
+
+		// Properties of dynamic resolution scaling
+		DynamicResolutionProperties dynamicResolutionProperties;
+
 		// Target FPS (frames per second)
 		double fps = 0.0;
 
@@ -32,8 +117,18 @@ namespace Pekan
 		// (Has effect only if there is no target FPS set)
 		bool useVSync = true;
 
-		// Number of samples per pixel to be used for multisampling
+		// Method used for anti-aliasing rendered frames
+		AntiAliasingMode antiAliasingMode = AntiAliasingMode::Multisample;
+
+		// Number of samples per pixel to be used for multisampling.
+		// (Has effect only if anti-aliasing mode is Multisample)
 		int numberOfSamples = 1;
+
+		// Flag indicating if consecutive mouse-moved events, and consecutive mouse-scrolled events,
+		// should be coalesced into a single event, instead of each one being dispatched separately.
+		// Coalesced events are dispatched when an event of another type comes, or at the end of polling events.
+		// Useful with high polling rate mice, that can generate many mouse-moved events per frame.
+		bool coalesceMouseEvents = false;
 	};
 
 	// A base class for all Pekan applications
@@ -52,6 +147,9 @@ namespace Pekan
 
 		void run();
 
+		// Returns the index of the frame currently being rendered, counting from 0
+		long long getFrameIndex() const { return m_frameIndex; }
+
 		void exit();
 
 		virtual std::string getName() const { return ""; }
@@ -83,6 +181,12 @@ namespace Pekan
 
 	private: /* functions */
 
+		// Runs a single frame of the application, updating and rendering all layers with a given delta time
+		void runFrame(double deltaTime);
+
+		// Runs the application offscreen, rendering a fixed number of frames as fast as possible
+		void runOffscreen(const OffscreenProperties& offscreenProperties);
+
 		// Can be implemented by derived classes with specific initialization logic.
 		// @return true on success
 		virtual bool _init() { return true; }
@@ -103,12 +207,34 @@ namespace Pekan
 		void handleWindowResizedEvent(int width, int height);
 		void handleWindowClosedEvent();
 
+		// Sends an event of a given type to layers of the layer stack,
+		// one by one, until a layer successfully handles the event.
+		// If no layer successfully handles the event, then the event is sent to all registered event listeners.
+		// If event is still not handled, it will be pushed to the event queue.
+		template<typename EventT>
+		void dispatchEvent(const EventT& event, bool (EventListener::*onEventFunc)(const EventT&));
+
 		// Handles the event queue.
 		// The event queue is a queue of left-over events that were not handled by any layer or any event listener.
 		// NOTE: Make sure to pop all events from the queue, otherwise they will keep piling up.
 		//
 		// Can be implemented by derived classes with specific logic of handling the events from the event queue.
-		virtual void handleEventQueue() { while (!m_eventQueue.empty()) { m_eventQueue.pop(); } }
+		virtual void handleEventQueue() { m_eventQueue.clear(); }
+
+		// Dispatches the mouse-moved or mouse-scrolled event that is being coalesced, if there is one
+		void flushCoalescedMouseEvent();
+
+		// Dispatches a mouse-moved event with a given mouse position,
+		// calculating how much the mouse has moved since the previous mouse-moved event
+		void dispatchMouseMovedEvent(glm::vec2 mousePosition);
+
+		// Publishes input recorded while polling events as PekanEngine's input snapshot,
+		// and starts recording next frame's input
+		void updateInputSnapshot();
+
+		// Removes expired and unregistered event listeners from the list of event listeners.
+		// Called once per frame, outside of event dispatching, so that dispatching never has to modify the list.
+		void pruneEventListeners();
 
 		// Updates all registered recurring callbacks
 		// with current frame's delta time.
@@ -127,8 +253,35 @@ namespace Pekan
 		// Event queue where events are pushed if they are not handled by any layer or any event listener.
 		EventQueue m_eventQueue;
 
+		// An event listener registered in the application
+		struct RegisteredEventListener
+		{
+			std::weak_ptr<EventListener> weakPtr;
+			// Raw pointer to the listener, so that dispatching an event doesn't need to lock the weak pointer.
+			// Null if the listener has been unregistered and is waiting to be pruned.
+			EventListener* ptr = nullptr;
+		};
+
 		// List of registered event listeners that need to be notified when an event occurs
-		std::vector<std::weak_ptr<EventListener>> m_eventListeners;
+		std::vector<RegisteredEventListener> m_eventListeners;
+		// Flag indicating if some listeners in the list are expired or unregistered, and need to be pruned
+		bool m_needsPruneEventListeners = false;
+
+		// Input snapshot where input events are recorded while polling events.
+		// Published to PekanEngine once per frame, after polling events.
+		InputSnapshot m_nextInputSnapshot;
+
+		// Type of event currently being coalesced
+		enum class CoalescedEventType { None, MouseMoved, MouseScrolled };
+
+		// Flag indicating if mouse events should be coalesced (see ApplicationProperties::coalesceMouseEvents)
+		bool m_coalesceMouseEvents = false;
+		// Type, mouse position and accumulated scroll offset of the event currently being coalesced
+		CoalescedEventType m_coalescedEventType = CoalescedEventType::None;
+		glm::vec2 m_coalescedMousePosition = glm::vec2(0.0f);
+		glm::vec2 m_coalescedScrollOffset = glm::vec2(0.0f);
+		// Mouse position of the last dispatched mouse-moved event
+		glm::vec2 m_lastMousePosition = glm::vec2(0.0f);
 
 		// Delta timer used to keep track of time passed since last frame was rendered
 		DeltaTimer m_deltaTimer;
@@ -141,6 +294,9 @@ namespace Pekan
 		// List of registered callbacks to be called at the end of each frame
 		std::vector<OnFrameEndCallback> m_onFrameEndCallbacks;
 
+		// Index of the frame currently being rendered
+		long long m_frameIndex = 0;
+
 		// An enum containing possible states of initialization of a PekanApplication
 		enum class InitState
 		{
@@ -3,6 +3,7 @@
 #include "PekanLogger.h"
 #include "PekanApplication.h"
 #include "SubsystemManager.h"
+#include "Profiler.h"
 
 #include <iostream>
 
@@ -36,6 +37,9 @@ namespace Pekan
 			return false;
 		}
 
+		// Initialize profiler before subsystems, so that their initialization can be captured too
+		Profiler::init();
+
 		// Initialize all subsystems
 		SubsystemManager::initAll();
 
@@ -53,11 +57,17 @@ namespace Pekan
 			return;
 		}
 
+		// Export a profiler trace if one is requested, while subsystems are still alive
+		Profiler::exit();
+
 		// Exit all subsystems
 		SubsystemManager::exitAll();
 
 		s_window.destroy();
 
+		// Write log messages still waiting to be written by async logging
+		Logger::flush();
+
 		s_isInitialized = false;
 	}
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Window.h"
+#include "InputSnapshot.h"
 
 #include <glm/glm.hpp>
 
@@ -51,6 +52,11 @@ namespace Pekan
 		// INPUT POLLING //
 		///////////////////
 
+		// Returns (a const reference to) the snapshot of input captured for the current frame, right after polling events.
+		// Querying it only reads memory, and it also tells which keys and buttons were pressed/released during the frame.
+		// Prefer it in update code. Functions below query the window directly, so they are more up-to-date inside of event handlers.
+		static const InputSnapshot& getInputSnapshot() { return s_inputSnapshot; }
+
 		// Checks if a given key from the keyboard is currently pressed or released,
 		// or repeating which means that it had been pressed and held down for a bit (like half a second).
 		static bool isKeyPressed(KeyCode key);
@@ -71,6 +77,9 @@ namespace Pekan
 		// Window where current application is running
 		inline static Window s_window;
 
+		// Snapshot of input captured for the current frame
+		inline static InputSnapshot s_inputSnapshot;
+
 		// Application currently using Pekan
 		inline static PekanApplication* s_application = nullptr;
 
@@ -0,0 +1,514 @@
+#include "Profiler.h"
+
+#include "PekanLogger.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Environment variable naming a file where a Chrome trace is exported when the engine exits
+#define TRACE_FILE_ENVIRONMENT_VARIABLE "PEKAN_PROFILER_TRACE_FILE"
+
+namespace Pekan
+{
+
+	// Maximum number of events kept for each thread.
+	// When a thread records more events, its oldest events are overwritten.
+	constexpr size_t THREAD_BUFFER_CAPACITY = 65536;
+
+	// Maximum number of frames kept
+	constexpr size_t MAX_FRAMES_COUNT = 256;
+
+	// Ring buffer of events recorded by a single thread, or on a custom track
+	struct ThreadBuffer
+	{
+		// Index of the thread, used as thread ID in exported traces
+		int threadIndex = 0;
+		// Name of the thread, shown in exported traces
+		std::string name;
+
+		// Locked by the owning thread while recording an event.
+		// Other threads lock it only while reading events, so it's almost never contended.
+		// For custom tracks, locked by any thread recording an event.
+		std::mutex mutex;
+
+		// Events of the thread, used as a ring buffer of capacity THREAD_BUFFER_CAPACITY.
+		// Allocated when the first event is recorded, so threads that never record anything while capturing cost no memory.
+		std::vector<ProfilerEvent> events;
+		// Total number of events recorded since the last clear.
+		// Next event will be written at index (eventsCount % THREAD_BUFFER_CAPACITY).
+		size_t eventsCount = 0;
+
+		// Number of currently open profiled scopes on the thread
+		int depth = 0;
+
+		// Flag indicating if the thread owning the buffer has exited, so that the buffer can be reused by a new thread.
+		// Guarded by the thread buffers mutex. Buffers of custom tracks are never free.
+		bool isFree = false;
+	};
+
+	// Time at which the program started. All profiler times are relative to it.
+	static const std::chrono::steady_clock::time_point g_startTime = std::chrono::steady_clock::now();
+
+	// Flag indicating if capture is enabled
+	static std::atomic<bool> g_isCaptureEnabled = false;
+
+	// Buffers of all threads that have ever recorded an event.
+	// Buffers are never removed, so a buffer pointer stays valid until the end of the program.
+	// When a thread exits its buffer is reused by the next new thread, so the number of buffers
+	// is bounded by the largest number of threads using the profiler at the same time.
+	static std::vector<std::unique_ptr<ThreadBuffer>> g_threadBuffers;
+	// Mutex guarding the list of thread buffers
+	static std::mutex g_threadBuffersMutex;
+
+	// Owner of the calling thread's buffer, freeing the buffer for reuse when the thread exits
+	struct ThreadBufferOwner
+	{
+		// Buffer of the thread, or null if the thread hasn't used the profiler yet
+		ThreadBuffer* buffer = nullptr;
+
+		~ThreadBufferOwner()
+		{
+			if (buffer != nullptr)
+			{
+				std::lock_guard<std::mutex> lock(g_threadBuffersMutex);
+				buffer->isFree = true;
+			}
+		}
+	};
+	static thread_local ThreadBufferOwner g_threadBufferOwner;
+
+	// Buffer of the main thread, meaning the thread calling beginFrame()
+	static ThreadBuffer* g_mainThreadBuffer = nullptr;
+
+	// A custom track, not bound to any thread
+	struct Track
+	{
+		const char* name = nullptr;
+		ThreadBuffer* buffer = nullptr;
+	};
+	// All custom tracks, guarded by the same mutex as thread buffers
+	static std::vector<Track> g_tracks;
+
+	// Filepath where a Chrome trace is exported when the engine exits, or empty if no trace is requested
+	static std::string g_traceFilepath;
+
+	// Last captured frames, used as a ring buffer of capacity MAX_FRAMES_COUNT
+	static std::vector<ProfilerFrame> g_frames(MAX_FRAMES_COUNT);
+	// Total number of captured frames since the last clear
+	static size_t g_framesCount = 0;
+	// Mutex guarding captured frames, since they can be exported from any thread
+	static std::mutex g_framesMutex;
+	// Start time of the current frame, or -1 if the current frame is not captured
+	static long long g_frameStartTime = -1;
+
+	// Creates a new buffer with a given name, and adds it to the list of thread buffers.
+	// Thread buffers mutex must be locked by the caller.
+	static ThreadBuffer* createBuffer(const char* name)
+	{
+		std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+		buffer->threadIndex = int(g_threadBuffers.size());
+		buffer->name = (name != nullptr) ? std::string(name) : "Thread " + std::to_string(buffer->threadIndex);
+
+		ThreadBuffer* bufferPtr = buffer.get();
+		g_threadBuffers.push_back(std::move(buffer));
+		return bufferPtr;
+	}
+
+	// Returns buffer of the calling thread, reusing the buffer of an exited thread or creating a new one if needed
+	static ThreadBuffer* getThreadBuffer()
+	{
+		if (g_threadBufferOwner.buffer == nullptr)
+		{
+			std::lock_guard<std::mutex> lock(g_threadBuffersMutex);
+			const auto it = std::find_if(g_threadBuffers.begin(), g_threadBuffers.end(), [](const std::unique_ptr<ThreadBuffer>& buffer) { return buffer->isFree; });
+			if (it != g_threadBuffers.end())
+			{
+				// Events of the exited thread are discarded, since they would be shown as events of the new thread
+				ThreadBuffer* buffer = it->get();
+				std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+				buffer->name = "Thread " + std::to_string(buffer->threadIndex);
+				buffer->eventsCount = 0;
+				buffer->depth = 0;
+				buffer->isFree = false;
+				g_threadBufferOwner.buffer = buffer;
+			}
+			else
+			{
+				g_threadBufferOwner.buffer = createBuffer(nullptr);
+			}
+		}
+		return g_threadBufferOwner.buffer;
+	}
+
+	// Writes an event into a given buffer. Buffer's mutex must be locked by the caller.
+	static void writeEvent(ThreadBuffer& buffer, const char* name, long long startTime, long long endTime, int depth)
+	{
+		if (buffer.events.empty())
+		{
+			buffer.events.resize(THREAD_BUFFER_CAPACITY);
+		}
+		ProfilerEvent& event = buffer.events[buffer.eventsCount % THREAD_BUFFER_CAPACITY];
+		event.name = name;
+		event.startTime = startTime;
+		event.duration = endTime - startTime;
+		event.depth = depth;
+		buffer.eventsCount++;
+	}
+
+	// Returns the value of an environment variable,
+	// or an empty string if given environment variable doesn't exist.
+	static std::string getEnvVar(const char* varName)
+	{
+#ifdef _WIN32
+		char* value = nullptr;
+		size_t len = 0;
+		if (_dupenv_s(&value, &len, varName) == 0 && value != nullptr)
+		{
+			std::string result(value);
+			free(value);
+			return result;
+		}
+		return "";
+#else
+		const char* value = std::getenv(varName);
+		return (value == nullptr) ? "" : std::string(value);
+#endif
+	}
+
+	void Profiler::init()
+	{
+#if PEKAN_ENABLE_PROFILER
+		const std::string traceFilepath = getEnvVar(TRACE_FILE_ENVIRONMENT_VARIABLE);
+		if (!traceFilepath.empty())
+		{
+			g_traceFilepath = traceFilepath;
+			setCaptureEnabled(true);
+			PK_LOG_INFO("Profiler capture enabled. Trace will be exported to " << g_traceFilepath << " on exit.", "Pekan");
+		}
+#endif
+	}
+
+	void Profiler::exit()
+	{
+		if (!g_traceFilepath.empty())
+		{
+			exportChromeTrace(g_traceFilepath.c_str());
+			g_traceFilepath.clear();
+		}
+	}
+
+	void Profiler::setCaptureEnabled(bool enabled)
+	{
+#if PEKAN_ENABLE_PROFILER
+		g_isCaptureEnabled = enabled;
+#else
+		if (enabled)
+		{
+			PK_LOG_WARNING("Trying to enable profiler capture but Pekan is built without profiler support. Turn on the CMake option PEKAN_ENABLE_PROFILER.", "Pekan");
+		}
+#endif
+	}
+
+	bool Profiler::isCaptureEnabled()
+	{
+		return g_isCaptureEnabled.load(std::memory_order_relaxed);
+	}
+
+	void Profiler::beginFrame()
+	{
+		if (g_mainThreadBuffer == nullptr)
+		{
+			g_mainThreadBuffer = getThreadBuffer();
+			setThreadName("Main thread");
+		}
+		g_frameStartTime = isCaptureEnabled() ? _getTime() : -1;
+	}
+
+	void Profiler::endFrame()
+	{
+		// If capture was disabled when the frame began, don't capture the frame
+		if (g_frameStartTime < 0)
+		{
+			return;
+		}
+
+		const long long frameEndTime = _getTime();
+		std::lock_guard<std::mutex> lock(g_framesMutex);
+		ProfilerFrame& frame = g_frames[g_framesCount % MAX_FRAMES_COUNT];
+		frame.startTime = g_frameStartTime;
+		frame.duration = frameEndTime - g_frameStartTime;
+		g_framesCount++;
+		g_frameStartTime = -1;
+	}
+
+	void Profiler::setThreadName(const char* name)
+	{
+		PK_ASSERT(name != nullptr, "Trying to set a null thread name in Profiler.", "Pekan");
+
+		ThreadBuffer* buffer = getThreadBuffer();
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		buffer->name = name;
+	}
+
+	int Profiler::createTrack(const char* name)
+	{
+		PK_ASSERT(name != nullptr, "Trying to create a profiler track with a null name.", "Pekan");
+
+		std::lock_guard<std::mutex> lock(g_threadBuffersMutex);
+		g_tracks.push_back({ name, createBuffer(name) });
+		return int(g_tracks.size() - 1);
+	}
+
+	// Returns buffer of a custom track with a given index
+	static ThreadBuffer* getTrackBuffer(int trackIndex)
+	{
+		std::lock_guard<std::mutex> lock(g_threadBuffersMutex);
+		PK_ASSERT(trackIndex >= 0 && trackIndex < int(g_tracks.size()), "Trying to access a profiler track that doesn't exist.", "Pekan");
+		return g_tracks[trackIndex].buffer;
+	}
+
+	void Profiler::recordTrackEvent(int trackIndex, const char* name, long long startTime, long long endTime, int depth)
+	{
+		if (!isCaptureEnabled())
+		{
+			return;
+		}
+		ThreadBuffer* buffer = getTrackBuffer(trackIndex);
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		writeEvent(*buffer, name, startTime, endTime, depth);
+	}
+
+	int Profiler::getTracksCount()
+	{
+		std::lock_guard<std::mutex> lock(g_threadBuffersMutex);
+		return int(g_tracks.size());
+	}
+
+	const char* Profiler::getTrackName(int trackIndex)
+	{
+		std::lock_guard<std::mutex> lock(g_threadBuffersMutex);
+		PK_ASSERT(trackIndex >= 0 && trackIndex < int(g_tracks.size()), "Trying to get name of a profiler track that doesn't exist.", "Pekan");
+		return g_tracks[trackIndex].name;
+	}
+
+	// Copies all events currently held in a given thread buffer into a given list, ordered by their end time.
+	// Given buffer must be locked by the caller.
+	static void copyEvents(const ThreadBuffer& buffer, std::vector<ProfilerEvent>& events)
+	{
+		const size_t count = std::min(buffer.eventsCount, THREAD_BUFFER_CAPACITY);
+		const size_t firstIndex = buffer.eventsCount - count;
+		events.reserve(events.size() + count);
+		for (size_t i = firstIndex; i < buffer.eventsCount; i++)
+		{
+			events.push_back(buffer.events[i % THREAD_BUFFER_CAPACITY]);
+		}
+	}
+
+	// Writes a given string to a given stream as a JSON string, escaping special characters
+	static void writeJsonString(std::ofstream& file, const char* str)
+	{
+		file << '"';
+		for (const char* c = str; *c != '\0'; c++)
+		{
+			switch (*c)
+			{
+				case '"':  file << "\\\""; break;
+				case '\\': file << "\\\\"; break;
+				case '\n': file << "\\n"; break;
+				case '\t': file << "\\t"; break;
+				default:   file << *c; break;
+			}
+		}
+		file << '"';
+	}
+
+	// Writes a single complete event ("ph":"X") of Chrome trace event format to a given stream.
+	// Times are given in nanoseconds and written in microseconds, as expected by the format.
+	static void writeTraceEvent(std::ofstream& file, const char* name, int threadIndex, long long startTime, long long duration)
+	{
+		file << ",\n{\"name\":";
+		writeJsonString(file, name);
+		file << ",\"cat\":\"Pekan\",\"ph\":\"X\",\"pid\":0,\"tid\":" << threadIndex
+			<< ",\"ts\":" << double(startTime) / 1000.0
+			<< ",\"dur\":" << double(duration) / 1000.0 << "}";
+	}
+
+	bool Profiler::exportChromeTrace(const char* filepath)
+	{
+		PK_ASSERT(filepath != nullptr, "Trying to export a Chrome trace to a null filepath.", "Pekan");
+
+		std::ofstream file(filepath);
+		if (!file.is_open())
+		{
+			PK_LOG_ERROR("Failed to open file " << filepath << " for exporting a Chrome trace.", "Pekan");
+			return false;
+		}
+		file << std::fixed;
+		file.precision(3);
+
+		// First event is process name, so that every following event can be written with a leading comma
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"Pekan\"}}";
+
+		// Write events of all threads, copying them out of each thread's buffer first,
+		// so that the thread is blocked only for the duration of the copy and not for the duration of the writing.
+		std::vector<ProfilerEvent> events;
+		std::lock_guard<std::mutex> threadBuffersLock(g_threadBuffersMutex);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : g_threadBuffers)
+		{
+			std::string threadName;
+			events.clear();
+			{
+				std::lock_guard<std::mutex> lock(buffer->mutex);
+				copyEvents(*buffer, events);
+				threadName = buffer->name;
+			}
+
+			file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->threadIndex << ",\"args\":{\"name\":";
+			writeJsonString(file, threadName.c_str());
+			file << "}}";
+
+			for (const ProfilerEvent& event : events)
+			{
+				writeTraceEvent(file, event.name, buffer->threadIndex, event.startTime, event.duration);
+			}
+		}
+
+		// Write frames as events of the main thread, enclosing all other events of the frame.
+		// Frames are copied out first, so that the main thread is not blocked for the duration of the writing.
+		if (g_mainThreadBuffer != nullptr)
+		{
+			std::vector<ProfilerFrame> frames;
+			{
+				std::lock_guard<std::mutex> lock(g_framesMutex);
+				const size_t framesCount = std::min(g_framesCount, MAX_FRAMES_COUNT);
+				frames.reserve(framesCount);
+				for (size_t i = g_framesCount - framesCount; i < g_framesCount; i++)
+				{
+					frames.push_back(g_frames[i % MAX_FRAMES_COUNT]);
+				}
+			}
+			for (const ProfilerFrame& frame : frames)
+			{
+				writeTraceEvent(file, "Frame", g_mainThreadBuffer->threadIndex, frame.startTime, frame.duration);
+			}
+		}
+
+		file << "\n]}\n";
+		if (!file.good())
+		{
+			PK_LOG_ERROR("Failed to write Chrome trace to file " << filepath, "Pekan");
+			return false;
+		}
+
+		PK_LOG_INFO("Exported Chrome trace to " << filepath, "Pekan");
+		return true;
+	}
+
+	void Profiler::getRecentFrames(int framesCount, std::vector<ProfilerFrame>& frames, std::vector<ProfilerEvent>& events)
+	{
+		frames.clear();
+		events.clear();
+		if (framesCount <= 0 || g_mainThreadBuffer == nullptr)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(g_framesMutex);
+			const size_t count = std::min({ size_t(framesCount), g_framesCount, MAX_FRAMES_COUNT });
+			for (size_t i = g_framesCount - count; i < g_framesCount; i++)
+			{
+				frames.push_back(g_frames[i % MAX_FRAMES_COUNT]);
+			}
+		}
+		if (frames.empty())
+		{
+			return;
+		}
+		const long long rangeStartTime = frames.front().startTime;
+		const long long rangeEndTime = frames.back().startTime + frames.back().duration;
+
+		// Events are recorded in order of their end time,
+		// so walk backwards from the newest event until reaching events that ended before the first frame.
+		std::lock_guard<std::mutex> lock(g_mainThreadBuffer->mutex);
+		const size_t availableCount = std::min(g_mainThreadBuffer->eventsCount, THREAD_BUFFER_CAPACITY);
+		for (size_t i = 0; i < availableCount; i++)
+		{
+			const ProfilerEvent& event = g_mainThreadBuffer->events[(g_mainThreadBuffer->eventsCount - 1 - i) % THREAD_BUFFER_CAPACITY];
+			const long long eventEndTime = event.startTime + event.duration;
+			if (eventEndTime < rangeStartTime)
+			{
+				break;
+			}
+			if (eventEndTime <= rangeEndTime)
+			{
+				events.push_back(event);
+			}
+		}
+		std::reverse(events.begin(), events.end());
+	}
+
+	void Profiler::getTrackEvents(int trackIndex, long long startTime, long long endTime, std::vector<ProfilerEvent>& events)
+	{
+		events.clear();
+		ThreadBuffer* buffer = getTrackBuffer(trackIndex);
+
+		// Events of custom tracks are not necessarily recorded in order of their end time,
+		// for example GPU events are recorded when their results are read, a few frames late.
+		// So walk backwards from the newest event, with some slack, until reaching events that ended long before given range.
+		constexpr long long SLACK_TIME = 1000000000LL;
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		const size_t availableCount = std::min(buffer->eventsCount, THREAD_BUFFER_CAPACITY);
+		for (size_t i = 0; i < availableCount; i++)
+		{
+			const ProfilerEvent& event = buffer->events[(buffer->eventsCount - 1 - i) % THREAD_BUFFER_CAPACITY];
+			const long long eventEndTime = event.startTime + event.duration;
+			if (eventEndTime < startTime - SLACK_TIME)
+			{
+				break;
+			}
+			if (eventEndTime >= startTime && eventEndTime <= endTime)
+			{
+				events.push_back(event);
+			}
+		}
+		std::sort(events.begin(), events.end(), [](const ProfilerEvent& a, const ProfilerEvent& b) { return a.startTime < b.startTime; });
+	}
+
+	void Profiler::clear()
+	{
+		std::lock_guard<std::mutex> threadBuffersLock(g_threadBuffersMutex);
+		for (const std::unique_ptr<ThreadBuffer>& buffer : g_threadBuffers)
+		{
+			std::lock_guard<std::mutex> lock(buffer->mutex);
+			buffer->eventsCount = 0;
+		}
+		std::lock_guard<std::mutex> framesLock(g_framesMutex);
+		g_framesCount = 0;
+	}
+
+	long long Profiler::_getTime()
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_startTime).count();
+	}
+
+	void Profiler::_recordEvent(const char* name, long long startTime, long long endTime, int depth)
+	{
+		ThreadBuffer* buffer = getThreadBuffer();
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		writeEvent(*buffer, name, startTime, endTime, depth);
+	}
+
+	int& Profiler::_getThreadDepth()
+	{
+		return getThreadBuffer()->depth;
+	}
+
+} // namespace Pekan
\ No newline at end of file
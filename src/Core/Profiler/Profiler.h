@@ -0,0 +1,172 @@
+#pragma once
+
+#include <vector>
+
+// PEKAN_ENABLE_PROFILER is set by CMake, from the option with the same name.
+// If it's 0, PK_PROFILE_SCOPE and PK_PROFILE_FUNCTION expand to nothing,
+// removing all profiling code from the whole code base.
+#ifndef PEKAN_ENABLE_PROFILER
+	#define PEKAN_ENABLE_PROFILER 0
+#endif
+
+namespace Pekan
+{
+
+	// A single profiled scope, recorded when the scope ends
+	struct ProfilerEvent
+	{
+		// Name of the scope. Must be a string literal, or some other string living until the end of the program.
+		const char* name = nullptr;
+
+		// Time at which the scope began, in nanoseconds since the program started
+		long long startTime = 0;
+		// Duration of the scope, in nanoseconds
+		long long duration = 0;
+
+		// Number of profiled scopes enclosing this scope on the same thread
+		int depth = 0;
+	};
+
+	// A single frame, as marked by beginFrame() and endFrame()
+	struct ProfilerFrame
+	{
+		// Time at which the frame began, in nanoseconds since the program started
+		long long startTime = 0;
+		// Duration of the frame, in nanoseconds
+		long long duration = 0;
+	};
+
+	// A static class for hierarchical CPU profiling.
+	//
+	// Scopes are profiled with the macros PK_PROFILE_SCOPE and PK_PROFILE_FUNCTION.
+	// Each thread records its scopes into its own ring buffer of fixed size, allocated when the thread records its first event,
+	// so after that recording never allocates, and threads don't wait for each other. When a ring buffer is full, the oldest events are overwritten.
+	// When a thread exits, its ring buffer is reused by the next thread that starts recording.
+	//
+	// Besides threads, events can be recorded on custom tracks, created with createTrack().
+	// These are meant for timelines that are not CPU threads, like the GPU.
+	//
+	// Capture can be enabled and disabled at runtime, and is disabled by default.
+	// If environment variable PEKAN_PROFILER_TRACE_FILE is set, capture is enabled from the start,
+	// and a Chrome trace is exported to the file it names when the engine exits.
+	// While capture is disabled, a profiled scope costs a single check of a flag.
+	// Captured events can be exported to a Chrome trace event JSON file,
+	// which can be opened in chrome://tracing or https://ui.perfetto.dev
+	//
+	// If Pekan is built with the CMake option PEKAN_ENABLE_PROFILER turned off, profiling compiles out completely.
+	class Profiler
+	{
+		// Make PekanEngine a friend so that it can initialize and exit the Profiler
+		friend class PekanEngine;
+
+	public:
+
+		// Enables/disables capturing of profiled scopes
+		static void setCaptureEnabled(bool enabled);
+		static bool isCaptureEnabled();
+
+		// Marks beginning and end of a frame. Called by PekanApplication on the main thread.
+		static void beginFrame();
+		static void endFrame();
+
+		// Sets a name of the calling thread, shown in exported traces
+		static void setThreadName(const char* name);
+
+		// Creates a custom track with a given name, to record events on with recordTrackEvent().
+		// Name must be a string literal, or some other string living until the end of the program.
+		// Returns index of the created track.
+		static int createTrack(const char* name);
+
+		// Records an event on a custom track with a given index.
+		// Times are in nanoseconds since the program started, as returned by _getTime().
+		// Does nothing if capture is disabled.
+		static void recordTrackEvent(int trackIndex, const char* name, long long startTime, long long endTime, int depth);
+
+		// Returns number of custom tracks, and name of a custom track with a given index
+		static int getTracksCount();
+		static const char* getTrackName(int trackIndex);
+
+		// Exports all captured events of all threads and custom tracks to a Chrome trace event JSON file.
+		// Returns true on success.
+		static bool exportChromeTrace(const char* filepath);
+
+		// Fills given lists with the last (up to) N captured frames, and all events of the main thread recorded during them.
+		// Frames are ordered from oldest to newest. Events are ordered by their end time.
+		// Must be called from the main thread.
+		static void getRecentFrames(int framesCount, std::vector<ProfilerFrame>& frames, std::vector<ProfilerEvent>& events);
+
+		// Fills given list with all events of a custom track with a given index that ended in a given time range.
+		// Events are ordered by their start time.
+		static void getTrackEvents(int trackIndex, long long startTime, long long endTime, std::vector<ProfilerEvent>& events);
+
+		// Clears all captured frames and events
+		static void clear();
+
+		// Returns current time, in nanoseconds since the program started
+		static long long _getTime();
+
+		// Records a profiled scope on the calling thread.
+		// Used by ProfileScope, not meant to be called directly.
+		static void _recordEvent(const char* name, long long startTime, long long endTime, int depth);
+
+		// Returns a reference to the number of currently open profiled scopes on the calling thread.
+		// Used by ProfileScope, not meant to be called directly.
+		static int& _getThreadDepth();
+
+	private:
+
+		// Initializes the Profiler from environment variables. Only PekanEngine should call this.
+		static void init();
+
+		// Exports a trace if requested by environment variables. Only PekanEngine should call this.
+		static void exit();
+	};
+
+	// An RAII object profiling the scope in which it lives. Use the PK_PROFILE_SCOPE macro instead of using it directly.
+	class ProfileScope
+	{
+	public:
+
+		ProfileScope(const char* name)
+		{
+			if (Profiler::isCaptureEnabled())
+			{
+				m_name = name;
+				m_depth = Profiler::_getThreadDepth()++;
+				m_startTime = Profiler::_getTime();
+			}
+		}
+
+		~ProfileScope()
+		{
+			if (m_name != nullptr)
+			{
+				Profiler::_recordEvent(m_name, m_startTime, Profiler::_getTime(), m_depth);
+				Profiler::_getThreadDepth()--;
+			}
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+
+		// Name of the profiled scope, or null if capture was disabled when the scope began
+		const char* m_name = nullptr;
+		long long m_startTime = 0;
+		int m_depth = 0;
+	};
+
+} // namespace Pekan
+
+#if PEKAN_ENABLE_PROFILER
+	#define PK_PROFILE_CONCAT_IMPL(A, B) A##B
+	#define PK_PROFILE_CONCAT(A, B) PK_PROFILE_CONCAT_IMPL(A, B)
+	// Profiles the current scope under a given name. Name must be a string literal.
+	#define PK_PROFILE_SCOPE(NAME) Pekan::ProfileScope PK_PROFILE_CONCAT(pkProfileScope, __LINE__)(NAME)
+	// Profiles the current function under its name
+	#define PK_PROFILE_FUNCTION() PK_PROFILE_SCOPE(__FUNCTION__)
+#else
+	#define PK_PROFILE_SCOPE(NAME)
+	#define PK_PROFILE_FUNCTION()
+#endif
\ No newline at end of file
@@ -49,6 +49,48 @@ namespace FileUtils
 		}
 	}
 
+	std::vector<unsigned char> readBinaryFile(const char* filepath)
+	{
+		std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+		{
+			PK_LOG_ERROR("Failed to open file for reading: " << filepath, "Pekan");
+			return {};
+		}
+
+		// File is opened at the end, so current position is the size of the file
+		const std::streamsize size = file.tellg();
+		file.seekg(0, std::ios::beg);
+
+		std::vector<unsigned char> bytes(size_t(size));
+		if (size > 0 && !file.read(reinterpret_cast<char*>(bytes.data()), size))
+		{
+			PK_LOG_ERROR("Failed to read file: " << filepath, "Pekan");
+			return {};
+		}
+
+		return bytes;
+	}
+
+	bool writeBinaryFile(const char* filepath, const void* data, size_t size)
+	{
+		std::ofstream file(filepath, std::ios::binary);
+		if (!file.is_open())
+		{
+			PK_LOG_ERROR("Failed to write file: " << filepath, "Pekan");
+			return false;
+		}
+
+		file.write(static_cast<const char*>(data), std::streamsize(size));
+		if (!file)
+		{
+			PK_LOG_ERROR("Failed to write file: " << filepath, "Pekan");
+			return false;
+		}
+
+		return true;
+	}
+
 	const unsigned char* readImageFile(const char* filepath, int& width, int& height, int& numChannels)
 	{
 		stbi_set_flip_vertically_on_load(true);
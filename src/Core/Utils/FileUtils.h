@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace Pekan
 {
@@ -15,6 +16,16 @@ namespace FileUtils
 	// If the file exists, it will be overwritten.
 	void writeStringToTextFile(const char* filepath, const char* content);
 
+	// Reads a binary file's contents into a byte array.
+	// If the file fails to open, an empty array will be returned.
+	std::vector<unsigned char> readBinaryFile(const char* filepath);
+
+	// Writes a given number of bytes into a binary file.
+	// If the file doesn't exist, it will be created.
+	// If the file exists, it will be overwritten.
+	// Returns true on success.
+	bool writeBinaryFile(const char* filepath, const void* data, size_t size);
+
 	// Reads an image file.
 	// Returns raw pixel data, where each byte is a component of a pixel.
 	// 
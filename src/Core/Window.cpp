@@ -12,47 +12,75 @@
 namespace Pekan
 {
 
-	bool Window::create(const ApplicationProperties& applicationProperties)
+	// Sets window hints for OpenGL version, OpenGL Core Profile and number of samples
+	static void setContextWindowHints(const ApplicationProperties& applicationProperties)
 	{
-		m_properties = applicationProperties.windowProperties;
-
-		if (!glfwInit())
-		{
-			PK_LOG_ERROR("Failed to initialize GLFW.", "Pekan");
-			return false;
-		}
-
-		// Set window hint for OpenGL version and OpenGL Core Profile
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, PK_OPENGL_VERSION_MAJOR);
 		glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, PK_OPENGL_VERSION_MINOR);
 		glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 		glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GL_TRUE);
-		// Set window hint for number of samples
-		glfwWindowHint(GLFW_SAMPLES, applicationProperties.numberOfSamples);
+		// Renderer2D resolves overlap order with depth testing, so window's frame buffer must have a depth buffer
+		glfwWindowHint(GLFW_DEPTH_BITS, 24);
+		// With FXAA frames are rendered single-sampled and anti-aliased afterwards by the PostProcessor
+		const bool isMultisample = (applicationProperties.antiAliasingMode == AntiAliasingMode::Multisample);
+		glfwWindowHint(GLFW_SAMPLES, isMultisample ? applicationProperties.numberOfSamples : 1);
+	}
 
-		// Create a GLFW window
-		if (m_properties.fullScreen)
-		{
-			GLFWmonitor* primaryMonitor = glfwGetPrimaryMonitor();
-			const GLFWvidmode* mode = glfwGetVideoMode(primaryMonitor);
+	bool Window::create(const ApplicationProperties& applicationProperties)
+	{
+		m_properties = applicationProperties.windowProperties;
 
-			m_glfwWindow = glfwCreateWindow(mode->width, mode->height, m_properties.title.c_str(), primaryMonitor, nullptr);
-		}
-		else
+		if (applicationProperties.offscreenProperties.enabled && applicationProperties.offscreenProperties.headless)
 		{
-			m_glfwWindow = glfwCreateWindow(m_properties.width, m_properties.height, m_properties.title.c_str(), nullptr, nullptr);
+			// A headless window has no underlying GLFW window, so there is nothing else to create
+			m_isHeadless = true;
+			m_shouldBeClosedHeadless = false;
+			PK_LOG_INFO("Created a headless window without an OpenGL context.", "Pekan");
+			return true;
 		}
-		if (m_glfwWindow == nullptr)
+
+		if (applicationProperties.offscreenProperties.enabled)
 		{
-			PK_LOG_ERROR("Failed to create a window with GLFW.", "Pekan");
-			glfwTerminate();
-			return false;
+			if (!createOffscreen(applicationProperties))
+			{
+				PK_LOG_ERROR("Failed to create an offscreen window with GLFW.", "Pekan");
+				return false;
+			}
 		}
-
-		if (!m_properties.fullScreen)
+		else
 		{
-			// Set window's initial position
-			glfwSetWindowPos(m_glfwWindow, m_properties.initialPosition.x, m_properties.initialPosition.y);
+			if (!glfwInit())
+			{
+				PK_LOG_ERROR("Failed to initialize GLFW.", "Pekan");
+				return false;
+			}
+
+			setContextWindowHints(applicationProperties);
+
+			// Create a GLFW window
+			if (m_properties.fullScreen)
+			{
+				GLFWmonitor* primaryMonitor = glfwGetPrimaryMonitor();
+				const GLFWvidmode* mode = glfwGetVideoMode(primaryMonitor);
+
+				m_glfwWindow = glfwCreateWindow(mode->width, mode->height, m_properties.title.c_str(), primaryMonitor, nullptr);
+			}
+			else
+			{
+				m_glfwWindow = glfwCreateWindow(m_properties.width, m_properties.height, m_properties.title.c_str(), nullptr, nullptr);
+			}
+			if (m_glfwWindow == nullptr)
+			{
+				PK_LOG_ERROR("Failed to create a window with GLFW.", "Pekan");
+				glfwTerminate();
+				return false;
+			}
+
+			if (!m_properties.fullScreen)
+			{
+				// Set window's initial position
+				glfwSetWindowPos(m_glfwWindow, m_properties.initialPosition.x, m_properties.initialPosition.y);
+			}
 		}
 
 		// Make the window's context current
@@ -69,9 +97,63 @@ namespace Pekan
 		return true;
 	}
 
+	bool Window::createOffscreen(const ApplicationProperties& applicationProperties)
+	{
+		// Try context creation APIs from the most to the least headless one:
+		//   1. Surfaceless EGL on GLFW's null platform, which doesn't need a display server
+		//   2. OSMesa on GLFW's null platform, which renders in software and doesn't need a display server either
+		//   3. A hidden window on the native platform, which needs a display server
+		struct Attempt
+		{
+			int platform;
+			int contextCreationApi;
+			const char* name;
+		};
+		constexpr Attempt attempts[] =
+		{
+			{ GLFW_PLATFORM_NULL, GLFW_EGL_CONTEXT_API, "surfaceless EGL" },
+			{ GLFW_PLATFORM_NULL, GLFW_OSMESA_CONTEXT_API, "OSMesa" },
+			{ GLFW_ANY_PLATFORM, GLFW_NATIVE_CONTEXT_API, "a hidden native window" }
+		};
+
+		for (const Attempt& attempt : attempts)
+		{
+			if (attempt.platform != GLFW_ANY_PLATFORM && !glfwPlatformSupported(attempt.platform))
+			{
+				continue;
+			}
+
+			glfwInitHint(GLFW_PLATFORM, attempt.platform);
+			if (!glfwInit())
+			{
+				continue;
+			}
+
+			setContextWindowHints(applicationProperties);
+			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, attempt.contextCreationApi);
+
+			m_glfwWindow = glfwCreateWindow(m_properties.width, m_properties.height, m_properties.title.c_str(), nullptr, nullptr);
+			if (m_glfwWindow != nullptr)
+			{
+				PK_LOG_INFO("Created an offscreen OpenGL context using " << attempt.name << ".", "Pekan");
+				return true;
+			}
+
+			// Terminate GLFW so that the next attempt can initialize it with a different platform
+			glfwTerminate();
+		}
+
+		return false;
+	}
+
 	void Window::destroy()
 	{
-		if (m_glfwWindow)
+		if (m_isHeadless)
+		{
+			m_isHeadless = false;
+		}
+		else if (m_glfwWindow)
 		{
 			glfwDestroyWindow(m_glfwWindow);
 			glfwTerminate();
@@ -85,46 +167,83 @@ namespace Pekan
 
 	void Window::enableVSync()
 	{
+		if (m_isHeadless)
+		{
+			return;
+		}
 		glfwSwapInterval(1);
 	}
 
 	void Window::disableVSync()
 	{
+		if (m_isHeadless)
+		{
+			return;
+		}
 		glfwSwapInterval(0);
 	}
 
 	bool Window::shouldBeClosed() const
 	{
+		if (m_isHeadless)
+		{
+			return m_shouldBeClosedHeadless;
+		}
 		return glfwWindowShouldClose(m_glfwWindow);
 	}
 
 	void Window::setShouldBeClosed(bool enabled)
 	{
+		if (m_isHeadless)
+		{
+			m_shouldBeClosedHeadless = enabled;
+			return;
+		}
 		glfwSetWindowShouldClose(m_glfwWindow, enabled);
 	}
 
 	void Window::swapBuffers()
 	{
+		if (m_isHeadless)
+		{
+			return;
+		}
 		glfwSwapBuffers(m_glfwWindow);
 	}
 
 	bool Window::isMinimized() const
 	{
+		if (m_isHeadless)
+		{
+			return false;
+		}
 		return glfwGetWindowAttrib(m_glfwWindow, GLFW_ICONIFIED) != 0;
 	}
 
 	bool Window::isKeyPressed(KeyCode key) const
 	{
+		if (m_isHeadless)
+		{
+			return false;
+		}
 		return (glfwGetKey(m_glfwWindow, int(key)) == GLFW_PRESS || glfwGetKey(m_glfwWindow, int(key)) == GLFW_REPEAT);
 	}
 
 	bool Window::isKeyReleased(KeyCode key) const
 	{
+		if (m_isHeadless)
+		{
+			return true;
+		}
 		return (glfwGetKey(m_glfwWindow, int(key)) == GLFW_RELEASE);
 	}
 
 	bool Window::isKeyRepeating(KeyCode key) const
 	{
+		if (m_isHeadless)
+		{
+			return false;
+		}
 		return (glfwGetKey(m_glfwWindow, int(key)) == GLFW_REPEAT);
 	}
 
@@ -132,22 +251,37 @@ namespace Pekan
 	{
 		double xMouse = 0.0;
 		double yMouse = 0.0;
-		glfwGetCursorPos(m_glfwWindow, &xMouse, &yMouse);
+		if (!m_isHeadless)
+		{
+			glfwGetCursorPos(m_glfwWindow, &xMouse, &yMouse);
+		}
 		return { float(xMouse), float(yMouse) };
 	}
 
 	bool Window::isMouseButtonPressed(MouseButton button) const
 	{
+		if (m_isHeadless)
+		{
+			return false;
+		}
 		return glfwGetMouseButton(m_glfwWindow, int(button)) == GLFW_PRESS;
 	}
 
 	bool Window::isMouseButtonReleased(MouseButton button) const
 	{
+		if (m_isHeadless)
+		{
+			return true;
+		}
 		return glfwGetMouseButton(m_glfwWindow, int(button)) == GLFW_RELEASE;
 	}
 
 	glm::ivec2 Window::getSize() const
 	{
+		if (m_isHeadless)
+		{
+			return { m_properties.width, m_properties.height };
+		}
 		int width, height;
 		glfwGetWindowSize(m_glfwWindow, &width, &height);
 		return { width, height };
@@ -181,6 +315,10 @@ namespace Pekan
 
 	glm::ivec2 Window::getFrameBufferSize() const
 	{
+		if (m_isHeadless)
+		{
+			return { m_properties.width, m_properties.height };
+		}
 		int width, height;
 		glfwGetFramebufferSize(m_glfwWindow, &width, &height);
 		return { width, height };
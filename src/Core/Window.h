@@ -50,7 +50,10 @@ namespace Pekan
 
 	public:
 
-		// Creates a window with given application properties
+		// Creates a window with given application properties.
+		// If application runs offscreen, the window is hidden and, where possible, has no surface at all.
+		// If application runs headless, there is no underlying GLFW window and no OpenGL context.
+		// The window then only keeps its size and "should be closed" state, and reports no input.
 		bool create(const ApplicationProperties& applicationProperties);
 		// Destroys a window
 		void destroy();
@@ -76,6 +79,9 @@ namespace Pekan
 		// Checks if window is currently minimized (iconified)
 		bool isMinimized() const;
 
+		// Checks if window is headless, meaning that it has no underlying GLFW window and no OpenGL context
+		bool isHeadless() const { return m_isHeadless; }
+
 		// Returns (a pointer to) the underlying GLFW window
 		GLFWwindow* getGlfwWindow() { return m_glfwWindow; }
 
@@ -106,6 +112,10 @@ namespace Pekan
 
 	private: /* functions */
 
+		// Creates a hidden window with an OpenGL context that can be used for offscreen rendering.
+		// Prefers contexts that don't need a display server, so that multiple processes can render in parallel on a headless machine.
+		bool createOffscreen(const ApplicationProperties& applicationProperties);
+
 		// Connects event callbacks with the window, so that they are actually called when an event occurs.
 		void setEventCallbacks();
 
@@ -127,6 +137,11 @@ namespace Pekan
 
 		// Window's properties
 		WindowProperties m_properties;
+
+		// Flag indicating if window is headless, having no underlying GLFW window
+		bool m_isHeadless = false;
+		// "Should be closed" state of a headless window, kept by GLFW otherwise
+		bool m_shouldBeClosedHeadless = false;
 	};
 
 } // namespace Pekan
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "GUISubsystem.h"
 
 #include "PekanLogger.h"
+#include "GpuProfiler.h"
 #include "PekanUserMessageBox.h"
 #include "SubsystemManager.h"
 #include "PekanEngine.h"
@@ -37,6 +38,13 @@ namespace GUI
 
 	bool GUISubsystem::init()
 	{
+		// ImGui needs a GLFW window and an OpenGL context, which a headless window doesn't have
+		if (PekanEngine::getWindow().isHeadless())
+		{
+			PK_LOG_ERROR("GUI subsystem can't be initialized when application runs headless, without a window.", "Pekan");
+			return false;
+		}
+
 		if (!initImGui())
 		{
 			PK_LOG_ERROR("Failed to initialize ImGui when initializing the GUI subsystem.", "Pekan");
@@ -103,6 +111,8 @@ namespace GUI
 
 	void GUISubsystem::beginFrame()
 	{
+		PK_PROFILE_FUNCTION();
+
 		if (m_isFrameActive)
 		{
 			PK_LOG_ERROR("Attempting to begin a new GUI frame while another frame is already active.", "Pekan");
@@ -118,6 +128,8 @@ namespace GUI
 
 	void GUISubsystem::endFrame()
 	{
+		PK_PROFILE_FUNCTION();
+
 		if (!m_isFrameActive)
 		{
 			PK_LOG_ERROR("Attempting to end a GUI frame but no frame is currently active.", "Pekan");
@@ -129,7 +141,10 @@ namespace GUI
 #endif
 
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		{
+			PK_PROFILE_GPU_SCOPE("GUI");
+			ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		}
 
 		// Update and Render additional Platform Windows
 		// (Platform functions may change the current OpenGL context, so we save/restore it)
@@ -0,0 +1,26 @@
+#include "ProfilerGUIWindow.h"
+
+// Filepath of the file where the profiler window exports Chrome traces
+#define TRACE_FILEPATH "PekanTrace.json"
+
+namespace Pekan
+{
+namespace GUI
+{
+
+	bool ProfilerGUIWindow::_init()
+	{
+		m_profilerWidget->create(this, m_framesCount, TRACE_FILEPATH);
+		return true;
+	}
+
+	GUIWindowProperties ProfilerGUIWindow::getProperties() const
+	{
+		GUIWindowProperties props;
+		props.size = { 700, 300 };
+		props.name = "Profiler";
+		return props;
+	}
+
+} // namespace GUI
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "GUIWindow.h"
+#include "ProfilerWidget.h"
+
+namespace Pekan
+{
+namespace GUI
+{
+
+	// A GUI window showing the Profiler's flame graph of the last N frames, together with its controls.
+	// Can be pushed onto the layer stack of any application.
+	class ProfilerGUIWindow : public GUIWindow
+	{
+		bool _init() override;
+
+	public:
+
+		ProfilerGUIWindow(PekanApplication* application, int framesCount = 10)
+			: GUIWindow(application), m_framesCount(framesCount) {}
+
+		std::string getLayerName() const override { return "profiler_gui_layer"; }
+
+	private: /* functions */
+
+		GUIWindowProperties getProperties() const override;
+
+	private: /* variables */
+
+		// Number of frames shown in the flame graph
+		int m_framesCount = 10;
+
+		ProfilerWidget_Ptr m_profilerWidget = std::make_shared<ProfilerWidget>();
+	};
+
+} // namespace GUI
+} // namespace Pekan
\ No newline at end of file
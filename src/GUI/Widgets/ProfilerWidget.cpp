@@ -0,0 +1,165 @@
+#include "ProfilerWidget.h"
+
+#include "PekanLogger.h"
+
+#include "imgui.h"
+
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+namespace Pekan
+{
+namespace GUI
+{
+
+	// Height of a single row of the flame graph, in pixels
+	constexpr float ROW_HEIGHT = 18.0f;
+
+	// Minimum width of a scope's rectangle, in pixels, for its name to be shown inside of it
+	constexpr float MIN_WIDTH_FOR_TEXT = 30.0f;
+
+	// Returns a color for a scope with a given name.
+	// Color depends only on the name, so the same scope has the same color in all frames.
+	static ImU32 getScopeColor(const char* name)
+	{
+		const size_t hash = std::hash<std::string_view>{}(name);
+		const float hue = float(hash % 360) / 360.0f;
+		return ImColor::HSV(hue, 0.45f, 0.85f);
+	}
+
+	void ProfilerWidget::create(GUIWindow* guiWindow)
+	{
+		Widget::create(guiWindow);
+	}
+	void ProfilerWidget::create(GUIWindow* guiWindow, int framesCount, const char* traceFilepath)
+	{
+		PK_ASSERT(framesCount > 0, "Trying to create a ProfilerWidget showing a non-positive number of frames.", "Pekan");
+		PK_ASSERT(traceFilepath != nullptr, "Trying to create a ProfilerWidget with a null trace filepath.", "Pekan");
+
+		Widget::create(guiWindow);
+		m_framesCount = framesCount;
+		m_traceFilepath = traceFilepath;
+	}
+	void ProfilerWidget::destroy()
+	{
+		m_frames.clear();
+		m_events.clear();
+		m_trackEvents.clear();
+		Widget::destroy();
+	}
+
+	void ProfilerWidget::_render() const
+	{
+		PK_ASSERT_QUICK(isValid());
+
+#if PEKAN_ENABLE_PROFILER
+		bool isCaptureEnabled = Profiler::isCaptureEnabled();
+		if (ImGui::Checkbox("Capture", &isCaptureEnabled))
+		{
+			Profiler::setCaptureEnabled(isCaptureEnabled);
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Export trace"))
+		{
+			Profiler::exportChromeTrace(m_traceFilepath.c_str());
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Clear"))
+		{
+			Profiler::clear();
+		}
+
+		Profiler::getRecentFrames(m_framesCount, m_frames, m_events);
+		if (m_frames.empty())
+		{
+			ImGui::Text("No captured frames");
+			return;
+		}
+
+		// Display average frame time over shown frames
+		long long framesDuration = 0;
+		for (const ProfilerFrame& frame : m_frames)
+		{
+			framesDuration += frame.duration;
+		}
+		ImGui::Text("Last %d frames, avg %.3f ms/frame", int(m_frames.size()), double(framesDuration) / double(m_frames.size()) / 1e6);
+
+		renderFlameGraph("##MainThread", m_events);
+
+		// Render flame graphs of custom tracks, over the same time range
+		const long long rangeStartTime = m_frames.front().startTime;
+		const long long rangeEndTime = m_frames.back().startTime + m_frames.back().duration;
+		const int tracksCount = Profiler::getTracksCount();
+		for (int i = 0; i < tracksCount; i++)
+		{
+			const char* trackName = Profiler::getTrackName(i);
+			Profiler::getTrackEvents(i, rangeStartTime, rangeEndTime, m_trackEvents);
+			ImGui::Text("%s", trackName);
+			ImGui::PushID(i);
+			renderFlameGraph("##Track", m_trackEvents);
+			ImGui::PopID();
+		}
+#else
+		ImGui::Text("Profiler is compiled out.");
+		ImGui::Text("Turn on the CMake option PEKAN_ENABLE_PROFILER.");
+#endif
+	}
+
+	void ProfilerWidget::renderFlameGraph(const char* id, const std::vector<ProfilerEvent>& events) const
+	{
+		int maxDepth = 0;
+		for (const ProfilerEvent& event : events)
+		{
+			maxDepth = std::max(maxDepth, event.depth);
+		}
+
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		const float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+		const float height = float(maxDepth + 1) * ROW_HEIGHT;
+		// Reserve space for the flame graph, so that it's laid out like any other widget
+		ImGui::InvisibleButton(id, ImVec2(width, height));
+		const bool isHovered = ImGui::IsItemHovered();
+		const ImVec2 mousePos = ImGui::GetIO().MousePos;
+
+		// Map time range of the shown frames to the width of the flame graph
+		const long long rangeStartTime = m_frames.front().startTime;
+		const long long rangeEndTime = m_frames.back().startTime + m_frames.back().duration;
+		const double pixelsPerNanosecond = double(width) / double(std::max(rangeEndTime - rangeStartTime, 1LL));
+
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		drawList->PushClipRect(origin, ImVec2(origin.x + width, origin.y + height), true);
+
+		for (const ProfilerEvent& event : events)
+		{
+			const float x0 = origin.x + float(double(event.startTime - rangeStartTime) * pixelsPerNanosecond);
+			const float x1 = std::max(origin.x + float(double(event.startTime + event.duration - rangeStartTime) * pixelsPerNanosecond), x0 + 1.0f);
+			const float y0 = origin.y + float(event.depth) * ROW_HEIGHT;
+			const float y1 = y0 + ROW_HEIGHT - 1.0f;
+
+			drawList->AddRectFilled(ImVec2(x0, y0), ImVec2(x1, y1), getScopeColor(event.name));
+			if (x1 - x0 >= MIN_WIDTH_FOR_TEXT)
+			{
+				drawList->PushClipRect(ImVec2(x0, y0), ImVec2(x1, y1), true);
+				drawList->AddText(ImVec2(x0 + 2.0f, y0 + 1.0f), IM_COL32(0, 0, 0, 255), event.name);
+				drawList->PopClipRect();
+			}
+
+			if (isHovered && mousePos.x >= x0 && mousePos.x < x1 && mousePos.y >= y0 && mousePos.y < y1)
+			{
+				ImGui::SetTooltip("%s\n%.3f ms", event.name, double(event.duration) / 1e6);
+			}
+		}
+
+		// Mark frame boundaries
+		for (const ProfilerFrame& frame : m_frames)
+		{
+			const float x = origin.x + float(double(frame.startTime - rangeStartTime) * pixelsPerNanosecond);
+			drawList->AddLine(ImVec2(x, origin.y), ImVec2(x, origin.y + height), IM_COL32(255, 255, 255, 160));
+		}
+
+		drawList->PopClipRect();
+	}
+
+} // namespace GUI
+} // namespace Pekan
\ No newline at end of file
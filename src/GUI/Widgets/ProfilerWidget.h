@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Widget.h"
+#include "Profiler.h"
+
+#include <string>
+#include <vector>
+
+namespace Pekan
+{
+namespace GUI
+{
+
+	// A widget showing the last N frames captured by the Profiler as a flame graph,
+	// with controls for enabling/disabling capture and exporting a Chrome trace.
+	//
+	// Frames are laid out from left to right, and nested scopes are stacked below their parents.
+	// Below the main thread's flame graph, a flame graph of each custom track (like the GPU) is shown over the same time range.
+	// Hovering a scope shows its name and duration.
+	//
+	// NOTE: Instances of this class MUST be owned by a ProfilerWidget_Ptr
+	class ProfilerWidget : public Widget
+	{
+	public:
+
+		void create(GUIWindow* guiWindow);
+		void create(GUIWindow* guiWindow, int framesCount, const char* traceFilepath);
+		void destroy();
+
+		int getFramesCount() const { return m_framesCount; }
+
+	private: /* functions */
+
+		void _render() const override;
+
+		// Renders a flame graph of given events, over the time range of the frames currently held by the widget
+		void renderFlameGraph(const char* id, const std::vector<ProfilerEvent>& events) const;
+
+	private: /* variables */
+
+		// Number of frames shown in the flame graph
+		int m_framesCount = 10;
+
+		// Filepath of the file where a Chrome trace is exported
+		std::string m_traceFilepath = "PekanTrace.json";
+
+		// Frames and events shown in the flame graph.
+		// Kept between frames to avoid reallocating them each frame.
+		mutable std::vector<ProfilerFrame> m_frames;
+		mutable std::vector<ProfilerEvent> m_events;
+		mutable std::vector<ProfilerEvent> m_trackEvents;
+	};
+
+	typedef std::shared_ptr<ProfilerWidget> ProfilerWidget_Ptr;
+	typedef std::shared_ptr<const ProfilerWidget> ProfilerWidget_ConstPtr;
+
+} // namespace GUI
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,584 @@
+#include "CommandList.h"
+
+#include "Shader.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Texture2D.h"
+#include "PekanLogger.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <type_traits>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// Alignment of each command inside of the arena, enough for any payload
+	constexpr size_t COMMAND_ALIGNMENT = 8;
+
+	// Header written in front of each command's payload
+	struct CommandHeader
+	{
+		CommandType type = CommandType::Draw;
+		// Size of the whole command, in bytes, including header, payload and any extra data after the payload
+		uint32_t size = 0;
+	};
+	static_assert(sizeof(CommandHeader) % COMMAND_ALIGNMENT == 0, "CommandHeader must keep payloads aligned.");
+
+	/////////////////////////////
+	// Payloads of all commands
+	/////////////////////////////
+
+	struct BindShaderCommand
+	{
+		Shader* shader = nullptr;
+	};
+
+	struct BindVertexArrayCommand
+	{
+		const VertexArray* vertexArray = nullptr;
+	};
+
+	struct BindIndexBufferCommand
+	{
+		const IndexBuffer* indexBuffer = nullptr;
+	};
+
+	struct BindTextureCommand
+	{
+		const Texture2D* texture = nullptr;
+		unsigned slot = 0;
+	};
+
+	// Uniform name's characters, including a null terminator, are stored right after the payload
+	template<typename ValueType>
+	struct SetUniformCommand
+	{
+		ValueType value;
+		uint32_t nameLength = 0;
+	};
+
+	// Buffer's data is stored right after the payload
+	struct SetBufferDataCommand
+	{
+		void* buffer = nullptr;
+		long long offset = 0;
+		long long size = 0;
+		BufferDataUsage dataUsage = BufferDataUsage::None;
+		IndexType indexType = IndexType::UnsignedInt;
+	};
+
+	struct DrawCommand
+	{
+		unsigned elementsCount = 0;
+		DrawMode mode = DrawMode::Triangles;
+	};
+
+	struct ClearCommand
+	{
+		bool doClearColorBuffer = true;
+		bool doClearDepthBuffer = false;
+	};
+
+	// Returns the name of a given command type, used when dumping commands
+	static const char* getCommandTypeName(CommandType type)
+	{
+		switch (type)
+		{
+			case CommandType::BindShader:                return "BindShader";
+			case CommandType::BindVertexArray:           return "BindVertexArray";
+			case CommandType::BindIndexBuffer:           return "BindIndexBuffer";
+			case CommandType::BindTexture:               return "BindTexture";
+			case CommandType::SetUniform1i:              return "SetUniform1i";
+			case CommandType::SetUniform1f:              return "SetUniform1f";
+			case CommandType::SetUniform4f:              return "SetUniform4f";
+			case CommandType::SetUniformMatrix4fv:       return "SetUniformMatrix4fv";
+			case CommandType::SetVertexBufferData:       return "SetVertexBufferData";
+			case CommandType::SetVertexBufferSubData:    return "SetVertexBufferSubData";
+			case CommandType::SetIndexBufferData:        return "SetIndexBufferData";
+			case CommandType::Draw:                      return "Draw";
+			case CommandType::DrawIndexed:               return "DrawIndexed";
+			case CommandType::Clear:                     return "Clear";
+		}
+		return "Unknown";
+	}
+
+	// Returns a pointer to the payload of a command with a given header
+	template<typename PayloadType>
+	static const PayloadType* getPayload(const CommandHeader* header)
+	{
+		return reinterpret_cast<const PayloadType*>(reinterpret_cast<const unsigned char*>(header) + sizeof(CommandHeader));
+	}
+
+	// Returns a pointer to the extra data stored after the payload of a command with a given header
+	template<typename PayloadType>
+	static const unsigned char* getExtraData(const CommandHeader* header)
+	{
+		return reinterpret_cast<const unsigned char*>(header) + sizeof(CommandHeader) + sizeof(PayloadType);
+	}
+
+	struct CommandList::ExecutionState
+	{
+		Shader* shader = nullptr;
+		const VertexArray* vertexArray = nullptr;
+		const IndexBuffer* indexBuffer = nullptr;
+	};
+
+	template<typename PayloadType>
+	PayloadType* CommandList::allocateCommand(CommandType type, size_t extraBytesCount)
+	{
+		static_assert(std::is_trivially_copyable_v<PayloadType>, "Command payloads must be trivially copyable.");
+
+		// Round command's size up to keep the next command aligned
+		const size_t unalignedSize = sizeof(CommandHeader) + sizeof(PayloadType) + extraBytesCount;
+		const size_t commandSize = (unalignedSize + COMMAND_ALIGNMENT - 1) / COMMAND_ALIGNMENT * COMMAND_ALIGNMENT;
+
+		const size_t offset = m_arena.size();
+		m_arena.resize(offset + commandSize);
+
+		CommandHeader* header = new (m_arena.data() + offset) CommandHeader();
+		header->type = type;
+		header->size = uint32_t(commandSize);
+		m_commandsCount++;
+
+		return new (m_arena.data() + offset + sizeof(CommandHeader)) PayloadType();
+	}
+
+	template<typename ValueType>
+	void CommandList::recordUniform(CommandType type, const char* uniformName, const ValueType& value)
+	{
+		if (m_isValidationEnabled)
+		{
+			if (uniformName == nullptr)
+			{
+				reportInvalidCommand("Trying to record setting a uniform with a null name.");
+				return;
+			}
+			if (!m_hasBoundShader)
+			{
+				reportInvalidCommand("Trying to record setting a uniform without a bound shader.");
+				return;
+			}
+		}
+
+		const uint32_t nameLength = uint32_t(std::strlen(uniformName));
+		SetUniformCommand<ValueType>* command = allocateCommand<SetUniformCommand<ValueType>>(type, nameLength + 1);
+		command->value = value;
+		command->nameLength = nameLength;
+		std::memcpy(reinterpret_cast<unsigned char*>(command) + sizeof(SetUniformCommand<ValueType>), uniformName, nameLength + 1);
+	}
+
+	template<typename BufferType>
+	void CommandList::recordBufferData(CommandType type, BufferType* buffer, const void* data, long long offset, long long size, BufferDataUsage dataUsage, IndexType indexType)
+	{
+		if (m_isValidationEnabled && (size < 0 || offset < 0 || (data == nullptr && size > 0)))
+		{
+			reportInvalidCommand("Trying to record a buffer update with invalid data.");
+			return;
+		}
+
+		SetBufferDataCommand* command = allocateCommand<SetBufferDataCommand>(type, size_t(size));
+		command->buffer = buffer;
+		command->offset = offset;
+		command->size = size;
+		command->dataUsage = dataUsage;
+		command->indexType = indexType;
+		if (size > 0 && data != nullptr)
+		{
+			std::memcpy(reinterpret_cast<unsigned char*>(command) + sizeof(SetBufferDataCommand), data, size_t(size));
+		}
+	}
+
+	void CommandList::bindShader(Shader& shader)
+	{
+		allocateCommand<BindShaderCommand>(CommandType::BindShader)->shader = &shader;
+		m_hasBoundShader = true;
+	}
+
+	void CommandList::bindVertexArray(const VertexArray& vertexArray)
+	{
+		allocateCommand<BindVertexArrayCommand>(CommandType::BindVertexArray)->vertexArray = &vertexArray;
+		m_hasBoundVertexArray = true;
+	}
+
+	void CommandList::bindIndexBuffer(const IndexBuffer& indexBuffer)
+	{
+		allocateCommand<BindIndexBufferCommand>(CommandType::BindIndexBuffer)->indexBuffer = &indexBuffer;
+		m_hasBoundIndexBuffer = true;
+	}
+
+	void CommandList::bindTexture(const Texture2D& texture, unsigned slot)
+	{
+		BindTextureCommand* command = allocateCommand<BindTextureCommand>(CommandType::BindTexture);
+		command->texture = &texture;
+		command->slot = slot;
+	}
+
+	void CommandList::setUniform1i(const char* uniformName, int value)
+	{
+		recordUniform(CommandType::SetUniform1i, uniformName, value);
+	}
+
+	void CommandList::setUniform1f(const char* uniformName, float value)
+	{
+		recordUniform(CommandType::SetUniform1f, uniformName, value);
+	}
+
+	void CommandList::setUniform4f(const char* uniformName, const glm::vec4& value)
+	{
+		recordUniform(CommandType::SetUniform4f, uniformName, value);
+	}
+
+	void CommandList::setUniformMatrix4fv(const char* uniformName, const glm::mat4& value)
+	{
+		recordUniform(CommandType::SetUniformMatrix4fv, uniformName, value);
+	}
+
+	void CommandList::setVertexBufferData(VertexBuffer& vertexBuffer, const void* data, long long size, BufferDataUsage dataUsage)
+	{
+		recordBufferData(CommandType::SetVertexBufferData, &vertexBuffer, data, 0, size, dataUsage, IndexType::UnsignedInt);
+	}
+
+	void CommandList::setVertexBufferSubData(VertexBuffer& vertexBuffer, const void* data, long long offset, long long size)
+	{
+		recordBufferData(CommandType::SetVertexBufferSubData, &vertexBuffer, data, offset, size, BufferDataUsage::None, IndexType::UnsignedInt);
+	}
+
+	void CommandList::setIndexBufferData(IndexBuffer& indexBuffer, const void* data, long long size, BufferDataUsage dataUsage, IndexType indexType)
+	{
+		recordBufferData(CommandType::SetIndexBufferData, &indexBuffer, data, 0, size, dataUsage, indexType);
+	}
+
+	void CommandList::draw(unsigned elementsCount, DrawMode mode)
+	{
+		if (m_isValidationEnabled && (!m_hasBoundShader || !m_hasBoundVertexArray))
+		{
+			reportInvalidCommand("Trying to record a draw without a bound shader and vertex array.");
+			return;
+		}
+
+		DrawCommand* command = allocateCommand<DrawCommand>(CommandType::Draw);
+		command->elementsCount = elementsCount;
+		command->mode = mode;
+	}
+
+	void CommandList::drawIndexed(unsigned elementsCount, DrawMode mode)
+	{
+		if (m_isValidationEnabled && (!m_hasBoundShader || !m_hasBoundVertexArray || !m_hasBoundIndexBuffer))
+		{
+			reportInvalidCommand("Trying to record an indexed draw without a bound shader, vertex array and index buffer.");
+			return;
+		}
+
+		DrawCommand* command = allocateCommand<DrawCommand>(CommandType::DrawIndexed);
+		command->elementsCount = elementsCount;
+		command->mode = mode;
+	}
+
+	void CommandList::clear(bool doClearColorBuffer, bool doClearDepthBuffer)
+	{
+		ClearCommand* command = allocateCommand<ClearCommand>(CommandType::Clear);
+		command->doClearColorBuffer = doClearColorBuffer;
+		command->doClearDepthBuffer = doClearDepthBuffer;
+	}
+
+	void CommandList::submit() const
+	{
+		ExecutionState state;
+		execute(state);
+	}
+
+	void CommandList::submitInOrder(const std::vector<const CommandList*>& commandLists)
+	{
+		// Share execution state between lists, since each list continues where the previous one left off
+		ExecutionState state;
+		for (const CommandList* commandList : commandLists)
+		{
+			PK_ASSERT(commandList != nullptr, "Trying to submit a null command list.", "Pekan");
+			commandList->execute(state);
+		}
+	}
+
+	void CommandList::execute(ExecutionState& state) const
+	{
+		size_t position = 0;
+		while (position < m_arena.size())
+		{
+			const CommandHeader* header = reinterpret_cast<const CommandHeader*>(m_arena.data() + position);
+			position += header->size;
+
+			switch (header->type)
+			{
+				case CommandType::BindShader:
+				{
+					Shader* shader = getPayload<BindShaderCommand>(header)->shader;
+					if (m_isValidationEnabled && !shader->isValid())
+					{
+						reportInvalidCommand("Trying to bind an invalid shader.");
+						break;
+					}
+					shader->bind();
+					state.shader = shader;
+					break;
+				}
+				case CommandType::BindVertexArray:
+				{
+					const VertexArray* vertexArray = getPayload<BindVertexArrayCommand>(header)->vertexArray;
+					if (m_isValidationEnabled && !vertexArray->isValid())
+					{
+						reportInvalidCommand("Trying to bind an invalid vertex array.");
+						break;
+					}
+					vertexArray->bind();
+					state.vertexArray = vertexArray;
+					break;
+				}
+				case CommandType::BindIndexBuffer:
+				{
+					const IndexBuffer* indexBuffer = getPayload<BindIndexBufferCommand>(header)->indexBuffer;
+					if (m_isValidationEnabled && !indexBuffer->isValid())
+					{
+						reportInvalidCommand("Trying to bind an invalid index buffer.");
+						break;
+					}
+					indexBuffer->bind();
+					state.indexBuffer = indexBuffer;
+					break;
+				}
+				case CommandType::BindTexture:
+				{
+					const BindTextureCommand* command = getPayload<BindTextureCommand>(header);
+					if (m_isValidationEnabled && !command->texture->isValid())
+					{
+						reportInvalidCommand("Trying to bind an invalid texture.");
+						break;
+					}
+					command->texture->bind(command->slot);
+					break;
+				}
+				case CommandType::SetUniform1i:
+				case CommandType::SetUniform1f:
+				case CommandType::SetUniform4f:
+				case CommandType::SetUniformMatrix4fv:
+				{
+					if (state.shader == nullptr)
+					{
+						reportInvalidCommand("Trying to set a uniform without a bound shader.");
+						break;
+					}
+					if (header->type == CommandType::SetUniform1i)
+					{
+						const char* name = reinterpret_cast<const char*>(getExtraData<SetUniformCommand<int>>(header));
+						state.shader->setUniform1i(name, getPayload<SetUniformCommand<int>>(header)->value);
+					}
+					else if (header->type == CommandType::SetUniform1f)
+					{
+						const char* name = reinterpret_cast<const char*>(getExtraData<SetUniformCommand<float>>(header));
+						state.shader->setUniform1f(name, getPayload<SetUniformCommand<float>>(header)->value);
+					}
+					else if (header->type == CommandType::SetUniform4f)
+					{
+						const char* name = reinterpret_cast<const char*>(getExtraData<SetUniformCommand<glm::vec4>>(header));
+						state.shader->setUniform4f(name, getPayload<SetUniformCommand<glm::vec4>>(header)->value);
+					}
+					else
+					{
+						const char* name = reinterpret_cast<const char*>(getExtraData<SetUniformCommand<glm::mat4>>(header));
+						state.shader->setUniformMatrix4fv(name, getPayload<SetUniformCommand<glm::mat4>>(header)->value);
+					}
+					break;
+				}
+				case CommandType::SetVertexBufferData:
+				case CommandType::SetVertexBufferSubData:
+				{
+					const SetBufferDataCommand* command = getPayload<SetBufferDataCommand>(header);
+					VertexBuffer* vertexBuffer = static_cast<VertexBuffer*>(command->buffer);
+					if (m_isValidationEnabled && !vertexBuffer->isValid())
+					{
+						reportInvalidCommand("Trying to update data of an invalid vertex buffer.");
+						break;
+					}
+					const unsigned char* data = getExtraData<SetBufferDataCommand>(header);
+					if (header->type == CommandType::SetVertexBufferData)
+					{
+						vertexBuffer->setData(data, command->size, command->dataUsage);
+					}
+					else
+					{
+						vertexBuffer->setSubData(data, command->offset, command->size);
+					}
+					break;
+				}
+				case CommandType::SetIndexBufferData:
+				{
+					const SetBufferDataCommand* command = getPayload<SetBufferDataCommand>(header);
+					IndexBuffer* indexBuffer = static_cast<IndexBuffer*>(command->buffer);
+					if (m_isValidationEnabled && !indexBuffer->isValid())
+					{
+						reportInvalidCommand("Trying to update data of an invalid index buffer.");
+						break;
+					}
+					indexBuffer->setData(getExtraData<SetBufferDataCommand>(header), command->size, command->dataUsage, command->indexType);
+					break;
+				}
+				case CommandType::Draw:
+				{
+					if (m_isValidationEnabled && (state.shader == nullptr || state.vertexArray == nullptr))
+					{
+						reportInvalidCommand("Trying to draw without a bound shader and vertex array.");
+						break;
+					}
+					const DrawCommand* command = getPayload<DrawCommand>(header);
+					RenderCommands::draw(command->elementsCount, command->mode);
+					break;
+				}
+				case CommandType::DrawIndexed:
+				{
+					if (m_isValidationEnabled && (state.shader == nullptr || state.vertexArray == nullptr || state.indexBuffer == nullptr))
+					{
+						reportInvalidCommand("Trying to draw indexed without a bound shader, vertex array and index buffer.");
+						break;
+					}
+					const DrawCommand* command = getPayload<DrawCommand>(header);
+					if (m_isValidationEnabled && command->elementsCount > unsigned(state.indexBuffer->getCount()))
+					{
+						reportInvalidCommand("Trying to draw more indices than the bound index buffer has.");
+						break;
+					}
+					// Index type is taken from the bound index buffer, so that it matches buffer's data
+					const IndexType indexType = (state.indexBuffer != nullptr) ? state.indexBuffer->getIndexType() : IndexType::UnsignedInt;
+					RenderCommands::drawIndexed(command->elementsCount, command->mode, indexType);
+					break;
+				}
+				case CommandType::Clear:
+				{
+					const ClearCommand* command = getPayload<ClearCommand>(header);
+					RenderCommands::clear(command->doClearColorBuffer, command->doClearDepthBuffer);
+					break;
+				}
+			}
+		}
+	}
+
+	void CommandList::reset()
+	{
+		m_arena.clear();
+		m_commandsCount = 0;
+		m_hasBoundShader = false;
+		m_hasBoundVertexArray = false;
+		m_hasBoundIndexBuffer = false;
+	}
+
+	std::string CommandList::dump() const
+	{
+		std::ostringstream stream;
+		int commandIndex = 0;
+		size_t position = 0;
+		while (position < m_arena.size())
+		{
+			const CommandHeader* header = reinterpret_cast<const CommandHeader*>(m_arena.data() + position);
+			position += header->size;
+
+			stream << "#" << commandIndex++ << " " << getCommandTypeName(header->type);
+			switch (header->type)
+			{
+				case CommandType::BindShader:
+					stream << " shader=" << getPayload<BindShaderCommand>(header)->shader;
+					break;
+				case CommandType::BindVertexArray:
+					stream << " vertexArray=" << getPayload<BindVertexArrayCommand>(header)->vertexArray;
+					break;
+				case CommandType::BindIndexBuffer:
+					stream << " indexBuffer=" << getPayload<BindIndexBufferCommand>(header)->indexBuffer;
+					break;
+				case CommandType::BindTexture:
+					stream << " texture=" << getPayload<BindTextureCommand>(header)->texture
+						<< " slot=" << getPayload<BindTextureCommand>(header)->slot;
+					break;
+				case CommandType::SetUniform1i:
+					stream << " name=" << reinterpret_cast<const char*>(getExtraData<SetUniformCommand<int>>(header))
+						<< " value=" << getPayload<SetUniformCommand<int>>(header)->value;
+					break;
+				case CommandType::SetUniform1f:
+					stream << " name=" << reinterpret_cast<const char*>(getExtraData<SetUniformCommand<float>>(header))
+						<< " value=" << getPayload<SetUniformCommand<float>>(header)->value;
+					break;
+				case CommandType::SetUniform4f:
+				{
+					const glm::vec4& value = getPayload<SetUniformCommand<glm::vec4>>(header)->value;
+					stream << " name=" << reinterpret_cast<const char*>(getExtraData<SetUniformCommand<glm::vec4>>(header))
+						<< " value=(" << value.x << ", " << value.y << ", " << value.z << ", " << value.w << ")";
+					break;
+				}
+				case CommandType::SetUniformMatrix4fv:
+				{
+					const glm::mat4& value = getPayload<SetUniformCommand<glm::mat4>>(header)->value;
+					stream << " name=" << reinterpret_cast<const char*>(getExtraData<SetUniformCommand<glm::mat4>>(header)) << " value=(";
+					for (int column = 0; column < 4; column++)
+					{
+						stream << (column > 0 ? ", " : "") << "(" << value[column].x << ", " << value[column].y << ", " << value[column].z << ", " << value[column].w << ")";
+					}
+					stream << ")";
+					break;
+				}
+				case CommandType::SetVertexBufferData:
+				case CommandType::SetVertexBufferSubData:
+				case CommandType::SetIndexBufferData:
+				{
+					const SetBufferDataCommand* command = getPayload<SetBufferDataCommand>(header);
+					stream << " buffer=" << command->buffer << " offset=" << command->offset << " size=" << command->size;
+					break;
+				}
+				case CommandType::Draw:
+				case CommandType::DrawIndexed:
+				{
+					const DrawCommand* command = getPayload<DrawCommand>(header);
+					stream << " elementsCount=" << command->elementsCount << " mode=" << int(command->mode);
+					break;
+				}
+				case CommandType::Clear:
+				{
+					const ClearCommand* command = getPayload<ClearCommand>(header);
+					stream << " color=" << command->doClearColorBuffer << " depth=" << command->doClearDepthBuffer;
+					break;
+				}
+			}
+			stream << "\n";
+		}
+		return stream.str();
+	}
+
+	bool CommandList::saveDump(const char* filepath) const
+	{
+		if (filepath == nullptr)
+		{
+			PK_LOG_ERROR("Trying to save a command list dump to a null filepath.", "Pekan");
+			return false;
+		}
+		std::ofstream file(filepath);
+		if (!file.is_open())
+		{
+			PK_LOG_ERROR("Failed to open file " << filepath << " for saving a command list dump.", "Pekan");
+			return false;
+		}
+		file << dump();
+		file.close();
+		if (!file.good())
+		{
+			PK_LOG_ERROR("Failed to write command list dump to file " << filepath, "Pekan");
+			return false;
+		}
+		return true;
+	}
+
+	void CommandList::reportInvalidCommand(const char* message) const
+	{
+		PK_LOG_ERROR("Invalid command in CommandList: " << message, "Pekan");
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "RenderCommands.h"
+#include "RenderState.h"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	class Shader;
+	class VertexArray;
+	class VertexBuffer;
+	class IndexBuffer;
+	class Texture2D;
+
+	// Enum for types of commands that can be recorded into a command list
+	enum class CommandType : uint16_t
+	{
+		BindShader,
+		BindVertexArray,
+		BindIndexBuffer,
+		BindTexture,
+		SetUniform1i,
+		SetUniform1f,
+		SetUniform4f,
+		SetUniformMatrix4fv,
+		SetVertexBufferData,
+		SetVertexBufferSubData,
+		SetIndexBufferData,
+		Draw,
+		DrawIndexed,
+		Clear
+	};
+
+	// A list of render commands, recorded now and executed later.
+	//
+	// Recording a command doesn't touch the GPU at all. It only writes the command, together with any data it needs
+	// (uniform names, buffer data), into a linear memory arena owned by the list.
+	// This means that command lists can be recorded on any thread, including multiple worker threads in parallel,
+	// as long as each list is recorded by a single thread at a time.
+	// Recorded lists are then submitted on the thread owning the graphics context, with submit() or submitInOrder().
+	//
+	// GPU resources referenced by recorded commands must stay alive until the list is submitted.
+	//
+	// A command list can be dumped as human-readable text with dump(), which can be used for capturing a frame
+	// and inspecting it offline.
+	class CommandList
+	{
+	public:
+
+		// Records binding a shader. Uniform commands recorded after this one set uniforms in this shader.
+		void bindShader(Shader& shader);
+		// Records binding a vertex array
+		void bindVertexArray(const VertexArray& vertexArray);
+		// Records binding an index buffer. Index type of draws recorded after this one is taken from this index buffer.
+		// NOTE: The index buffer binding is part of the vertex array's state, so binding a vertex array replaces it.
+		//       Record this after bindVertexArray(), otherwise it has no effect on the draws.
+		void bindIndexBuffer(const IndexBuffer& indexBuffer);
+		// Records binding a texture to a given slot
+		void bindTexture(const Texture2D& texture, unsigned slot);
+
+		// Record setting a uniform in the currently bound shader.
+		// Uniform name is copied, so it doesn't need to outlive the call.
+		void setUniform1i(const char* uniformName, int value);
+		void setUniform1f(const char* uniformName, float value);
+		void setUniform4f(const char* uniformName, const glm::vec4& value);
+		void setUniformMatrix4fv(const char* uniformName, const glm::mat4& value);
+
+		// Record updating data of a buffer.
+		// Data is copied into the command list, so it doesn't need to outlive the call.
+		void setVertexBufferData(VertexBuffer& vertexBuffer, const void* data, long long size, BufferDataUsage dataUsage);
+		void setVertexBufferSubData(VertexBuffer& vertexBuffer, const void* data, long long offset, long long size);
+		void setIndexBufferData(IndexBuffer& indexBuffer, const void* data, long long size, BufferDataUsage dataUsage, IndexType indexType = IndexType::UnsignedInt);
+
+		// Record draw calls. Same as RenderCommands::draw() and RenderCommands::drawIndexed().
+		void draw(unsigned elementsCount, DrawMode mode = DrawMode::Triangles);
+		void drawIndexed(unsigned elementsCount, DrawMode mode = DrawMode::Triangles);
+
+		// Records clearing the currently bound frame buffer. Same as RenderCommands::clear().
+		void clear(bool doClearColorBuffer = true, bool doClearDepthBuffer = false);
+
+		// Executes all recorded commands in order. Must be called on the thread owning the graphics context.
+		// Recorded commands are kept, so a list can be submitted multiple times.
+		void submit() const;
+
+		// Submits a given sequence of command lists in order, one after another.
+		// Lists may have been recorded in parallel, but they are always executed in the given order.
+		static void submitInOrder(const std::vector<const CommandList*>& commandLists);
+
+		// Clears all recorded commands, keeping allocated memory for the next recording
+		void reset();
+
+		// Enables/disables validation mode.
+		// In validation mode, commands are checked for common mistakes both when recorded and when submitted,
+		// like drawing without a bound shader or vertex array, setting a uniform without a bound shader,
+		// or referencing a GPU resource that is not valid anymore. Invalid commands are reported and skipped.
+		void setValidationEnabled(bool enabled) { m_isValidationEnabled = enabled; }
+		bool isValidationEnabled() const { return m_isValidationEnabled; }
+
+		// Returns a human-readable description of all recorded commands, one command per line
+		std::string dump() const;
+		// Writes a human-readable description of all recorded commands to a text file.
+		// Returns true on success.
+		bool saveDump(const char* filepath) const;
+
+		// Returns the number of recorded commands
+		int getCommandsCount() const { return m_commandsCount; }
+		// Returns the number of bytes of the arena currently used by recorded commands
+		size_t getUsedMemory() const { return m_arena.size(); }
+
+		// Checks if list has no recorded commands
+		bool isEmpty() const { return m_commandsCount == 0; }
+
+	private: /* functions */
+
+		// State of the graphics pipeline tracked while executing commands
+		struct ExecutionState;
+
+		// Executes all recorded commands in order, using and updating a given execution state
+		void execute(ExecutionState& state) const;
+
+		// Allocates a command of a given type in the arena, with a given number of extra bytes after it,
+		// and returns a pointer to command's payload. Pointer is valid only until the next allocation.
+		template<typename PayloadType>
+		PayloadType* allocateCommand(CommandType type, size_t extraBytesCount = 0);
+
+		// Records a uniform command with a given value
+		template<typename ValueType>
+		void recordUniform(CommandType type, const char* uniformName, const ValueType& value);
+
+		// Records a buffer data command, copying given data after the command
+		template<typename BufferType>
+		void recordBufferData(CommandType type, BufferType* buffer, const void* data, long long offset, long long size, BufferDataUsage dataUsage, IndexType indexType);
+
+		// Reports an invalid command in validation mode
+		void reportInvalidCommand(const char* message) const;
+
+	private: /* variables */
+
+		// Linear memory arena containing all recorded commands, one after another
+		std::vector<unsigned char> m_arena;
+
+		// Number of recorded commands
+		int m_commandsCount = 0;
+
+		// State tracked while recording, used in validation mode
+		bool m_hasBoundShader = false;
+		bool m_hasBoundVertexArray = false;
+		bool m_hasBoundIndexBuffer = false;
+
+		// Flag indicating if validation mode is enabled
+		bool m_isValidationEnabled = false;
+	};
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
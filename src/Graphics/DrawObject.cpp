@@ -84,7 +84,7 @@ namespace Graphics
 		if (m_indexBuffer.hasData())
 		{
 			const unsigned indicesCount = unsigned(m_indexBuffer.getCount());
-			RenderCommands::drawIndexed(indicesCount, mode);
+			RenderCommands::drawIndexed(indicesCount, mode, m_indexBuffer.getIndexType());
 		}
 		else
 		{
@@ -93,6 +93,22 @@ namespace Graphics
 		}
 	}
 
+	void DrawObject::render(DrawMode mode, unsigned elementsCount) const
+	{
+		bind();
+
+		if (m_indexBuffer.hasData())
+		{
+			PK_ASSERT(elementsCount <= unsigned(m_indexBuffer.getCount()), "Trying to render more indices than a DrawObject has.", "Pekan");
+			RenderCommands::drawIndexed(elementsCount, mode, m_indexBuffer.getIndexType());
+		}
+		else
+		{
+			PK_ASSERT(elementsCount <= unsigned(m_vertexBuffer.getSize()) / m_vertexBufferLayout.getVertexSize(), "Trying to render more vertices than a DrawObject has.", "Pekan");
+			RenderCommands::draw(elementsCount, mode);
+		}
+	}
+
 	void DrawObject::setVertexData(const void* data, long long size)
 	{
 		PK_ASSERT(isValid(), "Trying to set vertex data to a DrawObject that is not yet created.", "Pekan");
@@ -145,6 +161,15 @@ namespace Graphics
 		m_indexDataUsage = dataUsage;
 	}
 
+	void DrawObject::setIndices(const unsigned* indices, long long indicesCount, BufferDataUsage dataUsage)
+	{
+		PK_ASSERT(isValid(), "Trying to set indices to a DrawObject that is not yet created.", "Pekan");
+
+		m_vertexArray.bind();
+		m_indexBuffer.setIndices(indices, indicesCount, dataUsage);
+		m_indexDataUsage = dataUsage;
+	}
+
 	void DrawObject::setIndexSubData(const void* data, long long offset, long long size)
 	{
 		PK_ASSERT(isValid(), "Trying to set index subdata to a DrawObject that is not yet created.", "Pekan");
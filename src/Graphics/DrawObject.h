@@ -47,6 +47,9 @@ namespace Graphics
 
 		// Renders the object
 		void render(DrawMode mode = DrawMode::Triangles) const;
+		// Renders only the first given number of elements of the object.
+		// Elements are indices if the object has index data, or vertices otherwise.
+		void render(DrawMode mode, unsigned elementsCount) const;
 
 		// Sets new vertex data to the draw object (old data usage will be used)
 		void setVertexData(const void* data, long long size);
@@ -61,6 +64,9 @@ namespace Graphics
 		void setIndexData(const void* data, long long size, BufferDataUsage dataUsage);
 		// Fills a region of draw object's index data with given data. Previous data in this region is overwritten.
 		void setIndexSubData(const void* data, long long offset, long long size);
+		// Sets new 32-bit indices, with a new data usage, to the draw object.
+		// Indices are stored as 16-bit indices if they all fit, which is handled automatically when rendering.
+		void setIndices(const unsigned* indices, long long indicesCount, BufferDataUsage dataUsage);
 
 		// Sets new source code to be used for draw object's shader
 		void setShaderSource(const char* vertexShaderSource, const char* fragmentShaderSource);
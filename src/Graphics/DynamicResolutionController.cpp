@@ -0,0 +1,65 @@
+#include "DynamicResolutionController.h"
+
+#include "PekanLogger.h"
+
+#include <algorithm>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	void DynamicResolutionController::setProperties(const DynamicResolutionProperties& properties)
+	{
+		PK_ASSERT(properties.minResolutionScale > 0.0f && properties.minResolutionScale <= properties.maxResolutionScale && properties.maxResolutionScale <= 1.0f,
+			"Invalid dynamic resolution properties. Resolution scale bounds must satisfy 0 < min <= max <= 1.", "Pekan");
+		PK_ASSERT(properties.scaleUpThreshold < properties.scaleDownThreshold,
+			"Invalid dynamic resolution properties. Scale up threshold must be lower than scale down threshold.", "Pekan");
+		PK_ASSERT(properties.smoothingFactor > 0.0 && properties.smoothingFactor <= 1.0,
+			"Invalid dynamic resolution properties. Smoothing factor must be in range (0, 1].", "Pekan");
+
+		m_properties = properties;
+		m_resolutionScale = properties.maxResolutionScale;
+		m_smoothedFrameTime = -1.0;
+		m_framesSinceChange = 0;
+	}
+
+	bool DynamicResolutionController::update(double frameTime)
+	{
+		// Smooth frame time with an exponential moving average
+		if (m_smoothedFrameTime < 0.0)
+		{
+			m_smoothedFrameTime = frameTime;
+		}
+		else
+		{
+			m_smoothedFrameTime += (frameTime - m_smoothedFrameTime) * m_properties.smoothingFactor;
+		}
+
+		m_framesSinceChange++;
+		if (m_framesSinceChange < m_properties.framesBetweenChanges)
+		{
+			return false;
+		}
+
+		float newResolutionScale = m_resolutionScale;
+		if (m_smoothedFrameTime > m_properties.targetFrameTime * m_properties.scaleDownThreshold)
+		{
+			newResolutionScale = std::max(m_resolutionScale - m_properties.resolutionScaleStep, m_properties.minResolutionScale);
+		}
+		else if (m_smoothedFrameTime < m_properties.targetFrameTime * m_properties.scaleUpThreshold)
+		{
+			newResolutionScale = std::min(m_resolutionScale + m_properties.resolutionScaleStep, m_properties.maxResolutionScale);
+		}
+
+		if (newResolutionScale == m_resolutionScale)
+		{
+			return false;
+		}
+		m_resolutionScale = newResolutionScale;
+		m_framesSinceChange = 0;
+		return true;
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
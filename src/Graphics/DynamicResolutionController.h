@@ -0,0 +1,44 @@
+#pragma once
+
+#include "PekanApplication.h"
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// A class deciding on resolution scale for dynamic resolution scaling, based on measured frame times.
+	//
+	// Frame times are smoothed with an exponential moving average, so that single spikes are ignored,
+	// and compared against a target frame time with two separate thresholds for lowering and raising resolution,
+	// so that resolution doesn't oscillate when frame time is close to the target.
+	class DynamicResolutionController
+	{
+	public:
+
+		// Sets properties of dynamic resolution scaling and resets resolution scale to its maximum
+		void setProperties(const DynamicResolutionProperties& properties);
+
+		// Feeds time of the last frame, in seconds.
+		// Returns true if resolution scale changed.
+		bool update(double frameTime);
+
+		float getResolutionScale() const { return m_resolutionScale; }
+
+		// Returns smoothed frame time, in seconds, or -1 if no frame time has been fed yet
+		double getSmoothedFrameTime() const { return m_smoothedFrameTime; }
+
+	private: /* variables */
+
+		DynamicResolutionProperties m_properties;
+
+		float m_resolutionScale = 1.0f;
+
+		double m_smoothedFrameTime = -1.0;
+
+		// Number of frames since the last change of resolution scale
+		int m_framesSinceChange = 0;
+	};
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
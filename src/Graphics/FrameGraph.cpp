@@ -0,0 +1,317 @@
+#include "FrameGraph.h"
+
+#include "FrameBuffer.h"
+#include "RenderState.h"
+#include "PekanLogger.h"
+#include "Profiler.h"
+
+#include <sstream>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	void FrameGraphBuilder::read(RenderTargetHandle renderTarget)
+	{
+		PK_ASSERT(renderTarget.index >= 0 && renderTarget.index < int(m_frameGraph.m_renderTargets.size()), "Trying to read an invalid render target in a FrameGraph pass.", "Pekan");
+
+		m_frameGraph.m_passes[m_passIndex].reads.push_back(renderTarget.index);
+	}
+
+	void FrameGraphBuilder::write(RenderTargetHandle renderTarget)
+	{
+		PK_ASSERT(renderTarget.index >= 0 && renderTarget.index < int(m_frameGraph.m_renderTargets.size()), "Trying to write an invalid render target in a FrameGraph pass.", "Pekan");
+
+		m_frameGraph.m_passes[m_passIndex].writes.push_back(renderTarget.index);
+		m_frameGraph.m_renderTargets[renderTarget.index].writerPasses.push_back(m_passIndex);
+	}
+
+	void FrameGraphBuilder::setHasSideEffects()
+	{
+		m_frameGraph.m_passes[m_passIndex].hasSideEffects = true;
+	}
+
+	RenderTargetHandle FrameGraph::createRenderTarget(const char* name, const RenderTargetDescription& description)
+	{
+		PK_ASSERT(description.width > 0 && description.height > 0, "Trying to create a render target with an invalid size in a FrameGraph.", "Pekan");
+
+		RenderTarget renderTarget;
+		renderTarget.name = name;
+		renderTarget.description = description;
+		m_renderTargets.push_back(std::move(renderTarget));
+		m_isCompiled = false;
+		return { int(m_renderTargets.size()) - 1 };
+	}
+
+	RenderTargetHandle FrameGraph::importRenderTarget(const char* name, FrameBuffer* frameBuffer, const RenderTargetDescription& description)
+	{
+		RenderTarget renderTarget;
+		renderTarget.name = name;
+		renderTarget.description = description;
+		renderTarget.isImported = true;
+		renderTarget.frameBuffer = frameBuffer;
+		m_renderTargets.push_back(std::move(renderTarget));
+		m_isCompiled = false;
+		return { int(m_renderTargets.size()) - 1 };
+	}
+
+	void FrameGraph::setImportedFrameBuffer(RenderTargetHandle renderTarget, FrameBuffer* frameBuffer)
+	{
+		PK_ASSERT(renderTarget.index >= 0 && renderTarget.index < int(m_renderTargets.size()), "Trying to set frame buffer of an invalid render target in a FrameGraph.", "Pekan");
+		PK_ASSERT(m_renderTargets[renderTarget.index].isImported, "Trying to set frame buffer of a transient render target in a FrameGraph.", "Pekan");
+
+		m_renderTargets[renderTarget.index].frameBuffer = frameBuffer;
+	}
+
+	void FrameGraph::addPass(const char* name, const FrameGraphSetupCallback& setupCallback, const FrameGraphExecuteCallback& executeCallback)
+	{
+		Pass pass;
+		pass.name = name;
+		pass.executeCallback = executeCallback;
+		m_passes.push_back(std::move(pass));
+		m_isCompiled = false;
+
+		FrameGraphBuilder builder(*this, int(m_passes.size()) - 1);
+		setupCallback(builder);
+	}
+
+	void FrameGraph::compile()
+	{
+		// Count references.
+		// A pass is referenced by each render target it writes, a render target is referenced by each pass reading it.
+		// Imported render targets are used outside of the frame graph, so they get an extra reference that is never removed.
+		for (RenderTarget& renderTarget : m_renderTargets)
+		{
+			renderTarget.referencesCount = renderTarget.isImported ? 1 : 0;
+			renderTarget.firstPassIndex = -1;
+			renderTarget.lastPassIndex = -1;
+		}
+		for (Pass& pass : m_passes)
+		{
+			pass.referencesCount = int(pass.writes.size());
+			pass.isCulled = false;
+			for (int renderTargetIndex : pass.reads)
+			{
+				m_renderTargets[renderTargetIndex].referencesCount++;
+			}
+		}
+
+		// Cull passes, starting from render targets that are never read,
+		// and walking back through passes that write them and render targets that those passes read.
+		std::vector<int> unreferencedRenderTargets;
+		for (int i = 0; i < int(m_renderTargets.size()); i++)
+		{
+			if (m_renderTargets[i].referencesCount == 0)
+			{
+				unreferencedRenderTargets.push_back(i);
+			}
+		}
+		// Culls a given pass and removes its references to render targets it reads
+		const auto cullPass = [this, &unreferencedRenderTargets](Pass& pass)
+		{
+			pass.isCulled = true;
+			for (int renderTargetIndex : pass.reads)
+			{
+				RenderTarget& renderTarget = m_renderTargets[renderTargetIndex];
+				renderTarget.referencesCount--;
+				if (renderTarget.referencesCount == 0)
+				{
+					unreferencedRenderTargets.push_back(renderTargetIndex);
+				}
+			}
+		};
+		// Passes that don't write anything are useless, unless they have side effects
+		for (Pass& pass : m_passes)
+		{
+			if (pass.referencesCount == 0 && !pass.hasSideEffects)
+			{
+				cullPass(pass);
+			}
+		}
+		while (!unreferencedRenderTargets.empty())
+		{
+			const int renderTargetIndex = unreferencedRenderTargets.back();
+			unreferencedRenderTargets.pop_back();
+			for (int passIndex : m_renderTargets[renderTargetIndex].writerPasses)
+			{
+				Pass& pass = m_passes[passIndex];
+				if (pass.isCulled || pass.hasSideEffects)
+				{
+					continue;
+				}
+				pass.referencesCount--;
+				if (pass.referencesCount == 0)
+				{
+					cullPass(pass);
+				}
+			}
+		}
+
+		// Compute lifetimes of render targets, as the range of not culled passes using them
+		for (int passIndex = 0; passIndex < int(m_passes.size()); passIndex++)
+		{
+			const Pass& pass = m_passes[passIndex];
+			if (pass.isCulled)
+			{
+				continue;
+			}
+			for (const std::vector<int>* renderTargetIndices : { &pass.reads, &pass.writes })
+			{
+				for (int renderTargetIndex : *renderTargetIndices)
+				{
+					RenderTarget& renderTarget = m_renderTargets[renderTargetIndex];
+					if (renderTarget.firstPassIndex < 0)
+					{
+						renderTarget.firstPassIndex = passIndex;
+					}
+					renderTarget.lastPassIndex = passIndex;
+				}
+			}
+		}
+
+		m_isCompiled = true;
+	}
+
+	void FrameGraph::execute(RenderTargetPool& renderTargetPool)
+	{
+		PK_PROFILE_FUNCTION();
+
+		if (!m_isCompiled)
+		{
+			compile();
+		}
+
+		for (int passIndex = 0; passIndex < int(m_passes.size()); passIndex++)
+		{
+			const Pass& pass = m_passes[passIndex];
+			if (pass.isCulled)
+			{
+				continue;
+			}
+
+			// Acquire transient render targets whose lifetime begins with this pass
+			for (RenderTarget& renderTarget : m_renderTargets)
+			{
+				if (!renderTarget.isImported && renderTarget.firstPassIndex == passIndex)
+				{
+					renderTarget.frameBuffer = renderTargetPool.acquire(renderTarget.description);
+				}
+			}
+
+			// Bind the first render target written by the pass
+			if (!pass.writes.empty())
+			{
+				const RenderTarget& renderTarget = m_renderTargets[pass.writes[0]];
+				if (renderTarget.frameBuffer != nullptr)
+				{
+					renderTarget.frameBuffer->bind();
+				}
+				else
+				{
+					FrameBuffer::bindDefault();
+				}
+				RenderState::setViewport(0, 0, renderTarget.description.width, renderTarget.description.height);
+			}
+
+			pass.executeCallback(*this);
+
+			// Release transient render targets whose lifetime ends with this pass,
+			// so that following passes can alias them
+			for (RenderTarget& renderTarget : m_renderTargets)
+			{
+				if (!renderTarget.isImported && renderTarget.lastPassIndex == passIndex)
+				{
+					renderTargetPool.release(renderTarget.frameBuffer);
+					renderTarget.frameBuffer = nullptr;
+				}
+			}
+		}
+	}
+
+	void FrameGraph::clear()
+	{
+		m_renderTargets.clear();
+		m_passes.clear();
+		m_isCompiled = false;
+	}
+
+	const FrameBuffer* FrameGraph::getFrameBuffer(RenderTargetHandle renderTarget) const
+	{
+		PK_ASSERT(renderTarget.index >= 0 && renderTarget.index < int(m_renderTargets.size()), "Trying to get frame buffer of an invalid render target from a FrameGraph.", "Pekan");
+		PK_ASSERT(m_renderTargets[renderTarget.index].isImported || m_renderTargets[renderTarget.index].frameBuffer != nullptr,
+			"Trying to get frame buffer of a transient render target outside of its lifetime.", "Pekan");
+
+		return m_renderTargets[renderTarget.index].frameBuffer;
+	}
+
+	void FrameGraph::bindTexture(RenderTargetHandle renderTarget, unsigned slot) const
+	{
+		const FrameBuffer* frameBuffer = getFrameBuffer(renderTarget);
+		if (frameBuffer == nullptr)
+		{
+			PK_LOG_ERROR("Trying to bind texture of the default frame buffer in a FrameGraph. It can't be sampled.", "Pekan");
+			return;
+		}
+		frameBuffer->bindTexture(slot);
+	}
+
+	const RenderTargetDescription& FrameGraph::getDescription(RenderTargetHandle renderTarget) const
+	{
+		PK_ASSERT(renderTarget.index >= 0 && renderTarget.index < int(m_renderTargets.size()), "Trying to get description of an invalid render target from a FrameGraph.", "Pekan");
+
+		return m_renderTargets[renderTarget.index].description;
+	}
+
+	int FrameGraph::getCulledPassesCount() const
+	{
+		int culledPassesCount = 0;
+		for (const Pass& pass : m_passes)
+		{
+			if (pass.isCulled)
+			{
+				culledPassesCount++;
+			}
+		}
+		return culledPassesCount;
+	}
+
+	std::string FrameGraph::dump() const
+	{
+		std::ostringstream stream;
+		for (int i = 0; i < int(m_passes.size()); i++)
+		{
+			const Pass& pass = m_passes[i];
+			stream << "Pass #" << i << " " << pass.name << (pass.isCulled ? " (culled)" : "");
+			stream << " reads:";
+			for (int renderTargetIndex : pass.reads)
+			{
+				stream << " " << m_renderTargets[renderTargetIndex].name;
+			}
+			stream << " writes:";
+			for (int renderTargetIndex : pass.writes)
+			{
+				stream << " " << m_renderTargets[renderTargetIndex].name;
+			}
+			stream << "\n";
+		}
+		for (const RenderTarget& renderTarget : m_renderTargets)
+		{
+			const RenderTargetDescription& description = renderTarget.description;
+			stream << "Render target " << renderTarget.name << " " << description.width << "x" << description.height
+				<< " samples=" << description.samplesPerPixel << (renderTarget.isImported ? " (imported)" : "");
+			if (renderTarget.firstPassIndex >= 0)
+			{
+				stream << " lifetime=[" << renderTarget.firstPassIndex << ", " << renderTarget.lastPassIndex << "]";
+			}
+			else
+			{
+				stream << " unused";
+			}
+			stream << "\n";
+		}
+		return stream.str();
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
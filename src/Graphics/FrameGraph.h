@@ -0,0 +1,178 @@
+#pragma once
+
+#include "RenderTargetPool.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	class FrameBuffer;
+	class FrameGraph;
+
+	// A handle to a render target of a frame graph.
+	// Valid only inside of the frame graph that created it, until the frame graph is cleared.
+	struct RenderTargetHandle
+	{
+		int index = -1;
+
+		bool isValid() const { return index >= 0; }
+	};
+
+	// An object given to the setup callback of a pass,
+	// used for declaring render targets that the pass reads from and writes to.
+	class FrameGraphBuilder
+	{
+		friend class FrameGraph;
+
+	public:
+
+		// Declares that the pass reads from a given render target
+		void read(RenderTargetHandle renderTarget);
+		// Declares that the pass writes to a given render target.
+		// The first render target that a pass writes to is bound, with a viewport covering it, before the pass is executed.
+		void write(RenderTargetHandle renderTarget);
+
+		// Marks the pass as having effects outside of the frame graph, so that it's never culled
+		void setHasSideEffects();
+
+	private: /* functions */
+
+		FrameGraphBuilder(FrameGraph& frameGraph, int passIndex) : m_frameGraph(frameGraph), m_passIndex(passIndex) {}
+
+	private: /* variables */
+
+		FrameGraph& m_frameGraph;
+
+		// Index of the pass being set up
+		int m_passIndex = -1;
+	};
+
+	// Type definitions for callbacks of a frame graph pass.
+	// Setup callback is called immediately when the pass is added, and declares what the pass reads and writes.
+	// Execute callback is called when the frame graph is executed, and does the actual rendering.
+	typedef std::function<void(FrameGraphBuilder&)> FrameGraphSetupCallback;
+	typedef std::function<void(const FrameGraph&)> FrameGraphExecuteCallback;
+
+	// A class describing how a frame is composed, as a graph of passes and render targets.
+	//
+	// Each pass declares the render targets it reads from and writes to, and the frame graph uses that to:
+	//   - cull passes whose results are never used.
+	//     Results are used if they end up in an imported render target, or if they are read by a pass that is not culled.
+	//   - allocate transient render targets from a RenderTargetPool only for as long as they are needed,
+	//     so that render targets with non-overlapping lifetimes alias the same frame buffer.
+	//
+	// Render targets living outside of the frame graph, like the screen, are imported into it.
+	//
+	// Usage:
+	//   1. Create transient render targets with createRenderTarget() and import external ones with importRenderTarget()
+	//   2. Add passes with addPass(), in order of execution
+	//   3. Call compile() and then execute()
+	// A compiled frame graph can be executed again in following frames, as long as its structure doesn't change.
+	// Frame buffers of imported render targets can be changed between executions with setImportedFrameBuffer().
+	// Call clear() before recording a frame graph of a different structure.
+	class FrameGraph
+	{
+		friend class FrameGraphBuilder;
+
+	public:
+
+		// Creates a transient render target with a given description.
+		// Transient render targets are acquired from a pool right before the first pass using them, and released right after the last one,
+		// so render targets whose passes don't overlap share the same frame buffer.
+		// NOTE: A transient render target has undefined contents before it's first written to.
+		RenderTargetHandle createRenderTarget(const char* name, const RenderTargetDescription& description);
+
+		// Imports a render target living outside of the frame graph.
+		// Pass a null pointer as frame buffer to import the default frame buffer.
+		// Description is used only for its size, so that passes writing to the render target get a correct viewport.
+		RenderTargetHandle importRenderTarget(const char* name, FrameBuffer* frameBuffer, const RenderTargetDescription& description);
+		// Sets the frame buffer of a given imported render target, without recompiling the frame graph.
+		// Pass a null pointer as frame buffer to use the default frame buffer.
+		void setImportedFrameBuffer(RenderTargetHandle renderTarget, FrameBuffer* frameBuffer);
+
+		// Adds a pass with given setup and execute callbacks. Setup callback is called immediately.
+		void addPass(const char* name, const FrameGraphSetupCallback& setupCallback, const FrameGraphExecuteCallback& executeCallback);
+
+		// Culls unused passes and computes lifetimes of transient render targets
+		void compile();
+
+		// Executes all passes that are not culled, in the order in which they were added,
+		// acquiring transient render targets from a given pool and releasing them back to it.
+		// Compiles the frame graph first, if not yet compiled.
+		void execute(RenderTargetPool& renderTargetPool);
+
+		// Removes all passes and render targets
+		void clear();
+
+		// Returns the frame buffer of a given render target, to be used by passes while the frame graph is executed.
+		// Returns a null pointer for the default frame buffer.
+		const FrameBuffer* getFrameBuffer(RenderTargetHandle renderTarget) const;
+
+		// Binds texture of a given render target to a given slot, to be used by passes reading the render target
+		void bindTexture(RenderTargetHandle renderTarget, unsigned slot) const;
+
+		// Returns description of a given render target
+		const RenderTargetDescription& getDescription(RenderTargetHandle renderTarget) const;
+
+		int getPassesCount() const { return int(m_passes.size()); }
+		// Returns number of passes culled by the last compilation
+		int getCulledPassesCount() const;
+
+		// Returns a human-readable description of passes and render targets,
+		// including which passes are culled and the lifetimes of render targets.
+		std::string dump() const;
+
+	private: /* variables */
+
+		struct RenderTarget
+		{
+			std::string name;
+			RenderTargetDescription description;
+
+			bool isImported = false;
+
+			// Frame buffer of the render target.
+			// For imported render targets set on import, for transient ones set only while they are alive during execution.
+			FrameBuffer* frameBuffer = nullptr;
+
+			// Passes writing to the render target
+			std::vector<int> writerPasses;
+
+			// Number of passes reading from the render target, used for culling
+			int referencesCount = 0;
+
+			// Indices of the first and last not culled pass using the render target
+			int firstPassIndex = -1;
+			int lastPassIndex = -1;
+		};
+
+		struct Pass
+		{
+			std::string name;
+			FrameGraphExecuteCallback executeCallback;
+
+			// Render targets that the pass reads from and writes to
+			std::vector<int> reads;
+			std::vector<int> writes;
+
+			bool hasSideEffects = false;
+
+			// Number of render targets written by the pass that are still used, used for culling
+			int referencesCount = 0;
+
+			bool isCulled = false;
+		};
+
+		std::vector<RenderTarget> m_renderTargets;
+		std::vector<Pass> m_passes;
+
+		bool m_isCompiled = false;
+	};
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "PekanLogger.h"
+#include "GraphicsBackend.h"
 #include <glad/glad.h>
 
 namespace Pekan
@@ -17,4 +18,6 @@ namespace Graphics
 // An error-checking macro for wrapping OpenGL calls.
 // What it does is it clears all OpenGL errors from the error queue, then does the OpenGL call,
 // and then loops over all new errors in the error queue and logs them using PekanLogger.
-#define GLCall(x) _CLEAR_GL_ERRORS; x; _LOG_GL_ERRORS;
\ No newline at end of file
+// If a headless graphics backend is used, the OpenGL call is skipped and only counted.
+// Wrapped in a do-while, so that it behaves as a single statement, also inside of an if-else without braces.
+#define GLCall(x) do { if (Pekan::Graphics::GraphicsBackend::isOpenGL()) { _CLEAR_GL_ERRORS; x; _LOG_GL_ERRORS; } else { Pekan::Graphics::GraphicsBackend::onSkippedGLCall(); } } while (0)
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "GpuProfiler.h"
+
+#include "GpuTimer.h"
+#include "GLCall.h"
+#include "PekanLogger.h"
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// Number of measurements of a single pass that can be waiting for their results at the same time
+	constexpr int TIMER_RING_SIZE = 4;
+
+	// Number of frames between two samplings of GPU and CPU clocks, used to convert GPU time to CPU time.
+	// Clocks are resampled from time to time, because they may drift apart.
+	constexpr int CALIBRATION_INTERVAL = 120;
+
+	// A single measured pass
+	struct GpuPass
+	{
+		// Name of the pass, a string literal
+		const char* name = nullptr;
+
+		GpuTimer timer;
+
+		// Number of passes enclosing this pass when it was last measured
+		int depth = 0;
+
+		// Flag indicating if the pass is currently being measured
+		bool isMeasuring = false;
+	};
+
+	// All passes measured so far, by name
+	static std::unordered_map<std::string_view, std::unique_ptr<GpuPass>> g_passes;
+
+	// Passes currently being measured, from outermost to innermost
+	static std::vector<GpuPass*> g_passStack;
+
+	// Index of Profiler's track where measured passes are recorded, or -1 if not yet created
+	static int g_gpuTrack = -1;
+
+	// Offset to be added to a GPU timestamp to convert it to CPU time, as returned by Profiler::_getTime()
+	static long long g_gpuToCpuOffset = 0;
+	// Number of frames left until the next sampling of GPU and CPU clocks
+	static int g_framesUntilCalibration = 0;
+
+	// Samples GPU and CPU clocks at the same moment, and computes the offset between them
+	static void calibrate()
+	{
+		GLint64 gpuTime = 0;
+		GLCall(glGetInteger64v(GL_TIMESTAMP, &gpuTime));
+		g_gpuToCpuOffset = Profiler::_getTime() - (long long)(gpuTime);
+		g_framesUntilCalibration = CALIBRATION_INTERVAL;
+	}
+
+	// Returns pass with a given name, creating it if needed
+	static GpuPass* getPass(const char* name)
+	{
+		const auto it = g_passes.find(name);
+		if (it != g_passes.end())
+		{
+			return it->second.get();
+		}
+
+		std::unique_ptr<GpuPass> pass = std::make_unique<GpuPass>();
+		GpuPass* passPtr = pass.get();
+		pass->name = name;
+		pass->timer.create(TIMER_RING_SIZE);
+		// Record each measurement of the pass on the GPU track, when its result is read
+		pass->timer.setCallback
+		(
+			[passPtr](unsigned long long beginTimestamp, unsigned long long endTimestamp)
+			{
+				Profiler::recordTrackEvent
+				(
+					g_gpuTrack, passPtr->name,
+					(long long)(beginTimestamp) + g_gpuToCpuOffset,
+					(long long)(endTimestamp) + g_gpuToCpuOffset,
+					passPtr->depth
+				);
+			}
+		);
+		g_passes[name] = std::move(pass);
+		return passPtr;
+	}
+
+	bool GpuProfiler::beginPass(const char* name)
+	{
+		PK_ASSERT(name != nullptr, "Trying to begin a GPU pass with a null name.", "Pekan");
+
+		if (!isSupported())
+		{
+			return false;
+		}
+		if (g_gpuTrack < 0)
+		{
+			g_gpuTrack = Profiler::createTrack("GPU");
+		}
+		if (g_passes.empty())
+		{
+			calibrate();
+		}
+
+		GpuPass* pass = getPass(name);
+		// A pass can't be nested inside of itself, so measure only the outermost one
+		if (pass->isMeasuring)
+		{
+			return false;
+		}
+		// If all measurements of the pass are still waiting for their results, skip this one
+		if (!pass->timer.begin())
+		{
+			return false;
+		}
+
+		pass->depth = int(g_passStack.size());
+		pass->isMeasuring = true;
+		g_passStack.push_back(pass);
+		return true;
+	}
+
+	void GpuProfiler::endPass()
+	{
+		PK_ASSERT(!g_passStack.empty(), "Trying to end a GPU pass but no pass is being measured.", "Pekan");
+
+		GpuPass* pass = g_passStack.back();
+		pass->timer.end();
+		pass->isMeasuring = false;
+		g_passStack.pop_back();
+	}
+
+	float GpuProfiler::getPassTime(const char* name)
+	{
+		const auto it = g_passes.find(name);
+		if (it == g_passes.end())
+		{
+			return -1.0f;
+		}
+		return it->second->timer.getTime();
+	}
+
+	bool GpuProfiler::isSupported()
+	{
+		// Timestamp queries are core since OpenGL 3.3
+		return GraphicsBackend::isOpenGL() && GLAD_GL_VERSION_3_3;
+	}
+
+	void GpuProfiler::update()
+	{
+		if (g_passes.empty())
+		{
+			return;
+		}
+		PK_ASSERT(g_passStack.empty(), "GPU passes are still being measured at the end of a frame. Each beginPass() must be followed by an endPass().", "Pekan");
+
+		// Read results of all finished measurements, recording them into the Profiler through timers' callbacks
+		for (const auto& [name, pass] : g_passes)
+		{
+			pass->timer.getTime();
+		}
+
+		g_framesUntilCalibration--;
+		if (g_framesUntilCalibration <= 0)
+		{
+			calibrate();
+		}
+	}
+
+	void GpuProfiler::exit()
+	{
+		for (const auto& [name, pass] : g_passes)
+		{
+			pass->timer.destroy();
+		}
+		g_passes.clear();
+		g_passStack.clear();
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Profiler.h"
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// A static class for measuring GPU time of named passes, feeding the results into the Profiler.
+	//
+	// Passes are measured with the macro PK_PROFILE_GPU_SCOPE, which encloses GPU commands issued in its scope
+	// between two timestamp queries. Each pass has its own ring of queries, read a few frames later,
+	// when their results are available, so measuring never stalls the GPU pipeline.
+	//
+	// Measured passes are recorded on the Profiler's "GPU" track, converted to CPU time,
+	// so they show up in exported traces and in the ProfilerWidget next to CPU scopes.
+	// GPU time is converted to CPU time by periodically sampling both clocks at the same moment,
+	// so passes show up roughly when the GPU actually executed them, a bit later than the CPU scopes submitting them.
+	//
+	// Passes are measured only while Profiler's capture is enabled, and only if timer queries are supported.
+	class GpuProfiler
+	{
+		// Make GraphicsSubsystem a friend so that it can update and exit GpuProfiler
+		friend class GraphicsSubsystem;
+
+	public:
+
+		// Begins measuring a pass with a given name. Name must be a string literal.
+		// Returns false if the pass is not measured, in which case endPass() must not be called.
+		static bool beginPass(const char* name);
+		// Ends measuring the pass begun with the last successful call to beginPass()
+		static void endPass();
+
+		// Returns most recent measured GPU time of a pass with a given name, in milliseconds,
+		// or -1 if the pass hasn't been measured yet.
+		static float getPassTime(const char* name);
+
+		// Checks if GPU timing is supported by the current graphics backend
+		static bool isSupported();
+
+	private:
+
+		// Reads results of finished measurements and records them into the Profiler.
+		// Called by GraphicsSubsystem at the end of each frame.
+		static void update();
+
+		// Destroys all timer queries. Must be called before OpenGL context destruction.
+		// Only GraphicsSubsystem should call this.
+		static void exit();
+	};
+
+	// An RAII object measuring GPU time of the scope in which it lives. Use the PK_PROFILE_GPU_SCOPE macro instead of using it directly.
+	class GpuProfileScope
+	{
+	public:
+
+		GpuProfileScope(const char* name)
+			: m_isMeasuring(Profiler::isCaptureEnabled() && GpuProfiler::beginPass(name))
+		{}
+
+		~GpuProfileScope()
+		{
+			if (m_isMeasuring)
+			{
+				GpuProfiler::endPass();
+			}
+		}
+
+		GpuProfileScope(const GpuProfileScope&) = delete;
+		GpuProfileScope& operator=(const GpuProfileScope&) = delete;
+
+	private:
+
+		// Flag indicating if the pass is being measured
+		bool m_isMeasuring = false;
+	};
+
+} // namespace Graphics
+} // namespace Pekan
+
+#if PEKAN_ENABLE_PROFILER
+	// Measures GPU time of the commands issued in the current scope, as a pass with a given name. Name must be a string literal.
+	#define PK_PROFILE_GPU_SCOPE(NAME) Pekan::Graphics::GpuProfileScope PK_PROFILE_CONCAT(pkGpuProfileScope, __LINE__)(NAME)
+#else
+	#define PK_PROFILE_GPU_SCOPE(NAME)
+#endif
\ No newline at end of file
@@ -7,6 +7,9 @@ namespace Pekan
 namespace Graphics
 {
 
+	// ID of the frame buffer bound when any frame buffer is unbound. 0 means window's frame buffer.
+	static unsigned g_defaultFrameBufferId = 0;
+
 	FrameBuffer::~FrameBuffer()
 	{
 		PK_ASSERT(!isValid(), "You forgot to destroy() a FrameBuffer instance.", "Pekan");
@@ -21,6 +24,7 @@ namespace Graphics
 		m_height = height;
 
 		GLCall(glGenFramebuffers(1, &m_id));
+		GraphicsBackend::onCreateResource(GpuResourceType::FrameBuffer, m_id);
 		bind();
 
 		// Create texture,
@@ -35,10 +39,14 @@ namespace Graphics
 		}
 		createRenderBuffer();
 
-		GLCall(const unsigned fboStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER));
-		if (fboStatus != GL_FRAMEBUFFER_COMPLETE)
+		if (GraphicsBackend::isOpenGL())
 		{
-			PK_LOG_ERROR("FrameBuffer failed to create with an OpenGL error: " << fboStatus, "Pekan");
+			unsigned fboStatus = GL_FRAMEBUFFER_COMPLETE;
+			GLCall(fboStatus = glCheckFramebufferStatus(GL_FRAMEBUFFER));
+			if (fboStatus != GL_FRAMEBUFFER_COMPLETE)
+			{
+				PK_LOG_ERROR("FrameBuffer failed to create with an OpenGL error: " << fboStatus, "Pekan");
+			}
 		}
 	}
 
@@ -55,6 +63,7 @@ namespace Graphics
 		{
 			m_texture.destroy();
 		}
+		GraphicsBackend::onDestroyResource(GpuResourceType::FrameBuffer, m_id);
 		GLCall(glDeleteFramebuffers(1, &m_id));
 		m_id = 0;
 	}
@@ -70,7 +79,19 @@ namespace Graphics
 	{
 		PK_ASSERT(isValid(), "Trying to unbind a FrameBuffer that is not yet created.", "Pekan");
 
-		GLCall(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+		GLCall(glBindFramebuffer(GL_FRAMEBUFFER, g_defaultFrameBufferId));
+	}
+
+	void FrameBuffer::setDefault(const FrameBuffer* frameBuffer)
+	{
+		PK_ASSERT(frameBuffer == nullptr || frameBuffer->isValid(), "Trying to set a FrameBuffer that is not yet created as the default one.", "Pekan");
+
+		g_defaultFrameBufferId = (frameBuffer != nullptr) ? frameBuffer->m_id : 0;
+	}
+
+	void FrameBuffer::bindDefault()
+	{
+		GLCall(glBindFramebuffer(GL_FRAMEBUFFER, g_defaultFrameBufferId));
 	}
 
 	void FrameBuffer::bindTexture() const
@@ -101,6 +122,15 @@ namespace Graphics
 		}
 	}
 
+	void FrameBuffer::setTextureFilter(TextureMinifyFunction minifyFunction, TextureMagnifyFunction magnifyFunction)
+	{
+		PK_ASSERT(isValid(), "Trying to set texture filter of a FrameBuffer that is not yet created.", "Pekan");
+		PK_ASSERT(m_samplesPerPixel == 1, "Trying to set texture filter of a multisample FrameBuffer.", "Pekan");
+
+		m_texture.setMinifyFunction(minifyFunction);
+		m_texture.setMagnifyFunction(magnifyFunction);
+	}
+
 	void FrameBuffer::resolveMultisampleToSinglesample(FrameBuffer& targetFrameBuffer)
 	{
 		PK_ASSERT(m_samplesPerPixel > 1, "Trying to resolve a multisample FrameBuffer to a single-sample FrameBuffer,"
@@ -118,6 +148,39 @@ namespace Graphics
 		));
 	}
 
+	void FrameBuffer::blit(const FrameBuffer* targetFrameBuffer, int width, int height, int targetWidth, int targetHeight, bool useLinearFilter) const
+	{
+		PK_ASSERT(isValid(), "Trying to blit a FrameBuffer that is not yet created.", "Pekan");
+		PK_ASSERT(targetFrameBuffer == nullptr || targetFrameBuffer->isValid(), "Trying to blit a FrameBuffer to a FrameBuffer that is not yet created.", "Pekan");
+		PK_ASSERT(m_samplesPerPixel <= 1 || (width == targetWidth && height == targetHeight), "Trying to blit a multisample FrameBuffer to a region of a different size.", "Pekan");
+
+		GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, m_id));
+		GLCall(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, (targetFrameBuffer != nullptr) ? targetFrameBuffer->m_id : g_defaultFrameBufferId));
+		GLCall(glBlitFramebuffer
+		(
+			0, 0, width, height,
+			0, 0, targetWidth, targetHeight,
+			GL_COLOR_BUFFER_BIT, useLinearFilter ? GL_LINEAR : GL_NEAREST
+		));
+	}
+
+	bool FrameBuffer::readPixels(std::vector<unsigned char>& pixels) const
+	{
+		PK_ASSERT(isValid(), "Trying to read pixels of a FrameBuffer that is not yet created.", "Pekan");
+		if (m_samplesPerPixel > 1)
+		{
+			PK_LOG_ERROR("Trying to read pixels of a multisample FrameBuffer. It must be resolved to a single-sample FrameBuffer first.", "Pekan");
+			return false;
+		}
+
+		bind();
+		pixels.resize(size_t(m_width) * size_t(m_height) * 4);
+		// Rows of RGBA pixels are always 4-byte aligned, but set pack alignment explicitly to not depend on current state
+		GLCall(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+		GLCall(glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+		return true;
+	}
+
 	bool FrameBuffer::isValid() const
 	{
 		return m_id != 0;
@@ -4,6 +4,8 @@
 #include "Texture2DMultisample.h"
 #include "RenderBuffer.h"
 
+#include <vector>
+
 namespace Pekan
 {
 namespace Graphics
@@ -21,20 +23,50 @@ namespace Graphics
 		void destroy();
 
 		void bind() const;
+		// Unbinds the frame buffer, binding the default frame buffer instead
 		void unbind() const;
 
+		// Sets a frame buffer to be bound instead of window's frame buffer whenever a frame buffer is unbound.
+		// Used when rendering offscreen, where the final frame must end up in a frame buffer that can be read.
+		// Pass a null pointer to use window's frame buffer again.
+		static void setDefault(const FrameBuffer* frameBuffer);
+		// Binds the default frame buffer
+		static void bindDefault();
+
 		// Binds the underlying texture so that its contents can be accessed
 		// from outside the frame buffer.
 		void bindTexture() const;
 		void bindTexture(unsigned slot) const;
 
+		// Sets minify and magnify functions used when sampling the underlying texture of a single-sample frame buffer.
+		// Default is TextureMinifyFunction::Nearest and TextureMagnifyFunction::Nearest.
+		void setTextureFilter(TextureMinifyFunction minifyFunction, TextureMagnifyFunction magnifyFunction);
+
 		// Resolves a multisample frame buffer to a given target single-sample buffer,
 		// effectively copying all pixel data, but changing it from multisample to single-sample.
 		void resolveMultisampleToSinglesample(FrameBuffer& targetFrameBuffer);
 
+		// Copies bottom-left region of a given size of the frame buffer to bottom-left region of a given size of a target frame buffer,
+		// scaling it if sizes are different. If target frame buffer is a null pointer, copies to the default frame buffer.
+		// Copies only colors of pixels, not depth and stencil values.
+		// NOTE: A multisample frame buffer can only be copied to a region of the same size.
+		void blit(const FrameBuffer* targetFrameBuffer, int width, int height, int targetWidth, int targetHeight, bool useLinearFilter) const;
+
+		// Reads colors of all pixels of the frame buffer into a given array, in RGBA format,
+		// row by row from the bottom row to the top one. Leaves the frame buffer bound.
+		// NOTE: This waits for all rendering to the frame buffer to finish.
+		//       Use a FrameBufferReadback for reading frames without stalling.
+		// Multisample frame buffers can't be read directly, they must be resolved to a single-sample one first.
+		// Returns true on success.
+		bool readPixels(std::vector<unsigned char>& pixels) const;
+
 		// Checks if frame buffer is valid, meaning that it has been successfully created and not yet destroyed
 		bool isValid() const;
 
+		int getWidth() const { return m_width; }
+		int getHeight() const { return m_height; }
+		int getSamplesPerPixel() const { return m_samplesPerPixel; }
+
 	private: /* functions */
 
 		// Creates underlying 2D texture object
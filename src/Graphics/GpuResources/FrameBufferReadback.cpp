@@ -0,0 +1,212 @@
+#include "FrameBufferReadback.h"
+
+#include "FrameBuffer.h"
+#include "GLCall.h"
+
+#include <cstring>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	FrameBufferReadback::~FrameBufferReadback()
+	{
+		if (isValid())
+		{
+			destroy();
+		}
+	}
+
+	void FrameBufferReadback::create(int width, int height, int ringSize)
+	{
+		PK_ASSERT(!isValid(), "Trying to create a FrameBufferReadback instance that is already created.", "Pekan");
+		PK_ASSERT(width > 0 && height > 0, "Trying to create a FrameBufferReadback with a non-positive size.", "Pekan");
+		PK_ASSERT(ringSize > 0, "Trying to create a FrameBufferReadback with a non-positive ring size.", "Pekan");
+
+		m_width = width;
+		m_height = height;
+		m_nextSlot = 0;
+		m_pendingCount = 0;
+
+		const long long bufferSize = (long long)(width) * height * 4;
+		m_slots.resize(ringSize);
+		for (Slot& slot : m_slots)
+		{
+			GLCall(glGenBuffers(1, &slot.bufferId));
+			GraphicsBackend::onCreateResource(GpuResourceType::PixelPackBuffer, slot.bufferId);
+			// Allocate buffer's memory once, so that readbacks only copy into it.
+			// GL_STREAM_READ tells the driver that the buffer will be written by the GPU and read by the CPU, once per write.
+			GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.bufferId));
+			GLCall(glBufferData(GL_PIXEL_PACK_BUFFER, bufferSize, nullptr, GL_STREAM_READ));
+		}
+		GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+	}
+
+	void FrameBufferReadback::destroy()
+	{
+		PK_ASSERT(isValid(), "Trying to destroy a FrameBufferReadback instance that is not yet created.", "Pekan");
+
+		for (Slot& slot : m_slots)
+		{
+			if (slot.fence != nullptr)
+			{
+				GLCall(glDeleteSync(GLsync(slot.fence)));
+			}
+			GraphicsBackend::onDestroyResource(GpuResourceType::PixelPackBuffer, slot.bufferId);
+			GLCall(glDeleteBuffers(1, &slot.bufferId));
+		}
+		m_slots.clear();
+		m_pendingCount = 0;
+		m_finishedFrames.clear();
+	}
+
+	bool FrameBufferReadback::requestReadback(const FrameBuffer& frameBuffer, long long frameIndex)
+	{
+		PK_ASSERT(isValid(), "Trying to request a readback from a FrameBufferReadback that is not yet created.", "Pekan");
+		if (frameBuffer.getSamplesPerPixel() > 1)
+		{
+			PK_LOG_ERROR("Trying to read back a multisample FrameBuffer. It must be resolved to a single-sample FrameBuffer first.", "Pekan");
+			return false;
+		}
+		if (frameBuffer.getWidth() != m_width || frameBuffer.getHeight() != m_height)
+		{
+			PK_LOG_ERROR("Trying to read back a FrameBuffer with a size different from the size of the FrameBufferReadback.", "Pekan");
+			return false;
+		}
+		// If all slots are in flight, drop the frame instead of waiting for the oldest one
+		if (m_pendingCount == int(m_slots.size()))
+		{
+			PK_LOG_WARNING("All readback buffers are in flight. Frame " << frameIndex << " will not be read back.", "Pekan");
+			return false;
+		}
+
+		Slot& slot = m_slots[m_nextSlot];
+		slot.frameIndex = frameIndex;
+
+		// Remember currently bound frame buffers, so that reading back doesn't change where the caller renders to
+		int previousDrawFrameBufferId = 0;
+		int previousReadFrameBufferId = 0;
+		GLCall(glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDrawFrameBufferId));
+		GLCall(glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFrameBufferId));
+
+		// Read pixels into the pixel pack buffer. With a pack buffer bound, glReadPixels() returns immediately
+		// and the last parameter is an offset into the buffer instead of a pointer to CPU memory.
+		frameBuffer.bind();
+		GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.bufferId));
+		GLCall(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+		GLCall(glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+		GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+		GLCall(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, unsigned(previousDrawFrameBufferId)));
+		GLCall(glBindFramebuffer(GL_READ_FRAMEBUFFER, unsigned(previousReadFrameBufferId)));
+		// Put a fence after the copy, so that we can check when it's done
+		GLCall(slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+		m_nextSlot = (m_nextSlot + 1) % int(m_slots.size());
+		m_pendingCount++;
+		return true;
+	}
+
+	void FrameBufferReadback::update()
+	{
+		PK_ASSERT(isValid(), "Trying to update a FrameBufferReadback that is not yet created.", "Pekan");
+
+		// Readbacks finish in the order in which they were requested,
+		// so stop at the first one that is not finished yet
+		while (m_pendingCount > 0 && deliverOldest(false)) {}
+	}
+
+	void FrameBufferReadback::flush()
+	{
+		PK_ASSERT(isValid(), "Trying to flush a FrameBufferReadback that is not yet created.", "Pekan");
+
+		while (m_pendingCount > 0)
+		{
+			deliverOldest(true);
+		}
+	}
+
+	bool FrameBufferReadback::pollFrame(ReadbackFrame& frame)
+	{
+		if (m_finishedFrames.empty())
+		{
+			return false;
+		}
+		frame = std::move(m_finishedFrames.front());
+		m_finishedFrames.pop_front();
+		return true;
+	}
+
+	bool FrameBufferReadback::deliverOldest(bool doWait)
+	{
+		const int slotCount = int(m_slots.size());
+		Slot& slot = m_slots[(m_nextSlot - m_pendingCount + slotCount) % slotCount];
+
+		// Check if the copy is done. With a zero timeout this never blocks.
+		// A null fence means that there is no OpenGL backend, so there is nothing to wait for.
+		if (slot.fence != nullptr)
+		{
+			unsigned waitResult = GL_ALREADY_SIGNALED;
+			const unsigned long long timeout = doWait ? ~0ull : 0ull;
+			GLCall(waitResult = glClientWaitSync(GLsync(slot.fence), GL_SYNC_FLUSH_COMMANDS_BIT, timeout));
+			if (waitResult == GL_TIMEOUT_EXPIRED)
+			{
+				return false;
+			}
+			GLCall(glDeleteSync(GLsync(slot.fence)));
+			slot.fence = nullptr;
+			// If waiting failed, the buffer's content can't be trusted, so drop the slot without delivering it
+			if (waitResult == GL_WAIT_FAILED)
+			{
+				PK_LOG_ERROR("Failed waiting for a readback of frame " << slot.frameIndex << ". The frame is dropped.", "Pekan");
+				m_pendingCount--;
+				return true;
+			}
+		}
+
+		const size_t pixelsSize = size_t(m_width) * size_t(m_height) * 4;
+
+		// Map the buffer to read pixels from it.
+		// Without an OpenGL backend nothing is mapped, and the frame is delivered with zeroed pixels.
+		GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.bufferId));
+		const void* mappedPixels = nullptr;
+		GLCall(mappedPixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, (long long)(pixelsSize), GL_MAP_READ_BIT));
+		if (mappedPixels == nullptr && GraphicsBackend::isOpenGL())
+		{
+			GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+			PK_LOG_ERROR("Failed mapping the readback buffer of frame " << slot.frameIndex << ". The frame is dropped.", "Pekan");
+			m_pendingCount--;
+			return true;
+		}
+
+		// Get the frame to copy pixels into
+		ReadbackFrame* frame = &m_callbackFrame;
+		if (!m_callback)
+		{
+			m_finishedFrames.emplace_back();
+			frame = &m_finishedFrames.back();
+		}
+		frame->frameIndex = slot.frameIndex;
+		frame->width = m_width;
+		frame->height = m_height;
+		frame->pixels.resize(pixelsSize);
+
+		if (mappedPixels != nullptr)
+		{
+			std::memcpy(frame->pixels.data(), mappedPixels, pixelsSize);
+			GLCall(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+		}
+		GLCall(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+		m_pendingCount--;
+
+		if (m_callback)
+		{
+			m_callback(m_callbackFrame);
+		}
+		return true;
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
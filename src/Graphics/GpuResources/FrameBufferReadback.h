@@ -0,0 +1,124 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	class FrameBuffer;
+
+	// Pixels of a frame read back from a frame buffer
+	struct ReadbackFrame
+	{
+		// Index of the frame that was read, as given when requesting the readback
+		long long frameIndex = -1;
+
+		int width = 0;
+		int height = 0;
+
+		// Colors of all pixels, in RGBA format, row by row from the bottom row to the top one
+		std::vector<unsigned char> pixels;
+	};
+
+	// Type definition for a callback called when a readback is finished
+	typedef std::function<void(const ReadbackFrame&)> ReadbackCallback;
+
+	// A class for reading pixels of a frame buffer back to the CPU without stalling the GPU pipeline.
+	//
+	// Each readback copies frame buffer's pixels into one of a ring of pixel pack buffers and puts a fence after the copy.
+	// The copy is done by the GPU asynchronously, and the CPU only checks, without waiting, if the fence has been passed.
+	// This means that pixels of frame N become available a couple of frames later, depending on the size of the ring.
+	//
+	// Usage:
+	//   1. Call requestReadback() after rendering a frame into a frame buffer
+	//   2. Call update() once per frame, which delivers all finished readbacks
+	//   3. Receive finished readbacks either through a callback set with setCallback(), or by polling with pollFrame()
+	class FrameBufferReadback
+	{
+	public:
+
+		~FrameBufferReadback();
+
+		// Creates a ring of pixel pack buffers for reading frames of a given size.
+		// Ring size is the maximum number of readbacks that can be in flight at the same time.
+		void create(int width, int height, int ringSize = 3);
+		// Destroys pixel pack buffers. Readbacks that are still in flight are discarded.
+		void destroy();
+
+		// Starts reading pixels of a given single-sample frame buffer, without waiting for the read to finish.
+		// Frame buffer must have the same size as the readback.
+		// If all buffers of the ring are in flight, frame is dropped and false is returned.
+		// Frame buffers bound for drawing and reading before the call are bound again after it.
+		bool requestReadback(const FrameBuffer& frameBuffer, long long frameIndex);
+
+		// Delivers all readbacks that have finished, in the order in which they were requested. Never waits.
+		void update();
+
+		// Waits for all readbacks in flight to finish, and delivers them
+		void flush();
+
+		// Sets a callback to be called with each finished readback.
+		// Frame passed to the callback is reused between readbacks, so it must be copied if it's needed after the callback returns.
+		// If there is no callback, finished readbacks are queued and can be received with pollFrame().
+		void setCallback(const ReadbackCallback& callback) { m_callback = callback; }
+
+		// Moves the oldest finished readback into a given frame.
+		// Returns false if there are no finished readbacks.
+		bool pollFrame(ReadbackFrame& frame);
+
+		// Returns number of readbacks currently in flight
+		int getPendingCount() const { return m_pendingCount; }
+		// Returns number of pixel pack buffers in the ring
+		int getRingSize() const { return int(m_slots.size()); }
+
+		// Checks if readback is valid, meaning that it has been successfully created and not yet destroyed
+		bool isValid() const { return !m_slots.empty(); }
+
+	private: /* functions */
+
+		// Delivers the oldest readback in flight, if it has finished.
+		// If doWait is true, waits for it to finish.
+		// Returns true if the readback finished, whether it was delivered or dropped because reading it failed.
+		bool deliverOldest(bool doWait);
+
+	private: /* variables */
+
+		// A single slot of the ring
+		struct Slot
+		{
+			// ID of slot's pixel pack buffer on the GPU
+			unsigned bufferId = 0;
+			// Fence put after copying pixels into the buffer. Null if slot is not in flight.
+			void* fence = nullptr;
+			// Index of the frame being read into the buffer
+			long long frameIndex = -1;
+		};
+
+		// Ring of slots
+		std::vector<Slot> m_slots;
+
+		// Index of the slot to be used by the next readback
+		int m_nextSlot = 0;
+		// Number of slots currently in flight
+		int m_pendingCount = 0;
+
+		// Size of read frames, in pixels
+		int m_width = 0;
+		int m_height = 0;
+
+		// Callback called with each finished readback
+		ReadbackCallback m_callback;
+
+		// Frame reused for delivering readbacks to the callback
+		ReadbackFrame m_callbackFrame;
+
+		// Finished readbacks waiting to be polled, used if there is no callback
+		std::deque<ReadbackFrame> m_finishedFrames;
+	};
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
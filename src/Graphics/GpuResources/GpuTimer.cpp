@@ -0,0 +1,124 @@
+#include "GpuTimer.h"
+
+#include "GLCall.h"
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	GpuTimer::~GpuTimer()
+	{
+		if (isValid())
+		{
+			destroy();
+		}
+	}
+
+	void GpuTimer::create(int ringSize)
+	{
+		PK_ASSERT(!isValid(), "Trying to create a GpuTimer instance that is already created.", "Pekan");
+		PK_ASSERT(ringSize > 0, "Trying to create a GpuTimer with ring size <= 0.", "Pekan");
+
+		m_slots.resize(ringSize);
+		for (Slot& slot : m_slots)
+		{
+			GLCall(glGenQueries(1, &slot.beginQueryId));
+			GraphicsBackend::onCreateResource(GpuResourceType::TimerQuery, slot.beginQueryId);
+			GLCall(glGenQueries(1, &slot.endQueryId));
+			GraphicsBackend::onCreateResource(GpuResourceType::TimerQuery, slot.endQueryId);
+		}
+		m_nextSlot = 0;
+		m_isMeasuring = false;
+		m_time = -1.0f;
+	}
+
+	void GpuTimer::destroy()
+	{
+		PK_ASSERT(isValid(), "Trying to destroy a GpuTimer instance that is not yet created.", "Pekan");
+
+		for (Slot& slot : m_slots)
+		{
+			GraphicsBackend::onDestroyResource(GpuResourceType::TimerQuery, slot.beginQueryId);
+			GLCall(glDeleteQueries(1, &slot.beginQueryId));
+			GraphicsBackend::onDestroyResource(GpuResourceType::TimerQuery, slot.endQueryId);
+			GLCall(glDeleteQueries(1, &slot.endQueryId));
+		}
+		m_slots.clear();
+		m_callback = nullptr;
+	}
+
+	bool GpuTimer::begin()
+	{
+		PK_ASSERT(isValid(), "Trying to begin a GpuTimer that is not yet created.", "Pekan");
+		PK_ASSERT(!m_isMeasuring, "Trying to begin a GpuTimer that is already measuring.", "Pekan");
+
+		readResults();
+		Slot& slot = m_slots[m_nextSlot];
+		if (slot.isPending)
+		{
+			return false;
+		}
+
+		GLCall(glQueryCounter(slot.beginQueryId, GL_TIMESTAMP));
+		m_isMeasuring = true;
+		return true;
+	}
+
+	void GpuTimer::end()
+	{
+		PK_ASSERT(m_isMeasuring, "Trying to end a GpuTimer that is not measuring.", "Pekan");
+
+		Slot& slot = m_slots[m_nextSlot];
+		GLCall(glQueryCounter(slot.endQueryId, GL_TIMESTAMP));
+		slot.isPending = true;
+		m_nextSlot = (m_nextSlot + 1) % int(m_slots.size());
+		m_isMeasuring = false;
+	}
+
+	float GpuTimer::getTime()
+	{
+		if (isValid())
+		{
+			readResults();
+		}
+		return m_time;
+	}
+
+	void GpuTimer::readResults()
+	{
+		// Go through slots from oldest to newest, so that we end up with the most recent available result
+		const int slotsCount = int(m_slots.size());
+		for (int i = 0; i < slotsCount; i++)
+		{
+			Slot& slot = m_slots[(m_nextSlot + i) % slotsCount];
+			if (!slot.isPending)
+			{
+				continue;
+			}
+
+			// End timestamp is written after begin timestamp, so if it's available both are
+			GLint isAvailable = GL_FALSE;
+			GLCall(glGetQueryObjectiv(slot.endQueryId, GL_QUERY_RESULT_AVAILABLE, &isAvailable));
+			if (!isAvailable)
+			{
+				// Newer measurements can't be available either
+				break;
+			}
+			GLuint64 beginTimestamp = 0;
+			GLuint64 endTimestamp = 0;
+			GLCall(glGetQueryObjectui64v(slot.beginQueryId, GL_QUERY_RESULT, &beginTimestamp));
+			GLCall(glGetQueryObjectui64v(slot.endQueryId, GL_QUERY_RESULT, &endTimestamp));
+			// Convert from nanoseconds to milliseconds
+			m_time = float(double(endTimestamp - beginTimestamp) / 1000000.0);
+			slot.isPending = false;
+
+			if (m_callback)
+			{
+				m_callback(beginTimestamp, endTimestamp);
+			}
+		}
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// A callback function receiving GPU timestamps, in nanoseconds, at which a measurement began and ended
+	typedef std::function<void(unsigned long long beginTimestamp, unsigned long long endTimestamp)> GpuTimerCallback;
+
+	// A class for measuring how much time the GPU spends executing a sequence of commands.
+	//
+	// Commands are enclosed between begin() and end(), which record GPU timestamps with timer queries.
+	// Query results become available only after the GPU executes the commands, a frame or more later,
+	// so a ring of queries is used and results are read only when available, without ever stalling the GPU pipeline.
+	// As a consequence, measured time lags a few frames behind.
+	//
+	// Timestamps are used instead of elapsed time queries, so timers can be nested and overlapped freely.
+	class GpuTimer
+	{
+	public:
+
+		~GpuTimer();
+
+		// Creates the underlying timer queries.
+		// Ring size is the maximum number of measurements that can be waiting for their result at the same time.
+		void create(int ringSize = 3);
+		void destroy();
+
+		// Begins measuring. Must be followed by a call to end().
+		// If all measurements in the ring are still waiting for their results, this one is skipped and false is returned.
+		bool begin();
+		// Ends measuring, started with the last successful call to begin()
+		void end();
+
+		// Returns most recent measured time, in milliseconds, or -1 if nothing has been measured yet.
+		// Reads results of finished measurements first, without waiting for unfinished ones.
+		float getTime();
+
+		// Sets a callback function to be called with the timestamps of each finished measurement, when its result is read.
+		// Unlike getTime(), this doesn't miss any measurements, even if multiple measurements finish between two reads.
+		void setCallback(const GpuTimerCallback& callback) { m_callback = callback; }
+
+		// Checks if GPU timer is valid, meaning that it has been successfully created and not yet destroyed
+		bool isValid() const { return !m_slots.empty(); }
+
+	private: /* functions */
+
+		// Reads results of all finished measurements, from oldest to newest
+		void readResults();
+
+	private: /* variables */
+
+		// A single measurement, a pair of timestamp queries
+		struct Slot
+		{
+			unsigned beginQueryId = 0;
+			unsigned endQueryId = 0;
+			// Flag indicating if measurement is issued but its result is not yet read
+			bool isPending = false;
+		};
+
+		std::vector<Slot> m_slots;
+
+		// Index of the slot to be used by next measurement
+		int m_nextSlot = 0;
+
+		// Flag indicating if a measurement is currently begun but not yet ended
+		bool m_isMeasuring = false;
+
+		// Most recent measured time, in milliseconds
+		float m_time = -1.0f;
+
+		// Callback function called with the timestamps of each finished measurement
+		GpuTimerCallback m_callback;
+	};
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "GLCall.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace Pekan
 {
 namespace Graphics
@@ -20,36 +23,69 @@ namespace Graphics
 		PK_ASSERT(!isValid(), "Trying to create an IndexBuffer instance that is already created.", "Pekan");
 
 		GLCall(glGenBuffers(1, &m_id));
+		GraphicsBackend::onCreateResource(GpuResourceType::IndexBuffer, m_id);
 		bind();
 
 		m_size = 0;
 	}
 
-	void IndexBuffer::create(const void* data, long long size, BufferDataUsage dataUsage)
+	void IndexBuffer::create(const void* data, long long size, BufferDataUsage dataUsage, IndexType indexType)
 	{
 		PK_ASSERT(!isValid(), "Trying to create an IndexBuffer instance that is already created.", "Pekan");
 		PK_ASSERT(size >= 0, "Cannot create an IndexBuffer with a negative size.", "Pekan");
 
 		GLCall(glGenBuffers(1, &m_id));
-		setData(data, size, dataUsage);
+		GraphicsBackend::onCreateResource(GpuResourceType::IndexBuffer, m_id);
+		setData(data, size, dataUsage, indexType);
 	}
 
 	void IndexBuffer::destroy()
 	{
 		PK_ASSERT(isValid(), "Trying to destroy an IndexBuffer instance that is not yet created.", "Pekan");
 
+		GraphicsBackend::onDestroyResource(GpuResourceType::IndexBuffer, m_id);
 		GLCall(glDeleteBuffers(1, &m_id));
 		m_id = 0;
+		m_shortIndices.clear();
+		m_shortIndices.shrink_to_fit();
 	}
 
-	void IndexBuffer::setData(const void* data, long long size, BufferDataUsage dataUsage)
+	void IndexBuffer::setData(const void* data, long long size, BufferDataUsage dataUsage, IndexType indexType)
 	{
 		PK_ASSERT(isValid(), "Trying to set data to an IndexBuffer that is not yet created.", "Pekan");
 		PK_ASSERT(size >= 0, "Cannot set data with a negative size to an IndexBuffer.", "Pekan");
+		PK_ASSERT(size % RenderState::getIndexTypeSize(indexType) == 0, "Trying to set data to an IndexBuffer with a size that is not a multiple of index size.", "Pekan");
 
 		bind();
 		GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, RenderState::getBufferDataUsageOpenGLEnum(dataUsage)));
+		GraphicsBackend::onUploadData(GpuResourceType::IndexBuffer, m_id, size);
 		m_size = size;
+		m_indexType = indexType;
+	}
+
+	void IndexBuffer::setIndices(const unsigned* indices, long long indicesCount, BufferDataUsage dataUsage)
+	{
+		PK_ASSERT(indicesCount >= 0, "Cannot set a negative number of indices to an IndexBuffer.", "Pekan");
+
+		// Check if all indices fit in 16 bits
+		unsigned maxIndex = 0;
+		for (long long i = 0; i < indicesCount; i++)
+		{
+			maxIndex = std::max(maxIndex, indices[i]);
+		}
+		if (maxIndex > 0xFFFF)
+		{
+			setData(indices, indicesCount * sizeof(unsigned), dataUsage, IndexType::UnsignedInt);
+			return;
+		}
+
+		// Convert indices to 16 bits.
+		m_shortIndices.resize(indicesCount);
+		for (long long i = 0; i < indicesCount; i++)
+		{
+			m_shortIndices[i] = (unsigned short)(indices[i]);
+		}
+		setData(m_shortIndices.data(), indicesCount * sizeof(unsigned short), dataUsage, IndexType::UnsignedShort);
 	}
 
 	void IndexBuffer::setSubData(const void* data, long long offset, long long size)
@@ -57,9 +93,11 @@ namespace Graphics
 		PK_ASSERT(isValid(), "Trying to set subdata to an IndexBuffer that is not yet created.", "Pekan");
 		PK_ASSERT(size >= 0, "Cannot set subdata with a negative size to an IndexBuffer.", "Pekan");
 		PK_ASSERT(offset >= 0 && offset + size <= m_size, "Trying to set subdata that is out of range to an IndexBuffer.", "Pekan");
+		PK_ASSERT(offset % RenderState::getIndexTypeSize(m_indexType) == 0 && size % RenderState::getIndexTypeSize(m_indexType) == 0, "Trying to set subdata to an IndexBuffer that is not aligned to index size.", "Pekan");
 
 		bind();
 		GLCall(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, data));
+		GraphicsBackend::onUploadData(GpuResourceType::IndexBuffer, m_id, size);
 	}
 
 	void IndexBuffer::bind() const
@@ -2,6 +2,8 @@
 
 #include "RenderState.h"
 
+#include <vector>
+
 namespace Pekan
 {
 namespace Graphics
@@ -18,11 +20,15 @@ namespace Graphics
 		// Creates the underlying index buffer object
 		void create();
 		// Creates the underlying index buffer object, fills it with given data, and binds it
-		void create(const void* data, long long size, BufferDataUsage dataUsage = BufferDataUsage::StaticDraw);
+		void create(const void* data, long long size, BufferDataUsage dataUsage = BufferDataUsage::StaticDraw, IndexType indexType = IndexType::UnsignedInt);
 		void destroy();
 
-		// Fills index buffer with given data. Any previous data is overwritten.
-		void setData(const void* data, long long size, BufferDataUsage dataUsage = BufferDataUsage::StaticDraw);
+		// Fills index buffer with given data, containing indices of a given type. Any previous data is overwritten.
+		void setData(const void* data, long long size, BufferDataUsage dataUsage = BufferDataUsage::StaticDraw, IndexType indexType = IndexType::UnsignedInt);
+		// Fills index buffer with given 32-bit indices. Any previous data is overwritten.
+		// If all indices fit in 16 bits, they are stored as 16-bit indices to save memory and bandwidth,
+		// so make sure to use getIndexType() when drawing.
+		void setIndices(const unsigned* indices, long long indicesCount, BufferDataUsage dataUsage = BufferDataUsage::StaticDraw);
 		// Fills a region of the index buffer with given data. Previous data in this region is overwritten.
 		// @param[in] data - Data to be filled in to the region
 		// @param[in] offset - Offset from the beginning of the index buffer to where the region begins
@@ -35,7 +41,9 @@ namespace Graphics
 		// Returns size of index buffer's data, in bytes
 		long long getSize() const { return m_size; }
 		// Returns the number of indices in the index buffer
-		long long getCount() const { return m_size / sizeof(unsigned); }
+		long long getCount() const { return m_size / RenderState::getIndexTypeSize(m_indexType); }
+		// Returns the type of indices in the index buffer
+		IndexType getIndexType() const { return m_indexType; }
 
 		// Checks if index buffer contains any data
 		bool hasData() const { return m_size > 0; }
@@ -48,8 +56,15 @@ namespace Graphics
 		// Index buffer's size, in bytes
 		long long m_size = -1;
 
+		// Type of indices in the index buffer
+		IndexType m_indexType = IndexType::UnsignedInt;
+
 		// Index buffer's ID on the GPU
 		unsigned m_id = 0;
+
+		// Indices converted to 16 bits by setIndices(), reused between calls to avoid allocations.
+		// Owned by each index buffer, so that index buffers can be filled from different threads.
+		std::vector<unsigned short> m_shortIndices;
 	};
 
 } // namespace Graphics
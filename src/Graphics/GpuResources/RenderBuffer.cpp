@@ -19,6 +19,7 @@ namespace Graphics
 		PK_ASSERT(samplesPerPixel > 0, "Trying to create a RenderBuffer with samples per pixel <= 0", "Pekan");
 
 		GLCall(glGenRenderbuffers(1, &m_id));
+		GraphicsBackend::onCreateResource(GpuResourceType::RenderBuffer, m_id);
 		bind();
 		
 		if (samplesPerPixel > 1)
@@ -36,6 +37,7 @@ namespace Graphics
 	{
 		PK_ASSERT(isValid(), "Trying to destroy a RenderBuffer instance that is not yet created.", "Pekan");
 
+		GraphicsBackend::onDestroyResource(GpuResourceType::RenderBuffer, m_id);
 		GLCall(glDeleteRenderbuffers(1, &m_id));
 		m_id = 0;
 	}
@@ -25,23 +25,27 @@ namespace Graphics {
 
 		m_hasShadersAttached = false;
 		GLCall(m_id = glCreateProgram());
+		GraphicsBackend::onCreateResource(GpuResourceType::Shader, m_id);
 	}
 
-	void Shader::create(const char* vertexShaderSource, const char* fragmentShaderSource)
+	bool Shader::create(const char* vertexShaderSource, const char* fragmentShaderSource)
 	{
 		PK_ASSERT(!isValid(), "Trying to create a Shader instance that is already created.", "Pekan");
 
 		m_hasShadersAttached = false;
 		GLCall(m_id = glCreateProgram());
-		setSource(vertexShaderSource, fragmentShaderSource);
+		GraphicsBackend::onCreateResource(GpuResourceType::Shader, m_id);
+		const bool success = setSource(vertexShaderSource, fragmentShaderSource);
 		// We can bind the shader once we set its source
 		bind();
+		return success;
 	}
 
 	void Shader::destroy()
 	{
 		PK_ASSERT(isValid(), "Trying to destroy a Shader instance that is not yet created.", "Pekan");
 
+		GraphicsBackend::onDestroyResource(GpuResourceType::Shader, m_id);
 		GLCall(glDeleteProgram(m_id));
 		m_id = 0;
 
@@ -51,7 +55,7 @@ namespace Graphics {
 		m_uniformLocationCache.clear();
 	}
 
-	void Shader::setSource(const char* vertexShaderSource, const char* fragmentShaderSource)
+	bool Shader::setSource(const char* vertexShaderSource, const char* fragmentShaderSource)
 	{
 		PK_ASSERT(isValid(), "Trying to set source to a Shader that is not yet created.", "Pekan");
 
@@ -68,19 +72,25 @@ namespace Graphics {
 		GLCall(glAttachShader(m_id, vertexShaderID));
 		GLCall(glAttachShader(m_id, fragmentShaderID));
 		GLCall(glLinkProgram(m_id));
-		// Check if program linked successfully
-		int success;
-		GLCall(glGetProgramiv(m_id, GL_LINK_STATUS, &success));
-		if (!success) {
-			char infoLog[512];
-			GLCall(glGetProgramInfoLog(m_id, 512, nullptr, infoLog));
-			PK_LOG_ERROR("Shader program linking failed: " << infoLog, "Pekan");
+		// Check if program linked successfully.
+		// A program fails to link if any of its shaders failed to compile, so this covers compilation too.
+		bool isLinked = true;
+		if (GraphicsBackend::isOpenGL()) {
+			int success = GL_FALSE;
+			GLCall(glGetProgramiv(m_id, GL_LINK_STATUS, &success));
+			if (!success) {
+				char infoLog[512];
+				GLCall(glGetProgramInfoLog(m_id, 512, nullptr, infoLog));
+				PK_LOG_ERROR("Shader program linking failed: " << infoLog, "Pekan");
+				isLinked = false;
+			}
 		}
 		// Delete the individual shaders, as the shader program has them now
 		GLCall(glDeleteShader(vertexShaderID));
 		GLCall(glDeleteShader(fragmentShaderID));
 
 		m_hasShadersAttached = true;
+		return isLinked;
 	}
 
 	void Shader::bind() const {
@@ -291,16 +301,19 @@ namespace Graphics {
 	unsigned Shader::compileShader(unsigned shaderType, const char* sourceCode) {
 		PK_ASSERT(isValid(), "Trying to compile a Shader that is not yet created.", "Pekan");
 
-		GLCall(const unsigned shaderID = glCreateShader(shaderType));
+		unsigned shaderID = 0;
+		GLCall(shaderID = glCreateShader(shaderType));
 		GLCall(glShaderSource(shaderID, 1, &sourceCode, nullptr));
 		GLCall(glCompileShader(shaderID));
 
-		int success;
-		GLCall(glGetShaderiv(shaderID, GL_COMPILE_STATUS, &success));
-		if (!success) {
-			char infoLog[512];
-			GLCall(glGetShaderInfoLog(shaderID, 512, nullptr, infoLog));
-			PK_LOG_ERROR("Shader compilation failed: " << infoLog, "Pekan");
+		if (GraphicsBackend::isOpenGL()) {
+			int success = GL_FALSE;
+			GLCall(glGetShaderiv(shaderID, GL_COMPILE_STATUS, &success));
+			if (!success) {
+				char infoLog[512];
+				GLCall(glGetShaderInfoLog(shaderID, 512, nullptr, infoLog));
+				PK_LOG_ERROR("Shader compilation failed: " << infoLog, "Pekan");
+			}
 		}
 		return shaderID;
 	}
@@ -314,9 +327,12 @@ namespace Graphics {
 			return cacheIt->second;
 		}
 		// Otherwise retrieve it by asking OpenGL for the location
-		GLCall(const int location = glGetUniformLocation(m_id, uniformName.c_str()));
-		if (location < 0) {
-			PK_LOG_ERROR("Trying to set value for uniform \"" << uniformName << "\" inside a shader, but such uniform doesn't exist.", "Pekan");
+		int location = 0;
+		if (GraphicsBackend::isOpenGL()) {
+			GLCall(location = glGetUniformLocation(m_id, uniformName.c_str()));
+			if (location < 0) {
+				PK_LOG_ERROR("Trying to set value for uniform \"" << uniformName << "\" inside a shader, but such uniform doesn't exist.", "Pekan");
+			}
 		}
 		// Cache the location so that it can be reused in next calls to this function
 		m_uniformLocationCache[uniformName] = location;
@@ -330,12 +346,12 @@ namespace Graphics {
 		int shaderCount = 0;
 		unsigned shaders[MAX_SHADERS_ATTACHED];
 		// Get attached shaders
-		glGetAttachedShaders(m_id, MAX_SHADERS_ATTACHED, &shaderCount, shaders);
+		GLCall(glGetAttachedShaders(m_id, MAX_SHADERS_ATTACHED, &shaderCount, shaders));
 		// Detach and delete each shader
 		for (int i = 0; i < shaderCount; i++)
 		{
-			glDetachShader(m_id, shaders[i]);
-			glDeleteShader(shaders[i]);
+			GLCall(glDetachShader(m_id, shaders[i]));
+			GLCall(glDeleteShader(shaders[i]));
 		}
 
 		m_hasShadersAttached = false;
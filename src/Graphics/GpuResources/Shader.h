@@ -19,12 +19,14 @@ namespace Graphics {
 
 		// Creates the underlying shader program object
 		void create();
-		// Creates the underlying shader program object with given source code for vertex shader and fragment shader
-		void create(const char* vertexShaderSource, const char* fragmentShaderSource);
+		// Creates the underlying shader program object with given source code for vertex shader and fragment shader.
+		// Returns false if the shader program failed to compile or link.
+		bool create(const char* vertexShaderSource, const char* fragmentShaderSource);
 		void destroy();
 
-		// Sets source code of vertex shader and fragment shader to be used for this shader program
-		void setSource(const char* vertexShaderSource, const char* fragmentShaderSource);
+		// Sets source code of vertex shader and fragment shader to be used for this shader program.
+		// Returns false if the shader program failed to compile or link.
+		bool setSource(const char* vertexShaderSource, const char* fragmentShaderSource);
 
 		void bind() const;
 		void unbind() const;
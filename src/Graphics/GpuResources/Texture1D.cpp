@@ -23,6 +23,7 @@ namespace Graphics {
 		PK_ASSERT(!isValid(), "Trying to create a Texture1D instance that is already created.", "Pekan");
 
 		GLCall(glGenTextures(1, &m_id));
+		GraphicsBackend::onCreateResource(GpuResourceType::Texture1D, m_id);
 		bind();
 
 		// Configure the default minify and magnify functions of the texture
@@ -46,6 +47,7 @@ namespace Graphics {
 	{
 		PK_ASSERT(isValid(), "Trying to destroy a Texture1D instance that is not yet created.", "Pekan");
 
+		GraphicsBackend::onDestroyResource(GpuResourceType::Texture1D, m_id);
 		GLCall(glDeleteTextures(1, &m_id));
 		m_id = 0;
 	}
@@ -59,6 +61,7 @@ namespace Graphics {
 		// Set colors data to the texture object
 		const unsigned textureSize = static_cast<unsigned>(colors.size());
 		GLCall(glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA32F, textureSize, 0, GL_RGBA, GL_FLOAT, colors.data()));
+		GraphicsBackend::onUploadData(GpuResourceType::Texture1D, m_id, (long long)(colors.size() * sizeof(glm::vec4)));
 	}
 
 	void Texture1D::bind() const
@@ -31,6 +31,7 @@ namespace Graphics {
 		PK_ASSERT(!isValid(), "Trying to create a Texture2D instance that is already created.", "Pekan");
 
 		GLCall(glGenTextures(1, &m_id));
+		GraphicsBackend::onCreateResource(GpuResourceType::Texture2D, m_id);
 		bind();
 
 		// Configure the default minify and magnify functions of the texture
@@ -55,6 +56,7 @@ namespace Graphics {
 	{
 		PK_ASSERT(isValid(), "Trying to destroy a Texture2D instance that is not yet created.", "Pekan");
 
+		GraphicsBackend::onDestroyResource(GpuResourceType::Texture2D, m_id);
 		GLCall(glDeleteTextures(1, &m_id));
 		m_id = 0;
 	}
@@ -75,8 +77,25 @@ namespace Graphics {
 		unsigned format = 0, internalFormat = 0;
 		getFormat(image, format, internalFormat);
 		GLCall(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, image.getWidth(), image.getHeight(), 0, format, DEFAULT_PIXEL_TYPE, image.getData()));
+		GraphicsBackend::onUploadData(GpuResourceType::Texture2D, m_id, (long long)(image.getWidth()) * image.getHeight() * image.getNumChannels());
 		// Generate mipmaps
 		GLCall(glGenerateMipmap(GL_TEXTURE_2D));
+
+		// Only images with an alpha channel can have translucent texels, so look for one in them
+		m_isOpaque = true;
+		if (image.getNumChannels() == 4)
+		{
+			const size_t texelsCount = size_t(image.getWidth()) * size_t(image.getHeight());
+			const unsigned char* data = image.getData();
+			for (size_t i = 0; i < texelsCount; i++)
+			{
+				if (data[i * 4 + 3] != 255)
+				{
+					m_isOpaque = false;
+					break;
+				}
+			}
+		}
 	}
 
 	void Texture2D::setSize(int width, int height, int numChannels)
@@ -90,6 +109,9 @@ namespace Graphics {
 		unsigned format = 0, internalFormat = 0;
 		getFormat(numChannels, format, internalFormat);
 		GLCall(glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, DEFAULT_PIXEL_TYPE, nullptr));
+
+		// Texels are not known, so with an alpha channel they may be translucent
+		m_isOpaque = (numChannels != 4);
 	}
 
 	void Texture2D::bind() const
@@ -60,6 +60,11 @@ namespace Graphics {
 		// Checks if texture is valid, meaning that it has been successfully created and not yet destroyed
 		bool isValid() const { return m_id != 0; }
 
+		// Checks if all of texture's texels are fully opaque.
+		// A texture without an alpha channel is always opaque. A texture with an alpha channel is opaque
+		// only if the last image set to it has no translucent texels, so a texture with only a size set is not.
+		bool isOpaque() const { return m_isOpaque; }
+
 	private: /* functions */
 
 		// Determines the format (and internal format) that a texture must have to support a given image
@@ -72,6 +77,9 @@ namespace Graphics {
 
 		// Texture's ID on the GPU
 		unsigned m_id = 0;
+
+		// Flag indicating if all of texture's texels are fully opaque
+		bool m_isOpaque = true;
 	};
 
 	typedef std::shared_ptr<Texture2D> Texture2D_Ptr;
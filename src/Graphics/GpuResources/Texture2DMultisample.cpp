@@ -25,6 +25,7 @@ namespace Graphics {
 		m_samplesPerTexel = samplesPerTexel;
 
 		GLCall(glGenTextures(1, &m_id));
+		GraphicsBackend::onCreateResource(GpuResourceType::Texture2DMultisample, m_id);
 		bind();
 	}
 
@@ -32,6 +33,7 @@ namespace Graphics {
 	{
 		PK_ASSERT(isValid(), "Trying to destroy a Texture2DMultisample instance that is not yet created.", "Pekan");
 
+		GraphicsBackend::onDestroyResource(GpuResourceType::Texture2DMultisample, m_id);
 		GLCall(glDeleteTextures(1, &m_id));
 		m_id = 0;
 	}
@@ -23,6 +23,7 @@ namespace Graphics
 		PK_ASSERT(!isValid(), "Trying to create a VertexArray instance that is already created.", "Pekan");
 
 		GLCall(glGenVertexArrays(1, &m_id));
+		GraphicsBackend::onCreateResource(GpuResourceType::VertexArray, m_id);
 		bind();
 	}
 
@@ -30,6 +31,7 @@ namespace Graphics
 	{
 		PK_ASSERT(isValid(), "Trying to destroy a VertexArray instance that is not yet created.", "Pekan");
 
+		GraphicsBackend::onDestroyResource(GpuResourceType::VertexArray, m_id);
 		GLCall(glDeleteVertexArrays(1, &m_id));
 		m_id = 0;
 
@@ -91,7 +93,7 @@ namespace Graphics
 					i,
 					element.getComponentsCount(),
 					RenderState::getShaderDataTypeOpenGLBaseType(element.type),
-					element.normalized ? GL_TRUE : GL_FALSE,
+					(element.normalized || RenderState::isShaderDataTypeNormalized(element.type)) ? GL_TRUE : GL_FALSE,
 					layout.getStride(),
 					reinterpret_cast<GLvoid*>((long long)(element.getOffset()))
 				));
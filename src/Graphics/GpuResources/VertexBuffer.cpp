@@ -55,6 +55,7 @@ namespace Graphics
 		PK_ASSERT(!isValid(), "Trying to create a VertexBuffer instance that is already created.", "Pekan");
 
 		GLCall(glGenBuffers(1, &m_id));
+		GraphicsBackend::onCreateResource(GpuResourceType::VertexBuffer, m_id);
 		bind();
 
 		m_size = 0;
@@ -71,6 +72,7 @@ namespace Graphics
 		PK_ASSERT(size >= 0, "Cannot create a VertexBuffer with a negative size.", "Pekan");
 
 		GLCall(glGenBuffers(1, &m_id));
+		GraphicsBackend::onCreateResource(GpuResourceType::VertexBuffer, m_id);
 		setData(data, size, dataUsage);
 	}
 
@@ -78,6 +80,7 @@ namespace Graphics
 	{
 		PK_ASSERT(isValid(), "Trying to destroy a VertexBuffer instance that is not yet created.", "Pekan");
 
+		GraphicsBackend::onDestroyResource(GpuResourceType::VertexBuffer, m_id);
 		GLCall(glDeleteBuffers(1, &m_id));
 		m_id = 0;
 	}
@@ -89,6 +92,7 @@ namespace Graphics
 
 		bind();
 		GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, RenderState::getBufferDataUsageOpenGLEnum(dataUsage)));
+		GraphicsBackend::onUploadData(GpuResourceType::VertexBuffer, m_id, size);
 		m_size = size;
 	}
 
@@ -100,6 +104,7 @@ namespace Graphics
 
 		bind();
 		GLCall(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
+		GraphicsBackend::onUploadData(GpuResourceType::VertexBuffer, m_id, size);
 	}
 
 	void VertexBuffer::bind() const
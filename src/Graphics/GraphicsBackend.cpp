@@ -0,0 +1,210 @@
+#include "GraphicsBackend.h"
+
+#include <sstream>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	static GraphicsBackendStats g_stats;
+
+	static std::vector<RecordedCommand> g_recordedCommands;
+
+	// Last fake ID assigned to a resource by a headless backend
+	static unsigned g_lastResourceId = 0;
+
+	static const char* getGpuResourceTypeName(GpuResourceType type)
+	{
+		switch (type)
+		{
+			case GpuResourceType::None:                    return "None";
+			case GpuResourceType::VertexBuffer:            return "VertexBuffer";
+			case GpuResourceType::IndexBuffer:             return "IndexBuffer";
+			case GpuResourceType::VertexArray:             return "VertexArray";
+			case GpuResourceType::Shader:                  return "Shader";
+			case GpuResourceType::Texture1D:               return "Texture1D";
+			case GpuResourceType::Texture2D:               return "Texture2D";
+			case GpuResourceType::Texture2DMultisample:    return "Texture2DMultisample";
+			case GpuResourceType::FrameBuffer:             return "FrameBuffer";
+			case GpuResourceType::RenderBuffer:            return "RenderBuffer";
+			case GpuResourceType::PixelPackBuffer:         return "PixelPackBuffer";
+			case GpuResourceType::TimerQuery:              return "TimerQuery";
+		}
+		return "Unknown";
+	}
+
+	// Appends a command to recorded commands, if recording backend is used
+	static void record(const RecordedCommand& command)
+	{
+		if (GraphicsBackend::getType() == GraphicsBackendType::Recording)
+		{
+			g_recordedCommands.push_back(command);
+		}
+	}
+
+	void GraphicsBackend::setType(GraphicsBackendType type)
+	{
+		s_type = type;
+		g_lastResourceId = 0;
+		resetStats();
+		clearRecordedCommands();
+	}
+
+	const GraphicsBackendStats& GraphicsBackend::getStats()
+	{
+		return g_stats;
+	}
+
+	void GraphicsBackend::resetStats()
+	{
+		g_stats = GraphicsBackendStats();
+	}
+
+	const std::vector<RecordedCommand>& GraphicsBackend::getRecordedCommands()
+	{
+		return g_recordedCommands;
+	}
+
+	void GraphicsBackend::clearRecordedCommands()
+	{
+		g_recordedCommands.clear();
+	}
+
+	std::string GraphicsBackend::dumpRecordedCommands()
+	{
+		std::ostringstream stream;
+		for (size_t i = 0; i < g_recordedCommands.size(); i++)
+		{
+			const RecordedCommand& command = g_recordedCommands[i];
+			stream << "#" << i << " ";
+			switch (command.type)
+			{
+				case RecordedCommandType::CreateResource:
+					stream << "CreateResource " << getGpuResourceTypeName(command.resourceType) << " id=" << command.resourceId;
+					break;
+				case RecordedCommandType::DestroyResource:
+					stream << "DestroyResource " << getGpuResourceTypeName(command.resourceType) << " id=" << command.resourceId;
+					break;
+				case RecordedCommandType::UploadData:
+					stream << "UploadData " << getGpuResourceTypeName(command.resourceType) << " id=" << command.resourceId << " size=" << command.size;
+					break;
+				case RecordedCommandType::Draw:
+					stream << "Draw elementsCount=" << command.size << " mode=" << int(command.drawMode);
+					break;
+				case RecordedCommandType::DrawIndexed:
+					stream << "DrawIndexed elementsCount=" << command.size << " mode=" << int(command.drawMode) << " indexSize=" << RenderState::getIndexTypeSize(command.indexType);
+					break;
+				case RecordedCommandType::Clear:
+					stream << "Clear color=" << command.doClearColorBuffer << " depth=" << command.doClearDepthBuffer;
+					break;
+			}
+			stream << "\n";
+		}
+		return stream.str();
+	}
+
+	void GraphicsBackend::onCreateResource(GpuResourceType resourceType, unsigned& id)
+	{
+		g_stats.createdResourcesCount++;
+		if (s_type == GraphicsBackendType::OpenGL)
+		{
+			return;
+		}
+
+		id = ++g_lastResourceId;
+
+		RecordedCommand command;
+		command.type = RecordedCommandType::CreateResource;
+		command.resourceType = resourceType;
+		command.resourceId = id;
+		record(command);
+	}
+
+	void GraphicsBackend::onDestroyResource(GpuResourceType resourceType, unsigned id)
+	{
+		g_stats.destroyedResourcesCount++;
+		if (s_type == GraphicsBackendType::OpenGL)
+		{
+			return;
+		}
+
+		RecordedCommand command;
+		command.type = RecordedCommandType::DestroyResource;
+		command.resourceType = resourceType;
+		command.resourceId = id;
+		record(command);
+	}
+
+	void GraphicsBackend::onUploadData(GpuResourceType resourceType, unsigned id, long long size)
+	{
+		g_stats.uploadsCount++;
+		g_stats.uploadedBytes += size;
+		if (s_type == GraphicsBackendType::OpenGL)
+		{
+			return;
+		}
+
+		RecordedCommand command;
+		command.type = RecordedCommandType::UploadData;
+		command.resourceType = resourceType;
+		command.resourceId = id;
+		command.size = size;
+		record(command);
+	}
+
+	void GraphicsBackend::onDraw(unsigned elementsCount, DrawMode mode)
+	{
+		g_stats.drawCallsCount++;
+		g_stats.drawnElementsCount += elementsCount;
+		if (s_type == GraphicsBackendType::OpenGL)
+		{
+			return;
+		}
+
+		RecordedCommand command;
+		command.type = RecordedCommandType::Draw;
+		command.size = elementsCount;
+		command.drawMode = mode;
+		record(command);
+	}
+
+	void GraphicsBackend::onDrawIndexed(unsigned elementsCount, DrawMode mode, IndexType indexType)
+	{
+		g_stats.drawCallsCount++;
+		g_stats.drawnElementsCount += elementsCount;
+		if (s_type == GraphicsBackendType::OpenGL)
+		{
+			return;
+		}
+
+		RecordedCommand command;
+		command.type = RecordedCommandType::DrawIndexed;
+		command.size = elementsCount;
+		command.drawMode = mode;
+		command.indexType = indexType;
+		record(command);
+	}
+
+	void GraphicsBackend::onClear(bool doClearColorBuffer, bool doClearDepthBuffer)
+	{
+		g_stats.clearsCount++;
+		if (s_type == GraphicsBackendType::OpenGL)
+		{
+			return;
+		}
+
+		RecordedCommand command;
+		command.type = RecordedCommandType::Clear;
+		command.doClearColorBuffer = doClearColorBuffer;
+		command.doClearDepthBuffer = doClearDepthBuffer;
+		record(command);
+	}
+
+	void GraphicsBackend::onSkippedGLCall()
+	{
+		g_stats.glCallsCount++;
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "RenderState.h"
+#include "RenderCommands.h"
+
+#include <string>
+#include <vector>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// Enum for backends that the Graphics subsystem can run on
+	enum class GraphicsBackendType
+	{
+		// Renders with OpenGL. Requires an OpenGL context.
+		OpenGL,
+		// Doesn't render anything and doesn't need an OpenGL context.
+		// Only counts calls and uploaded bytes, like all backends do, available in GraphicsBackend::getStats().
+		Null,
+		// Same as Null, but additionally stores the stream of executed commands,
+		// available in GraphicsBackend::getRecordedCommands().
+		Recording
+	};
+
+	// Enum for types of GPU resources, used by headless backends
+	enum class GpuResourceType
+	{
+		None,
+		VertexBuffer,
+		IndexBuffer,
+		VertexArray,
+		Shader,
+		Texture1D,
+		Texture2D,
+		Texture2DMultisample,
+		FrameBuffer,
+		RenderBuffer,
+		PixelPackBuffer,
+		TimerQuery
+	};
+
+	// Statistics gathered by all backends
+	struct GraphicsBackendStats
+	{
+		// Number of OpenGL calls that were skipped because there is no OpenGL context.
+		// Always 0 with the OpenGL backend.
+		long long glCallsCount = 0;
+
+		// Number of draw calls, including indexed ones, and total number of elements drawn by them
+		long long drawCallsCount = 0;
+		long long drawnElementsCount = 0;
+
+		long long clearsCount = 0;
+
+		long long createdResourcesCount = 0;
+		long long destroyedResourcesCount = 0;
+
+		// Number of data uploads to buffers and textures, and total number of bytes uploaded by them
+		long long uploadsCount = 0;
+		long long uploadedBytes = 0;
+	};
+
+	// Enum for types of commands stored by the recording backend
+	enum class RecordedCommandType
+	{
+		CreateResource,
+		DestroyResource,
+		UploadData,
+		Draw,
+		DrawIndexed,
+		Clear
+	};
+
+	// A command stored by the recording backend
+	struct RecordedCommand
+	{
+		RecordedCommandType type = RecordedCommandType::Draw;
+
+		// Type and ID of the resource that the command operates on, if any
+		GpuResourceType resourceType = GpuResourceType::None;
+		unsigned resourceId = 0;
+
+		// Number of bytes uploaded for UploadData commands,
+		// or number of elements drawn for Draw and DrawIndexed commands.
+		long long size = 0;
+
+		// Draw mode and index type of Draw and DrawIndexed commands
+		DrawMode drawMode = DrawMode::Triangles;
+		IndexType indexType = IndexType::UnsignedInt;
+
+		// Cleared buffers of Clear commands
+		bool doClearColorBuffer = false;
+		bool doClearDepthBuffer = false;
+	};
+
+	// A static class managing the backend that the Graphics subsystem runs on.
+	//
+	// By default the OpenGL backend is used. Headless backends (Null and Recording) don't need an OpenGL context,
+	// so they can be used on machines without a GPU, for example for measuring the CPU cost of rendering a scene.
+	// With a headless backend all OpenGL calls are skipped, GPU resources get fake IDs assigned in a deterministic order,
+	// and render commands, resource creation and data uploads are recorded, with the Recording backend.
+	// With all backends, including OpenGL, render commands, resource creation and data uploads are counted in stats.
+	class GraphicsBackend
+	{
+	public:
+
+		// Sets the type of backend to be used. Resets stats and recorded commands.
+		// Must be set before any GPU resources are created,
+		// and before the Graphics subsystem is initialized, so that it knows whether to load OpenGL.
+		static void setType(GraphicsBackendType type);
+		static GraphicsBackendType getType() { return s_type; }
+
+		// Checks if OpenGL backend is used, meaning that OpenGL calls should be executed.
+		//
+		// With a headless backend OpenGL calls are skipped (see GLCall), so there is nothing to compile, link, check or query.
+		// Code that reads a result back from OpenGL should do so only if this returns true,
+		// and otherwise consider the operation successful, or use a sensible default value.
+		// Inline, since it's checked before each OpenGL call.
+		static bool isOpenGL() { return s_type == GraphicsBackendType::OpenGL; }
+
+		// Returns stats gathered since the last reset.
+		// Stats are gathered by all backends, so they can be used for reporting draw calls and uploads of real frames too.
+		static const GraphicsBackendStats& getStats();
+		static void resetStats();
+
+		// Returns commands stored by the recording backend since the last clear
+		static const std::vector<RecordedCommand>& getRecordedCommands();
+		static void clearRecordedCommands();
+
+		// Returns a human-readable description of all recorded commands, one command per line.
+		// Resources are identified by their fake IDs, so the description is deterministic
+		// and can be compared between runs.
+		static std::string dumpRecordedCommands();
+
+		// Functions notifying the backend about executed operations, used internally by Graphics.
+		// With the OpenGL backend they only update stats.
+
+		// Assigns a fake ID to a newly created resource
+		static void onCreateResource(GpuResourceType resourceType, unsigned& id);
+		static void onDestroyResource(GpuResourceType resourceType, unsigned id);
+		static void onUploadData(GpuResourceType resourceType, unsigned id, long long size);
+		static void onDraw(unsigned elementsCount, DrawMode mode);
+		static void onDrawIndexed(unsigned elementsCount, DrawMode mode, IndexType indexType);
+		static void onClear(bool doClearColorBuffer, bool doClearDepthBuffer);
+		static void onSkippedGLCall();
+
+	private: /* variables */
+
+		inline static GraphicsBackendType s_type = GraphicsBackendType::OpenGL;
+	};
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
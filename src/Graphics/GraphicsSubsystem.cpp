@@ -5,11 +5,21 @@
 #include "RenderCommands.h"
 #include "RenderState.h"
 #include "PostProcessor.h"
+#include "ShaderCache.h"
+#include "GpuProfiler.h"
+#include "FrameBuffer.h"
+#include "FrameBufferReadback.h"
+#include "ImageSequenceWriter.h"
+#include "Image.h"
 #include "PekanLogger.h"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace Pekan
 {
 namespace Graphics
@@ -21,6 +31,20 @@ namespace Graphics
 
 	static GraphicsSubsystem g_graphicsSystem;
 
+	// Flag indicating if the Graphics subsystem is initialized, used to prevent changing the backend while running
+	static bool g_isInitialized = false;
+
+	// Frame buffer where an offscreen application renders its frames
+	static FrameBuffer g_offscreenFrameBuffer;
+	// Pixels read from the offscreen frame buffer, reused between frames to avoid allocations
+	static std::vector<unsigned char> g_offscreenPixels;
+	// Readback and writer used when an offscreen application writes all of its frames,
+	// so that frames are read and written without stalling rendering
+	static FrameBufferReadback g_offscreenReadback;
+	static ImageSequenceWriter g_offscreenWriter;
+
+	static void initOffscreenRendering(PekanApplication* application, const OffscreenProperties& offscreenProperties);
+
 	void GraphicsSubsystem::registerAsSubsystem()
 	{
 		SubsystemManager::registerSubsystem(&g_graphicsSystem);
@@ -50,17 +74,46 @@ namespace Graphics
 		// Log OpenGL version
 		PK_LOG_INFO("Successfully loaded OpenGL " << glGetString(GL_VERSION), "Pekan");
 
+		// Check that window's frame buffer has a depth buffer, which rendering relies on for resolving overlap order
+		int depthBits = 0;
+		glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_DEPTH, GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE, &depthBits);
+		if (depthBits <= 0)
+		{
+			PK_LOG_ERROR("Window's frame buffer has no depth buffer. Overlapping renderables will not be rendered in the right order.", "Pekan");
+		}
+
 		return true;
 	}
 
+	void GraphicsSubsystem::setBackend(GraphicsBackendType backendType)
+	{
+		PK_ASSERT(!g_isInitialized, "Trying to set Graphics backend after the Graphics subsystem is initialized.", "Pekan");
+		GraphicsBackend::setType(backendType);
+	}
+
 	bool GraphicsSubsystem::init()
 	{
-		if (!loadOpenGL())
+		// A headless window has no OpenGL context, so there is nothing to render with OpenGL
+		if (GraphicsBackend::isOpenGL() && PekanEngine::getWindow().isHeadless())
 		{
-			PK_LOG_ERROR("Failed to load OpenGL when initializing the Graphics subsystem.", "Pekan");
+			PK_LOG_ERROR("Application runs headless, without an OpenGL context, so Graphics can't run on the OpenGL backend. Use a headless backend instead.", "Pekan");
 			return false;
 		}
 
+		// Load OpenGL only if we are going to render with it. Headless backends don't use the OpenGL context.
+		if (GraphicsBackend::isOpenGL())
+		{
+			if (!loadOpenGL())
+			{
+				PK_LOG_ERROR("Failed to load OpenGL when initializing the Graphics subsystem.", "Pekan");
+				return false;
+			}
+		}
+		else
+		{
+			PK_LOG_INFO("Graphics subsystem is running on a headless backend. Nothing will be rendered.", "Pekan");
+		}
+
 		// Get application
 		PekanApplication* application = PekanEngine::getApplication();
 		if (application == nullptr)
@@ -68,8 +121,17 @@ namespace Graphics
 			PK_LOG_ERROR("No application found when initializing the Graphics subsystem.", "Pekan");
 			return false;
 		}
+		const ApplicationProperties properties = application->getProperties();
+
+		// If application runs offscreen, make it render into a frame buffer.
+		// (Must be done before registering the clearing callback, so that the frame buffer is bound before it's cleared)
+		if (properties.offscreenProperties.enabled)
+		{
+			initOffscreenRendering(application, properties.offscreenProperties);
+		}
+
 		// If application wants automatic clearing of window between frames
-		if (application->getProperties().windowProperties.shouldClearAutomatically)
+		if (properties.windowProperties.shouldClearAutomatically)
 		{
 			// Set default background color to black
 			RenderState::setBackgroundColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -86,12 +148,126 @@ namespace Graphics
 			);
 		}
 
+		// Read GPU pass timings at the end of each frame, and feed them into the Profiler
+		if (GpuProfiler::isSupported())
+		{
+			application->registerOnFrameEndCallback([]() { GpuProfiler::update(); });
+		}
+
+		// If application wants FXAA, anti-alias each frame with PostProcessor's FXAA pass
+		if (properties.antiAliasingMode == AntiAliasingMode::Fxaa)
+		{
+			PostProcessor::setFxaaEnabled(true);
+		}
+
+		// If application wants dynamic resolution scaling, let PostProcessor render frames at a scaled resolution
+		if (properties.dynamicResolutionProperties.enabled)
+		{
+			PostProcessor::setDynamicResolution(properties.dynamicResolutionProperties);
+		}
+
+		g_isInitialized = true;
 		return true;
 	}
 
 	void GraphicsSubsystem::exit()
 	{
 		PostProcessor::exit();
+		// Must be exited after PostProcessor, whose passes use cached shaders
+		ShaderCache::exit();
+		GpuProfiler::exit();
+
+		if (g_offscreenReadback.isValid())
+		{
+			// Deliver frames still in flight to the writer, and wait for the writer to write them
+			g_offscreenReadback.flush();
+			g_offscreenReadback.destroy();
+			g_offscreenWriter.stop();
+		}
+		if (g_offscreenFrameBuffer.isValid())
+		{
+			FrameBuffer::setDefault(nullptr);
+			g_offscreenFrameBuffer.destroy();
+		}
+
+		g_isInitialized = false;
+	}
+
+	// Reads the current frame from the offscreen frame buffer and writes it to an image file, if it needs to be written
+	static void writeOffscreenFrame(long long frameIndex, const OffscreenProperties& offscreenProperties)
+	{
+		// If all frames are written, read them back asynchronously and let the writer write them on its thread
+		if (offscreenProperties.writeAllFrames)
+		{
+			g_offscreenReadback.update();
+			// If all readback buffers are still in flight, wait for them instead of dropping a frame
+			if (g_offscreenReadback.getPendingCount() == g_offscreenReadback.getRingSize())
+			{
+				g_offscreenReadback.flush();
+			}
+			g_offscreenReadback.requestReadback(g_offscreenFrameBuffer, frameIndex);
+			return;
+		}
+
+		// Otherwise only the last frame is written, so there is nothing to gain from reading it asynchronously
+		const bool isLastFrame = (frameIndex == offscreenProperties.framesCount - 1);
+		if (!isLastFrame)
+		{
+			return;
+		}
+		if (!g_offscreenFrameBuffer.readPixels(g_offscreenPixels))
+		{
+			PK_LOG_ERROR("Failed to read pixels of an offscreen frame.", "Pekan");
+			return;
+		}
+		const Image image(g_offscreenPixels.data(), g_offscreenFrameBuffer.getWidth(), g_offscreenFrameBuffer.getHeight(), 4);
+		image.save(offscreenProperties.outputFilepath.c_str());
+	}
+
+	static void initOffscreenRendering(PekanApplication* application, const OffscreenProperties& offscreenProperties)
+	{
+		// Create a frame buffer with the size of the window, and make it the default one,
+		// so that anything rendered to "the screen" ends up inside of it
+		const glm::ivec2 windowSize = PekanEngine::getWindow().getSize();
+		g_offscreenFrameBuffer.create(windowSize.x, windowSize.y, 1);
+		FrameBuffer::setDefault(&g_offscreenFrameBuffer);
+
+		// Bind the frame buffer at the beginning of each frame
+		application->registerOnFrameBeginCallback
+		(
+			[]()
+			{
+				g_offscreenFrameBuffer.bind();
+			}
+		);
+
+		// With a headless backend nothing is rendered, so there are no frames to write
+		if (!GraphicsBackend::isOpenGL())
+		{
+			return;
+		}
+
+		if (offscreenProperties.writeAllFrames)
+		{
+			g_offscreenReadback.create(windowSize.x, windowSize.y);
+			g_offscreenWriter.start(offscreenProperties.outputFilepath);
+			g_offscreenReadback.setCallback
+			(
+				[](const ReadbackFrame& frame)
+				{
+					g_offscreenWriter.write(frame);
+				}
+			);
+		}
+
+		// Write the rendered frame at the end of each frame
+		application->registerOnFrameEndCallback
+		(
+			[application, offscreenProperties]()
+			{
+				writeOffscreenFrame(application->getFrameIndex(), offscreenProperties);
+			}
+		);
 	}
 
 #if PK_OPENGL_VERSION_MAJOR >= 4 && PK_OPENGL_VERSION_MINOR >= 3
@@ -108,13 +284,38 @@ namespace Graphics
 		const void* userParam
 	)
 	{
+		// Errors are never rate limited, so they can share a single call site
+		if (severity == GL_DEBUG_SEVERITY_HIGH)
+		{
+			PK_LOG_ERROR(message, "OpenGL");
+			return;
+		}
+
+#if PK_LOGGER_SUPPORT
+		Logger::LogLevel level = Logger::LogLevel::Debug;
 		switch (severity)
 		{
-			case GL_DEBUG_SEVERITY_HIGH:            PK_LOG_ERROR(message, "OpenGL");      break;
-			case GL_DEBUG_SEVERITY_MEDIUM:          PK_LOG_WARNING(message, "OpenGL");    break;
-			case GL_DEBUG_SEVERITY_LOW:             PK_LOG_INFO(message, "OpenGL");       break;
-			case GL_DEBUG_SEVERITY_NOTIFICATION:    PK_LOG_DEBUG(message, "OpenGL");      break;
+			case GL_DEBUG_SEVERITY_MEDIUM:          level = Logger::LogLevel::Warning;    break;
+			case GL_DEBUG_SEVERITY_LOW:             level = Logger::LogLevel::Info;       break;
+			case GL_DEBUG_SEVERITY_NOTIFICATION:    level = Logger::LogLevel::Debug;      break;
+			default:                                return;
+		}
+
+		// Rate limiting is done per call site, so give each message ID a call site of its own.
+		// Otherwise a single noisy message would suppress all other OpenGL messages.
+		// Debug output is synchronous, so the callback is only called on the thread owning the OpenGL context.
+		// Call sites are never destroyed, because logger keeps pointers to those that have suppressed messages.
+		static std::unordered_map<unsigned long long, Logger::_LogCallSite*> callSites;
+		Logger::_LogCallSite*& callSite = callSites[((unsigned long long)(level) << 32) | id];
+		if (callSite == nullptr)
+		{
+			callSite = new Logger::_LogCallSite(level, "OpenGL", PK_SOURCE_FILE, __LINE__);
+		}
+		if (callSite->isEnabled() && callSite->passesRateLimit())
+		{
+			Logger::_logFormatted(*callSite, "{} (ID {})", message, id);
 		}
+#endif
 	}
 
 	// Enables OpenGL's debug output and binds our callback function
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ISubsystem.h"
+#include "GraphicsBackend.h"
 
 namespace Pekan
 {
@@ -26,6 +27,13 @@ namespace Graphics
 		// Loads OpenGL function pointers
 		static bool loadOpenGL();
 
+		// Sets the backend that Graphics runs on. Must be called before the subsystem is initialized.
+		// A headless backend (Null or Recording) doesn't use the OpenGL context, but a window still creates one,
+		// unless application runs headless (see OffscreenProperties::headless), skipping GLFW entirely.
+		// Then rendering code can run, and be measured, on machines without a GPU or a display server.
+		static void setBackend(GraphicsBackendType backendType);
+		static GraphicsBackendType getBackend() { return GraphicsBackend::getType(); }
+
 	private: /* functions */
 
 		bool init() override;
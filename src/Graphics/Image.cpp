@@ -3,6 +3,8 @@
 #include "PekanLogger.h"
 #include "Utils/FileUtils.h"
 
+#include <vector>
+
 namespace Pekan
 {
 namespace Graphics
@@ -27,5 +29,61 @@ namespace Graphics
 		return true;
 	}
 
+	bool Image::save(const char* filepath) const
+	{
+		if (!isValid())
+		{
+			PK_LOG_ERROR("Trying to save an invalid image to file: " << filepath, "Pekan");
+			return false;
+		}
+		if (m_numChannels != 1 && m_numChannels != 3 && m_numChannels != 4)
+		{
+			PK_LOG_ERROR("Trying to save an image with " << m_numChannels << " channels to file: " << filepath
+				<< ". Only images with 1, 3 or 4 channels can be saved.", "Pekan");
+			return false;
+		}
+
+		constexpr size_t TGA_HEADER_SIZE = 18;
+		const size_t pixelsCount = size_t(m_width) * size_t(m_height);
+		std::vector<unsigned char> fileData(TGA_HEADER_SIZE + pixelsCount * m_numChannels, 0);
+
+		// Fill in TGA header. Image type is 2 for uncompressed true-color images and 3 for uncompressed grayscale images.
+		// Image descriptor keeps origin at the bottom-left, matching the order of our rows.
+		fileData[2] = (m_numChannels == 1) ? 3 : 2;
+		fileData[12] = (unsigned char)(m_width & 0xFF);
+		fileData[13] = (unsigned char)((m_width >> 8) & 0xFF);
+		fileData[14] = (unsigned char)(m_height & 0xFF);
+		fileData[15] = (unsigned char)((m_height >> 8) & 0xFF);
+		fileData[16] = (unsigned char)(m_numChannels * 8);
+		fileData[17] = (m_numChannels == 4) ? 8 : 0;
+
+		// Copy pixels, swapping red and blue channels, because TGA stores colors in BGR(A) order
+		unsigned char* pixels = fileData.data() + TGA_HEADER_SIZE;
+		for (size_t i = 0; i < pixelsCount; i++)
+		{
+			const unsigned char* source = m_data + i * m_numChannels;
+			unsigned char* destination = pixels + i * m_numChannels;
+			if (m_numChannels == 1)
+			{
+				destination[0] = source[0];
+				continue;
+			}
+			destination[0] = source[2];
+			destination[1] = source[1];
+			destination[2] = source[0];
+			if (m_numChannels == 4)
+			{
+				destination[3] = source[3];
+			}
+		}
+
+		if (!FileUtils::writeBinaryFile(filepath, fileData.data(), fileData.size()))
+		{
+			PK_LOG_ERROR("Failed to save image to file: " << filepath, "Pekan");
+			return false;
+		}
+		return true;
+	}
+
 } // namespace Graphics
 } // namespace Pekan
\ No newline at end of file
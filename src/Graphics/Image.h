@@ -11,10 +11,20 @@ namespace Graphics
 
 		Image() = default;
 		Image(const char* filepath) { load(filepath); }
+		// Creates an image wrapping already existing pixel data.
+		// NOTE: Image does NOT take ownership of the data. It must outlive the image.
+		Image(const unsigned char* data, int width, int height, int numChannels)
+			: m_data(data), m_width(width), m_height(height), m_numChannels(numChannels) {}
 
 		// Loads image from given image file
 		bool load(const char* filepath);
 
+		// Saves image to a given file in uncompressed TGA format.
+		// Image's rows are expected to go from the bottom row to the top one,
+		// same as loaded images and pixels read from a frame buffer.
+		// Supports images with 1, 3 or 4 channels. Returns true on success.
+		bool save(const char* filepath) const;
+
 		const unsigned char* getData() const { return m_data; }
 
 		int getWidth() const { return m_width; }
@@ -0,0 +1,146 @@
+#include "ImageSequenceWriter.h"
+
+#include "Image.h"
+#include "PekanLogger.h"
+#include "Utils/FileUtils.h"
+
+#include <filesystem>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	ImageSequenceWriter::~ImageSequenceWriter()
+	{
+		if (isRunning())
+		{
+			stop();
+		}
+	}
+
+	bool ImageSequenceWriter::start(const std::string& outputFilepath, ImageSequenceFormat format, int maxQueuedFrames)
+	{
+		PK_ASSERT(!isRunning(), "Trying to start an ImageSequenceWriter that is already running.", "Pekan");
+		if (maxQueuedFrames <= 0)
+		{
+			PK_LOG_ERROR("Trying to start an ImageSequenceWriter with a non-positive number of max queued frames.", "Pekan");
+			return false;
+		}
+
+		m_outputFilepath = outputFilepath;
+		m_format = format;
+		m_maxQueuedFrames = maxQueuedFrames;
+		m_shouldStop = false;
+
+		m_thread = std::thread(&ImageSequenceWriter::run, this);
+		return true;
+	}
+
+	void ImageSequenceWriter::stop()
+	{
+		PK_ASSERT(isRunning(), "Trying to stop an ImageSequenceWriter that is not running.", "Pekan");
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_shouldStop = true;
+		}
+		m_condition.notify_all();
+		m_thread.join();
+
+		m_freeFrames.clear();
+	}
+
+	void ImageSequenceWriter::write(const ReadbackFrame& frame)
+	{
+		PK_ASSERT(isRunning(), "Trying to write a frame with an ImageSequenceWriter that is not running.", "Pekan");
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		// Wait until there is room in the queue
+		m_condition.wait(lock, [this]() { return int(m_queuedFrames.size()) < m_maxQueuedFrames; });
+
+		// Reuse memory of an already written frame, if there is one
+		if (!m_freeFrames.empty())
+		{
+			m_queuedFrames.push_back(std::move(m_freeFrames.back()));
+			m_freeFrames.pop_back();
+		}
+		else
+		{
+			m_queuedFrames.emplace_back();
+		}
+		ReadbackFrame& queuedFrame = m_queuedFrames.back();
+		queuedFrame.frameIndex = frame.frameIndex;
+		queuedFrame.width = frame.width;
+		queuedFrame.height = frame.height;
+		queuedFrame.pixels.assign(frame.pixels.begin(), frame.pixels.end());
+
+		lock.unlock();
+		m_condition.notify_all();
+	}
+
+	std::string ImageSequenceWriter::getFrameFilepath(const std::string& outputFilepath, long long frameIndex)
+	{
+		const std::filesystem::path path(outputFilepath);
+		const std::string frameIndexString = std::to_string(frameIndex);
+		// Pad frame index with zeros, so that files are sorted correctly by name
+		const std::string paddedFrameIndex = std::string(frameIndexString.size() < 5 ? 5 - frameIndexString.size() : 0, '0') + frameIndexString;
+
+		std::filesystem::path framePath = path;
+		framePath.replace_filename(path.stem().string() + "_" + paddedFrameIndex + path.extension().string());
+		return framePath.string();
+	}
+
+	void ImageSequenceWriter::run()
+	{
+		ReadbackFrame frame;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() { return !m_queuedFrames.empty() || m_shouldStop; });
+				// Stop only once all queued frames are written
+				if (m_queuedFrames.empty())
+				{
+					return;
+				}
+				// Give the previously written frame's memory back, and take the next queued frame
+				if (!frame.pixels.empty())
+				{
+					m_freeFrames.push_back(std::move(frame));
+				}
+				frame = std::move(m_queuedFrames.front());
+				m_queuedFrames.pop_front();
+			}
+			// Notify a possibly waiting write() that there is room in the queue now
+			m_condition.notify_all();
+
+			// Write the frame outside of the lock, so that new frames can be queued meanwhile
+			writeFrame(frame);
+		}
+	}
+
+	void ImageSequenceWriter::writeFrame(const ReadbackFrame& frame) const
+	{
+		const std::string filepath = getFrameFilepath(m_outputFilepath, frame.frameIndex);
+		switch (m_format)
+		{
+			case ImageSequenceFormat::Tga:
+			{
+				const Image image(frame.pixels.data(), frame.width, frame.height, 4);
+				image.save(filepath.c_str());
+				break;
+			}
+			case ImageSequenceFormat::Raw:
+			{
+				if (!FileUtils::writeBinaryFile(filepath.c_str(), frame.pixels.data(), frame.pixels.size()))
+				{
+					PK_LOG_ERROR("Failed to write frame " << frame.frameIndex << " to file: " << filepath, "Pekan");
+				}
+				break;
+			}
+		}
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "FrameBufferReadback.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// Enum for formats in which an image sequence can be written
+	enum class ImageSequenceFormat
+	{
+		// Uncompressed TGA images
+		Tga,
+		// Raw RGBA pixels, row by row from the bottom row to the top one, without any header
+		Raw
+	};
+
+	// A class writing a sequence of frames to image files on a worker thread,
+	// so that encoding and disk access don't slow down rendering.
+	//
+	// Each frame is written to the output filepath, with frame's index appended to file's name.
+	// Frames are typically received from a FrameBufferReadback.
+	class ImageSequenceWriter
+	{
+	public:
+
+		~ImageSequenceWriter();
+
+		// Starts the worker thread.
+		// Max queued frames limits memory used by frames waiting to be written.
+		// Returns true on success.
+		bool start(const std::string& outputFilepath, ImageSequenceFormat format = ImageSequenceFormat::Tga, int maxQueuedFrames = 8);
+
+		// Waits until all queued frames are written, and stops the worker thread
+		void stop();
+
+		// Queues a frame to be written by the worker thread. Frame's pixels are copied.
+		// If there are already max queued frames waiting, waits until the worker thread writes one of them,
+		// so that no frames are lost.
+		void write(const ReadbackFrame& frame);
+
+		// Checks if worker thread is running
+		bool isRunning() const { return m_thread.joinable(); }
+
+		// Returns path of the file where a frame with a given index is written,
+		// which is a given output filepath with frame's index appended to file's name
+		static std::string getFrameFilepath(const std::string& outputFilepath, long long frameIndex);
+
+	private: /* functions */
+
+		// Main function of the worker thread
+		void run();
+
+		// Writes a single frame to its file
+		void writeFrame(const ReadbackFrame& frame) const;
+
+	private: /* variables */
+
+		std::thread m_thread;
+
+		// Mutex protecting all variables below that are accessed by both threads
+		std::mutex m_mutex;
+		// Condition variable notified when a frame is queued, a frame is written, or the worker thread is asked to stop
+		std::condition_variable m_condition;
+
+		// Frames waiting to be written
+		std::deque<ReadbackFrame> m_queuedFrames;
+		// Frames already written, kept so that their memory is reused by the next queued frames
+		std::vector<ReadbackFrame> m_freeFrames;
+
+		// Flag indicating if the worker thread should stop once it writes all queued frames
+		bool m_shouldStop = false;
+
+		std::string m_outputFilepath;
+		ImageSequenceFormat m_format = ImageSequenceFormat::Tga;
+		int m_maxQueuedFrames = 8;
+	};
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
@@ -1,14 +1,29 @@
 #include "PostProcessor.h"
 
 #include "GLCall.h"
-#include "DrawObject.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "ShaderCache.h"
+#include "RenderCommands.h"
 #include "FrameBuffer.h"
-#include "Utils/FileUtils.h"
+#include "GpuTimer.h"
+#include "FrameGraph.h"
+#include "DynamicResolutionController.h"
 #include "PekanLogger.h"
+#include "GpuProfiler.h"
 #include "PekanEngine.h"
 #include "PekanApplication.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <vector>
+
 #define VERTEX_SHADER_FILEPATH PEKAN_GRAPHICS_ROOT_DIR "/Shaders/PostProcessor_VertexShader.glsl"
+#define FXAA_SHADER_FILEPATH PEKAN_GRAPHICS_ROOT_DIR "/Shaders/PostProcessor_Fxaa.glsl"
 
 namespace Pekan
 {
@@ -18,28 +33,100 @@ namespace Graphics
 	// A flag indicating if the post processor has been initialized
 	static bool g_isInitialized = false;
 
-	// A flag indicating if a post-processing shader has been set
-	static bool g_hasSetPostProcessingShader = false;
-
 	///////////////////////////////////////////////////////////////////////////////////////////////////////////////
-	// The flow of data here is basically this:
+	// Each frame is composed with a frame graph. The flow of data here is basically this:
 	//     -> draw call
-	//     -> g_frameBufferMultisample    (only if using multisample rendering)
-	//     -> g_frameBufferFinal
-	//     -> g_drawObject with a post-processing shader applied
+	//     -> scene render target         (multisample if using multisample rendering)
+	//     -> "Resolve" pass              (only if using multisample rendering)
+	//     -> "Upscale" pass              (only if using dynamic resolution scaling, and rendering at a lower resolution)
+	//     -> pass 0 -> render target of pass 0's resolution
+	//     -> pass 1 -> render target of pass 1's resolution
+	//     -> ...
+	//     -> last enabled pass
+	//     -> FXAA pass                   (only if FXAA is enabled)
 	//     -> screen
+	//
+	// All render targets are acquired from a pool with the current size of the window's frame buffer, so window resizes are handled
+	// without any special care, and render targets of the old size are recycled or destroyed after a few frames.
+	// The frame graph is recorded and compiled only when its structure changes, for example when a pass is enabled
+	// or the window is resized, and otherwise the same graph is executed every frame.
+	// Render target of a pass lives only until the next pass reads it, so passes of the same resolution
+	// alias each other's render targets, effectively ping-ponging between two frame buffers.
 	///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-	// An intermediate frame buffer that will be used to render multisample frames.
-	// A multisample frame has to then be transferred to the final frame buffer before applying the post-processing shader.
-	static FrameBuffer g_frameBufferMultisample;
+	// Pool of all render targets used by the PostProcessor
+	static RenderTargetPool g_renderTargetPool;
+
+	// Frame graph composing each frame, executed in endFrame()
+	static FrameGraph g_frameGraph;
+	// Handle of the scene render target imported into the frame graph
+	static RenderTargetHandle g_sceneRenderTarget;
+
+	// Render target where the scene is rendered, acquired from the pool in beginFrame() and released in endFrame()
+	static FrameBuffer* g_sceneFrameBuffer = nullptr;
+
+	// Size of the current frame at full resolution, in pixels
+	static glm::ivec2 g_frameSize = { 0, 0 };
+
+	// A single post-processing pass
+	struct PostProcessingPass
+	{
+		// Shader used to render the rectangle in this pass.
+		// Owned by the ShaderCache, so switching it is only a pointer swap.
+		Shader* shader = nullptr;
+
+		// Fraction of output's resolution at which the pass runs
+		float resolutionScale = 1.0f;
+
+		bool isEnabled = true;
+	};
 
-	// The final frame buffer that will be passed to the post-processing shader.
-	static FrameBuffer g_frameBufferFinal;
+	// All passes of the chain, in order of execution
+	static std::vector<std::unique_ptr<PostProcessingPass>> g_passes;
+
+	// Built-in FXAA pass, running after all other passes, if enabled
+	static PostProcessingPass g_fxaaPass;
+
+	// Passes to be executed in the current frame, in order of execution.
+	// Kept between frames to avoid reallocating it each frame.
+	static std::vector<PostProcessingPass*> g_enabledPasses;
+
+	// GPU timer measuring time spent on anti-aliasing
+	static GpuTimer g_antiAliasingTimer;
+
+	// Flag indicating if dynamic resolution scaling is enabled
+	static bool g_isEnabledDynamicResolution = false;
+	// Controller deciding on resolution scale used for dynamic resolution scaling
+	static DynamicResolutionController g_dynamicResolutionController;
+	// Resolution scale at which the current frame is rendered.
+	// Changes only between frames, so that a frame is rendered entirely at the same resolution.
+	static float g_resolutionScale = 1.0f;
+	// GPU timer measuring time of the whole frame, from beginFrame() to the end of endFrame()
+	static GpuTimer g_frameTimer;
+	// CPU time point at which the current frame began
+	static std::chrono::steady_clock::time_point g_frameBeginTime;
+	// Flag indicating if GPU time of the current frame is being measured
+	static bool g_isFrameTimed = false;
+
+	// Flag indicating if beginFrame() has prepared a frame for post-processing, that endFrame() has to finish
+	static bool g_isFrameBegun = false;
+
+	// Everything that the structure of the frame graph depends on.
+	// When any of it changes, the frame graph is recorded again.
+	struct FrameGraphSettings
+	{
+		glm::ivec2 frameSize = { 0, 0 };
+		int samplesPerPixel = 1;
+		bool isRenderedAtLowerResolution = false;
+		std::vector<PostProcessingPass*> passes;
+		std::vector<float> passResolutionScales;
 
-	// Underlying draw object
-	// used to render rectangle with post-processed frame.
-	static DrawObject g_drawObject;
+		bool operator==(const FrameGraphSettings& other) const = default;
+	};
+	// Settings with which the frame graph was last recorded
+	static FrameGraphSettings g_frameGraphSettings;
+	// Settings of the current frame. Kept between frames to avoid reallocating them each frame.
+	static FrameGraphSettings g_currentFrameGraphSettings;
 
 	// Vertices of a rectangle covering the whole window/viewport
 	constexpr float RECTANGLE_VERTICES[] =
@@ -53,6 +140,11 @@ namespace Graphics
 	// Indices of a rectangle covering the whole window/viewport
 	constexpr unsigned RECTANGLE_INDICES[] = { 0, 1, 2, 0, 2, 3 };
 
+	// Geometry of a rectangle covering the whole window/viewport, shared by all passes
+	static VertexArray g_rectangleVertexArray;
+	static VertexBuffer g_rectangleVertexBuffer;
+	static IndexBuffer g_rectangleIndexBuffer;
+
 	// Number of samples per pixel
 	static int g_samplesPerPixel = -1;
 
@@ -66,7 +158,10 @@ namespace Graphics
 			const PekanApplication* application = PekanEngine::getApplication();
 			if (application != nullptr)
 			{
-				g_samplesPerPixel = application->getProperties().numberOfSamples;
+				// With FXAA we render single-sampled, and anti-alias with the FXAA pass instead
+				const ApplicationProperties properties = application->getProperties();
+				const bool isMultisample = (properties.antiAliasingMode == AntiAliasingMode::Multisample);
+				g_samplesPerPixel = isMultisample ? properties.numberOfSamples : 1;
 			}
 			else
 			{
@@ -75,101 +170,437 @@ namespace Graphics
 			}
 		}
 
-		// Create underlying frame buffers with the size of the window
-		const glm::ivec2 windowSize = PekanEngine::getWindow().getSize();
-		if (g_samplesPerPixel > 1)
-		{
-			g_frameBufferMultisample.create(windowSize.x, windowSize.y, g_samplesPerPixel);
-		}
-		g_frameBufferFinal.create(windowSize.x, windowSize.y, 1);
+		// Create rectangle's geometry.
+		// Index buffer is created while vertex array is bound, so that vertex array remembers it.
+		g_rectangleVertexArray.create();
+		g_rectangleVertexBuffer.create(RECTANGLE_VERTICES, sizeof(RECTANGLE_VERTICES), BufferDataUsage::StaticDraw);
+		g_rectangleVertexArray.addVertexBuffer
+		(
+			g_rectangleVertexBuffer,
+			{ { ShaderDataType::Float2, "position" }, { ShaderDataType::Float2, "textureCoordinates"} }
+		);
+		g_rectangleIndexBuffer.create(RECTANGLE_INDICES, sizeof(RECTANGLE_INDICES), BufferDataUsage::StaticDraw);
+
+		g_antiAliasingTimer.create();
 
 		g_isInitialized = true;
 		return true;
 	}
 
+	// Initializes the PostProcessor if it's not yet initialized.
+	// Returns false on failure.
+	static bool ensureInitialized()
+	{
+		if (!g_isInitialized && !init())
+		{
+			PK_LOG_ERROR("Failed to initialize PostProcessor.", "Pekan");
+			return false;
+		}
+		return true;
+	}
+
+	// Returns a post-processing shader with a given fragment shader, coming from the ShaderCache
+	static Shader* getPostProcessingShader(const char* postProcessingShaderFilepath, const ShaderDefines& defines = {}, const ShaderSubstitutions& substitutions = {})
+	{
+		Shader* shader = ShaderCache::getPermutation(VERTEX_SHADER_FILEPATH, postProcessingShaderFilepath, defines, substitutions);
+		if (shader == nullptr)
+		{
+			PK_LOG_ERROR("Failed to get post-processing shader " << postProcessingShaderFilepath << " from the shader cache.", "Pekan");
+			return nullptr;
+		}
+		// Set "screenTexture" uniform inside the shader to 0,
+		// because we will always bind the input texture on slot 0
+		shader->setUniform1i("screenTexture", 0);
+		return shader;
+	}
+
+	Shader* PostProcessor::getPassShaderPermutation(const char* postProcessingShaderFilepath, const ShaderDefines& defines, const ShaderSubstitutions& substitutions)
+	{
+		return getPostProcessingShader(postProcessingShaderFilepath, defines, substitutions);
+	}
+
 	void PostProcessor::setPostProcessingShader(const char* postProcessingShaderFilepath)
 	{
-		// If PostProcessor is not yet initialized, initialize it now
-		if (!g_isInitialized)
+		setPostProcessingShader(getPostProcessingShader(postProcessingShaderFilepath));
+	}
+
+	void PostProcessor::setPostProcessingShader(Shader* shader)
+	{
+		if (g_passes.empty())
 		{
-			if (!init())
-			{
-				PK_LOG_ERROR("Failed to initialize PostProcessor.", "Pekan");
-				return;
-			}
+			addPass(shader);
+			return;
+		}
+		setPassShader(0, shader);
+	}
+
+	int PostProcessor::addPass(const char* postProcessingShaderFilepath, float resolutionScale)
+	{
+		return addPass(getPostProcessingShader(postProcessingShaderFilepath), resolutionScale);
+	}
+
+	int PostProcessor::addPass(Shader* shader, float resolutionScale)
+	{
+		if (shader == nullptr)
+		{
+			PK_LOG_ERROR("Trying to add a post-processing pass with a null shader.", "Pekan");
+			return -1;
+		}
+		if (resolutionScale <= 0.0f || resolutionScale > 1.0f)
+		{
+			PK_LOG_ERROR("Trying to add a post-processing pass with resolution scale " << resolutionScale << ". It must be in range (0, 1].", "Pekan");
+			return -1;
+		}
+		if (!ensureInitialized())
+		{
+			return -1;
 		}
 
-		// If draw object is already created, just set new shader source
-		if (g_drawObject.isValid())
+		std::unique_ptr<PostProcessingPass> pass = std::make_unique<PostProcessingPass>();
+		pass->shader = shader;
+		pass->resolutionScale = resolutionScale;
+
+		g_passes.push_back(std::move(pass));
+		return int(g_passes.size() - 1);
+	}
+
+	void PostProcessor::setPassShader(int passIndex, Shader* shader)
+	{
+		PK_ASSERT(passIndex >= 0 && passIndex < int(g_passes.size()), "Trying to set shader of a post-processing pass that doesn't exist.", "Pekan");
+		if (shader == nullptr)
 		{
-			g_drawObject.setShaderSource
-			(
-				FileUtils::readTextFileToString(VERTEX_SHADER_FILEPATH).c_str(),
-				FileUtils::readTextFileToString(postProcessingShaderFilepath).c_str()
-			);
+			PK_LOG_ERROR("Trying to set a null shader to a post-processing pass.", "Pekan");
 			return;
 		}
+		g_passes[passIndex]->shader = shader;
+	}
 
-		// Create underlying draw object with rectangle's vertices,
-		// a default vertex shader, and use given post-processing shader as a fragment shader.
-		g_drawObject.create
-		(
-			RECTANGLE_VERTICES, 4 * 2 * 2 * sizeof(float),
-			{ { ShaderDataType::Float2, "position" }, { ShaderDataType::Float2, "textureCoordinates"} },
-			BufferDataUsage::StaticDraw,
-			FileUtils::readTextFileToString(VERTEX_SHADER_FILEPATH).c_str(),
-			FileUtils::readTextFileToString(postProcessingShaderFilepath).c_str()
-		);
-		g_drawObject.setIndexData(RECTANGLE_INDICES, 6 * sizeof(unsigned), BufferDataUsage::StaticDraw);
-		// Set "screenTexture" uniform inside the shader to 0,
-		// because we will always bind the frame buffer's texture on slot 0
-		g_drawObject.getShader().setUniform1i("screenTexture", 0);
+	void PostProcessor::setPassEnabled(int passIndex, bool enabled)
+	{
+		PK_ASSERT(passIndex >= 0 && passIndex < int(g_passes.size()), "Trying to enable/disable a post-processing pass that doesn't exist.", "Pekan");
+		g_passes[passIndex]->isEnabled = enabled;
+	}
 
-		g_hasSetPostProcessingShader = true;
+	bool PostProcessor::isPassEnabled(int passIndex)
+	{
+		PK_ASSERT(passIndex >= 0 && passIndex < int(g_passes.size()), "Trying to check if a post-processing pass that doesn't exist is enabled.", "Pekan");
+		return g_passes[passIndex]->isEnabled;
 	}
 
-	void PostProcessor::beginFrame()
+	Shader* PostProcessor::getPassShader(int passIndex)
 	{
-		// If PostProcessor is not initialized or there is no post-processing shader set, do nothing
-		if (!g_isInitialized || !g_hasSetPostProcessingShader)
+		if (passIndex < 0 || passIndex >= int(g_passes.size()))
+		{
+			PK_LOG_ERROR("Trying to get shader of a post-processing pass that doesn't exist.", "Pekan");
+			return nullptr;
+		}
+		return g_passes[passIndex]->shader;
+	}
+
+	int PostProcessor::getPassesCount()
+	{
+		return int(g_passes.size());
+	}
+
+	void PostProcessor::setFxaaEnabled(bool enabled)
+	{
+		if (!ensureInitialized())
 		{
 			return;
 		}
 
-		// Bind the correct frame buffer depending on samples per pixel
-		if (g_samplesPerPixel > 1)
+		// Get FXAA shader the first time FXAA is enabled
+		if (enabled && g_fxaaPass.shader == nullptr)
 		{
-			g_frameBufferMultisample.bind();
+			g_fxaaPass.shader = getPostProcessingShader(FXAA_SHADER_FILEPATH);
 		}
-		else
+		g_fxaaPass.isEnabled = enabled;
+	}
+
+	bool PostProcessor::isFxaaEnabled()
+	{
+		return g_fxaaPass.isEnabled && g_fxaaPass.shader != nullptr;
+	}
+
+	float PostProcessor::getAntiAliasingTime()
+	{
+		return g_antiAliasingTimer.isValid() ? g_antiAliasingTimer.getTime() : -1.0f;
+	}
+
+	void PostProcessor::setDynamicResolution(const DynamicResolutionProperties& properties)
+	{
+		if (!ensureInitialized())
 		{
-			g_frameBufferFinal.bind();
+			return;
 		}
+
+		g_isEnabledDynamicResolution = properties.enabled;
+		if (!properties.enabled)
+		{
+			g_resolutionScale = 1.0f;
+			return;
+		}
+
+		g_dynamicResolutionController.setProperties(properties);
+		g_resolutionScale = g_dynamicResolutionController.getResolutionScale();
+		if (!g_frameTimer.isValid())
+		{
+			g_frameTimer.create();
+		}
+	}
+
+	float PostProcessor::getResolutionScale()
+	{
+		return g_resolutionScale;
+	}
+
+	// Collects all passes to be executed in the current frame into g_enabledPasses
+	static void collectEnabledPasses()
+	{
+		g_enabledPasses.clear();
+		for (const std::unique_ptr<PostProcessingPass>& pass : g_passes)
+		{
+			if (pass->isEnabled)
+			{
+				g_enabledPasses.push_back(pass.get());
+			}
+		}
+		if (PostProcessor::isFxaaEnabled())
+		{
+			g_enabledPasses.push_back(&g_fxaaPass);
+		}
+	}
+
+	// Checks if PostProcessor has anything to do in a frame,
+	// meaning that there is at least one pass to be executed, or dynamic resolution scaling is enabled
+	static bool isActive()
+	{
+		if (g_isEnabledDynamicResolution || PostProcessor::isFxaaEnabled())
+		{
+			return true;
+		}
+		for (const std::unique_ptr<PostProcessingPass>& pass : g_passes)
+		{
+			if (pass->isEnabled)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Returns size of the region of scene render target where the current frame is rendered,
+	// which is smaller than the render target itself if rendering at a lower resolution
+	static glm::ivec2 getRenderSize()
+	{
+		return
+		{
+			std::max(1, int(std::round(g_frameSize.x * g_resolutionScale))),
+			std::max(1, int(std::round(g_frameSize.y * g_resolutionScale)))
+		};
+	}
+
+	void PostProcessor::beginFrame()
+	{
+		PK_PROFILE_FUNCTION();
+
+		// If PostProcessor is not initialized or has nothing to do, do nothing
+		if (!g_isInitialized || !isActive())
+		{
+			return;
+		}
+		// If window is minimized there is nothing to render to.
+		// Use size of window's frame buffer, which is the size of the screen render target and differs from window's size on high-DPI displays.
+		g_frameSize = PekanEngine::getWindow().getFrameBufferSize();
+		if (g_frameSize.x <= 0 || g_frameSize.y <= 0)
+		{
+			return;
+		}
+		g_isFrameBegun = true;
+
+		// Acquire scene render target with the current size of the frame, and bind it.
+		// Use linear filtering, so that passes of a lower resolution scale it smoothly.
+		g_sceneFrameBuffer = g_renderTargetPool.acquire({ g_frameSize.x, g_frameSize.y, g_samplesPerPixel, true });
+		g_sceneFrameBuffer->bind();
+		RenderState::setViewport(0, 0, g_frameSize.x, g_frameSize.y);
 		// Clear both color and depth from frame buffer
 		RenderCommands::clear(true, true);
+
+		if (g_isEnabledDynamicResolution)
+		{
+			// Start measuring frame time
+			g_frameBeginTime = std::chrono::steady_clock::now();
+			g_isFrameTimed = g_frameTimer.begin();
+
+			// Render the frame only into a region of the frame buffer, with a size corresponding to current resolution scale
+			g_resolutionScale = g_dynamicResolutionController.getResolutionScale();
+			const glm::ivec2 renderSize = getRenderSize();
+			RenderState::setViewport(0, 0, renderSize.x, renderSize.y);
+		}
 	}
 
-	void PostProcessor::endFrame()
+	// Feeds time of the frame that has just ended to dynamic resolution controller.
+	// Frame time is the bigger of CPU time and GPU time of the frame, so resolution is lowered only if it helps,
+	// though GPU time is from a few frames ago, as GPU timer doesn't wait for the GPU.
+	static void updateDynamicResolution()
 	{
-		// If PostProcessor is not initialized or there is no post-processing shader set, do nothing
-		if (!g_isInitialized || !g_hasSetPostProcessingShader)
+		if (g_isFrameTimed)
 		{
-			return;
+			g_frameTimer.end();
+			g_isFrameTimed = false;
 		}
+		const std::chrono::duration<double> cpuFrameTime = std::chrono::steady_clock::now() - g_frameBeginTime;
+		const double gpuFrameTime = double(g_frameTimer.getTime()) / 1000.0;
+		g_dynamicResolutionController.update(std::max(cpuFrameTime.count(), gpuFrameTime));
+	}
+
+	// Records the frame graph composing a frame, for current settings
+	static void recordFrameGraph()
+	{
+		g_frameGraph.clear();
+
+		const int lastEnabledPassIndex = int(g_enabledPasses.size()) - 1;
+
+		// Import scene render target and the screen into the frame graph.
+		// Scene's frame buffer is set each frame, since it's acquired from the pool in beginFrame().
+		g_sceneRenderTarget = g_frameGraph.importRenderTarget("Scene", nullptr, { g_frameSize.x, g_frameSize.y, g_samplesPerPixel, true });
+		RenderTargetHandle input = g_sceneRenderTarget;
+		const RenderTargetHandle screen = g_frameGraph.importRenderTarget("Screen", nullptr, { g_frameSize.x, g_frameSize.y });
 
-		// If we are using the multisample frame buffer,
-		// resolve it to the final frame buffer.
-		// This will transform all pixel data from multisample to single-sample
-		// and copy it to the final frame buffer
+		// If we are using multisample rendering, resolve scene render target to a single-sample one.
+		// This will transform all pixel data from multisample to single-sample.
 		if (g_samplesPerPixel > 1)
 		{
-			g_frameBufferMultisample.resolveMultisampleToSinglesample(g_frameBufferFinal);
+			const RenderTargetHandle multisample = input;
+			const RenderTargetHandle resolved = g_frameGraph.createRenderTarget("Resolved", { g_frameSize.x, g_frameSize.y, 1, true });
+			g_frameGraph.addPass("Resolve",
+				[multisample, resolved](FrameGraphBuilder& builder)
+				{
+					builder.read(multisample);
+					builder.write(resolved);
+				},
+				[multisample, resolved](const FrameGraph& frameGraph)
+				{
+					PK_PROFILE_GPU_SCOPE("Resolve");
+					const bool isTimed = g_antiAliasingTimer.begin();
+					// Render size is read at execution, since it changes with resolution scale without changing the frame graph
+					const glm::ivec2 renderSize = getRenderSize();
+					frameGraph.getFrameBuffer(multisample)->blit(frameGraph.getFrameBuffer(resolved), renderSize.x, renderSize.y, renderSize.x, renderSize.y, false);
+					if (isTimed)
+					{
+						g_antiAliasingTimer.end();
+					}
+				}
+			);
+			input = resolved;
+		}
+
+		// If there are no passes, we are here only for dynamic resolution scaling, so just upscale rendered frame to the screen.
+		// Otherwise, if frame is rendered at a lower resolution, upscale it to full resolution, so that passes don't need to know about it.
+		if (g_enabledPasses.empty() || g_frameGraphSettings.isRenderedAtLowerResolution)
+		{
+			const RenderTargetHandle source = input;
+			const RenderTargetHandle upscaled = g_enabledPasses.empty()
+				? screen
+				: g_frameGraph.createRenderTarget("Upscaled", { g_frameSize.x, g_frameSize.y, 1, true });
+			g_frameGraph.addPass("Upscale",
+				[source, upscaled](FrameGraphBuilder& builder)
+				{
+					builder.read(source);
+					builder.write(upscaled);
+				},
+				[source, upscaled](const FrameGraph& frameGraph)
+				{
+					const glm::ivec2 renderSize = getRenderSize();
+					const RenderTargetDescription& upscaledDescription = frameGraph.getDescription(upscaled);
+					frameGraph.getFrameBuffer(source)->blit(frameGraph.getFrameBuffer(upscaled), renderSize.x, renderSize.y, upscaledDescription.width, upscaledDescription.height, true);
+				}
+			);
+			input = upscaled;
+		}
+
+		// Add all enabled passes, each one reading the output of the previous one.
+		// Last pass renders to the screen, other passes render to a render target of their resolution.
+		for (int i = 0; i <= lastEnabledPassIndex; i++)
+		{
+			PostProcessingPass* pass = g_enabledPasses[i];
+			const RenderTargetHandle source = input;
+			RenderTargetHandle output = screen;
+			if (i < lastEnabledPassIndex)
+			{
+				const int width = std::max(1, int(std::round(g_frameSize.x * pass->resolutionScale)));
+				const int height = std::max(1, int(std::round(g_frameSize.y * pass->resolutionScale)));
+				output = g_frameGraph.createRenderTarget("PassOutput", { width, height, 1, true });
+			}
+			const bool isFxaa = (pass == &g_fxaaPass);
+			g_frameGraph.addPass(isFxaa ? "FXAA" : "PostProcessing",
+				[source, output](FrameGraphBuilder& builder)
+				{
+					builder.read(source);
+					builder.write(output);
+				},
+				[pass, source, isFxaa](const FrameGraph& frameGraph)
+				{
+					PK_PROFILE_GPU_SCOPE(isFxaa ? "FXAA" : "PostProcessing");
+					// Bind input texture to slot 0, because shader expects it there,
+					// and render the rectangle using pass's shader.
+					frameGraph.bindTexture(source, 0);
+					if (isFxaa)
+					{
+						const RenderTargetDescription& sourceDescription = frameGraph.getDescription(source);
+						pass->shader->setUniform2f("inverseScreenSize", { 1.0f / float(sourceDescription.width), 1.0f / float(sourceDescription.height) });
+					}
+					const bool isTimed = isFxaa && g_antiAliasingTimer.begin();
+					pass->shader->bind();
+					g_rectangleVertexArray.bind();
+					RenderCommands::drawIndexed(6, DrawMode::Triangles, g_rectangleIndexBuffer.getIndexType());
+					if (isTimed)
+					{
+						g_antiAliasingTimer.end();
+					}
+				}
+			);
+			input = output;
+		}
+
+		g_frameGraph.compile();
+	}
+
+	// Fills g_currentFrameGraphSettings with settings of the current frame
+	static void collectFrameGraphSettings()
+	{
+		FrameGraphSettings& settings = g_currentFrameGraphSettings;
+		settings.frameSize = g_frameSize;
+		settings.samplesPerPixel = g_samplesPerPixel;
+		settings.isRenderedAtLowerResolution = (getRenderSize() != g_frameSize);
+		settings.passes = g_enabledPasses;
+		settings.passResolutionScales.clear();
+		for (const PostProcessingPass* pass : g_enabledPasses)
+		{
+			settings.passResolutionScales.push_back(pass->resolutionScale);
 		}
+	}
+
+	void PostProcessor::endFrame()
+	{
+		PK_PROFILE_FUNCTION();
 
-		// Unbind our frame buffer,
-		// effectively binding the default frame buffer which is the screen.
-		// (It doesn't matter which one we unbind)
-		g_frameBufferFinal.unbind();
+		// If beginFrame() did nothing, do nothing
+		if (!g_isFrameBegun)
+		{
+			return;
+		}
+		g_isFrameBegun = false;
+
+		// Record the frame graph again only if something it depends on has changed
+		collectEnabledPasses();
+		collectFrameGraphSettings();
+		if (g_frameGraph.getPassesCount() == 0 || !(g_currentFrameGraphSettings == g_frameGraphSettings))
+		{
+			std::swap(g_frameGraphSettings, g_currentFrameGraphSettings);
+			recordFrameGraph();
+		}
+		g_frameGraph.setImportedFrameBuffer(g_sceneRenderTarget, g_sceneFrameBuffer);
 
 		// If depth testing is enabled, disable it as we don't need it to render the post-processed result onto the rectangle
 		bool originalIsEnabledDepthTest = RenderState::isEnabledDepthTest();
@@ -178,31 +609,37 @@ namespace Graphics
 			RenderState::disableDepthTest();
 		}
 
-		// Bind final frame buffer's texture containing the rendered frame,
-		// because we want to access it in the post-processing shader.
-		// (Importantly, bind it to slot 0 because shader expects it there)
-		g_frameBufferFinal.bindTexture(0);
-		// Render the rectangle using the post-processing shader and the texture containing the rendered frame
-		g_drawObject.render();
+		g_frameGraph.execute(g_renderTargetPool);
 
 		// If depth testing was originally enabled, enable it again
 		if (originalIsEnabledDepthTest)
 		{
 			RenderState::enableDepthTest();
 		}
+
+		// Scene's frame buffer is released below, so don't keep a pointer to it in the frame graph
+		g_frameGraph.setImportedFrameBuffer(g_sceneRenderTarget, nullptr);
+
+		// Release scene render target, and destroy render targets that are no longer used, for example after a window resize
+		g_renderTargetPool.release(g_sceneFrameBuffer);
+		g_sceneFrameBuffer = nullptr;
+		g_renderTargetPool.update();
+
+		if (g_isEnabledDynamicResolution)
+		{
+			updateDynamicResolution();
+		}
 	}
 
 	Shader* PostProcessor::getShader()
 	{
 		PK_ASSERT(g_isInitialized, "Trying to get shader from PostProcessor but it's not yet initialized.", "Pekan");
-		// If there is no post-processing shader set, return null
-		if (!g_hasSetPostProcessingShader)
+		// If there are no passes, return null
+		if (g_passes.empty())
 		{
 			return nullptr;
 		}
-		PK_ASSERT(g_drawObject.isValid(), "Trying to get shader from PostProcessor but underlying draw object is not valid.", "Pekan");
-
-		return &g_drawObject.getShader();
+		return g_passes[0]->shader;
 	}
 
 	void PostProcessor::exit()
@@ -212,27 +649,41 @@ namespace Graphics
 			return;
 		}
 
-		PK_ASSERT(g_frameBufferFinal.isValid(), "PostProcessor is being exited but its final frame buffer is not valid.", "Pekan");
-		PK_ASSERT(g_drawObject.isValid(), "PostProcessor is being exited but its underlying draw object is not valid.", "Pekan");
-
-		// Destroy underlying frame buffers
+		// Destroy all render targets
+		if (g_sceneFrameBuffer != nullptr)
 		{
-			g_frameBufferFinal.destroy();
-			// Ensure multisample frame buffer is valid before destroying it.
-			// It may not be valid if we were not using multisample rendering.
-			if (g_frameBufferMultisample.isValid())
-			{
-				g_frameBufferMultisample.destroy();
-			}
+			g_renderTargetPool.release(g_sceneFrameBuffer);
+			g_sceneFrameBuffer = nullptr;
+		}
+		g_frameGraph.clear();
+		g_frameGraphSettings = {};
+		g_renderTargetPool.clear();
+
+		// Remove all passes. Their shaders are owned by the ShaderCache, which destroys them on its own.
+		g_passes.clear();
+		g_fxaaPass.shader = nullptr;
+		g_fxaaPass.isEnabled = true;
+		g_enabledPasses.clear();
+
+		// Destroy rectangle's geometry
+		g_rectangleIndexBuffer.destroy();
+		g_rectangleVertexBuffer.destroy();
+		g_rectangleVertexArray.destroy();
+
+		// Destroy GPU timers
+		g_antiAliasingTimer.destroy();
+		if (g_frameTimer.isValid())
+		{
+			g_frameTimer.destroy();
 		}
 
-		// Destroy underlying draw object
-		g_drawObject.destroy();
+		// Reset dynamic resolution scaling
+		g_isEnabledDynamicResolution = false;
+		g_resolutionScale = 1.0f;
 
 		// Reset flags
 		g_isInitialized = false;
-		g_hasSetPostProcessingShader = false;
-		g_hasSetPostProcessingShader = false;
+		g_isFrameBegun = false;
 		g_samplesPerPixel = -1;
 	}
 
@@ -1,13 +1,37 @@
 #pragma once
 
+#include "ShaderPreprocessor.h"
+
 namespace Pekan
 {
+
+	struct DynamicResolutionProperties;
+
 namespace Graphics
 {
 
 	class Shader;
 
 	// A static class for post-processing a frame after rendering before showing it on screen.
+	//
+	// Post-processing is done by a chain of passes, executed in the order in which they were added.
+	// Each pass renders a fullscreen rectangle with its own post-processing shader,
+	// receiving the output of the previous pass (or the rendered frame, for the first pass) as its input.
+	// The last enabled pass renders to the screen.
+	//
+	// Passes can run at a fraction of the output resolution, which is useful for effects like blur and bloom.
+	// Each frame is composed with a FrameGraph, and all render targets come from a pool sized from the window each frame,
+	// so window resizes are handled automatically, and passes of the same resolution share their render targets.
+	// Enabling and disabling passes is cheap, disabled passes are simply skipped.
+	//
+	// Shaders of all passes come from the ShaderCache. Permutations of a pass shader can be precompiled
+	// with getPassShaderPermutation(), so switching between them at runtime with setPassShader() is only a pointer swap.
+	//
+	// If FXAA is enabled, a built-in FXAA pass runs after all other passes, anti-aliasing the final result.
+	//
+	// If dynamic resolution scaling is enabled, frames are rendered at a lower resolution when they take too long,
+	// and upscaled to full resolution before the passes, or directly to the screen if there are no passes.
+	// Anything rendered after endFrame(), like GUI, is rendered at window's native resolution.
 	class PostProcessor
 	{
 		// Make GraphicsSubsystem a friend so that it can exit PostProcessor when GraphicsSubsystem is exited.
@@ -17,19 +41,79 @@ namespace Graphics
 
 		// Sets a given post-processing shader to be used for post-processing each frame after rendering.
 		// If needed, initializes the PostProcessor first.
+		// This is the same as the first pass of the chain. If there are no passes, one is added.
 		//
 		// NOTE: Given shader MUST have a sampler2D uniform called "screenTexture".
 		//       Inside of it the shader will receive the rendered frame.
 		static void setPostProcessingShader(const char* postProcessingShaderFilepath);
+		// Same as above, but with a shader previously returned by getPassShaderPermutation()
+		static void setPostProcessingShader(Shader* shader);
+
+		// Adds a pass at the end of the chain, with a given post-processing shader, running at a given fraction of output's resolution.
+		// If needed, initializes the PostProcessor first.
+		// Returns index of the added pass, or -1 on failure.
+		//
+		// NOTE: Given shader MUST have a sampler2D uniform called "screenTexture".
+		//       Inside of it the shader will receive the output of the previous pass.
+		static int addPass(const char* postProcessingShaderFilepath, float resolutionScale = 1.0f);
+		// Same as above, but with a shader previously returned by getPassShaderPermutation()
+		static int addPass(Shader* shader, float resolutionScale = 1.0f);
+
+		// Returns a permutation of a post-processing shader, preprocessed with given defines and substitutions.
+		// The permutation is compiled into the ShaderCache if it's not already there,
+		// so calling this at load time precompiles it. Returns null on failure.
+		static Shader* getPassShaderPermutation
+		(
+			const char* postProcessingShaderFilepath,
+			const ShaderDefines& defines = {},
+			const ShaderSubstitutions& substitutions = {}
+		);
+
+		// Sets the shader of a pass with a given index, to a shader previously returned by getPassShaderPermutation()
+		static void setPassShader(int passIndex, Shader* shader);
+
+		// Enables/disables a pass with a given index. Disabled passes are skipped. Passes are enabled by default.
+		static void setPassEnabled(int passIndex, bool enabled);
+		static bool isPassEnabled(int passIndex);
+
+		// Returns (a pointer to) the shader of a pass with a given index.
+		// Can be used to set uniforms.
+		static Shader* getPassShader(int passIndex);
+
+		// Returns number of passes in the chain, including disabled ones
+		static int getPassesCount();
+
+		// Enables/disables Fast Approximate Anti-Aliasing (FXAA) - a built-in pass that always runs last.
+		// If needed, initializes the PostProcessor first.
+		// Enabled automatically by the Graphics subsystem if application's anti-aliasing mode is FXAA.
+		static void setFxaaEnabled(bool enabled);
+		static bool isFxaaEnabled();
+
+		// Returns GPU time, in milliseconds, spent on anti-aliasing in a recent frame,
+		// meaning either resolving the multisample frame, or running the FXAA pass.
+		// Returns -1 if no anti-aliasing has been measured yet.
+		//
+		// NOTE: Time is measured with timer queries that are read a few frames later, without waiting for the GPU,
+		//       so it lags behind by a few frames.
+		static float getAntiAliasingTime();
+
+		// Enables/disables dynamic resolution scaling with given properties.
+		// If needed, initializes the PostProcessor first.
+		// Enabled automatically by the Graphics subsystem if application's dynamic resolution properties say so.
+		static void setDynamicResolution(const DynamicResolutionProperties& properties);
+
+		// Returns resolution scale at which frames are currently rendered, as a fraction of window's resolution.
+		// Always 1 if dynamic resolution scaling is disabled.
+		static float getResolutionScale();
 
 		// A function to be called before rendering a frame.
-		// Does nothing if no post-processing shader has been set.
+		// Does nothing if there are no enabled passes.
 		static void beginFrame();
 		// A function to be called after rendering a frame.
-		// Does nothing if no post-processing shader has been set.
+		// Does nothing if there are no enabled passes.
 		static void endFrame();
 
-		// Returns (a pointer to) underlying shader.
+		// Returns (a pointer to) the shader of the first pass.
 		// Can be used to set uniforms.
 		static Shader* getShader();
 
@@ -10,19 +10,22 @@ namespace Graphics
 
 	void RenderCommands::draw(unsigned elementsCount, DrawMode mode)
 	{
+		GraphicsBackend::onDraw(elementsCount, mode);
 		GLCall(glDrawArrays(getDrawModeOpenGLEnum(mode), 0, elementsCount));
 	}
 
-	void RenderCommands::drawIndexed(unsigned elementsCount, DrawMode mode)
+	void RenderCommands::drawIndexed(unsigned elementsCount, DrawMode mode, IndexType indexType)
 	{
-		GLCall(glDrawElements(getDrawModeOpenGLEnum(mode), elementsCount, GL_UNSIGNED_INT, 0));
+		GraphicsBackend::onDrawIndexed(elementsCount, mode, indexType);
+		GLCall(glDrawElements(getDrawModeOpenGLEnum(mode), elementsCount, RenderState::getIndexTypeOpenGLEnum(indexType), 0));
 	}
 
 	void RenderCommands::clear(bool doClearColorBuffer, bool doClearDepthBuffer)
 	{
+		GraphicsBackend::onClear(doClearColorBuffer, doClearDepthBuffer);
 		if (doClearColorBuffer && doClearDepthBuffer)
 		{
-			GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT))
+			GLCall(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
 		}
 		else if (doClearColorBuffer)
 		{
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PekanEngine.h"
+#include "RenderState.h"
 
 namespace Pekan
 {
@@ -34,7 +35,8 @@ namespace Graphics
 
 		// Draws elements from currently bound vertex buffer.
 		// Uses currently bound index buffer to determine which elements to draw and in what order.
-		static void drawIndexed(unsigned elementsCount, DrawMode mode = DrawMode::Triangles);
+		// Index type must match the type of indices inside of the index buffer.
+		static void drawIndexed(unsigned elementsCount, DrawMode mode = DrawMode::Triangles, IndexType indexType = IndexType::UnsignedInt);
 
 		// Clears everything rendered on window.
 		// @param[in] doClearColorBuffer - a flag indicating whether color buffer should be cleared
@@ -8,6 +8,10 @@ constexpr int DEFAULT_NUMBER_OF_SAMPLES = 8;
 
 // A flag indicating if depth testing is currently enabled
 static bool g_isEnabledDepthTest = false;
+// Function currently used for depth testing
+static Pekan::Graphics::DepthFunction g_depthFunction = Pekan::Graphics::DepthFunction::Less;
+// A flag indicating if writing to the depth buffer is currently enabled
+static bool g_isEnabledDepthWriting = true;
 
 namespace Pekan
 {
@@ -19,6 +23,11 @@ namespace Graphics
 		GLCall(glClearColor(r, g, b, a));
 	}
 
+	void RenderState::setViewport(int x, int y, int width, int height)
+	{
+		GLCall(glViewport(x, y, width, height));
+	}
+
 	void RenderState::enableBlending()
 	{
 		GLCall(glEnable(GL_BLEND));
@@ -46,6 +55,34 @@ namespace Graphics
 		return g_isEnabledDepthTest;
 	}
 
+	void RenderState::setDepthFunction(DepthFunction depthFunction)
+	{
+		GLCall(glDepthFunc(getDepthFunctionOpenGLEnum(depthFunction)));
+		g_depthFunction = depthFunction;
+	}
+
+	DepthFunction RenderState::getDepthFunction()
+	{
+		return g_depthFunction;
+	}
+
+	void RenderState::enableDepthWriting()
+	{
+		GLCall(glDepthMask(GL_TRUE));
+		g_isEnabledDepthWriting = true;
+	}
+
+	void RenderState::disableDepthWriting()
+	{
+		GLCall(glDepthMask(GL_FALSE));
+		g_isEnabledDepthWriting = false;
+	}
+
+	bool RenderState::isEnabledDepthWriting()
+	{
+		return g_isEnabledDepthWriting;
+	}
+
 	void RenderState::enableMultisampleAntiAliasing()
 	{
 		GLCall(glEnable(GL_MULTISAMPLE));
@@ -80,6 +117,11 @@ namespace Graphics
 			case ShaderDataType::Int3:      return GL_INT;
 			case ShaderDataType::Int4:      return GL_INT;
 			case ShaderDataType::Bool:      return GL_BOOL;
+			case ShaderDataType::UByte4Normalized:     return GL_UNSIGNED_BYTE;
+			case ShaderDataType::Short2Normalized:     return GL_SHORT;
+			case ShaderDataType::UShort2Normalized:    return GL_UNSIGNED_SHORT;
+			case ShaderDataType::Half2:                return GL_HALF_FLOAT;
+			case ShaderDataType::Half4:                return GL_HALF_FLOAT;
 		}
 		PK_ASSERT(false, "Unknown ShaderDataType, cannot determine OpenGL base type.", "Pekan");
 		return 0;
@@ -108,6 +150,23 @@ namespace Graphics
 		return 0;
 	}
 
+	unsigned RenderState::getDepthFunctionOpenGLEnum(DepthFunction depthFunction)
+	{
+		switch (depthFunction)
+		{
+			case DepthFunction::Never:             return GL_NEVER;
+			case DepthFunction::Less:              return GL_LESS;
+			case DepthFunction::Equal:             return GL_EQUAL;
+			case DepthFunction::LessOrEqual:       return GL_LEQUAL;
+			case DepthFunction::Greater:           return GL_GREATER;
+			case DepthFunction::NotEqual:          return GL_NOTEQUAL;
+			case DepthFunction::GreaterOrEqual:    return GL_GEQUAL;
+			case DepthFunction::Always:            return GL_ALWAYS;
+		}
+		PK_ASSERT(false, "Unknown DepthFunction, cannot determine OpenGL enum.", "Pekan");
+		return 0;
+	}
+
 	unsigned RenderState::getBufferDataUsageOpenGLEnum(BufferDataUsage dataUsage)
 	{
 		switch (dataUsage)
@@ -141,6 +200,11 @@ namespace Graphics
 			case ShaderDataType::Int3:      return 4 * 3;
 			case ShaderDataType::Int4:      return 4 * 4;
 			case ShaderDataType::Bool:      return 1;
+			case ShaderDataType::UByte4Normalized:     return 1 * 4;
+			case ShaderDataType::Short2Normalized:     return 2 * 2;
+			case ShaderDataType::UShort2Normalized:    return 2 * 2;
+			case ShaderDataType::Half2:                return 2 * 2;
+			case ShaderDataType::Half4:                return 2 * 4;
 		}
 		PK_ASSERT(false, "Unknown ShaderDataType, cannot determine its size.", "Pekan");
 		return 0;
@@ -161,6 +225,11 @@ namespace Graphics
 			case ShaderDataType::Int3:      return 3;
 			case ShaderDataType::Int4:      return 4;
 			case ShaderDataType::Bool:      return 1;
+			case ShaderDataType::UByte4Normalized:     return 4;
+			case ShaderDataType::Short2Normalized:     return 2;
+			case ShaderDataType::UShort2Normalized:    return 2;
+			case ShaderDataType::Half2:                return 2;
+			case ShaderDataType::Half4:                return 4;
 		}
 		PK_ASSERT(false, "Unknown ShaderDataType, cannot determine its components count.", "Pekan");
 		return 0;
@@ -177,6 +246,38 @@ namespace Graphics
 		);
 	}
 
+	bool RenderState::isShaderDataTypeNormalized(ShaderDataType type)
+	{
+		return
+		(
+			type == ShaderDataType::UByte4Normalized ||
+			type == ShaderDataType::Short2Normalized ||
+			type == ShaderDataType::UShort2Normalized
+		);
+	}
+
+	unsigned RenderState::getIndexTypeOpenGLEnum(IndexType indexType)
+	{
+		switch (indexType)
+		{
+			case IndexType::UnsignedInt:      return GL_UNSIGNED_INT;
+			case IndexType::UnsignedShort:    return GL_UNSIGNED_SHORT;
+		}
+		PK_ASSERT(false, "Unknown IndexType, cannot determine OpenGL enum.", "Pekan");
+		return 0;
+	}
+
+	unsigned RenderState::getIndexTypeSize(IndexType indexType)
+	{
+		switch (indexType)
+		{
+			case IndexType::UnsignedInt:      return 4;
+			case IndexType::UnsignedShort:    return 2;
+		}
+		PK_ASSERT(false, "Unknown IndexType, cannot determine its size.", "Pekan");
+		return 0;
+	}
+
 	unsigned RenderState::getTextureSlotOpenGLEnum(unsigned slot)
 	{
 		switch (slot)
@@ -223,7 +324,12 @@ namespace Graphics
 		static int maxTextureSlots = -1;
 		if (maxTextureSlots == -1)
 		{
-			glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureSlots);
+			// Minimum guaranteed by OpenGL
+			maxTextureSlots = 16;
+			if (GraphicsBackend::isOpenGL())
+			{
+				GLCall(glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureSlots));
+			}
 		}
 		return maxTextureSlots;
 	}
@@ -233,7 +339,12 @@ namespace Graphics
 		static int maxTextureSize = -1;
 		if (maxTextureSize == -1)
 		{
-			glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+			// A size common on desktop GPUs
+			maxTextureSize = 8192;
+			if (GraphicsBackend::isOpenGL())
+			{
+				GLCall(glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize));
+			}
 		}
 		return maxTextureSize;
 	}
@@ -11,7 +11,27 @@ namespace Graphics
 	// They are mapped to concrete data types of GLSL, HLSL, etc.
 	enum class ShaderDataType
 	{
-		None = 0, Float = 1, Float2 = 2, Float3 = 3, Float4 = 4, Mat3 = 5, Mat4 = 6, Int = 7, Int2 = 8, Int3 = 9, Int4 = 10, Bool = 11
+		None = 0, Float = 1, Float2 = 2, Float3 = 3, Float4 = 4, Mat3 = 5, Mat4 = 6, Int = 7, Int2 = 8, Int3 = 9, Int4 = 10, Bool = 11,
+
+		// Compact types, stored in fewer bytes but read inside of shaders as floats (vec2 or vec4)
+
+		// 4 unsigned bytes, each mapped to [0, 1]. Useful for packed RGBA8 colors (see PackedColor).
+		UByte4Normalized = 12,
+		// 2 signed 16-bit integers, each mapped to [-1, 1]
+		Short2Normalized = 13,
+		// 2 unsigned 16-bit integers, each mapped to [0, 1]. Useful for texture coordinates.
+		UShort2Normalized = 14,
+		// 2 or 4 half precision (16-bit) floats
+		Half2 = 15, Half4 = 16
+	};
+
+	// Enum for data types of indices inside of an index buffer
+	enum class IndexType
+	{
+		// 32-bit indices, can index any number of vertices
+		UnsignedInt = 0,
+		// 16-bit indices, can index at most 65536 vertices but take half the memory
+		UnsignedShort = 1
 	};
 
 	// Enum for different types of blending factors
@@ -33,6 +53,21 @@ namespace Graphics
 		OneMinusConstantAlpha
 	};
 
+	// Enum for different functions that can be used for depth testing.
+	// A depth function compares an incoming fragment's depth with the depth already in the depth buffer,
+	// and the fragment passes the depth test if the comparison is true.
+	enum class DepthFunction
+	{
+		Never,
+		Less,
+		Equal,
+		LessOrEqual,
+		Greater,
+		NotEqual,
+		GreaterOrEqual,
+		Always
+	};
+
 	// Enum for different types of usage of a buffer
 	enum class BufferDataUsage
 	{
@@ -113,12 +148,16 @@ namespace Graphics
 		friend class Texture1D;
 		friend class Texture2D;
 		friend class Texture2DMultisample;
+		friend class RenderCommands;
 
 	public:
 
 		// Sets background's color, used to clear window
 		static void setBackgroundColor(float r, float g, float b, float a);
 
+		// Sets the region of the currently bound frame buffer that is rendered to, in pixels
+		static void setViewport(int x, int y, int width, int height);
+
 		// Enables blending capability
 		static void enableBlending();
 
@@ -136,6 +175,17 @@ namespace Graphics
 		// Checks if depth testing is enabled.
 		static bool isEnabledDepthTest();
 
+		// Sets the function used for depth testing. Default is DepthFunction::Less.
+		static void setDepthFunction(DepthFunction depthFunction);
+		static DepthFunction getDepthFunction();
+
+		// Enables/disables writing to the depth buffer.
+		// Fragments are still depth tested while depth writing is disabled, they just don't update the depth buffer.
+		// Usually disabled while rendering transparent primitives.
+		static void enableDepthWriting();
+		static void disableDepthWriting();
+		static bool isEnabledDepthWriting();
+
 		// Enables Multisample Anti-Aliasing (MSAA) for removing jagged edges of shapes and lines.
 		// IMPORTANT: In order for MSAA to work you need to have a window
 		//            with numberOfSamples greater than 1, preferably 4, 8, 16, 32 or 64.
@@ -161,6 +211,9 @@ namespace Graphics
 		// and a 2D texture can have at most 1024 * 1024 = 1048576 texels.
 		static int getMaxTextureSize();
 
+		// Returns size in bytes of a single index of a given type
+		static unsigned getIndexTypeSize(IndexType indexType);
+
 	private: /* functions */
 
 		// Returns the OpenGL base data type corresponding to the given shader data type.
@@ -171,6 +224,9 @@ namespace Graphics
 		// Returns the OpenGL enum value corresponding to the given blend factor
 		static unsigned getBlendFactorOpenGLEnum(BlendFactor blendFactor);
 
+		// Returns the OpenGL enum value corresponding to the given depth function
+		static unsigned getDepthFunctionOpenGLEnum(DepthFunction depthFunction);
+
 		// Returns the OpenGL enum value corresponding to the given buffer data usage
 		static unsigned getBufferDataUsageOpenGLEnum(BufferDataUsage dataUsage);
 
@@ -183,6 +239,13 @@ namespace Graphics
 		// Checks if a shader data type's base type is int
 		static bool isShaderDataTypeInt(ShaderDataType type);
 
+		// Checks if a shader data type is always normalized, meaning that it's stored as integers
+		// but read inside of shaders as floats in range [0, 1] or [-1, 1]
+		static bool isShaderDataTypeNormalized(ShaderDataType type);
+
+		// Returns the OpenGL enum value corresponding to the given index type
+		static unsigned getIndexTypeOpenGLEnum(IndexType indexType);
+
 		// Returns the OpenGL enum value corresponding to the given texture slot
 		static unsigned getTextureSlotOpenGLEnum(unsigned slot);
 
@@ -0,0 +1,117 @@
+#include "RenderTargetPool.h"
+
+#include "FrameBuffer.h"
+#include "PekanLogger.h"
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	RenderTargetPool::~RenderTargetPool()
+	{
+		// Render targets still in use are destroyed too, since nobody can release them to the pool anymore
+		for (Entry& entry : m_entries)
+		{
+			entry.frameBuffer->destroy();
+		}
+	}
+
+	FrameBuffer* RenderTargetPool::acquire(const RenderTargetDescription& description)
+	{
+		PK_ASSERT(description.width > 0 && description.height > 0, "Trying to acquire a render target with an invalid size.", "Pekan");
+		PK_ASSERT(description.samplesPerPixel > 0, "Trying to acquire a render target with samples per pixel <= 0.", "Pekan");
+
+		// Reuse a free frame buffer matching the description, if there is one
+		for (Entry& entry : m_entries)
+		{
+			if (!entry.isInUse && entry.description == description)
+			{
+				entry.isInUse = true;
+				entry.lastUsedFrameIndex = m_frameIndex;
+				return entry.frameBuffer.get();
+			}
+		}
+
+		// Otherwise recreate a free frame buffer that hasn't been acquired in this frame,
+		// so that a size changing every frame, for example while the window is being resized,
+		// keeps reusing the same entries instead of piling up frame buffers of stale sizes.
+		for (Entry& entry : m_entries)
+		{
+			if (!entry.isInUse && entry.lastUsedFrameIndex < m_frameIndex)
+			{
+				entry.frameBuffer->destroy();
+				createFrameBuffer(entry, description);
+				return entry.frameBuffer.get();
+			}
+		}
+
+		// Otherwise create a new one
+		m_entries.emplace_back();
+		Entry& entry = m_entries.back();
+		entry.frameBuffer = std::make_unique<FrameBuffer>();
+		createFrameBuffer(entry, description);
+		return entry.frameBuffer.get();
+	}
+
+	void RenderTargetPool::release(const FrameBuffer* frameBuffer)
+	{
+		for (Entry& entry : m_entries)
+		{
+			if (entry.frameBuffer.get() == frameBuffer)
+			{
+				PK_ASSERT(entry.isInUse, "Trying to release a render target that is not in use.", "Pekan");
+				entry.isInUse = false;
+				return;
+			}
+		}
+		PK_LOG_ERROR("Trying to release a render target that doesn't belong to the RenderTargetPool.", "Pekan");
+	}
+
+	void RenderTargetPool::update(int maxUnusedFramesCount)
+	{
+		for (size_t i = 0; i < m_entries.size();)
+		{
+			Entry& entry = m_entries[i];
+			if (!entry.isInUse && m_frameIndex - entry.lastUsedFrameIndex > maxUnusedFramesCount)
+			{
+				entry.frameBuffer->destroy();
+				// Order of entries doesn't matter, so remove by moving the last one in its place
+				if (i + 1 < m_entries.size())
+				{
+					m_entries[i] = std::move(m_entries.back());
+				}
+				m_entries.pop_back();
+			}
+			else
+			{
+				i++;
+			}
+		}
+		m_frameIndex++;
+	}
+
+	void RenderTargetPool::createFrameBuffer(Entry& entry, const RenderTargetDescription& description)
+	{
+		entry.description = description;
+		entry.frameBuffer->create(description.width, description.height, description.samplesPerPixel);
+		if (description.useLinearFilter && description.samplesPerPixel == 1)
+		{
+			entry.frameBuffer->setTextureFilter(TextureMinifyFunction::Linear, TextureMagnifyFunction::Linear);
+		}
+		entry.isInUse = true;
+		entry.lastUsedFrameIndex = m_frameIndex;
+	}
+
+	void RenderTargetPool::clear()
+	{
+		for (Entry& entry : m_entries)
+		{
+			PK_ASSERT(!entry.isInUse, "Trying to clear a RenderTargetPool while some of its render targets are still in use.", "Pekan");
+			entry.frameBuffer->destroy();
+		}
+		m_entries.clear();
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
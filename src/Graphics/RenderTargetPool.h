@@ -0,0 +1,85 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	class FrameBuffer;
+
+	// Description of a render target, from which a frame buffer can be created
+	struct RenderTargetDescription
+	{
+		// Size of render target, in pixels
+		int width = 0;
+		int height = 0;
+
+		// Number of samples per pixel
+		int samplesPerPixel = 1;
+
+		// Flag indicating if render target's texture should be sampled with linear filtering instead of nearest.
+		// (Has effect only for single-sample render targets)
+		bool useLinearFilter = false;
+
+		bool operator==(const RenderTargetDescription& other) const = default;
+	};
+
+	// A pool of frame buffers used as render targets, reused across frames.
+	//
+	// Acquiring a render target returns a free frame buffer matching the description.
+	// If there is none, a free frame buffer that hasn't been acquired in the current frame is recreated to match it,
+	// and only if there is no such frame buffer either, a new one is created.
+	// Frame buffers that haven't been acquired for a few frames are destroyed, so render targets of an old size,
+	// for example from before the window was resized, don't stay allocated forever.
+	class RenderTargetPool
+	{
+	public:
+
+		~RenderTargetPool();
+
+		// Acquires a frame buffer matching a given description, (re)creating it if needed.
+		// The frame buffer is in use until it's released.
+		FrameBuffer* acquire(const RenderTargetDescription& description);
+		// Releases a frame buffer previously acquired from the pool, so that it can be acquired again
+		void release(const FrameBuffer* frameBuffer);
+
+		// A function to be called once per frame, after all render targets of the frame have been released.
+		// Destroys frame buffers that have not been acquired for more than a given number of frames.
+		void update(int maxUnusedFramesCount = 3);
+
+		// Destroys all frame buffers of the pool. None of them must be in use.
+		void clear();
+
+		// Returns number of frame buffers currently allocated by the pool
+		int getFrameBuffersCount() const { return int(m_entries.size()); }
+
+	private: /* functions */
+
+		struct Entry;
+
+		// Creates entry's frame buffer with a given description, and marks it as acquired in the current frame
+		void createFrameBuffer(Entry& entry, const RenderTargetDescription& description);
+
+	private: /* variables */
+
+		// A frame buffer of the pool
+		struct Entry
+		{
+			RenderTargetDescription description;
+			std::unique_ptr<FrameBuffer> frameBuffer;
+			bool isInUse = false;
+			// Index of the frame in which the frame buffer was last acquired
+			long long lastUsedFrameIndex = 0;
+		};
+
+		std::vector<Entry> m_entries;
+
+		// Index of the current frame, counted by calls to update()
+		long long m_frameIndex = 0;
+	};
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
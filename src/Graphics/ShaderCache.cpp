@@ -0,0 +1,127 @@
+#include "ShaderCache.h"
+
+#include "Shader.h"
+#include "PekanLogger.h"
+
+#include <memory>
+#include <unordered_map>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// All cached shaders, by their permutation keys
+	static std::unordered_map<std::string, std::unique_ptr<Shader>> g_shaders;
+
+	// Returns permutation key of a shader made of given vertex and fragment shader files
+	static std::string getFilesPermutationKey
+	(
+		const std::string& vertexShaderFilepath,
+		const std::string& fragmentShaderFilepath,
+		const ShaderDefines& defines,
+		const ShaderSubstitutions& substitutions
+	)
+	{
+		// Prefix vertex shader's filepath with its length, so that filepaths containing "+" can't give the same name
+		const std::string name = std::to_string(vertexShaderFilepath.size()) + ":" + vertexShaderFilepath + "+" + fragmentShaderFilepath;
+		return ShaderPreprocessor::getPermutationKey(name, defines, substitutions);
+	}
+
+	Shader* ShaderCache::find(const std::string& key)
+	{
+		const auto it = g_shaders.find(key);
+		return (it != g_shaders.end()) ? it->second.get() : nullptr;
+	}
+
+	Shader* ShaderCache::getOrCreate(const std::string& key, const char* vertexShaderSource, const char* fragmentShaderSource)
+	{
+		Shader* shader = find(key);
+		if (shader != nullptr)
+		{
+			return shader;
+		}
+
+		std::unique_ptr<Shader> newShader = std::make_unique<Shader>();
+		if (!newShader->create(vertexShaderSource, fragmentShaderSource))
+		{
+			// Don't cache shaders that failed to compile, so that they can be retried, for example after fixing an include
+			PK_LOG_ERROR("Failed to compile shader " << key << ". It will not be cached.", "Pekan");
+			newShader->destroy();
+			return nullptr;
+		}
+		shader = newShader.get();
+		g_shaders[key] = std::move(newShader);
+		return shader;
+	}
+
+	Shader* ShaderCache::getPermutation
+	(
+		const std::string& vertexShaderFilepath,
+		const std::string& fragmentShaderFilepath,
+		const ShaderDefines& defines,
+		const ShaderSubstitutions& substitutions
+	)
+	{
+		const std::string key = getFilesPermutationKey(vertexShaderFilepath, fragmentShaderFilepath, defines, substitutions);
+		Shader* shader = find(key);
+		if (shader != nullptr)
+		{
+			return shader;
+		}
+
+		const std::string vertexShaderSource = ShaderPreprocessor::preprocessFile(vertexShaderFilepath, defines, substitutions);
+		const std::string fragmentShaderSource = ShaderPreprocessor::preprocessFile(fragmentShaderFilepath, defines, substitutions);
+		if (vertexShaderSource.empty() || fragmentShaderSource.empty())
+		{
+			PK_LOG_ERROR("Failed to preprocess shader permutation " << key, "Pekan");
+			return nullptr;
+		}
+		return getOrCreate(key, vertexShaderSource.c_str(), fragmentShaderSource.c_str());
+	}
+
+	int ShaderCache::precompile
+	(
+		const std::string& vertexShaderFilepath,
+		const std::string& fragmentShaderFilepath,
+		const std::vector<ShaderDefines>& permutations,
+		const ShaderSubstitutions& substitutions
+	)
+	{
+		int compiledCount = 0;
+		for (const ShaderDefines& defines : permutations)
+		{
+			const std::string key = getFilesPermutationKey(vertexShaderFilepath, fragmentShaderFilepath, defines, substitutions);
+			if (find(key) != nullptr)
+			{
+				continue;
+			}
+			if (getPermutation(vertexShaderFilepath, fragmentShaderFilepath, defines, substitutions) != nullptr)
+			{
+				compiledCount++;
+			}
+		}
+		return compiledCount;
+	}
+
+	int ShaderCache::getShadersCount()
+	{
+		return int(g_shaders.size());
+	}
+
+	void ShaderCache::clear()
+	{
+		for (auto& [key, shader] : g_shaders)
+		{
+			shader->destroy();
+		}
+		g_shaders.clear();
+	}
+
+	void ShaderCache::exit()
+	{
+		clear();
+	}
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
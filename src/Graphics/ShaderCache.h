@@ -0,0 +1,75 @@
+#pragma once
+
+#include "ShaderPreprocessor.h"
+
+#include <string>
+#include <vector>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	class Shader;
+
+	// A static class caching compiled shaders, identified by their permutation keys.
+	//
+	// Shaders are preprocessed in memory by the ShaderPreprocessor and compiled straight into the cache,
+	// without writing anything to disk. All permutations that might be needed can be precompiled at load time,
+	// so that switching between them at runtime is only a lookup and never causes a compilation hitch.
+	//
+	// Cached shaders are owned by the cache and stay valid until the Graphics subsystem is exited,
+	// or until a registered include is replaced with different source code, since that makes all cached shaders stale.
+	// A cached shader may be shared by multiple users, and so are its uniforms.
+	class ShaderCache
+	{
+		// Make GraphicsSubsystem a friend so that it can exit ShaderCache when GraphicsSubsystem is exited.
+		friend class GraphicsSubsystem;
+		// Make ShaderPreprocessor a friend so that it can clear ShaderCache when a registered include changes.
+		friend class ShaderPreprocessor;
+
+	public:
+
+		// Returns the cached shader with a given key, or a null pointer if there is no such shader in the cache
+		static Shader* find(const std::string& key);
+
+		// Returns the cached shader with a given key, compiling it from given source code first if it's not yet cached.
+		// If compilation fails, returns a null pointer and caches nothing.
+		static Shader* getOrCreate(const std::string& key, const char* vertexShaderSource, const char* fragmentShaderSource);
+
+		// Returns a permutation of a shader made of given vertex and fragment shader files,
+		// preprocessed with given defines and substitutions.
+		// If the permutation is not yet cached, files are preprocessed and the permutation is compiled first.
+		static Shader* getPermutation
+		(
+			const std::string& vertexShaderFilepath,
+			const std::string& fragmentShaderFilepath,
+			const ShaderDefines& defines = {},
+			const ShaderSubstitutions& substitutions = {}
+		);
+
+		// Compiles all given permutations of a shader made of given vertex and fragment shader files, that are not yet cached.
+		// Meant to be called at load time. Returns number of newly compiled permutations.
+		static int precompile
+		(
+			const std::string& vertexShaderFilepath,
+			const std::string& fragmentShaderFilepath,
+			const std::vector<ShaderDefines>& permutations,
+			const ShaderSubstitutions& substitutions = {}
+		);
+
+		// Returns number of shaders in the cache
+		static int getShadersCount();
+
+	private:
+
+		// Destroys all cached shaders
+		static void clear();
+
+		// Destroys all cached shaders. Must be called before OpenGL context destruction.
+		// Only GraphicsSubsystem should call this.
+		static void exit();
+	};
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
@@ -1,91 +1,342 @@
 #include "ShaderPreprocessor.h"
 
+#include "ShaderCache.h"
 #include "PekanLogger.h"
 #include "Utils/FileUtils.h"
 
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
 namespace Pekan
 {
 namespace Graphics
 {
 
-	// Replaces a filepath's extension with given extension
-	static std::string replaceFilepathExtension(const std::string& filepath, const std::string& newExtension)
+	// Maximum depth of nested includes, protecting against runaway recursion
+	constexpr int MAX_INCLUDE_DEPTH = 32;
+
+	// Sources registered to be included by name, without being read from disk
+	static std::unordered_map<std::string, std::string> g_registeredIncludes;
+
+	// Returns directory part of a given filepath, including the trailing separator,
+	// or an empty string if filepath has no directory part
+	static std::string getDirectory(const std::string& filepath)
 	{
-		const size_t dotPos = filepath.find_last_of('.');
-		if (dotPos == std::string::npos)
+		const size_t separatorPos = filepath.find_last_of("/\\");
+		if (separatorPos == std::string::npos)
 		{
-			PK_LOG_WARNING("Trying to replace a filepath's extension in ShaderPreprocessor, but given filepath doesn't have an extension.", "Pekan");
-			return filepath + newExtension;
+			return std::string();
 		}
-
-		return filepath.substr(0, dotPos) + newExtension;
+		return filepath.substr(0, separatorPos + 1);
 	}
 
-	void ShaderPreprocessor::preprocess(const std::string& pkshadFilepath, const std::unordered_map<std::string, std::string>& substitutions)
+	// If a given line is an #include directive, extracts included name from it and returns true.
+	// Otherwise returns false.
+	static bool parseIncludeDirective(const std::string& line, std::string& includedName)
 	{
-		if (pkshadFilepath.substr(pkshadFilepath.size() - 7) != ".pkshad")
+		size_t pos = line.find_first_not_of(" \t");
+		if (pos == std::string::npos || line.compare(pos, 8, "#include") != 0)
+		{
+			return false;
+		}
+		pos = line.find_first_not_of(" \t", pos + 8);
+		if (pos == std::string::npos || (line[pos] != '"' && line[pos] != '<'))
 		{
-			PK_LOG_WARNING("Trying to preprocess a .pkshad file but given filepath doesn't have a .pkshad extension.", "Pekan");
+			return false;
 		}
+		const char closingCharacter = (line[pos] == '"') ? '"' : '>';
+		const size_t end = line.find(closingCharacter, pos + 1);
+		if (end == std::string::npos)
+		{
+			return false;
+		}
+		includedName = line.substr(pos + 1, end - (pos + 1));
+		return true;
+	}
+
+	// Appends a #line directive to given output, making the next line be reported as given line of given source string
+	static void appendLineDirective(std::string& output, int lineNumber, int sourceIndex)
+	{
+		output += "#line " + std::to_string(lineNumber) + " " + std::to_string(sourceIndex) + '\n';
+	}
 
-		// Read .pkshad file
-		const std::string pkshadContent = FileUtils::readTextFileToString(pkshadFilepath.c_str());
+	// Appends given source to given output, replacing each #include directive with the included source, recursively.
+	// Included sources are surrounded by #line directives, so that compiler errors point to the original lines.
+	// Each included source gets the next source string index, and the index of given source is given as sourceIndex.
+	// Returns false if an included source can't be found.
+	static bool resolveIncludes
+	(
+		const std::string& source,
+		const std::string& sourceName,
+		int sourceIndex,
+		std::unordered_set<std::string>& includedSources,
+		int& nextSourceIndex,
+		int depth,
+		std::string& output
+	)
+	{
+		if (depth > MAX_INCLUDE_DEPTH)
+		{
+			PK_LOG_ERROR("Includes are nested too deeply while preprocessing shader " << sourceName, "Pekan");
+			return false;
+		}
 
-		// If we have no substitutions,
-		// just write .pkshad file's contents into a corresponding .glsl file
-		if (substitutions.empty())
+		bool success = true;
+		size_t lineStart = 0;
+		// 1-based number of the current line in given source
+		int lineNumber = 0;
+		while (lineStart < source.size())
 		{
-			const std::string glslFilepath = replaceFilepathExtension(pkshadFilepath, ".glsl");
-			FileUtils::writeStringToTextFile(glslFilepath.c_str(), pkshadContent.c_str());
-			return;
+			lineNumber++;
+			size_t lineEnd = source.find('\n', lineStart);
+			if (lineEnd == std::string::npos)
+			{
+				lineEnd = source.size();
+			}
+			const std::string line = source.substr(lineStart, lineEnd - lineStart);
+
+			std::string includedName;
+			if (!parseIncludeDirective(line, includedName))
+			{
+				output.append(source, lineStart, lineEnd - lineStart);
+				output += '\n';
+				lineStart = lineEnd + 1;
+				continue;
+			}
+			lineStart = lineEnd + 1;
+
+			// Look up included source among registered ones first, then on disk relative to the including file
+			const auto it = g_registeredIncludes.find(includedName);
+			const std::string includedKey = (it != g_registeredIncludes.end()) ? includedName : getDirectory(sourceName) + includedName;
+			// Each source is included at most once.
+			// A directive that includes nothing is replaced with an empty line, so that line numbers stay the same.
+			if (includedSources.count(includedKey) > 0)
+			{
+				output += '\n';
+				continue;
+			}
+			includedSources.insert(includedKey);
+
+			std::string includedSource;
+			if (it != g_registeredIncludes.end())
+			{
+				includedSource = it->second;
+			}
+			else
+			{
+				includedSource = FileUtils::readTextFileToString(includedKey.c_str());
+				if (includedSource.empty())
+				{
+					PK_LOG_ERROR("Failed to include \"" << includedName << "\" while preprocessing shader " << sourceName, "Pekan");
+					success = false;
+					output += '\n';
+					continue;
+				}
+			}
+
+			const int includedSourceIndex = nextSourceIndex++;
+			appendLineDirective(output, 1, includedSourceIndex);
+			if (!resolveIncludes(includedSource, includedKey, includedSourceIndex, includedSources, nextSourceIndex, depth + 1, output))
+			{
+				success = false;
+			}
+			// Continue with the line after the #include directive
+			appendLineDirective(output, lineNumber + 1, sourceIndex);
 		}
+		return success;
+	}
 
-		std::string glslContent = pkshadContent;
+	// Substitutes {{PLACEHOLDER}}s in given source with their values, in a single pass over the source
+	static std::string substitutePlaceholders(const std::string& source, const std::string& sourceName, const ShaderSubstitutions& substitutions)
+	{
+		std::string output;
+		output.reserve(source.size());
 
-		// Traverse .glsl content,
-		// searching for placeholders and replacing them with their values.
 		size_t searchPos = 0;
-		while (searchPos < glslContent.size())
+		while (searchPos < source.size())
 		{
 			// Find start of next placeholder
-			const size_t start = glslContent.find("{{", searchPos);
+			const size_t start = source.find("{{", searchPos);
 			if (start == std::string::npos)
 			{
 				break;
 			}
 			// Find end of placeholder
-			const size_t end = glslContent.find("}}", start);
+			const size_t end = source.find("}}", start);
 			if (end == std::string::npos)
 			{
-				PK_LOG_ERROR("Failed to preprocess a .pkshad file because of a wrongly formatted placeholder: " << pkshadFilepath, "Pekan");
+				PK_LOG_ERROR("Wrongly formatted placeholder while preprocessing shader " << sourceName, "Pekan");
 				break;
 			}
-			// Extract placeholder from between "{{" and "}}"
-			const std::string placeholder = glslContent.substr(start + 2, end - (start + 2));
-			// Find placeholder in given substitutions map
-			auto it = substitutions.find(placeholder);
+
+			// Copy everything before the placeholder
+			output.append(source, searchPos, start - searchPos);
+
+			// Extract placeholder from between "{{" and "}}", and find it in given substitutions
+			const std::string placeholder = source.substr(start + 2, end - (start + 2));
+			const auto it = substitutions.find(placeholder);
 			if (it != substitutions.end())
 			{
-				// Replace placeholder with its value
-				glslContent.replace(start, end - start + 2, it->second);
-				// Continue search right after the inserted value
-				searchPos = start + it->second.length();
+				output += it->second;
 			}
 			else
 			{
-				PK_LOG_WARNING
-				(
-					"Missing substitution for placeholder {{" << placeholder << "}} while preprocessing a .pkshad file: " << pkshadFilepath,
-					"Pekan"
-				);
+				PK_LOG_WARNING("Missing substitution for placeholder {{" << placeholder << "}} while preprocessing shader " << sourceName, "Pekan");
 				// We can continue after that, we'll just not make the substitution as we don't have it
-				searchPos = end + 2;
+				output.append(source, start, end + 2 - start);
 			}
+			searchPos = end + 2;
+		}
+		// Copy everything after the last placeholder
+		if (searchPos < source.size())
+		{
+			output.append(source, searchPos, std::string::npos);
+		}
+
+		return output;
+	}
+
+	// Inserts a #define for each of given defines right after the #version directive,
+	// or at the beginning if there is no #version directive.
+	// The defines are followed by a #line directive, so that lines after them keep their original numbers.
+	static void insertDefines(std::string& source, const ShaderDefines& defines)
+	{
+		if (defines.empty())
+		{
+			return;
 		}
 
-		// Write processed content to a .glsl file corresponding to the given .pkshad file
-		const std::string glslFilepath = replaceFilepathExtension(pkshadFilepath, ".glsl");
-		FileUtils::writeStringToTextFile(glslFilepath.c_str(), glslContent.c_str());
+		std::string definesBlock;
+		for (const auto& [name, value] : defines)
+		{
+			definesBlock += "#define " + name;
+			if (!value.empty())
+			{
+				definesBlock += " " + value;
+			}
+			definesBlock += '\n';
+		}
+
+		size_t insertPos = 0;
+		// 1-based number of the line following the defines, in the main source
+		int nextLineNumber = 1;
+		const size_t versionPos = source.find("#version");
+		if (versionPos != std::string::npos)
+		{
+			const size_t versionLineEnd = source.find('\n', versionPos);
+			insertPos = (versionLineEnd != std::string::npos) ? versionLineEnd + 1 : source.size();
+			if (versionLineEnd == std::string::npos)
+			{
+				definesBlock.insert(definesBlock.begin(), '\n');
+			}
+			// #version must come before any includes, so lines up to it are the main source's own lines
+			nextLineNumber = int(std::count(source.begin(), source.begin() + versionPos, '\n')) + 2;
+		}
+		appendLineDirective(definesBlock, nextLineNumber, 0);
+		source.insert(insertPos, definesBlock);
+	}
+
+	std::string ShaderPreprocessor::preprocessSource
+	(
+		const std::string& source,
+		const std::string& sourceName,
+		const ShaderDefines& defines,
+		const ShaderSubstitutions& substitutions
+	)
+	{
+		std::string result;
+		result.reserve(source.size());
+
+		std::unordered_set<std::string> includedSources;
+		includedSources.insert(sourceName);
+		// Given source is source string 0, and included sources are numbered from 1 in the order in which they are included
+		int nextSourceIndex = 1;
+		if (!resolveIncludes(source, sourceName, 0, includedSources, nextSourceIndex, 0, result))
+		{
+			PK_LOG_ERROR("Failed to resolve all includes while preprocessing shader " << sourceName, "Pekan");
+		}
+
+		if (!substitutions.empty())
+		{
+			result = substitutePlaceholders(result, sourceName, substitutions);
+		}
+
+		insertDefines(result, defines);
+
+		return result;
+	}
+
+	std::string ShaderPreprocessor::preprocessFile(const std::string& filepath, const ShaderDefines& defines, const ShaderSubstitutions& substitutions)
+	{
+		const std::string source = FileUtils::readTextFileToString(filepath.c_str());
+		if (source.empty())
+		{
+			PK_LOG_ERROR("Failed to read shader file for preprocessing: " << filepath, "Pekan");
+			return std::string();
+		}
+		return preprocessSource(source, filepath, defines, substitutions);
+	}
+
+	void ShaderPreprocessor::registerInclude(const std::string& name, const std::string& source)
+	{
+		const auto it = g_registeredIncludes.find(name);
+		if (it == g_registeredIncludes.end())
+		{
+			g_registeredIncludes[name] = source;
+			return;
+		}
+		if (it->second == source)
+		{
+			return;
+		}
+
+		it->second = source;
+		// Any cached shader might have been compiled with the old source, so all of them are stale now.
+		// We can't know which ones included it, since includes are resolved before compilation.
+		PK_LOG_WARNING("Replaced registered shader include \"" << name << "\". All cached shaders are destroyed.", "Pekan");
+		ShaderCache::clear();
+	}
+
+	// Appends a part of a permutation key to given key, prefixed with part's length,
+	// so that no name or value can be mistaken for a separator, whatever characters it contains
+	static void appendKeyPart(std::string& key, const std::string& part)
+	{
+		key += std::to_string(part.size());
+		key += ':';
+		key += part;
+	}
+
+	std::string ShaderPreprocessor::getPermutationKey(const std::string& name, const ShaderDefines& defines, const ShaderSubstitutions& substitutions)
+	{
+		std::string key;
+		appendKeyPart(key, name);
+		// Defines are already ordered by name
+		key += "|D";
+		for (const auto& [defineName, value] : defines)
+		{
+			appendKeyPart(key, defineName);
+			appendKeyPart(key, value);
+		}
+		// Substitutions are not ordered, so order them by name, so that the same substitutions always give the same key
+		if (!substitutions.empty())
+		{
+			std::vector<const std::pair<const std::string, std::string>*> orderedSubstitutions;
+			orderedSubstitutions.reserve(substitutions.size());
+			for (const auto& substitution : substitutions)
+			{
+				orderedSubstitutions.push_back(&substitution);
+			}
+			std::sort(orderedSubstitutions.begin(), orderedSubstitutions.end(),
+				[](const auto* a, const auto* b) { return a->first < b->first; });
+			key += "|S";
+			for (const auto* substitution : orderedSubstitutions)
+			{
+				appendKeyPart(key, substitution->first);
+				appendKeyPart(key, substitution->second);
+			}
+		}
+		return key;
 	}
 
 } // namespace Graphics
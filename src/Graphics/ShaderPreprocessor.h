@@ -1,26 +1,75 @@
 #pragma once
 
+#include <map>
 #include <string>
 #include <unordered_map>
-#include <fstream>
-#include <sstream>
 
 namespace Pekan
 {
 namespace Graphics
 {
 
-	// A class used for preprocessing .pkshad* files into .glsl files
+	// Type definition for feature defines selecting a permutation of a shader, mapping names to values.
+	// An empty value defines just the name.
+	// Ordered, so that the same set of defines always gives the same permutation key.
+	typedef std::map<std::string, std::string> ShaderDefines;
+
+	// Type definition for substitutions of {{PLACEHOLDER}}s in a shader, mapping placeholder names to values
+	typedef std::unordered_map<std::string, std::string> ShaderSubstitutions;
+
+	// A class used for preprocessing shader source code in memory, before it's compiled.
+	//
+	// Preprocessing does the following, in order:
+	//   1. Resolves #include "name" directives, recursively.
+	//      Included sources are looked up first among sources registered with registerInclude(),
+	//      and then on disk, relative to the directory of the including file.
+	//      Each source is included at most once, so there is no need for include guards.
+	//   2. Substitutes {{PLACEHOLDER}}s with values from given substitutions.
+	//   3. Inserts a #define for each of given defines, right after the #version directive.
+	//
+	// Included sources and defines are surrounded by #line directives, so that compiler errors point to original lines.
+	// Since GLSL identifies sources only by numbers, the preprocessed source is source string 0,
+	// and included sources are numbered from 1 in the order in which they are first included.
 	//
-	// * .pkshad is a custom Pekan file format for shaders
+	// Works with .pkshad* files as well as with plain .glsl files.
+	//
+	// * .pkshad is a custom Pekan file format for shaders, a .glsl file that may contain {{PLACEHOLDER}}s
 	class ShaderPreprocessor
 	{
 	public:
 
-		// Preprocesses a .pkshad file containing a Pekan shader, using a given list of substitutions.
-		// Generates a corresponding .glsl file with the resulting shader
-		// in the same path, same name, with .glsl extension.
-		static void preprocess(const std::string& pkshadFilepath, const std::unordered_map<std::string, std::string>& substitutions);
+		// Preprocesses given shader source code, returning the resulting source code.
+		// Source name is used in error messages, and as a filepath for resolving relative includes.
+		static std::string preprocessSource
+		(
+			const std::string& source,
+			const std::string& sourceName,
+			const ShaderDefines& defines = {},
+			const ShaderSubstitutions& substitutions = {}
+		);
+
+		// Reads a shader file and preprocesses it, returning the resulting source code
+		static std::string preprocessFile
+		(
+			const std::string& filepath,
+			const ShaderDefines& defines = {},
+			const ShaderSubstitutions& substitutions = {}
+		);
+
+		// Registers source code that can be included by shaders with #include "name",
+		// without being read from disk. Registering a name again replaces its source,
+		// and if the source is different, destroys all shaders in the ShaderCache, invalidating pointers to them.
+		static void registerInclude(const std::string& name, const std::string& source);
+
+		// Returns a key uniquely identifying a permutation of a shader with a given name,
+		// preprocessed with given defines and substitutions.
+		// Names and values are length-prefixed in the key, so different permutations never share a key.
+		static std::string getPermutationKey
+		(
+			const std::string& name,
+			const ShaderDefines& defines = {},
+			const ShaderSubstitutions& substitutions = {}
+		);
 	};
 
 } // namespace Graphics
@@ -0,0 +1,165 @@
+#version 330 core
+out vec4 FragColor;
+in vec2 texCoords;
+
+// Fast Approximate Anti-Aliasing (FXAA).
+// Finds edges by luma contrast, searches along each edge for its ends,
+// and re-samples the pixel with an offset across the edge, using linear filtering to blend it with its neighbour.
+
+uniform sampler2D screenTexture;
+
+// Size of a single texel of screen texture, in texture coordinates
+uniform vec2 inverseScreenSize;
+
+// Minimum amount of local contrast required to apply the algorithm, relative and absolute
+const float EDGE_THRESHOLD_RELATIVE = 0.125;
+const float EDGE_THRESHOLD_ABSOLUTE = 0.0312;
+// Amount of sub-pixel aliasing removal
+const float SUBPIXEL_QUALITY = 0.75;
+// Number of steps, and the size of each step in texels, when searching for the ends of an edge
+const int SEARCH_STEPS_COUNT = 10;
+const float SEARCH_STEP_SIZES[SEARCH_STEPS_COUNT] = float[](1.0, 1.0, 1.0, 1.0, 1.0, 1.5, 2.0, 2.0, 4.0, 8.0);
+
+float getLuma(vec3 color)
+{
+	return sqrt(dot(color, vec3(0.299, 0.587, 0.114)));
+}
+
+float getLumaAt(vec2 uv)
+{
+	return getLuma(texture(screenTexture, uv).rgb);
+}
+
+void main()
+{
+	vec3 colorCenter = texture(screenTexture, texCoords).rgb;
+
+	// Luma of the pixel and its 4 direct neighbours
+	float lumaCenter = getLuma(colorCenter);
+	float lumaDown = getLuma(textureOffset(screenTexture, texCoords, ivec2( 0, -1)).rgb);
+	float lumaUp = getLuma(textureOffset(screenTexture, texCoords, ivec2( 0,  1)).rgb);
+	float lumaLeft = getLuma(textureOffset(screenTexture, texCoords, ivec2(-1,  0)).rgb);
+	float lumaRight = getLuma(textureOffset(screenTexture, texCoords, ivec2( 1,  0)).rgb);
+
+	// If contrast is too low, we are not on an edge, so leave the pixel as it is
+	float lumaMin = min(lumaCenter, min(min(lumaDown, lumaUp), min(lumaLeft, lumaRight)));
+	float lumaMax = max(lumaCenter, max(max(lumaDown, lumaUp), max(lumaLeft, lumaRight)));
+	float lumaRange = lumaMax - lumaMin;
+	if (lumaRange < max(EDGE_THRESHOLD_ABSOLUTE, lumaMax * EDGE_THRESHOLD_RELATIVE))
+	{
+		FragColor = vec4(colorCenter, 1.0);
+		return;
+	}
+
+	// Luma of the 4 corner neighbours
+	float lumaDownLeft = getLuma(textureOffset(screenTexture, texCoords, ivec2(-1, -1)).rgb);
+	float lumaUpRight = getLuma(textureOffset(screenTexture, texCoords, ivec2( 1,  1)).rgb);
+	float lumaUpLeft = getLuma(textureOffset(screenTexture, texCoords, ivec2(-1,  1)).rgb);
+	float lumaDownRight = getLuma(textureOffset(screenTexture, texCoords, ivec2( 1, -1)).rgb);
+
+	float lumaDownUp = lumaDown + lumaUp;
+	float lumaLeftRight = lumaLeft + lumaRight;
+	float lumaLeftCorners = lumaDownLeft + lumaUpLeft;
+	float lumaDownCorners = lumaDownLeft + lumaDownRight;
+	float lumaRightCorners = lumaDownRight + lumaUpRight;
+	float lumaUpCorners = lumaUpRight + lumaUpLeft;
+
+	// Decide if the edge is horizontal or vertical
+	float edgeHorizontal = abs(-2.0 * lumaLeft + lumaLeftCorners) + abs(-2.0 * lumaCenter + lumaDownUp) * 2.0 + abs(-2.0 * lumaRight + lumaRightCorners);
+	float edgeVertical = abs(-2.0 * lumaUp + lumaUpCorners) + abs(-2.0 * lumaCenter + lumaLeftRight) * 2.0 + abs(-2.0 * lumaDown + lumaDownCorners);
+	bool isHorizontal = (edgeHorizontal >= edgeVertical);
+
+	// Decide on which side of the pixel the edge is, by choosing the steepest gradient
+	float luma1 = isHorizontal ? lumaDown : lumaLeft;
+	float luma2 = isHorizontal ? lumaUp : lumaRight;
+	float gradient1 = luma1 - lumaCenter;
+	float gradient2 = luma2 - lumaCenter;
+	bool is1Steepest = (abs(gradient1) >= abs(gradient2));
+	float gradientScaled = 0.25 * max(abs(gradient1), abs(gradient2));
+
+	float stepLength = isHorizontal ? inverseScreenSize.y : inverseScreenSize.x;
+	float lumaLocalAverage = 0.0;
+	if (is1Steepest)
+	{
+		stepLength = -stepLength;
+		lumaLocalAverage = 0.5 * (luma1 + lumaCenter);
+	}
+	else
+	{
+		lumaLocalAverage = 0.5 * (luma2 + lumaCenter);
+	}
+
+	// Move half a texel towards the edge, and search along it in both directions for its ends
+	vec2 uvEdge = texCoords;
+	if (isHorizontal)
+	{
+		uvEdge.y += stepLength * 0.5;
+	}
+	else
+	{
+		uvEdge.x += stepLength * 0.5;
+	}
+	vec2 offset = isHorizontal ? vec2(inverseScreenSize.x, 0.0) : vec2(0.0, inverseScreenSize.y);
+	vec2 uv1 = uvEdge - offset;
+	vec2 uv2 = uvEdge + offset;
+	float lumaEnd1 = 0.0;
+	float lumaEnd2 = 0.0;
+	bool reached1 = false;
+	bool reached2 = false;
+	for (int i = 0; i < SEARCH_STEPS_COUNT; i++)
+	{
+		if (!reached1)
+		{
+			lumaEnd1 = getLumaAt(uv1) - lumaLocalAverage;
+			reached1 = (abs(lumaEnd1) >= gradientScaled);
+		}
+		if (!reached2)
+		{
+			lumaEnd2 = getLumaAt(uv2) - lumaLocalAverage;
+			reached2 = (abs(lumaEnd2) >= gradientScaled);
+		}
+		if (reached1 && reached2)
+		{
+			break;
+		}
+		if (!reached1)
+		{
+			uv1 -= offset * SEARCH_STEP_SIZES[i];
+		}
+		if (!reached2)
+		{
+			uv2 += offset * SEARCH_STEP_SIZES[i];
+		}
+	}
+
+	// Compute how far across the edge to re-sample, based on the distance to the closest end of the edge
+	float distance1 = isHorizontal ? (texCoords.x - uv1.x) : (texCoords.y - uv1.y);
+	float distance2 = isHorizontal ? (uv2.x - texCoords.x) : (uv2.y - texCoords.y);
+	bool isDirection1 = (distance1 < distance2);
+	float distanceFinal = min(distance1, distance2);
+	float edgeLength = distance1 + distance2;
+	float pixelOffset = -distanceFinal / edgeLength + 0.5;
+
+	// Only re-sample if luma variation at the closest end of the edge is coherent with the center pixel
+	bool isLumaCenterSmaller = (lumaCenter < lumaLocalAverage);
+	bool isCorrectVariation = (((isDirection1 ? lumaEnd1 : lumaEnd2) < 0.0) != isLumaCenterSmaller);
+	float finalOffset = isCorrectVariation ? pixelOffset : 0.0;
+
+	// Sub-pixel anti-aliasing, for details thinner than a pixel
+	float lumaAverage = (1.0 / 12.0) * (2.0 * (lumaDownUp + lumaLeftRight) + lumaLeftCorners + lumaRightCorners);
+	float subPixelOffset1 = clamp(abs(lumaAverage - lumaCenter) / lumaRange, 0.0, 1.0);
+	float subPixelOffset2 = (-2.0 * subPixelOffset1 + 3.0) * subPixelOffset1 * subPixelOffset1;
+	float subPixelOffset = subPixelOffset2 * subPixelOffset2 * SUBPIXEL_QUALITY;
+	finalOffset = max(finalOffset, subPixelOffset);
+
+	vec2 uvFinal = texCoords;
+	if (isHorizontal)
+	{
+		uvFinal.y += finalOffset * stepLength;
+	}
+	else
+	{
+		uvFinal.x += finalOffset * stepLength;
+	}
+	FragColor = vec4(texture(screenTexture, uvFinal).rgb, 1.0);
+}
\ No newline at end of file
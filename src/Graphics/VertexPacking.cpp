@@ -0,0 +1,80 @@
+#include "VertexPacking.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// Packs a float in range [0, 1] into a byte
+	static uint8_t packUnorm8(float value)
+	{
+		return uint8_t(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+	}
+
+	PackedColor::PackedColor(const glm::vec4& color)
+		: r(packUnorm8(color.r))
+		, g(packUnorm8(color.g))
+		, b(packUnorm8(color.b))
+		, a(packUnorm8(color.a))
+	{}
+
+	glm::vec4 PackedColor::toVec4() const
+	{
+		return glm::vec4(r, g, b, a) / 255.0f;
+	}
+
+namespace VertexPacking
+{
+
+	uint16_t packUnorm16(float value)
+	{
+		return uint16_t(std::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+
+	int16_t packSnorm16(float value)
+	{
+		return int16_t(std::round(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+	}
+
+	uint16_t packHalf(float value)
+	{
+		uint32_t bits = 0;
+		std::memcpy(&bits, &value, sizeof(float));
+
+		const uint32_t sign = (bits >> 16) & 0x8000;
+		const int32_t exponent = int32_t((bits >> 23) & 0xFF) - 127 + 15;
+		const uint32_t mantissa = bits & 0x007FFFFF;
+
+		// NaN stays NaN, and infinity or values too big for a half float become infinity
+		if (((bits >> 23) & 0xFF) == 0xFF)
+		{
+			return uint16_t(sign | 0x7C00 | (mantissa != 0 ? 0x0200 : 0));
+		}
+		if (exponent >= 31)
+		{
+			return uint16_t(sign | 0x7C00);
+		}
+		// Values too small for a normal half float become denormals, or zero
+		if (exponent <= 0)
+		{
+			if (exponent < -10)
+			{
+				return uint16_t(sign);
+			}
+			const uint32_t fullMantissa = mantissa | 0x00800000;
+			const int shift = 14 - exponent;
+			// Round to nearest
+			return uint16_t(sign | ((fullMantissa + (1u << (shift - 1))) >> shift));
+		}
+		// Round mantissa to nearest. A carry out of the mantissa correctly increments the exponent.
+		return uint16_t((sign | (uint32_t(exponent) << 10) | (mantissa >> 13)) + ((mantissa >> 12) & 1));
+	}
+
+} // namespace VertexPacking
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
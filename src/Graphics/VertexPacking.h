@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+
+namespace Pekan
+{
+namespace Graphics
+{
+
+	// A color packed into 4 bytes, one byte per RGBA channel.
+	// Can be used as a vertex attribute of type ShaderDataType::UByte4Normalized,
+	// which is read inside of a shader as a vec4 with each component in range [0, 1].
+	struct PackedColor
+	{
+		PackedColor() = default;
+		PackedColor(const glm::vec4& color);
+
+		// Unpacks color into a vec4 with each component in range [0, 1]
+		glm::vec4 toVec4() const;
+
+		uint8_t r = 255;
+		uint8_t g = 255;
+		uint8_t b = 255;
+		uint8_t a = 255;
+	};
+	static_assert(sizeof(PackedColor) == 4, "PackedColor must be exactly 4 bytes, so that it can be used as a vertex attribute.");
+
+namespace VertexPacking
+{
+
+	// Packs a float in range [0, 1] into an unsigned 16-bit integer,
+	// to be used with ShaderDataType::UShort2Normalized. Values outside of the range are clamped.
+	uint16_t packUnorm16(float value);
+
+	// Packs a float in range [-1, 1] into a signed 16-bit integer,
+	// to be used with ShaderDataType::Short2Normalized. Values outside of the range are clamped.
+	int16_t packSnorm16(float value);
+
+	// Packs a float into a 16-bit (half precision) float,
+	// to be used with ShaderDataType::Half2 and ShaderDataType::Half4.
+	// Values too big for a half float become infinity, and values too small become zero.
+	uint16_t packHalf(float value);
+
+} // namespace VertexPacking
+
+} // namespace Graphics
+} // namespace Pekan
\ No newline at end of file
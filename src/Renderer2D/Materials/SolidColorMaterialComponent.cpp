@@ -4,6 +4,7 @@
 #include "SolidColorMaterialComponent.h"
 
 #include "VerticesAttributeView.h"
+#include "VertexPacking.h"
 
 namespace Pekan
 {
@@ -13,9 +14,10 @@ namespace Renderer2D
 	void SolidColorMaterialComponent::getVertexColors(void* vertices, int verticesCount, int vertexSize, int colorAttributeOffset) const
 	{
 		VerticesAttributeView colorAttrView{ vertices, verticesCount, vertexSize, colorAttributeOffset };
+		const Graphics::PackedColor packedColor(color);
 		for (int i = 0; i < verticesCount; i++)
 		{
-			colorAttrView.setVertexAttribute<glm::vec4>(i, color);
+			colorAttrView.setVertexAttribute<Graphics::PackedColor>(i, packedColor);
 		}
 	}
 
@@ -17,6 +17,7 @@ namespace Renderer2D
 
 		// Retrieves the vertex color from this material,
 		// and sets it as the color attribute of each vertex in the given array of vertices.
+		// Color attribute is expected to be a PackedColor, used with ShaderDataType::UByte4Normalized.
 		void getVertexColors
 		(
 			void* vertices,             // output array of vertices
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ParticlePool.h"
+#include "Texture2D.h"
+
+#include <glm/glm.hpp>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// A component for emitting particles.
+	//
+	// Particles are NOT entities. They live in a pool inside of the component,
+	// are simulated by the ParticleSystem, and are rendered with a single draw call per emitter.
+	// Particles are emitted at the world position of the entity (or at the origin if it has no transform),
+	// and after that they live in world space, so moving the emitter doesn't move already emitted particles.
+	struct ParticleEmitterComponent
+	{
+		/* data */
+
+		// Number of particles emitted per second
+		float emissionRate = 50.0f;
+		// Maximum number of particles alive at the same time.
+		// When reached, no more particles are emitted until some of the alive ones die.
+		int maxParticles = 1000;
+
+		// Range of lifetimes of emitted particles, in seconds. Each particle gets a random lifetime in this range.
+		float lifetimeMin = 1.0f;
+		float lifetimeMax = 2.0f;
+
+		// Range of velocities of emitted particles. Each particle gets a random velocity in this range.
+		glm::vec2 velocityMin = { -1.0f, -1.0f };
+		glm::vec2 velocityMax = { 1.0f, 1.0f };
+		// Acceleration applied to all particles, for example gravity
+		glm::vec2 acceleration = { 0.0f, 0.0f };
+
+		// Color of particles over their lifetime, linearly interpolated from start color at birth to end color at death
+		glm::vec4 colorStart = { 1.0f, 1.0f, 1.0f, 1.0f };
+		glm::vec4 colorEnd = { 1.0f, 1.0f, 1.0f, 0.0f };
+
+		// Size of particles over their lifetime, linearly interpolated from start size at birth to end size at death
+		float sizeStart = 1.0f;
+		float sizeEnd = 0.0f;
+
+		// Texture of particles, and a rectangle inside of it, for example an image from a texture atlas.
+		// If there is no texture, particles are rendered as squares with their color.
+		Graphics::Texture2D_ConstPtr texture;
+		glm::vec2 textureCoordinatesMin = { 0.0f, 0.0f };
+		glm::vec2 textureCoordinatesMax = { 1.0f, 1.0f };
+
+		// If false, no new particles are emitted, but already alive particles continue to be simulated
+		bool isEmitting = true;
+
+		// Pool of alive particles
+		ParticlePool pool;
+		// Time accumulated since the last emitted particle, in seconds.
+		// Used to emit a fractional number of particles per frame correctly.
+		float emissionTimeAccumulator = 0.0f;
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "ParticlePool.h"
+
+#include "PekanLogger.h"
+
+#include <algorithm>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	void ParticlePool::setCapacity(int capacity)
+	{
+		PK_ASSERT(capacity >= 0, "Trying to set a negative capacity to a particle pool.", "Pekan");
+
+		m_positionsX.resize(capacity);
+		m_positionsY.resize(capacity);
+		m_velocitiesX.resize(capacity);
+		m_velocitiesY.resize(capacity);
+		m_normalizedAges.resize(capacity);
+		m_inverseLifetimes.resize(capacity);
+
+		m_count = std::min(m_count, capacity);
+	}
+
+	bool ParticlePool::add(glm::vec2 position, glm::vec2 velocity, float lifetime)
+	{
+		PK_ASSERT(lifetime > 0.0f, "Trying to add a particle with non-positive lifetime to a particle pool.", "Pekan");
+
+		if (m_count >= getCapacity())
+		{
+			return false;
+		}
+
+		const int i = m_count++;
+		m_positionsX[i] = position.x;
+		m_positionsY[i] = position.y;
+		m_velocitiesX[i] = velocity.x;
+		m_velocitiesY[i] = velocity.y;
+		m_normalizedAges[i] = 0.0f;
+		m_inverseLifetimes[i] = 1.0f / lifetime;
+		return true;
+	}
+
+	void ParticlePool::simulate(float deltaTime, glm::vec2 acceleration)
+	{
+		const int count = m_count;
+		float* positionsX = m_positionsX.data();
+		float* positionsY = m_positionsY.data();
+		float* velocitiesX = m_velocitiesX.data();
+		float* velocitiesY = m_velocitiesY.data();
+		float* normalizedAges = m_normalizedAges.data();
+		float* inverseLifetimes = m_inverseLifetimes.data();
+
+		// Each attribute is updated in a separate simple loop over a contiguous array,
+		// so that the compiler can vectorize the loops.
+		const float velocityDeltaX = acceleration.x * deltaTime;
+		const float velocityDeltaY = acceleration.y * deltaTime;
+		for (int i = 0; i < count; i++)
+		{
+			velocitiesX[i] += velocityDeltaX;
+		}
+		for (int i = 0; i < count; i++)
+		{
+			velocitiesY[i] += velocityDeltaY;
+		}
+		for (int i = 0; i < count; i++)
+		{
+			positionsX[i] += velocitiesX[i] * deltaTime;
+		}
+		for (int i = 0; i < count; i++)
+		{
+			positionsY[i] += velocitiesY[i] * deltaTime;
+		}
+		for (int i = 0; i < count; i++)
+		{
+			normalizedAges[i] += inverseLifetimes[i] * deltaTime;
+		}
+
+		// Remove dead particles by moving the last alive particle in their place,
+		// keeping alive particles tightly packed.
+		int i = 0;
+		while (i < m_count)
+		{
+			if (normalizedAges[i] < 1.0f)
+			{
+				i++;
+				continue;
+			}
+			const int last = --m_count;
+			positionsX[i] = positionsX[last];
+			positionsY[i] = positionsY[last];
+			velocitiesX[i] = velocitiesX[last];
+			velocitiesY[i] = velocitiesY[last];
+			normalizedAges[i] = normalizedAges[last];
+			inverseLifetimes[i] = inverseLifetimes[last];
+		}
+	}
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// A pool of particles stored as a structure of arrays (SoA).
+	//
+	// Each attribute of the particles lives in its own contiguous array,
+	// so that simulation loops touch only the data they need and can be auto-vectorized by the compiler.
+	// Alive particles are always kept tightly packed in the range [0, count).
+	class ParticlePool
+	{
+	public:
+
+		// Sets the maximum number of particles that the pool can hold.
+		// Already alive particles that don't fit in the new capacity are removed.
+		void setCapacity(int capacity);
+
+		// Adds a new particle to the pool.
+		// Returns false if the pool is full.
+		bool add(glm::vec2 position, glm::vec2 velocity, float lifetime);
+
+		// Advances all particles by a given delta time, applying a given acceleration to them,
+		// and removes particles that have reached the end of their lifetime.
+		void simulate(float deltaTime, glm::vec2 acceleration);
+
+		// Removes all particles from the pool
+		void clear() { m_count = 0; }
+
+		int getCount() const { return m_count; }
+		int getCapacity() const { return int(m_positionsX.size()); }
+
+		const float* getPositionsX() const { return m_positionsX.data(); }
+		const float* getPositionsY() const { return m_positionsY.data(); }
+		// Returns the ages of particles, normalized to the [0, 1) range, where 0 is birth and 1 is death
+		const float* getNormalizedAges() const { return m_normalizedAges.data(); }
+
+	private: /* variables */
+
+		std::vector<float> m_positionsX;
+		std::vector<float> m_positionsY;
+		std::vector<float> m_velocitiesX;
+		std::vector<float> m_velocitiesY;
+		std::vector<float> m_normalizedAges;
+		// Inverse lifetimes (1 / lifetime) of particles, stored like this so that aging is a multiplication
+		std::vector<float> m_inverseLifetimes;
+
+		// Number of alive particles
+		int m_count = 0;
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "ParticleSystem.h"
+
+#include "ParticleEmitterComponent.h"
+#include "TransformComponent2D.h"
+#include "TransformSystem2D.h"
+#include "CameraComponent2D.h"
+#include "RenderQueue2D.h"
+#include "DrawObject.h"
+#include "RenderState.h"
+#include "VertexPacking.h"
+#include "Utils/FileUtils.h"
+#include "Utils/RandomizationUtils.h"
+#include "PekanLogger.h"
+#include "Entity/DisabledComponent.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Pekan::Graphics;
+
+#define VERTEX_SHADER_FILEPATH PEKAN_RENDERER2D_ROOT_DIR "/Shaders/2D_Particle_VertexShader.glsl"
+#define FRAGMENT_SHADER_FILEPATH PEKAN_RENDERER2D_ROOT_DIR "/Shaders/2D_Particle_FragmentShader.glsl"
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// Texture slot used for the texture of particles
+	constexpr int TEXTURE_SLOT = 0;
+
+	// Structure defining the layout of a vertex of a particle
+	struct ParticleVertex
+	{
+		glm::vec2 position = { 0.0f, 0.0f };
+		glm::vec2 textureCoordinates = { 0.0f, 0.0f };
+		PackedColor color;
+	};
+
+	// Draw object shared by all particle emitters.
+	// Its vertex data is streamed from CPU memory once per emitter per frame.
+	static DrawObject g_drawObject;
+	// Number of particles (quads) that draw object's index data can currently hold
+	static int g_indexedParticlesCount = 0;
+
+	// Vertices of particles of the emitter that is currently being rendered.
+	// Kept between frames so that memory is not reallocated every frame.
+	static std::vector<ParticleVertex> g_vertices;
+
+	// Camera used for rendering particles in the current frame
+	static const CameraComponent2D* g_camera = nullptr;
+
+	// Creates the draw object shared by all particle emitters
+	static void createDrawObject()
+	{
+		g_drawObject.create
+		(
+			{
+				{ ShaderDataType::Float2, "position" },
+				{ ShaderDataType::Float2, "textureCoordinates" },
+				{ ShaderDataType::UByte4Normalized, "color" }
+			},
+			FileUtils::readTextFileToString(VERTEX_SHADER_FILEPATH).c_str(),
+			FileUtils::readTextFileToString(FRAGMENT_SHADER_FILEPATH).c_str()
+		);
+		g_indexedParticlesCount = 0;
+	}
+
+	// Makes sure that draw object's index data is enough for rendering a given number of particles.
+	// Index data is only regenerated when the number of particles exceeds the current capacity.
+	static void ensureIndexDataFor(int particlesCount)
+	{
+		if (particlesCount <= g_indexedParticlesCount)
+		{
+			return;
+		}
+
+		// Grow capacity geometrically to avoid regenerating indices every time a few more particles are emitted
+		int newCount = std::max(g_indexedParticlesCount * 2, 1024);
+		while (newCount < particlesCount)
+		{
+			newCount *= 2;
+		}
+
+		std::vector<unsigned> indices(size_t(newCount) * 6);
+		for (int i = 0; i < newCount; i++)
+		{
+			const unsigned firstVertex = unsigned(i) * 4;
+			unsigned* quadIndices = indices.data() + size_t(i) * 6;
+			quadIndices[0] = firstVertex + 0;
+			quadIndices[1] = firstVertex + 1;
+			quadIndices[2] = firstVertex + 2;
+			quadIndices[3] = firstVertex + 0;
+			quadIndices[4] = firstVertex + 2;
+			quadIndices[5] = firstVertex + 3;
+		}
+		// Indices are stored as 16-bit indices while there are few enough particles
+		g_drawObject.setIndices(indices.data(), indices.size(), BufferDataUsage::StaticDraw);
+		g_indexedParticlesCount = newCount;
+	}
+
+	// Emits new particles from a given emitter at a given world position, according to emitter's emission rate
+	static void emitParticles(ParticleEmitterComponent& emitter, glm::vec2 emitterPosition, float deltaTime)
+	{
+		if (emitter.pool.getCapacity() != emitter.maxParticles)
+		{
+			emitter.pool.setCapacity(emitter.maxParticles);
+		}
+
+		if (!emitter.isEmitting || emitter.emissionRate <= 0.0f)
+		{
+			emitter.emissionTimeAccumulator = 0.0f;
+			return;
+		}
+
+		emitter.emissionTimeAccumulator += deltaTime;
+		const float emissionInterval = 1.0f / emitter.emissionRate;
+		const int countToEmit = int(emitter.emissionTimeAccumulator / emissionInterval);
+		emitter.emissionTimeAccumulator -= float(countToEmit) * emissionInterval;
+
+		for (int i = 0; i < countToEmit; i++)
+		{
+			const glm::vec2 velocity = RandomizationUtils::getRandomVec2(emitter.velocityMin, emitter.velocityMax);
+			const float lifetime = RandomizationUtils::getRandomFloat(emitter.lifetimeMin, emitter.lifetimeMax);
+			if (!emitter.pool.add(emitterPosition, velocity, lifetime))
+			{
+				// Pool is full, so no more particles can be emitted this frame
+				break;
+			}
+		}
+	}
+
+	// Fills the global vertices array with the vertices of all particles of a given emitter
+	static void fillVertices(const ParticleEmitterComponent& emitter)
+	{
+		const ParticlePool& pool = emitter.pool;
+		const int count = pool.getCount();
+		g_vertices.resize(size_t(count) * 4);
+
+		const float* positionsX = pool.getPositionsX();
+		const float* positionsY = pool.getPositionsY();
+		const float* normalizedAges = pool.getNormalizedAges();
+
+		const glm::vec2 uvMin = emitter.textureCoordinatesMin;
+		const glm::vec2 uvMax = emitter.textureCoordinatesMax;
+		for (int i = 0; i < count; i++)
+		{
+			const float t = normalizedAges[i];
+			const float halfSize = (emitter.sizeStart + (emitter.sizeEnd - emitter.sizeStart) * t) * 0.5f;
+			const PackedColor color(emitter.colorStart + (emitter.colorEnd - emitter.colorStart) * t);
+			const float x = positionsX[i];
+			const float y = positionsY[i];
+
+			ParticleVertex* vertices = g_vertices.data() + size_t(i) * 4;
+			vertices[0] = { { x - halfSize, y - halfSize }, { uvMin.x, uvMin.y }, color };
+			vertices[1] = { { x + halfSize, y - halfSize }, { uvMax.x, uvMin.y }, color };
+			vertices[2] = { { x + halfSize, y + halfSize }, { uvMax.x, uvMax.y }, color };
+			vertices[3] = { { x - halfSize, y + halfSize }, { uvMin.x, uvMax.y }, color };
+		}
+	}
+
+	void ParticleSystem::update(entt::registry& registry, float deltaTime)
+	{
+		auto view = registry.view<ParticleEmitterComponent>(entt::exclude<DisabledComponent>);
+		for (auto [entity, emitter] : view.each())
+		{
+			// Emit new particles at emitter's world position
+			glm::vec2 emitterPosition = { 0.0f, 0.0f };
+			if (const TransformComponent2D* transform = registry.try_get<TransformComponent2D>(entity))
+			{
+				const glm::mat3 worldMatrix = TransformSystem2D::getWorldMatrix(registry, *transform);
+				emitterPosition = glm::vec2(worldMatrix * glm::vec3(0.0f, 0.0f, 1.0f));
+			}
+			emitParticles(emitter, emitterPosition, deltaTime);
+
+			// Simulate all alive particles
+			emitter.pool.simulate(deltaTime, emitter.acceleration);
+		}
+	}
+
+	// Renders the particles of a given particle emitter entity with a single draw call, at a given clip-space depth
+	static void renderEmitter(const entt::registry& registry, entt::entity entity, float depth)
+	{
+		PK_ASSERT(registry.valid(entity), "Cannot render an entity that doesn't exist.", "Pekan");
+		PK_ASSERT(registry.all_of<ParticleEmitterComponent>(entity), "Cannot render an entity that doesn't have a ParticleEmitterComponent.", "Pekan");
+
+		const ParticleEmitterComponent& emitter = registry.get<ParticleEmitterComponent>(entity);
+		const int count = emitter.pool.getCount();
+
+		if (!g_drawObject.isValid())
+		{
+			createDrawObject();
+		}
+		ensureIndexDataFor(count);
+
+		// Stream particles' vertices to the GPU
+		fillVertices(emitter);
+		g_drawObject.setVertexData(g_vertices.data(), sizeof(ParticleVertex) * g_vertices.size(), BufferDataUsage::StreamDraw);
+
+		// Set draw object's shader uniforms
+		Shader& shader = g_drawObject.getShader();
+		shader.setUniformMatrix4fv("uViewProjectionMatrix", g_camera->getViewProjectionMatrix());
+		shader.setUniform1f("uDepth", depth);
+		const bool hasTexture = emitter.texture != nullptr && emitter.texture->isValid();
+		shader.setUniform1i("uHasTexture", hasTexture ? 1 : 0);
+		if (hasTexture)
+		{
+			shader.setUniform1i("uTexture", TEXTURE_SLOT);
+			emitter.texture->bind(TEXTURE_SLOT);
+		}
+
+		// Particles fade in and out through their color's alpha, so they are always alpha blended
+		RenderState::enableBlending();
+		RenderState::setBlendFunction(BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha);
+
+		// Render all particles of the emitter with a single draw call
+		g_drawObject.render(DrawMode::Triangles, unsigned(count) * 6);
+	}
+
+	void ParticleSystem::submit(const entt::registry& registry, const CameraComponent2D* camera, RenderQueue2D& renderQueue)
+	{
+		PK_ASSERT(camera != nullptr, "Cannot render particles without a camera.", "Pekan");
+		g_camera = camera;
+
+		const auto view = registry.view<ParticleEmitterComponent>(entt::exclude<DisabledComponent>);
+		for (auto [entity, emitter] : view.each())
+		{
+			if (emitter.pool.getCount() == 0)
+			{
+				continue;
+			}
+			const void* texture = (emitter.texture != nullptr && emitter.texture->isValid()) ? emitter.texture.get() : nullptr;
+			renderQueue.submit(registry, entity, renderEmitter, RenderQueueBlendMode::Transparent, RenderQueueShader::Particles, texture);
+		}
+	}
+
+	void ParticleSystem::exit()
+	{
+		if (g_drawObject.isValid())
+		{
+			g_drawObject.destroy();
+		}
+		g_indexedParticlesCount = 0;
+		g_vertices.clear();
+		g_vertices.shrink_to_fit();
+	}
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+	struct CameraComponent2D;
+	class RenderQueue2D;
+
+	class ParticleSystem
+	{
+	public:
+
+		// Emits new particles and simulates all alive particles of all particle emitters in the given registry
+		static void update(entt::registry& registry, float deltaTime);
+
+		// Submits all particle emitters in the given registry to a given render queue, to be rendered with a given camera.
+		// Each emitter is rendered with one draw call, in the transparent pass, ordered by its RenderOrderComponent2D.
+		static void submit(const entt::registry& registry, const CameraComponent2D* camera, RenderQueue2D& renderQueue);
+
+		// Releases GPU resources used for rendering particles
+		static void exit();
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// A component controlling the order in which an entity is rendered relative to other entities.
+	//
+	// Entities in a higher layer are rendered on top of entities in a lower layer.
+	// Inside of the same layer, entities with a smaller depth are rendered on top of entities with a bigger depth.
+	// Entities without this component are in layer 0 with depth 0.
+	// Entities with equal layer and depth overlap in the order they were submitted, the one submitted later being on top.
+	struct RenderOrderComponent2D
+	{
+		// Layer of the entity, in range [-128, 127]
+		int layer = 0;
+
+		// Depth of the entity inside of its layer, in range [0, 1],
+		// where 0 is the front of the layer and 1 is the back of the layer.
+		float depth = 0.0f;
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,249 @@
+#include "RenderQueue2D.h"
+
+#include "RenderOrderComponent2D.h"
+#include "RenderState.h"
+#include "PekanLogger.h"
+
+#include <algorithm>
+
+using namespace Pekan::Graphics;
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// Layout of a sort key of an opaque renderable, from the most significant bit:
+	//   [63]     blend mode (0)
+	//   [62-59]  shader
+	//   [58-43]  texture ID
+	//   [42-19]  distance from the front (layer and depth combined), so that opaque renderables are sorted front-to-back
+	//   [18-0]   unused
+	//
+	// Layout of a sort key of a transparent renderable, from the most significant bit:
+	//   [63]     blend mode (1)
+	//   [62-39]  distance from the back (layer and depth combined), so that transparent renderables are sorted back-to-front
+	//   [38-0]   submission index, so that transparent renderables at the same distance keep submission order
+	constexpr int BLEND_MODE_SHIFT = 63;
+	constexpr int OPAQUE_SHADER_SHIFT = 59;
+	constexpr int OPAQUE_TEXTURE_SHIFT = 43;
+	constexpr int OPAQUE_DISTANCE_SHIFT = 19;
+	constexpr int TRANSPARENT_DISTANCE_SHIFT = 39;
+
+	constexpr uint64_t SHADER_MASK = 0xF;
+	constexpr uint64_t TEXTURE_ID_MASK = 0xFFFF;
+	constexpr uint64_t SUBMISSION_INDEX_MASK = (uint64_t(1) << TRANSPARENT_DISTANCE_SHIFT) - 1;
+
+	// Number of bits used for a renderable's distance from the front.
+	// The upper 8 bits hold the layer, and the lower 16 bits hold the quantized depth inside of the layer.
+	constexpr int DISTANCE_BITS = 24;
+	constexpr uint32_t MAX_DISTANCE = (1u << DISTANCE_BITS) - 1;
+
+	// Range of supported layers
+	constexpr int MIN_LAYER = -128;
+	constexpr int MAX_LAYER = 127;
+
+	// Computes the distance of a renderable with given layer and depth from the front,
+	// as an integer in range [0, MAX_DISTANCE], where 0 is the front-most possible position.
+	static uint32_t getDistanceFromFront(int layer, float depth)
+	{
+		const uint32_t layerFromFront = uint32_t(MAX_LAYER - std::clamp(layer, MIN_LAYER, MAX_LAYER));
+		const uint32_t quantizedDepth = uint32_t(std::clamp(depth, 0.0f, 1.0f) * 65535.0f);
+		return (layerFromFront << 16) | quantizedDepth;
+	}
+
+	void RenderQueue2D::submit
+	(
+		const entt::registry& registry,
+		entt::entity entity,
+		RenderFunction renderFunction,
+		RenderQueueBlendMode blendMode,
+		RenderQueueShader shader,
+		const void* texture
+	)
+	{
+		PK_ASSERT_QUICK(renderFunction != nullptr);
+
+		int layer = 0;
+		float depth = 0.0f;
+		if (const RenderOrderComponent2D* renderOrder = registry.try_get<RenderOrderComponent2D>(entity))
+		{
+			layer = renderOrder->layer;
+			depth = renderOrder->depth;
+		}
+
+		// Texture IDs are needed only for grouping opaque renderables
+		const uint32_t textureId = (blendMode == RenderQueueBlendMode::Opaque) ? getTextureId(texture) : 0;
+
+		Item item;
+		item.sortKey = makeSortKey(blendMode, layer, depth, shader, textureId, m_items.size());
+		item.renderFunction = renderFunction;
+		item.entity = entity;
+		item.distanceFromFront = getDistanceFromFront(layer, depth);
+		m_items.push_back(item);
+	}
+
+	// Sorts given elements by their "sortKey" member with a least significant digit radix sort, using 8 passes of 8 bits each.
+	// It's stable, so elements with equal sort keys keep their order. Given buffer is used as scratch memory.
+	template<typename T>
+	static void radixSort(std::vector<T>& elements, std::vector<T>& buffer)
+	{
+		const size_t elementsCount = elements.size();
+		if (elementsCount < 2)
+		{
+			return;
+		}
+
+		// Compute histograms of all 8 bytes of the sort keys in a single pass over the elements
+		uint32_t histograms[8][256] = {};
+		for (const T& element : elements)
+		{
+			for (int byteIndex = 0; byteIndex < 8; byteIndex++)
+			{
+				histograms[byteIndex][(element.sortKey >> (byteIndex * 8)) & 0xFF]++;
+			}
+		}
+
+		buffer.resize(elementsCount);
+		T* source = elements.data();
+		T* destination = buffer.data();
+		for (int byteIndex = 0; byteIndex < 8; byteIndex++)
+		{
+			const int shift = byteIndex * 8;
+			uint32_t* histogram = histograms[byteIndex];
+
+			// Skip this pass if all sort keys have the same value of this byte, since it wouldn't change the order.
+			// That's the case for the unused lowest bits, and usually for some of the higher bits too.
+			if (histogram[(source[0].sortKey >> shift) & 0xFF] == elementsCount)
+			{
+				continue;
+			}
+
+			// Turn histogram into starting offsets of each bucket
+			uint32_t offset = 0;
+			for (int bucket = 0; bucket < 256; bucket++)
+			{
+				const uint32_t count = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += count;
+			}
+
+			// Scatter elements into their buckets
+			for (size_t i = 0; i < elementsCount; i++)
+			{
+				destination[histogram[(source[i].sortKey >> shift) & 0xFF]++] = source[i];
+			}
+			std::swap(source, destination);
+		}
+
+		// If sorted elements ended up in the buffer, swap it with the elements
+		if (source != elements.data())
+		{
+			elements.swap(buffer);
+		}
+	}
+
+	void RenderQueue2D::sort()
+	{
+		assignDepths();
+		radixSort(m_items, m_sortBuffer);
+	}
+
+	void RenderQueue2D::assignDepths()
+	{
+		const size_t itemsCount = m_items.size();
+
+		// Order renderables front-to-back by layer and depth, and the ones at the same layer and depth by reversed submission order,
+		// so that a renderable submitted later is in front, same as if everything was rendered in submission order
+		m_depthOrder.resize(itemsCount);
+		for (size_t i = 0; i < itemsCount; i++)
+		{
+			m_depthOrder[i].sortKey = (uint64_t(m_items[i].distanceFromFront) << TRANSPARENT_DISTANCE_SHIFT) | (SUBMISSION_INDEX_MASK - (i & SUBMISSION_INDEX_MASK));
+			m_depthOrder[i].itemIndex = uint32_t(i);
+		}
+		radixSort(m_depthOrder, m_depthOrderSortBuffer);
+
+		// Spread ranks evenly over [-1, 1), giving each renderable its own depth
+		const float depthStep = 2.0f / float(std::max<size_t>(itemsCount, 1));
+		for (size_t rank = 0; rank < itemsCount; rank++)
+		{
+			m_items[m_depthOrder[rank].itemIndex].depth = float(rank) * depthStep - 1.0f;
+		}
+	}
+
+	void RenderQueue2D::render(const entt::registry& registry) const
+	{
+		if (m_items.empty())
+		{
+			return;
+		}
+
+		// Remember current depth state, so that it can be restored after rendering
+		const bool originalIsEnabledDepthTest = RenderState::isEnabledDepthTest();
+		const DepthFunction originalDepthFunction = RenderState::getDepthFunction();
+
+		RenderState::enableDepthTest();
+		// Each renderable has its own depth, so overlap order is fully resolved by depth testing
+		RenderState::setDepthFunction(DepthFunction::Less);
+
+		// Render opaque pass. Opaque renderables are at the start of the queue, since blend mode is the most significant bit.
+		size_t i = 0;
+		for (; i < m_items.size() && (m_items[i].sortKey >> BLEND_MODE_SHIFT) == uint64_t(RenderQueueBlendMode::Opaque); i++)
+		{
+			m_items[i].renderFunction(registry, m_items[i].entity, m_items[i].depth);
+		}
+
+		// Render transparent pass, testing against depth of opaque renderables but without writing depth
+		RenderState::disableDepthWriting();
+		for (; i < m_items.size(); i++)
+		{
+			m_items[i].renderFunction(registry, m_items[i].entity, m_items[i].depth);
+		}
+		RenderState::enableDepthWriting();
+
+		// Restore original depth state
+		RenderState::setDepthFunction(originalDepthFunction);
+		if (!originalIsEnabledDepthTest)
+		{
+			RenderState::disableDepthTest();
+		}
+	}
+
+	void RenderQueue2D::clear()
+	{
+		m_items.clear();
+		m_depthOrder.clear();
+		m_textureIds.clear();
+	}
+
+	uint64_t RenderQueue2D::makeSortKey(RenderQueueBlendMode blendMode, int layer, float depth, RenderQueueShader shader, uint32_t textureId, uint64_t submissionIndex)
+	{
+		const uint64_t distanceFromFront = getDistanceFromFront(layer, depth);
+
+		if (blendMode == RenderQueueBlendMode::Opaque)
+		{
+			const uint64_t shaderBits = uint64_t(shader) & SHADER_MASK;
+			const uint64_t textureBits = uint64_t(textureId) & TEXTURE_ID_MASK;
+			return (shaderBits << OPAQUE_SHADER_SHIFT)
+				| (textureBits << OPAQUE_TEXTURE_SHIFT)
+				| (distanceFromFront << OPAQUE_DISTANCE_SHIFT);
+		}
+
+		const uint64_t distanceFromBack = MAX_DISTANCE - distanceFromFront;
+		return (uint64_t(1) << BLEND_MODE_SHIFT)
+			| (distanceFromBack << TRANSPARENT_DISTANCE_SHIFT)
+			| (submissionIndex & SUBMISSION_INDEX_MASK);
+	}
+
+	uint32_t RenderQueue2D::getTextureId(const void* texture)
+	{
+		if (texture == nullptr)
+		{
+			return 0;
+		}
+		const auto [it, inserted] = m_textureIds.try_emplace(texture, uint32_t(m_textureIds.size() + 1));
+		return it->second;
+	}
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
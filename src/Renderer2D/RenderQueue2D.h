@@ -0,0 +1,131 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// Blend mode of a renderable, determining in which pass of the render queue it's rendered
+	enum class RenderQueueBlendMode
+	{
+		// Rendered first, front-to-back, with depth testing and depth writing
+		Opaque = 0,
+		// Rendered after all opaque renderables, back-to-front, with depth testing but without depth writing
+		Transparent = 1
+	};
+
+	// Shaders used by renderables submitted to the render queue.
+	// Used only for sorting, so that renderables using the same shader are rendered together.
+	enum class RenderQueueShader
+	{
+		ShapeSolidColorMaterial = 0,
+		Line = 1,
+		Sprite = 2,
+		Tilemap = 3,
+		StaticShapes = 4,
+		StaticSprites = 5,
+		Particles = 6
+	};
+
+	// A queue of renderables to be rendered in a single frame.
+	//
+	// Each renderable is submitted with a 64-bit sort key built from its layer, depth, blend mode, shader and texture.
+	// Before rendering, the queue is sorted by these keys with a radix sort, and then rendered in two passes:
+	//   1. An opaque pass - sorted by shader and texture first (to minimize state changes) and then front-to-back,
+	//      relying on depth testing to resolve overlap order.
+	//   2. A transparent pass - sorted back-to-front, and renderables at the same layer and depth in submission order,
+	//      so that overlapping transparent renderables are blended in a deterministic order.
+	//
+	// Each renderable is rendered at its own clip-space depth, given by its rank when ordered by layer, depth
+	// and then submission order, with later submitted renderables in front. This way renderables at the same layer and depth
+	// overlap in submission order, even though opaque ones are not rendered in submission order.
+	//
+	// NOTE: Rendering relies on depth testing, so the frame buffer rendered to must have a depth buffer.
+	//
+	// Textures are identified in sort keys by small IDs assigned in order of first submission each frame,
+	// so renderables with different textures never share a sort key (up to 65536 textures per frame).
+	class RenderQueue2D
+	{
+	public:
+
+		// Type alias for a function that renders an entity at a given clip-space depth
+		using RenderFunction = void(*)(const entt::registry& registry, entt::entity entity, float depth);
+
+		// Submits an entity to be rendered with a given render function.
+		// Entity's layer and depth are taken from its RenderOrderComponent2D, if it has one.
+		// Texture is used only for sorting and can be null.
+		void submit
+		(
+			const entt::registry& registry,
+			entt::entity entity,
+			RenderFunction renderFunction,
+			RenderQueueBlendMode blendMode,
+			RenderQueueShader shader,
+			const void* texture = nullptr
+		);
+
+		// Sorts all submitted renderables by their sort keys, and assigns each one its clip-space depth
+		void sort();
+
+		// Renders all submitted renderables in their current order.
+		// Should be called after sort().
+		void render(const entt::registry& registry) const;
+
+		// Clears all submitted renderables, keeping allocated memory for the next frame
+		void clear();
+
+		int getSize() const { return int(m_items.size()); }
+
+		// Builds a sort key from given properties of a renderable.
+		// Texture ID is used only for opaque renderables, and submission index only for transparent ones.
+		static uint64_t makeSortKey(RenderQueueBlendMode blendMode, int layer, float depth, RenderQueueShader shader, uint32_t textureId, uint64_t submissionIndex);
+
+	private: /* functions */
+
+		// Assigns each submitted renderable a clip-space depth in range [-1, 1), from its rank when ordered by layer, depth
+		// and then submission order, where -1 is the front-most position. Must be called while renderables are in submission order.
+		void assignDepths();
+
+		// Returns the ID of a given texture in this frame, assigning a new one if texture is submitted for the first time.
+		// Null texture has ID 0.
+		uint32_t getTextureId(const void* texture);
+
+	private: /* variables */
+
+		// A renderable submitted to the queue
+		struct Item
+		{
+			uint64_t sortKey = 0;
+			RenderFunction renderFunction = nullptr;
+			entt::entity entity = entt::null;
+			// Distance from the front, with layer and depth combined, until the clip-space depth is assigned
+			uint32_t distanceFromFront = 0;
+			float depth = 0.0f;
+		};
+
+		// A renderable's position in depth order, used for assigning clip-space depths
+		struct DepthOrderEntry
+		{
+			uint64_t sortKey = 0;
+			uint32_t itemIndex = 0;
+		};
+
+		// Submitted renderables
+		std::vector<Item> m_items;
+		// Scratch buffer used by the radix sort, kept here so that it's not reallocated every frame
+		std::vector<Item> m_sortBuffer;
+		// Renderables in depth order, and a scratch buffer for sorting them, kept here for the same reason
+		std::vector<DepthOrderEntry> m_depthOrder;
+		std::vector<DepthOrderEntry> m_depthOrderSortBuffer;
+		// IDs of textures submitted this frame
+		std::unordered_map<const void*, uint32_t> m_textureIds;
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
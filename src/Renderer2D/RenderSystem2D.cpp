@@ -2,8 +2,15 @@
 
 #include "TransformComponent2D.h"
 #include "SpriteSystem.h"
+#include "ParticleSystem.h"
+#include "TilemapSystem.h"
+#include "StaticRenderSystem.h"
+#include "StaticRenderComponent.h"
+#include "RenderQueue2D.h"
 
 #include "DrawObject.h"
+#include "RenderCommands.h"
+#include "VertexPacking.h"
 #include "CameraComponent2D.h"
 #include "CameraSystem2D.h"
 #include "Entity/DisabledComponent.h"
@@ -49,6 +56,10 @@ namespace Renderer2D
 	// Current primary camera cached here for easy access
 	static const CameraComponent2D* g_camera = nullptr;
 
+	// Render queue that all entities are submitted to each frame.
+	// Kept here so that its memory is reused between frames.
+	static RenderQueue2D g_renderQueue;
+
 	// Type alias for a vertex positions getter function
 	using VertexPositionsGetter = void(*)
 	(
@@ -62,60 +73,53 @@ namespace Renderer2D
 		void* vertices, int verticesCount, int vertexSize, int positionAttributeOffset,
 		std::vector<unsigned>& indices
 	);
-	// Type alias for a function that renders an entity
-	using RenderFunction = void(*)(const entt::registry&, entt::entity);
+	// Type alias for a function that renders an entity at a given clip-space depth
+	using RenderFunction = RenderQueue2D::RenderFunction;
 
-	// Structure defining the layout of a vertex of a shape with solid color material
+	// Structure defining the layout of a vertex of a shape with solid color material.
+	// Color is packed into 4 bytes, making the whole vertex 12 bytes.
 	struct VertexOfShapeWithSolidColorMaterial
 	{
 		glm::vec2 position = { 0.0f, 0.0f };
-		glm::vec4 color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		PackedColor color;
 	};
 
 	// Type alias for a vertex of a line
 	typedef glm::vec2 VertexOfLine;
 
-	// Renders all entities with given component types (except those with DisabledComponent)
-	// by calling a given render function for each entity
-	//
-	// @tparam ComponentTypes...  Component types that an entity must have to be rendered
-	// @param[in] registry        Registry containing entities to render
-	// @param[in] renderFunction  Function that renders a single entity
-	template<typename... ComponentTypes>
-	void renderAllEntitiesWith(const entt::registry& registry, RenderFunction renderFunction)
+	// Returns the blend mode needed for rendering something with a given color
+	static RenderQueueBlendMode getBlendMode(const glm::vec4& color)
 	{
-		// Create a view over all entities that have the given components
-		const auto view = registry.view<ComponentTypes...>(entt::exclude<DisabledComponent>);
-		// Iterate over entities and call the provided render function
-		for (auto entity : view)
-		{
-			renderFunction(registry, entity);
-		}
+		return color.a < 1.0f ? RenderQueueBlendMode::Transparent : RenderQueueBlendMode::Opaque;
 	}
 
-	// Renders all entities that have all components from ComponentTypesToInclude
+	// Submits to the render queue all entities that have all components from ComponentTypesToInclude
 	// and do NOT have any components from ComponentTypesToExclude (except those with DisabledComponent),
-	// by calling a given render function for each entity
+	// to be rendered with a given render function
 	//
+	// @tparam ColorComponentType          Component type that an entity must have, whose "color" determines entity's blend mode
 	// @tparam ComponentTypesToInclude...  Component types that an entity must have to be rendered
 	// @tparam ComponentTypesToExclude...  Component types that an entity must NOT have to be rendered
 	// @param[in] registry        Registry containing entities to render
 	// @param[in] renderFunction  Function that renders a single entity
-	template<typename... ComponentTypesToInclude, typename... ComponentTypesToExclude>
-	void renderAllEntitiesWith
+	// @param[in] shader          Shader used by the render function, used for sorting
+	template<typename ColorComponentType, typename... ComponentTypesToInclude, typename... ComponentTypesToExclude>
+	void submitAllEntitiesWith
 	(
 		entt::exclude_t<ComponentTypesToExclude...>,
 		const entt::registry& registry,
-		RenderFunction renderFunction
+		RenderFunction renderFunction,
+		RenderQueueShader shader
 	)
 	{
 		// Create a view over all entities that
 		// have the given components to include and do NOT have the given components to exclude
-		const auto view = registry.view<ComponentTypesToInclude...>(entt::exclude<DisabledComponent, ComponentTypesToExclude...>);
-		// Iterate over entities and call the provided render function
+		const auto view = registry.view<ColorComponentType, ComponentTypesToInclude...>(entt::exclude<DisabledComponent, ComponentTypesToExclude...>);
+		// Iterate over entities and submit each one to the render queue
 		for (auto entity : view)
 		{
-			renderFunction(registry, entity);
+			const ColorComponentType& colorComponent = view.template get<ColorComponentType>(entity);
+			g_renderQueue.submit(registry, entity, renderFunction, getBlendMode(colorComponent.color), shader);
 		}
 	}
 
@@ -133,6 +137,7 @@ namespace Renderer2D
 		const entt::registry& registry,
 		const VertexOfShapeWithSolidColorMaterial* vertices, int verticesCount,
 		const unsigned *indices, int indicesCount,
+		float depth,              // clip-space depth at which to render the shape
 		DrawObject& drawObject    // draw object to create
 	)
 	{
@@ -143,20 +148,22 @@ namespace Renderer2D
 			sizeof(VertexOfShapeWithSolidColorMaterial) * verticesCount,
 			{
 				{ ShaderDataType::Float2, "position" },
-				{ ShaderDataType::Float4, "color" }
+				{ ShaderDataType::UByte4Normalized, "color" }
 			},
 			BufferDataUsage::StaticDraw,
 			FileUtils::readTextFileToString(SHAPE_WITH_SOLID_COLOR_MATERIAL_VERTEX_SHADER_FILEPATH).c_str(),
 			FileUtils::readTextFileToString(SHAPE_WITH_SOLID_COLOR_MATERIAL_FRAGMENT_SHADER_FILEPATH).c_str()
 		);
-		// Set given indices to the draw object
-		drawObject.setIndexData(indices, sizeof(unsigned) * indicesCount, BufferDataUsage::StaticDraw);
+		// Set given indices to the draw object. They are stored as 16-bit indices since shapes have few vertices.
+		drawObject.setIndices(indices, indicesCount, BufferDataUsage::StaticDraw);
 
 		// Set draw object's shader uniforms
 		{
 			Shader& shader = drawObject.getShader();
 			// Set view projection matrix uniform using the primary camera
 			setViewProjectionMatrixUniform(shader, g_camera);
+			// Set depth uniform
+			shader.setUniform1f("uDepth", depth);
 		}
 	}
 
@@ -169,7 +176,8 @@ namespace Renderer2D
 		VertexOfShapeWithSolidColorMaterial* vertices,    // array of shape's vertices with already filled position attributes
 		int verticesCount,                                // number of shape's vertices
 		const unsigned* indices,                          // indices array
-		int indicesCount                                  // number of indices
+		int indicesCount,                                 // number of indices
+		float depth                                       // clip-space depth at which to render the shape
 	)
 	{
 		// Get material component from entity
@@ -190,6 +198,7 @@ namespace Renderer2D
 			registry,
 			vertices, verticesCount,
 			indices, indicesCount,
+			depth,
 			drawObject
 		);
 
@@ -207,7 +216,8 @@ namespace Renderer2D
 		VertexPositionsGetter vertexPositionsGetter,    // a function for getting shape's vertex positions
 		int verticesCount,                              // number of shape's vertices
 		const unsigned* indices,                        // indices array
-		int indicesCount                                // number of indices
+		int indicesCount,                               // number of indices
+		float depth                                     // clip-space depth at which to render the shape
 	)
 	{
 		// Create vertices array with given number of vertices
@@ -227,7 +237,8 @@ namespace Renderer2D
 		(
 			registry, entity,
 			vertices.data(), verticesCount,
-			indices, indicesCount
+			indices, indicesCount,
+			depth
 		);
 	}
 
@@ -238,7 +249,8 @@ namespace Renderer2D
 		const entt::registry& registry,
 		entt::entity entity,
 		VertexPositionsAndIndicesGetter vertexPositionsAndIndicesGetter,    // a function for getting shape's vertex positions and indices
-		int verticesCount                                                   // number of shape's vertices
+		int verticesCount,                                                  // number of shape's vertices
+		float depth                                                         // clip-space depth at which to render the shape
 	)
 	{
 		// Create vertices array with given number of vertices
@@ -260,17 +272,18 @@ namespace Renderer2D
 		(
 			registry, entity,
 			vertices.data(), verticesCount,
-			indices.data(), int(indices.size())
+			indices.data(), int(indices.size()),
+			depth
 		);
 	}
 
 	// Renders an entity with rectangle geometry and a solid color material
 	// @tparam HasTransform - A boolean parameter indicating if the entity has a transform component
 	template<bool HasTransform>
-	static void renderRectangleWithSolidColorMaterial(const entt::registry& registry, entt::entity entity);
+	static void renderRectangleWithSolidColorMaterial(const entt::registry& registry, entt::entity entity, float depth);
 
 	template<>
-	static void renderRectangleWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity)
+	static void renderRectangleWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		// Define indices for two triangles making up a rectangle
 		static constexpr unsigned indices[6] = { 0, 1, 2, 0, 2, 3 };
@@ -280,12 +293,13 @@ namespace Renderer2D
 		(
 			registry, entity,
 			RectangleGeometrySystem::getVertexPositionsWorld, 4,
-			indices, 6
+			indices, 6,
+			depth
 		);
 	}
 
 	template<>
-	static void renderRectangleWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity)
+	static void renderRectangleWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		// Define indices for two triangles making up a rectangle
 		static constexpr unsigned indices[6] = { 0, 1, 2, 0, 2, 3 };
@@ -295,17 +309,18 @@ namespace Renderer2D
 		(
 			registry, entity,
 			RectangleGeometrySystem::getVertexPositionsLocal, 4,
-			indices, 6
+			indices, 6,
+			depth
 		);
 	}
 
 	// Renders an entity with line geometry and a solid color material
 	// @tparam HasTransform - A boolean parameter indicating if the entity has a transform component
 	template<bool HasTransform>
-	static void renderLineWithSolidColorMaterial(const entt::registry& registry, entt::entity entity);
+	static void renderLineWithSolidColorMaterial(const entt::registry& registry, entt::entity entity, float depth);
 
 	template<>
-	static void renderLineWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity)
+	static void renderLineWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		// Define indices for two triangles making up a rectangle
 		// (since lines are rendered as thin rectangles)
@@ -316,12 +331,13 @@ namespace Renderer2D
 		(
 			registry, entity,
 			LineGeometrySystem::getVertexPositionsWorld, 4,
-			indices, 6
+			indices, 6,
+			depth
 		);
 	}
 
 	template<>
-	static void renderLineWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity)
+	static void renderLineWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		// Define indices for two triangles making up a rectangle
 		// (since lines are rendered as thin rectangles)
@@ -332,17 +348,18 @@ namespace Renderer2D
 		(
 			registry, entity,
 			LineGeometrySystem::getVertexPositionsLocal, 4,
-			indices, 6
+			indices, 6,
+			depth
 		);
 	}
 
 	// Renders an entity with circle geometry and a solid color material
 	// @tparam HasTransform - A boolean parameter indicating if the entity has a transform component
 	template<bool HasTransform>
-	static void renderCircleWithSolidColorMaterial(const entt::registry& registry, entt::entity entity);
+	static void renderCircleWithSolidColorMaterial(const entt::registry& registry, entt::entity entity, float depth);
 
 	template<>
-	static void renderCircleWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity)
+	static void renderCircleWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		const CircleGeometryComponent& circleGeometry = registry.get<CircleGeometryComponent>(entity);
 
@@ -351,12 +368,13 @@ namespace Renderer2D
 		(
 			registry, entity,
 			CircleGeometrySystem::getVertexPositionsAndIndicesWorld,
-			circleGeometry.segmentsCount    // number of vertices is equal to number of segments
+			circleGeometry.segmentsCount,    // number of vertices is equal to number of segments
+			depth
 		);
 	}
 
 	template<>
-	static void renderCircleWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity)
+	static void renderCircleWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		const CircleGeometryComponent& circleGeometry = registry.get<CircleGeometryComponent>(entity);
 
@@ -365,17 +383,18 @@ namespace Renderer2D
 		(
 			registry, entity,
 			CircleGeometrySystem::getVertexPositionsAndIndicesLocal,
-			circleGeometry.segmentsCount    // number of vertices is equal to number of segments
+			circleGeometry.segmentsCount,    // number of vertices is equal to number of segments
+			depth
 		);
 	}
 
 	// Renders an entity with triangle geometry and a solid color material
 	// @tparam HasTransform - A boolean parameter indicating if the entity has a transform component
 	template<bool HasTransform>
-	static void renderTriangleWithSolidColorMaterial(const entt::registry& registry, entt::entity entity);
+	static void renderTriangleWithSolidColorMaterial(const entt::registry& registry, entt::entity entity, float depth);
 
 	template<>
-	static void renderTriangleWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity)
+	static void renderTriangleWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		// Define indices for a single triangle
 		static constexpr unsigned indices[3] = { 0, 1, 2 };
@@ -385,12 +404,13 @@ namespace Renderer2D
 		(
 			registry, entity,
 			TriangleGeometrySystem::getVertexPositionsWorld, 3,
-			indices, 3
+			indices, 3,
+			depth
 		);
 	}
 
 	template<>
-	static void renderTriangleWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity)
+	static void renderTriangleWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		// Define indices for a single triangle
 		static constexpr unsigned indices[3] = { 0, 1, 2 };
@@ -400,17 +420,18 @@ namespace Renderer2D
 		(
 			registry, entity,
 			TriangleGeometrySystem::getVertexPositionsLocal, 3,
-			indices, 3
+			indices, 3,
+			depth
 		);
 	}
 
 	// Renders an entity with polygon geometry and a solid color material
 	// @tparam HasTransform - A boolean parameter indicating if the entity has a transform component
 	template<bool HasTransform>
-	static void renderPolygonWithSolidColorMaterial(const entt::registry& registry, entt::entity entity);
+	static void renderPolygonWithSolidColorMaterial(const entt::registry& registry, entt::entity entity, float depth);
 
 	template<>
-	static void renderPolygonWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity)
+	static void renderPolygonWithSolidColorMaterial<true>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		const PolygonGeometryComponent& polygonGeometry = registry.get<PolygonGeometryComponent>(entity);
 
@@ -419,12 +440,13 @@ namespace Renderer2D
 		(
 			registry, entity,
 			PolygonGeometrySystem::getVertexPositionsAndIndicesWorld,
-			polygonGeometry.vertexPositions.size()
+			polygonGeometry.vertexPositions.size(),
+			depth
 		);
 	}
 
 	template<>
-	static void renderPolygonWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity)
+	static void renderPolygonWithSolidColorMaterial<false>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		const PolygonGeometryComponent& polygonGeometry = registry.get<PolygonGeometryComponent>(entity);
 
@@ -433,17 +455,18 @@ namespace Renderer2D
 		(
 			registry, entity,
 			PolygonGeometrySystem::getVertexPositionsAndIndicesLocal,
-			polygonGeometry.vertexPositions.size()
+			polygonGeometry.vertexPositions.size(),
+			depth
 		);
 	}
 
 	// Renders an entity with a line component
 	// @tparam HasTransform - A boolean parameter indicating if the entity has a transform component
 	template<bool HasTransform>
-	static void renderLine(const entt::registry& registry, entt::entity entity);
+	static void renderLine(const entt::registry& registry, entt::entity entity, float depth);
 
 	template<>
-	static void renderLine<true>(const entt::registry& registry, entt::entity entity)
+	static void renderLine<true>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		// Get line component from entity
 		const LineComponent& line = registry.get<LineComponent>(entity);
@@ -471,6 +494,8 @@ namespace Renderer2D
 			shader.setUniform4f("uColor", line.color);
 			// Set view projection matrix uniform using the primary camera
 			setViewProjectionMatrixUniform(shader, g_camera);
+			// Set depth uniform
+			shader.setUniform1f("uDepth", depth);
 		}
 
 		// Render the draw object
@@ -478,7 +503,7 @@ namespace Renderer2D
 	}
 
 	template<>
-	static void renderLine<false>(const entt::registry& registry, entt::entity entity)
+	static void renderLine<false>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		// Get line component from entity
 		const LineComponent& line = registry.get<LineComponent>(entity);
@@ -506,6 +531,8 @@ namespace Renderer2D
 			shader.setUniform4f("uColor", line.color);
 			// Set view projection matrix uniform using the primary camera
 			setViewProjectionMatrixUniform(shader, g_camera);
+			// Set depth uniform
+			shader.setUniform1f("uDepth", depth);
 		}
 
 		// Render the draw object
@@ -522,26 +549,45 @@ namespace Renderer2D
 			return;
 		}
 
-		// Render all rectangles, triangles, circles, lines, and polygons that have a solid color material and a transform
-		renderAllEntitiesWith<RectangleGeometryComponent, SolidColorMaterialComponent, TransformComponent2D>(registry, renderRectangleWithSolidColorMaterial<true>);
-		renderAllEntitiesWith<TriangleGeometryComponent, SolidColorMaterialComponent, TransformComponent2D>(registry, renderTriangleWithSolidColorMaterial<true>);
-		renderAllEntitiesWith<CircleGeometryComponent, SolidColorMaterialComponent, TransformComponent2D>(registry, renderCircleWithSolidColorMaterial<true>);
-		renderAllEntitiesWith<LineGeometryComponent, SolidColorMaterialComponent, TransformComponent2D>(registry, renderLineWithSolidColorMaterial<true>);
-		renderAllEntitiesWith<PolygonGeometryComponent, SolidColorMaterialComponent, TransformComponent2D>(registry, renderPolygonWithSolidColorMaterial<true>);
-		// Render all rectangles, triangles, circles, lines, and polygons that have a solid color material but no transform
-		renderAllEntitiesWith<RectangleGeometryComponent, SolidColorMaterialComponent>(entt::exclude<TransformComponent2D>, registry, renderRectangleWithSolidColorMaterial<false>);
-		renderAllEntitiesWith<TriangleGeometryComponent, SolidColorMaterialComponent>(entt::exclude<TransformComponent2D>, registry, renderTriangleWithSolidColorMaterial<false>);
-		renderAllEntitiesWith<CircleGeometryComponent, SolidColorMaterialComponent>(entt::exclude<TransformComponent2D>, registry, renderCircleWithSolidColorMaterial<false>);
-		renderAllEntitiesWith<LineGeometryComponent, SolidColorMaterialComponent>(entt::exclude<TransformComponent2D>, registry, renderLineWithSolidColorMaterial<false>);
-		renderAllEntitiesWith<PolygonGeometryComponent, SolidColorMaterialComponent>(entt::exclude<TransformComponent2D>, registry, renderPolygonWithSolidColorMaterial<false>);
-
-		// Render all lines that have a transform
-		renderAllEntitiesWith<LineComponent, TransformComponent2D>(registry, renderLine<true>);
-		// Render all lines that do not have a transform
-		renderAllEntitiesWith<LineComponent>(entt::exclude<TransformComponent2D>, registry, renderLine<false>);
-
-		// Render all sprites
-		SpriteSystem::render(registry, g_camera);
+		// Clear depth buffer before rendering anything, since render queue relies on depth testing to resolve overlap order
+		RenderCommands::clear(false, true);
+
+		g_renderQueue.clear();
+
+		// Submit all tilemaps
+		TilemapSystem::submit(registry, g_camera, g_renderQueue);
+
+		// Submit all static entities, baked into a few merged meshes
+		StaticRenderSystem::submit(registry, g_camera, g_renderQueue);
+
+		// Submit all rectangles, triangles, circles, lines, and polygons that have a solid color material and a transform
+		constexpr RenderQueueShader shapeShader = RenderQueueShader::ShapeSolidColorMaterial;
+		submitAllEntitiesWith<SolidColorMaterialComponent, RectangleGeometryComponent, TransformComponent2D>(entt::exclude<StaticRenderComponent>, registry, renderRectangleWithSolidColorMaterial<true>, shapeShader);
+		submitAllEntitiesWith<SolidColorMaterialComponent, TriangleGeometryComponent, TransformComponent2D>(entt::exclude<StaticRenderComponent>, registry, renderTriangleWithSolidColorMaterial<true>, shapeShader);
+		submitAllEntitiesWith<SolidColorMaterialComponent, CircleGeometryComponent, TransformComponent2D>(entt::exclude<StaticRenderComponent>, registry, renderCircleWithSolidColorMaterial<true>, shapeShader);
+		submitAllEntitiesWith<SolidColorMaterialComponent, LineGeometryComponent, TransformComponent2D>(entt::exclude<StaticRenderComponent>, registry, renderLineWithSolidColorMaterial<true>, shapeShader);
+		submitAllEntitiesWith<SolidColorMaterialComponent, PolygonGeometryComponent, TransformComponent2D>(entt::exclude<StaticRenderComponent>, registry, renderPolygonWithSolidColorMaterial<true>, shapeShader);
+		// Submit all rectangles, triangles, circles, lines, and polygons that have a solid color material but no transform
+		submitAllEntitiesWith<SolidColorMaterialComponent, RectangleGeometryComponent>(entt::exclude<TransformComponent2D, StaticRenderComponent>, registry, renderRectangleWithSolidColorMaterial<false>, shapeShader);
+		submitAllEntitiesWith<SolidColorMaterialComponent, TriangleGeometryComponent>(entt::exclude<TransformComponent2D, StaticRenderComponent>, registry, renderTriangleWithSolidColorMaterial<false>, shapeShader);
+		submitAllEntitiesWith<SolidColorMaterialComponent, CircleGeometryComponent>(entt::exclude<TransformComponent2D, StaticRenderComponent>, registry, renderCircleWithSolidColorMaterial<false>, shapeShader);
+		submitAllEntitiesWith<SolidColorMaterialComponent, LineGeometryComponent>(entt::exclude<TransformComponent2D, StaticRenderComponent>, registry, renderLineWithSolidColorMaterial<false>, shapeShader);
+		submitAllEntitiesWith<SolidColorMaterialComponent, PolygonGeometryComponent>(entt::exclude<TransformComponent2D, StaticRenderComponent>, registry, renderPolygonWithSolidColorMaterial<false>, shapeShader);
+
+		// Submit all lines that have a transform
+		submitAllEntitiesWith<LineComponent, TransformComponent2D>(entt::exclude<>, registry, renderLine<true>, RenderQueueShader::Line);
+		// Submit all lines that do not have a transform
+		submitAllEntitiesWith<LineComponent>(entt::exclude<TransformComponent2D>, registry, renderLine<false>, RenderQueueShader::Line);
+
+		// Submit all sprites
+		SpriteSystem::submit(registry, g_camera, g_renderQueue);
+
+		// Submit all particle emitters
+		ParticleSystem::submit(registry, g_camera, g_renderQueue);
+
+		// Sort everything that was submitted and render it
+		g_renderQueue.sort();
+		g_renderQueue.render(registry);
 	}
 
 } // namespace Renderer2D
@@ -11,7 +11,11 @@ namespace Renderer2D
 	{
 	public:
 
-		// Renders all renderable entities in the given registry
+		// Renders all renderable entities in the given registry.
+		// Shapes, lines and sprites are submitted to a render queue and rendered in an order
+		// determined by their RenderOrderComponent2D, blend mode, shader and texture.
+		// Overlap order is resolved with depth testing, so the frame buffer rendered to must have a depth buffer.
+		// Window's frame buffer and all FrameBuffer objects have one.
 		static void render(const entt::registry& registry);
 	};
 
@@ -5,6 +5,9 @@
 #include "GraphicsSubsystem.h"
 #include "ShaderPreprocessor.h"
 #include "CameraSystem2D.h"
+#include "ParticleSystem.h"
+#include "TilemapSystem.h"
+#include "StaticRenderSystem.h"
 
 using namespace Pekan::Graphics;
 
@@ -46,6 +49,9 @@ namespace Renderer2D
 
 	void Renderer2DSubsystem::exit()
 	{
+		ParticleSystem::exit();
+		TilemapSystem::exit();
+		StaticRenderSystem::exit();
 	}
 
 	ISubsystem* Renderer2DSubsystem::getParent()
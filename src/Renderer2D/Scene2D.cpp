@@ -4,6 +4,7 @@
 #include "RenderCommands.h"
 #include "RenderState.h"
 #include "PostProcessor.h"
+#include "GpuProfiler.h"
 
 using namespace Pekan::Graphics;
 
@@ -29,8 +30,12 @@ namespace Renderer2D {
 	{
 		PostProcessor::beginFrame();
 
-		const entt::registry& registry = getRegistry();
-		RenderSystem2D::render(registry);
+		{
+			PK_PROFILE_SCOPE("RenderSystem2D::render");
+			PK_PROFILE_GPU_SCOPE("Scene");
+			const entt::registry& registry = getRegistry();
+			RenderSystem2D::render(registry);
+		}
 
 		_render();
 
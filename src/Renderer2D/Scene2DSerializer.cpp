@@ -10,6 +10,7 @@
 #include "SolidColorMaterialComponent.h"
 #include "LineComponent.h"
 #include "CameraComponent2D.h"
+#include "RenderOrderComponent2D.h"
 
 #include "Scene.h"
 #include "Entity/EntityIDComponent.h"
@@ -134,6 +135,17 @@ namespace Renderer2D
 		return lineData;
 	}
 
+	// Serializes a given render order component into a JSON object
+	static json serializeRenderOrderComponent2D(const RenderOrderComponent2D& renderOrderComponent2D)
+	{
+		const json renderOrderData =
+		{
+			{ "layer", renderOrderComponent2D.layer },
+			{ "depth", renderOrderComponent2D.depth }
+		};
+		return renderOrderData;
+	}
+
 	// Serializes a given camera component into a JSON object
 	static json serializeCameraComponent2D(const CameraComponent2D& cameraComponent2D)
 	{
@@ -203,6 +215,11 @@ namespace Renderer2D
 		{
 			componentsData["Line"] = serializeLineComponent(*lineComponent);
 		}
+		const RenderOrderComponent2D* renderOrderComponent2D = registry.try_get<RenderOrderComponent2D>(entity);
+		if (renderOrderComponent2D != nullptr)
+		{
+			componentsData["RenderOrder2D"] = serializeRenderOrderComponent2D(*renderOrderComponent2D);
+		}
 		const CameraComponent2D* cameraComponent2D = registry.try_get<CameraComponent2D>(entity);
 		if (cameraComponent2D != nullptr)
 		{
@@ -3,8 +3,11 @@
 layout(location = 0) in vec2 aPosition;
 
 uniform mat4 uViewProjectionMatrix;
+// Clip-space depth at which to render, used for ordering overlapping primitives
+uniform float uDepth;
 
 void main()
 {
    gl_Position = uViewProjectionMatrix * vec4(aPosition, 0.0, 1.0);
+   gl_Position.z = uDepth * gl_Position.w;
 }
@@ -0,0 +1,20 @@
+#version 330 core
+
+in vec2 vTexCoord;
+in vec4 vColor;
+out vec4 FragColor;
+
+uniform sampler2D uTexture;
+uniform int uHasTexture;
+
+void main()
+{
+	if (uHasTexture != 0)
+	{
+		FragColor = texture(uTexture, vTexCoord) * vColor;
+	}
+	else
+	{
+		FragColor = vColor;
+	}
+}
@@ -0,0 +1,20 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPosition;
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec4 aColor;
+
+out vec2 vTexCoord;
+out vec4 vColor;
+
+uniform mat4 uViewProjectionMatrix;
+// Clip-space depth at which to render, used for ordering overlapping primitives
+uniform float uDepth;
+
+void main()
+{
+	gl_Position = uViewProjectionMatrix * vec4(aPosition, 0.0, 1.0);
+	gl_Position.z = uDepth * gl_Position.w;
+	vTexCoord = aTexCoord;
+	vColor = aColor;
+}
@@ -6,9 +6,12 @@ layout(location = 1) in vec2 aTexCoord;
 out vec2 vTexCoord;
 
 uniform mat4 uViewProjectionMatrix;
+// Clip-space depth at which to render, used for ordering overlapping primitives
+uniform float uDepth;
 
 void main()
 {
 	gl_Position = uViewProjectionMatrix * vec4(aPosition, 0.0, 1.0);
+	gl_Position.z = uDepth * gl_Position.w;
 	vTexCoord = aTexCoord;
 }
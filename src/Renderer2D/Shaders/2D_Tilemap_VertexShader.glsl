@@ -0,0 +1,18 @@
+#version 330 core
+
+layout(location = 0) in vec2 aPosition;
+layout(location = 1) in vec2 aTexCoord;
+
+out vec2 vTexCoord;
+
+uniform mat4 uViewProjectionMatrix;
+uniform mat4 uWorldMatrix;
+// Clip-space depth at which to render, used for ordering overlapping primitives
+uniform float uDepth;
+
+void main()
+{
+	gl_Position = uViewProjectionMatrix * uWorldMatrix * vec4(aPosition, 0.0, 1.0);
+	gl_Position.z = uDepth * gl_Position.w;
+	vTexCoord = aTexCoord;
+}
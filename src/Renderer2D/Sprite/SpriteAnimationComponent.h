@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Texture2D.h"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// A single frame of a sprite animation
+	struct SpriteAnimationFrame
+	{
+		// Texture coordinates of the frame inside of animation's texture
+		glm::vec2 textureCoordinatesMin = { 0.0f, 0.0f };
+		glm::vec2 textureCoordinatesMax = { 1.0f, 1.0f };
+
+		// Duration of the frame, in seconds
+		float duration = 0.1f;
+	};
+
+	// A flipbook animation - a table of frames inside of a single texture, usually a texture atlas page.
+	// Can be shared between any number of entities.
+	struct SpriteAnimation
+	{
+	public:
+
+		// Adds a frame at the end of the animation.
+		// Frames must have a positive duration, otherwise the frame is rejected and false is returned.
+		bool addFrame(const SpriteAnimationFrame& frame);
+
+		const std::vector<SpriteAnimationFrame>& getFrames() const { return m_frames; }
+
+		// Returns the sum of the durations of all frames, in seconds
+		float getTotalDuration() const { return m_totalDuration; }
+
+		// Texture containing all frames of the animation
+		Graphics::Texture2D_ConstPtr texture;
+
+	private: /* variables */
+
+		std::vector<SpriteAnimationFrame> m_frames;
+
+		// Sum of the durations of all frames, in seconds.
+		// Frames can only be added through addFrame(), so it's always in sync with them.
+		float m_totalDuration = 0.0f;
+	};
+
+	typedef std::shared_ptr<SpriteAnimation> SpriteAnimation_Ptr;
+	typedef std::shared_ptr<const SpriteAnimation> SpriteAnimation_ConstPtr;
+
+	// A component for animating an entity's sprite with a flipbook animation.
+	// Only the texture coordinates of entity's SpriteComponent are changed while animating,
+	// so the texture must be set to animation's texture beforehand.
+	struct SpriteAnimationComponent
+	{
+		/* data */
+
+		SpriteAnimation_ConstPtr animation;
+
+		// Playback speed multiplier
+		float speed = 1.0f;
+
+		// If true, animation starts over after its last frame. Otherwise it stops on its last frame.
+		bool loop = true;
+
+		bool isPlaying = true;
+
+		// Index of the current frame
+		int currentFrame = 0;
+		// Time spent in the current frame so far, in seconds
+		float timeInCurrentFrame = 0.0f;
+
+		// Index of the frame whose texture coordinates were last written to the sprite.
+		// Used so that the sprite is only touched when the frame changes.
+		int appliedFrame = -1;
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,131 @@
+#include "SpriteAnimationSystem.h"
+
+#include "SpriteComponent.h"
+#include "TextureAtlas.h"
+#include "PekanLogger.h"
+#include "Entity/DisabledComponent.h"
+
+#include <cmath>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	bool SpriteAnimation::addFrame(const SpriteAnimationFrame& frame)
+	{
+		// A frame with no duration would never be left, and one with a negative duration would break looping
+		if (!(frame.duration > 0.0f))
+		{
+			PK_LOG_ERROR("Cannot add a frame with non-positive duration to a sprite animation.", "Pekan");
+			return false;
+		}
+		m_frames.push_back(frame);
+		m_totalDuration += frame.duration;
+		return true;
+	}
+
+	// Advances a given animation component by a given time, moving to the next frame(s) if needed
+	static void advanceAnimation(SpriteAnimationComponent& animationComponent, const SpriteAnimation& animation, float time)
+	{
+		const std::vector<SpriteAnimationFrame>& frames = animation.getFrames();
+		const int framesCount = int(frames.size());
+
+		animationComponent.timeInCurrentFrame += time;
+
+		// If a looping animation is advanced by more than a full cycle, skip the full cycles
+		// so that we don't iterate over the same frames more than once.
+		if (animationComponent.loop && animationComponent.timeInCurrentFrame >= animation.getTotalDuration())
+		{
+			animationComponent.timeInCurrentFrame = std::fmod(animationComponent.timeInCurrentFrame, animation.getTotalDuration());
+		}
+
+		while (animationComponent.timeInCurrentFrame >= frames[animationComponent.currentFrame].duration)
+		{
+			animationComponent.timeInCurrentFrame -= frames[animationComponent.currentFrame].duration;
+			if (animationComponent.currentFrame + 1 < framesCount)
+			{
+				animationComponent.currentFrame++;
+			}
+			else if (animationComponent.loop)
+			{
+				animationComponent.currentFrame = 0;
+			}
+			else
+			{
+				// Stop on the last frame
+				animationComponent.timeInCurrentFrame = 0.0f;
+				animationComponent.isPlaying = false;
+				break;
+			}
+		}
+	}
+
+	void SpriteAnimationSystem::update(entt::registry& registry, float deltaTime)
+	{
+		auto view = registry.view<SpriteAnimationComponent, SpriteComponent>(entt::exclude<DisabledComponent>);
+		for (auto [entity, animationComponent, sprite] : view.each())
+		{
+			const SpriteAnimation* animation = animationComponent.animation.get();
+			if (animation == nullptr || animation->getFrames().empty())
+			{
+				continue;
+			}
+			PK_ASSERT_QUICK(animationComponent.currentFrame >= 0 && animationComponent.currentFrame < int(animation->getFrames().size()));
+
+			if (animationComponent.isPlaying)
+			{
+				advanceAnimation(animationComponent, *animation, deltaTime * animationComponent.speed);
+			}
+
+			// Only write to the sprite if the frame has changed
+			if (animationComponent.currentFrame != animationComponent.appliedFrame)
+			{
+				const SpriteAnimationFrame& frame = animation->getFrames()[animationComponent.currentFrame];
+				sprite.textureCoordinatesMin = frame.textureCoordinatesMin;
+				sprite.textureCoordinatesMax = frame.textureCoordinatesMax;
+				animationComponent.appliedFrame = animationComponent.currentFrame;
+			}
+		}
+	}
+
+	SpriteAnimation_Ptr SpriteAnimationSystem::createAnimation(const TextureAtlas& atlas, const std::vector<std::string>& frameNames, float frameDuration)
+	{
+		if (frameNames.empty())
+		{
+			PK_LOG_ERROR("Cannot create a sprite animation without any frames.", "Pekan");
+			return nullptr;
+		}
+		if (frameDuration <= 0.0f)
+		{
+			PK_LOG_ERROR("Cannot create a sprite animation with non-positive frame duration.", "Pekan");
+			return nullptr;
+		}
+
+		SpriteAnimation_Ptr animation = std::make_shared<SpriteAnimation>();
+
+		int pageIndex = -1;
+		for (const std::string& frameName : frameNames)
+		{
+			const TextureAtlasRegion* region = atlas.getRegion(frameName);
+			if (region == nullptr)
+			{
+				PK_LOG_ERROR("Cannot create a sprite animation with frame \"" << frameName << "\" that doesn't exist in the texture atlas.", "Pekan");
+				return nullptr;
+			}
+			if (pageIndex != -1 && region->pageIndex != pageIndex)
+			{
+				PK_LOG_ERROR("Cannot create a sprite animation with frames on different texture atlas pages.", "Pekan");
+				return nullptr;
+			}
+			pageIndex = region->pageIndex;
+
+			animation->addFrame({ region->textureCoordinatesMin, region->textureCoordinatesMax, frameDuration });
+		}
+
+		animation->texture = atlas.getPageTexture(pageIndex);
+		return animation;
+	}
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
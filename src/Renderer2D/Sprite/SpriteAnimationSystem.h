@@ -0,0 +1,31 @@
+#pragma once
+
+#include "SpriteAnimationComponent.h"
+
+#include <entt/entt.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+	class TextureAtlas;
+
+	class SpriteAnimationSystem
+	{
+	public:
+
+		// Advances the animations of all entities with a SpriteAnimationComponent and a SpriteComponent
+		// by a given delta time, in seconds, and updates the texture coordinates of their sprites.
+		static void update(entt::registry& registry, float deltaTime);
+
+		// Creates an animation from images of a texture atlas, in the given order, each lasting the given duration.
+		// All images must be on the same atlas page.
+		// Returns a null pointer on failure.
+		static SpriteAnimation_Ptr createAnimation(const TextureAtlas& atlas, const std::vector<std::string>& frameNames, float frameDuration);
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include "Utils/FileUtils.h"
 #include "PekanLogger.h"
 #include "Entity/DisabledComponent.h"
+#include "StaticRenderComponent.h"
+#include "RenderQueue2D.h"
 
 using namespace Pekan::Graphics;
 
@@ -111,6 +113,7 @@ namespace Renderer2D
 		const SpriteComponent& sprite,
 		const TransformComponent2D& transform,
 		int textureSlot,              // texture slot to set in the shader uniform
+		float depth,                  // clip-space depth at which to render the sprite
 		DrawObject& drawObject    // draw object to create
 	)
 	{
@@ -132,7 +135,7 @@ namespace Renderer2D
 		);
 		// Set draw object's index data for a sprite formed by two triangles
 		static constexpr unsigned indices[6] = { 0, 1, 2, 0, 2, 3 };
-		drawObject.setIndexData(indices, sizeof(unsigned) * 6, BufferDataUsage::StaticDraw);
+		drawObject.setIndices(indices, 6, BufferDataUsage::StaticDraw);
 
 		// Set draw object's shader uniforms
 		{
@@ -141,6 +144,8 @@ namespace Renderer2D
 			setViewProjectionMatrixUniform(shader, g_camera);
 			// Set texture slot uniform
 			shader.setUniform1i("uTexture", textureSlot);
+			// Set depth uniform
+			shader.setUniform1f("uDepth", depth);
 		}
 	}
 
@@ -150,6 +155,7 @@ namespace Renderer2D
 		const entt::registry& registry,
 		const SpriteComponent& sprite,
 		int textureSlot,              // texture slot to set in the shader uniform
+		float depth,                  // clip-space depth at which to render the sprite
 		DrawObject& drawObject    // draw object to create
 	)
 	{
@@ -171,7 +177,7 @@ namespace Renderer2D
 		);
 		// Set draw object's index data for a sprite formed by two triangles
 		static constexpr unsigned indices[6] = { 0, 1, 2, 0, 2, 3 };
-		drawObject.setIndexData(indices, sizeof(unsigned) * 6, BufferDataUsage::StaticDraw);
+		drawObject.setIndices(indices, 6, BufferDataUsage::StaticDraw);
 
 		// Set draw object's shader uniforms
 		{
@@ -180,16 +186,18 @@ namespace Renderer2D
 			setViewProjectionMatrixUniform(shader, g_camera);
 			// Set texture slot uniform
 			shader.setUniform1i("uTexture", textureSlot);
+			// Set depth uniform
+			shader.setUniform1f("uDepth", depth);
 		}
 	}
 
 	// Renders an entity with a sprite component
 	// @tparam HasTransform - A boolean parameter indicating if the entity has a transform component
 	template<bool HasTransform>
-	static void renderSprite(const entt::registry& registry, entt::entity entity);
+	static void renderSprite(const entt::registry& registry, entt::entity entity, float depth);
 
 	template<>
-	static void renderSprite<true>(const entt::registry& registry, entt::entity entity)
+	static void renderSprite<true>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		PK_ASSERT(registry.valid(entity), "Cannot render an entity that doesn't exist.", "Pekan");
 		PK_ASSERT(registry.all_of<SpriteComponent>(entity), "Cannot render an entity that doesn't have a SpriteComponent.", "Pekan");
@@ -197,15 +205,11 @@ namespace Renderer2D
 
 		// Get entity's sprite and transform components
 		const SpriteComponent& sprite = registry.get<SpriteComponent>(entity);
-		if (sprite.texture == nullptr || !sprite.texture->isValid())
-		{
-			PK_LOG_INFO("Skipped rendering an entity with SpriteComponent with invalid texture.", "Pekan");
-			return;
-		}
+		PK_ASSERT(sprite.texture != nullptr && sprite.texture->isValid(), "Cannot render an entity with SpriteComponent with invalid texture.", "Pekan");
 		const TransformComponent2D& transform = registry.get<TransformComponent2D>(entity);
 		// Create draw object for the sprite
 		DrawObject drawObject;
-		createDrawObjectForSprite(registry, sprite, transform, 0, drawObject);
+		createDrawObjectForSprite(registry, sprite, transform, 0, depth, drawObject);
 		// Bind sprite's texture
 		sprite.texture->bind(0);
 		// Render sprite's draw object
@@ -213,63 +217,91 @@ namespace Renderer2D
 	}
 
 	template<>
-	static void renderSprite<false>(const entt::registry& registry, entt::entity entity)
+	static void renderSprite<false>(const entt::registry& registry, entt::entity entity, float depth)
 	{
 		PK_ASSERT(registry.valid(entity), "Cannot render an entity that doesn't exist.", "Pekan");
 		PK_ASSERT(registry.all_of<SpriteComponent>(entity), "Cannot render an entity that doesn't have a SpriteComponent.", "Pekan");
 
 		// Get entity's sprite component
 		const SpriteComponent& sprite = registry.get<SpriteComponent>(entity);
-		if (sprite.texture == nullptr || !sprite.texture->isValid())
-		{
-			PK_LOG_INFO("Skipped rendering an entity with SpriteComponent with invalid texture.", "Pekan");
-			return;
-		}
+		PK_ASSERT(sprite.texture != nullptr && sprite.texture->isValid(), "Cannot render an entity with SpriteComponent with invalid texture.", "Pekan");
 		// Create draw object for the sprite
 		DrawObject drawObject;
-		createDrawObjectForSprite(registry, sprite, 0, drawObject);
+		createDrawObjectForSprite(registry, sprite, 0, depth, drawObject);
 		// Bind sprite's texture
 		sprite.texture->bind(0);
 		// Render sprite's draw object
 		drawObject.render();
 	}
 
-	// Renders all sprites that have (or all sprites that don't have) a transform component
+	// Submits a given sprite entity to a given render queue, unless its texture is invalid
+	template<bool HasTransform>
+	static void submitSprite(const entt::registry& registry, entt::entity entity, RenderQueue2D& renderQueue)
+	{
+		const SpriteComponent& sprite = registry.get<SpriteComponent>(entity);
+		if (sprite.texture == nullptr || !sprite.texture->isValid())
+		{
+			PK_LOG_INFO("Skipped rendering an entity with SpriteComponent with invalid texture.", "Pekan");
+			return;
+		}
+		// Sprites need blending only if their texture has translucent texels
+		const RenderQueueBlendMode blendMode = sprite.texture->isOpaque() ? RenderQueueBlendMode::Opaque : RenderQueueBlendMode::Transparent;
+		renderQueue.submit(registry, entity, renderSprite<HasTransform>, blendMode, RenderQueueShader::Sprite, sprite.texture.get());
+	}
+
+	// Submits all sprites that have (or all sprites that don't have) a transform component to a given render queue
 	// @tparam HasTransform - A boolean parameter indicating if the entities have a transform component
 	template<bool HasTransform>
-	static void renderAllSprites(const entt::registry& registry);
+	static void submitAllSprites(const entt::registry& registry, RenderQueue2D& renderQueue);
 
 	template<>
-	static void renderAllSprites<true>(const entt::registry& registry)
+	static void submitAllSprites<true>(const entt::registry& registry, RenderQueue2D& renderQueue)
 	{
-		// Get a view of all entities with a sprite component and a transform component
-		const auto view = registry.view<SpriteComponent, TransformComponent2D>(entt::exclude<DisabledComponent>);
-		// Render each such entity
+		// Get a view of all entities with a sprite component and a transform component.
+		// Static entities are skipped since they are rendered by the StaticRenderSystem.
+		const auto view = registry.view<SpriteComponent, TransformComponent2D>(entt::exclude<DisabledComponent, StaticRenderComponent>);
+		// Submit each such entity
 		for (entt::entity entity : view)
 		{
-			renderSprite<true>(registry, entity);
+			submitSprite<true>(registry, entity, renderQueue);
 		}
 	}
 
 	template<>
-	static void renderAllSprites<false>(const entt::registry& registry)
+	static void submitAllSprites<false>(const entt::registry& registry, RenderQueue2D& renderQueue)
 	{
-		// Get a view of all entities with a sprite component but without a transform component
-		const auto view = registry.view<SpriteComponent>(entt::exclude<DisabledComponent, TransformComponent2D>);
-		// Render each such entity
+		// Get a view of all entities with a sprite component but without a transform component.
+		// Static entities are skipped since they are rendered by the StaticRenderSystem.
+		const auto view = registry.view<SpriteComponent>(entt::exclude<DisabledComponent, TransformComponent2D, StaticRenderComponent>);
+		// Submit each such entity
 		for (entt::entity entity : view)
 		{
-			renderSprite<false>(registry, entity);
+			submitSprite<false>(registry, entity, renderQueue);
 		}
 	}
 
-	void SpriteSystem::render(const entt::registry& registry, const CameraComponent2D* camera)
+	void SpriteSystem::submit(const entt::registry& registry, const CameraComponent2D* camera, RenderQueue2D& renderQueue)
 	{
 		PK_ASSERT_QUICK(camera != nullptr);
 		g_camera = camera;
 
-		renderAllSprites<true>(registry);
-		renderAllSprites<false>(registry);
+		submitAllSprites<true>(registry, renderQueue);
+		submitAllSprites<false>(registry, renderQueue);
+	}
+
+	void SpriteSystem::getVertices(const entt::registry& registry, entt::entity entity, SpriteVertex* vertices)
+	{
+		PK_ASSERT(registry.all_of<SpriteComponent>(entity), "Cannot get sprite vertices of an entity that doesn't have a SpriteComponent.", "Pekan");
+
+		const SpriteComponent& sprite = registry.get<SpriteComponent>(entity);
+		if (const TransformComponent2D* transform = registry.try_get<TransformComponent2D>(entity))
+		{
+			getVerticesWorld(registry, sprite, *transform, vertices);
+		}
+		else
+		{
+			getVerticesLocal(registry, sprite, vertices);
+		}
 	}
 
 } // namespace Renderer2D
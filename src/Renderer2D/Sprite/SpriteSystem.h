@@ -10,12 +10,19 @@ namespace Pekan
 namespace Renderer2D
 {
 	struct CameraComponent2D;
+	struct SpriteVertex;
+	class RenderQueue2D;
 
 	class SpriteSystem
 	{
 	public:
 
-		static void render(const entt::registry& registry, const CameraComponent2D* camera);
+		// Submits all sprites to a given render queue, to be rendered later with the given camera
+		static void submit(const entt::registry& registry, const CameraComponent2D* camera, RenderQueue2D& renderQueue);
+
+		// Computes the 4 vertices of a given entity's sprite, in world space if the entity has a transform,
+		// or in local space otherwise.
+		static void getVertices(const entt::registry& registry, entt::entity entity, SpriteVertex* vertices /* output array of 4 SpriteVertex's */);
 	};
 
 } // namespace Renderer2D
@@ -0,0 +1,631 @@
+#include "TextureAtlas.h"
+
+#include "SpriteComponent.h"
+#include "Image.h"
+#include "PekanLogger.h"
+#include "Utils/FileUtils.h"
+
+#include <json.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+using json = nlohmann::ordered_json;
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// Number of channels of atlas pages. Images of any number of channels are converted to RGBA when added.
+	constexpr int PAGE_NUM_CHANNELS = 4;
+
+	// Identifier written at the beginning of each cooked page file
+	constexpr char PAGE_FILE_MAGIC[4] = { 'P', 'K', 'A', 'P' };
+
+	// Format version of the atlas index file
+	constexpr int INDEX_FILE_FORMAT_VERSION = 1;
+
+	// Header of a cooked page file. It is followed by the raw RGBA pixel data of the page.
+	struct PageFileHeader
+	{
+		char magic[4];
+		int32_t width;
+		int32_t height;
+		int32_t numChannels;
+	};
+
+	// A bin packer using the "skyline bottom-left" algorithm.
+	//
+	// Keeps track of the top edge (skyline) of the already packed rectangles,
+	// as a list of horizontal segments, and places each new rectangle
+	// on the segment where its top edge would end up lowest.
+	class SkylinePacker
+	{
+	public:
+
+		SkylinePacker(int width, int height) : m_width(width), m_height(height)
+		{
+			m_skyline.push_back({ 0, 0, width });
+		}
+
+		// Finds a place for a rectangle of given size and marks it as occupied.
+		// Returns false if the rectangle doesn't fit anywhere.
+		bool insert(int width, int height, int& x, int& y)
+		{
+			int bestTop = INT_MAX;
+			int bestSegmentWidth = INT_MAX;
+			size_t bestIndex = SIZE_MAX;
+			for (size_t i = 0; i < m_skyline.size(); i++)
+			{
+				int segmentY = 0;
+				if (!fits(i, width, height, segmentY))
+				{
+					continue;
+				}
+				// Prefer lowest top edge, and in case of a tie prefer a narrower segment to leave wider ones for later
+				const int top = segmentY + height;
+				if (top < bestTop || (top == bestTop && m_skyline[i].width < bestSegmentWidth))
+				{
+					bestTop = top;
+					bestSegmentWidth = m_skyline[i].width;
+					bestIndex = i;
+					y = segmentY;
+				}
+			}
+
+			if (bestIndex == SIZE_MAX)
+			{
+				return false;
+			}
+
+			x = m_skyline[bestIndex].x;
+			addSegment(bestIndex, x, y + height, width);
+			return true;
+		}
+
+	private: /* functions */
+
+		// Checks if a rectangle of given size fits with its left edge at the start of the segment with given index.
+		// If it fits, "y" is set to the lowest position at which the rectangle can be placed.
+		bool fits(size_t index, int width, int height, int& y) const
+		{
+			const int x = m_skyline[index].x;
+			if (x + width > m_width)
+			{
+				return false;
+			}
+
+			// The rectangle must be placed above all segments it spans over
+			y = m_skyline[index].y;
+			int widthLeft = width;
+			for (size_t i = index; widthLeft > 0; i++)
+			{
+				PK_ASSERT_QUICK(i < m_skyline.size());
+				y = std::max(y, m_skyline[i].y);
+				if (y + height > m_height)
+				{
+					return false;
+				}
+				widthLeft -= m_skyline[i].width;
+			}
+			return true;
+		}
+
+		// Inserts a new segment into the skyline at given index,
+		// shrinking or removing the following segments that are now covered by it.
+		void addSegment(size_t index, int x, int y, int width)
+		{
+			m_skyline.insert(m_skyline.begin() + index, { x, y, width });
+
+			for (size_t i = index + 1; i < m_skyline.size(); i++)
+			{
+				const Segment& previous = m_skyline[i - 1];
+				const int previousRight = previous.x + previous.width;
+				if (m_skyline[i].x >= previousRight)
+				{
+					break;
+				}
+
+				const int shrink = previousRight - m_skyline[i].x;
+				m_skyline[i].x += shrink;
+				m_skyline[i].width -= shrink;
+				if (m_skyline[i].width > 0)
+				{
+					break;
+				}
+				m_skyline.erase(m_skyline.begin() + i);
+				i--;
+			}
+
+			// Merge neighbouring segments at the same height
+			for (size_t i = 0; i + 1 < m_skyline.size(); )
+			{
+				if (m_skyline[i].y == m_skyline[i + 1].y)
+				{
+					m_skyline[i].width += m_skyline[i + 1].width;
+					m_skyline.erase(m_skyline.begin() + i + 1);
+				}
+				else
+				{
+					i++;
+				}
+			}
+		}
+
+	private: /* variables */
+
+		// A horizontal segment of the skyline
+		struct Segment
+		{
+			int x;
+			int y;
+			int width;
+		};
+
+		int m_width;
+		int m_height;
+
+		// Segments of the skyline, sorted from left to right
+		std::vector<Segment> m_skyline;
+	};
+
+	// Converts pixel data with given number of channels to RGBA pixel data
+	static void convertToRGBA(const unsigned char* data, int width, int height, int numChannels, std::vector<unsigned char>& pixels)
+	{
+		const size_t pixelsCount = size_t(width) * size_t(height);
+		pixels.resize(pixelsCount * PAGE_NUM_CHANNELS);
+		for (size_t i = 0; i < pixelsCount; i++)
+		{
+			const unsigned char* src = data + i * numChannels;
+			unsigned char* dst = pixels.data() + i * PAGE_NUM_CHANNELS;
+			switch (numChannels)
+			{
+				case 1:    dst[0] = src[0]; dst[1] = src[0]; dst[2] = src[0]; dst[3] = 255;       break;
+				case 2:    dst[0] = src[0]; dst[1] = src[0]; dst[2] = src[0]; dst[3] = src[1];    break;
+				case 3:    dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = 255;       break;
+				default:   dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3];    break;
+			}
+		}
+	}
+
+	// Copies a single RGBA pixel from one position of a page to another position of the same page
+	static void copyPixel(std::vector<unsigned char>& pixels, int pageWidth, int srcX, int srcY, int dstX, int dstY)
+	{
+		const size_t srcOffset = (size_t(srcY) * pageWidth + srcX) * PAGE_NUM_CHANNELS;
+		const size_t dstOffset = (size_t(dstY) * pageWidth + dstX) * PAGE_NUM_CHANNELS;
+		memcpy(pixels.data() + dstOffset, pixels.data() + srcOffset, PAGE_NUM_CHANNELS);
+	}
+
+	// Reads an integer field of a region from atlas index file.
+	// Returns false if field is missing or is not an integer that fits in an int.
+	static bool readRegionField(const json& regionData, const char* fieldName, int& value)
+	{
+		const auto it = regionData.find(fieldName);
+		if (it == regionData.end() || !it->is_number_integer())
+		{
+			return false;
+		}
+		const long long longValue = it->get<long long>();
+		if (longValue < INT_MIN || longValue > INT_MAX)
+		{
+			return false;
+		}
+		value = int(longValue);
+		return true;
+	}
+
+	// Blits an image into a page at a given position,
+	// and optionally extrudes image's edge pixels into the padding around it.
+	static void blitImage
+	(
+		std::vector<unsigned char>& pagePixels,
+		int pageWidth,
+		int pageHeight,
+		const std::vector<unsigned char>& imagePixels,
+		int imageWidth,
+		int imageHeight,
+		int x,                // position of image's bottom-left corner inside of the page
+		int y,                // ^
+		int padding,
+		bool extrudeEdges
+	)
+	{
+		// Copy image row by row
+		const size_t rowSize = size_t(imageWidth) * PAGE_NUM_CHANNELS;
+		for (int row = 0; row < imageHeight; row++)
+		{
+			const size_t dstOffset = (size_t(y + row) * pageWidth + x) * PAGE_NUM_CHANNELS;
+			memcpy(pagePixels.data() + dstOffset, imagePixels.data() + row * rowSize, rowSize);
+		}
+
+		if (!extrudeEdges || padding <= 0)
+		{
+			return;
+		}
+
+		PK_ASSERT_QUICK(x - padding >= 0 && y - padding >= 0);
+		PK_ASSERT_QUICK(x + imageWidth + padding <= pageWidth && y + imageHeight + padding <= pageHeight);
+
+		// Extrude left and right columns
+		for (int row = 0; row < imageHeight; row++)
+		{
+			for (int i = 1; i <= padding; i++)
+			{
+				copyPixel(pagePixels, pageWidth, x, y + row, x - i, y + row);
+				copyPixel(pagePixels, pageWidth, x + imageWidth - 1, y + row, x + imageWidth - 1 + i, y + row);
+			}
+		}
+		// Extrude bottom and top rows, including the already extruded columns, so that corners get filled too
+		for (int column = x - padding; column < x + imageWidth + padding; column++)
+		{
+			for (int i = 1; i <= padding; i++)
+			{
+				copyPixel(pagePixels, pageWidth, column, y, column, y - i);
+				copyPixel(pagePixels, pageWidth, column, y + imageHeight - 1, column, y + imageHeight - 1 + i);
+			}
+		}
+	}
+
+	bool TextureAtlas::addImage(const std::string& name, const Graphics::Image& image)
+	{
+		if (!image.isValid() || image.getWidth() <= 0 || image.getHeight() <= 0)
+		{
+			PK_LOG_ERROR("Trying to add an invalid image \"" << name << "\" to a texture atlas.", "Pekan");
+			return false;
+		}
+		if (image.getNumChannels() < 1 || image.getNumChannels() > 4)
+		{
+			PK_LOG_ERROR("Trying to add an image \"" << name << "\" with unsupported number of channels ("
+				<< image.getNumChannels() << ") to a texture atlas.", "Pekan");
+			return false;
+		}
+		const bool isNameInPending = std::any_of(m_pendingImages.begin(), m_pendingImages.end(),
+			[&name](const PendingImage& pendingImage) { return pendingImage.name == name; });
+		if (isNameInPending || m_regionIndices.count(name) > 0)
+		{
+			PK_LOG_ERROR("Trying to add an image \"" << name << "\" to a texture atlas that already has an image with that name.", "Pekan");
+			return false;
+		}
+
+		PendingImage pendingImage;
+		pendingImage.name = name;
+		pendingImage.width = image.getWidth();
+		pendingImage.height = image.getHeight();
+		convertToRGBA(image.getData(), image.getWidth(), image.getHeight(), image.getNumChannels(), pendingImage.pixels);
+		m_pendingImages.push_back(std::move(pendingImage));
+
+		return true;
+	}
+
+	bool TextureAtlas::build(const TextureAtlasProperties& properties)
+	{
+		PK_ASSERT(properties.pageWidth > 0 && properties.pageHeight > 0, "Trying to build a texture atlas with invalid page size.", "Pekan");
+		PK_ASSERT(properties.padding >= 0, "Trying to build a texture atlas with negative padding.", "Pekan");
+
+		if (m_pendingImages.empty())
+		{
+			PK_LOG_WARNING("Trying to build a texture atlas without adding any new images to it.", "Pekan");
+			return isBuilt();
+		}
+
+		const int padding = properties.padding;
+
+		// Pack tallest images first. This leaves a much flatter skyline and wastes less space.
+		std::vector<size_t> order(m_pendingImages.size());
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			order[i] = i;
+		}
+		std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+		{
+			return m_pendingImages[a].height > m_pendingImages[b].height;
+		});
+
+		// New pages created by this build, together with their packers
+		const size_t firstNewPage = m_pages.size();
+		std::vector<SkylinePacker> packers;
+
+		bool success = true;
+		for (size_t imageIndex : order)
+		{
+			const PendingImage& image = m_pendingImages[imageIndex];
+			const int paddedWidth = image.width + 2 * padding;
+			const int paddedHeight = image.height + 2 * padding;
+			if (paddedWidth > properties.pageWidth || paddedHeight > properties.pageHeight)
+			{
+				PK_LOG_ERROR("Cannot add image \"" << image.name << "\" of size " << image.width << "x" << image.height
+					<< " to a texture atlas with page size " << properties.pageWidth << "x" << properties.pageHeight << ".", "Pekan");
+				success = false;
+				continue;
+			}
+
+			// Try to fit image in one of the new pages, and if it doesn't fit in any of them, create another page
+			int x = 0, y = 0;
+			size_t packerIndex = 0;
+			while (packerIndex < packers.size() && !packers[packerIndex].insert(paddedWidth, paddedHeight, x, y))
+			{
+				packerIndex++;
+			}
+			if (packerIndex == packers.size())
+			{
+				packers.emplace_back(properties.pageWidth, properties.pageHeight);
+				const bool inserted = packers.back().insert(paddedWidth, paddedHeight, x, y);
+				PK_ASSERT_QUICK(inserted);
+
+				Page page;
+				page.width = properties.pageWidth;
+				page.height = properties.pageHeight;
+				page.pixels.resize(size_t(page.width) * size_t(page.height) * PAGE_NUM_CHANNELS, 0);
+				m_pages.push_back(std::move(page));
+			}
+
+			const size_t pageIndex = firstNewPage + packerIndex;
+			Page& page = m_pages[pageIndex];
+			blitImage(page.pixels, page.width, page.height, image.pixels, image.width, image.height, x + padding, y + padding, padding, properties.extrudeEdges);
+
+			TextureAtlasRegion region;
+			region.pageIndex = int(pageIndex);
+			region.x = x + padding;
+			region.y = y + padding;
+			region.width = image.width;
+			region.height = image.height;
+			m_regionIndices[image.name] = m_regions.size();
+			m_regions.push_back(region);
+		}
+
+		m_pendingImages.clear();
+
+		computeTextureCoordinates();
+		createPageTextures();
+
+		return success;
+	}
+
+	bool TextureAtlas::save(const char* indexFilepath) const
+	{
+		if (!isBuilt())
+		{
+			PK_LOG_ERROR("Trying to save a texture atlas that is not built.", "Pekan");
+			return false;
+		}
+		if (!m_pendingImages.empty())
+		{
+			PK_LOG_WARNING("Saving a texture atlas with images that are added but not yet built. They will not be saved.", "Pekan");
+		}
+
+		const std::filesystem::path indexPath(indexFilepath);
+		const std::string pageFilenameBase = indexPath.stem().string();
+
+		// Write each page to a separate cooked file next to the index file
+		json pagesData = json::array();
+		for (size_t i = 0; i < m_pages.size(); i++)
+		{
+			const Page& page = m_pages[i];
+			const std::string pageFilename = pageFilenameBase + "_page" + std::to_string(i) + ".pkpage";
+			const std::string pageFilepath = (indexPath.parent_path() / pageFilename).string();
+
+			PageFileHeader header;
+			memcpy(header.magic, PAGE_FILE_MAGIC, sizeof(PAGE_FILE_MAGIC));
+			header.width = page.width;
+			header.height = page.height;
+			header.numChannels = PAGE_NUM_CHANNELS;
+
+			std::vector<unsigned char> bytes(sizeof(PageFileHeader) + page.pixels.size());
+			memcpy(bytes.data(), &header, sizeof(PageFileHeader));
+			memcpy(bytes.data() + sizeof(PageFileHeader), page.pixels.data(), page.pixels.size());
+			if (!FileUtils::writeBinaryFile(pageFilepath.c_str(), bytes.data(), bytes.size()))
+			{
+				PK_LOG_ERROR("Failed to save texture atlas page to file: " << pageFilepath, "Pekan");
+				return false;
+			}
+
+			pagesData.push_back(pageFilename);
+		}
+
+		// Write regions of all images to the index file, sorted by name so that saved files don't differ between runs
+		std::vector<const std::string*> regionNames;
+		regionNames.reserve(m_regionIndices.size());
+		for (const auto& [name, regionIndex] : m_regionIndices)
+		{
+			regionNames.push_back(&name);
+		}
+		std::sort(regionNames.begin(), regionNames.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+
+		json regionsData = json::object();
+		for (const std::string* name : regionNames)
+		{
+			const TextureAtlasRegion& region = m_regions[m_regionIndices.at(*name)];
+			regionsData[*name] =
+			{
+				{ "page", region.pageIndex },
+				{ "x", region.x },
+				{ "y", region.y },
+				{ "width", region.width },
+				{ "height", region.height }
+			};
+		}
+
+		const json indexData =
+		{
+			{ "formatVersion", INDEX_FILE_FORMAT_VERSION },
+			{ "pages", pagesData },
+			{ "regions", regionsData }
+		};
+		FileUtils::writeStringToTextFile(indexFilepath, indexData.dump(4).c_str());
+
+		return true;
+	}
+
+	bool TextureAtlas::load(const char* indexFilepath)
+	{
+		clear();
+
+		const std::string indexText = FileUtils::readTextFileToString(indexFilepath);
+		const json indexData = json::parse(indexText, nullptr, false);
+		if (indexData.is_discarded() || !indexData.is_object())
+		{
+			PK_LOG_ERROR("Failed to load texture atlas. Index file is not valid JSON: " << indexFilepath, "Pekan");
+			return false;
+		}
+		const auto itFormatVersion = indexData.find("formatVersion");
+		if (itFormatVersion == indexData.end() || !itFormatVersion->is_number_integer() || itFormatVersion->get<int>() > INDEX_FILE_FORMAT_VERSION)
+		{
+			PK_LOG_ERROR("Failed to load texture atlas. Index file has missing or unsupported format version: " << indexFilepath, "Pekan");
+			return false;
+		}
+		const auto itPages = indexData.find("pages");
+		const auto itRegions = indexData.find("regions");
+		if (itPages == indexData.end() || !itPages->is_array() || itRegions == indexData.end() || !itRegions->is_object())
+		{
+			PK_LOG_ERROR("Failed to load texture atlas. Index file is missing \"pages\" or \"regions\": " << indexFilepath, "Pekan");
+			return false;
+		}
+
+		// Load each page from its cooked file. Page file paths are relative to the index file.
+		const std::filesystem::path indexDirectory = std::filesystem::path(indexFilepath).parent_path();
+		for (const json& pageData : *itPages)
+		{
+			if (!pageData.is_string())
+			{
+				PK_LOG_ERROR("Failed to load texture atlas. Index file contains an invalid page: " << indexFilepath, "Pekan");
+				clear();
+				return false;
+			}
+			const std::string pageFilepath = (indexDirectory / pageData.get<std::string>()).string();
+			const std::vector<unsigned char> bytes = FileUtils::readBinaryFile(pageFilepath.c_str());
+
+			PageFileHeader header;
+			if (bytes.size() < sizeof(PageFileHeader))
+			{
+				PK_LOG_ERROR("Failed to load texture atlas page from file: " << pageFilepath, "Pekan");
+				clear();
+				return false;
+			}
+			memcpy(&header, bytes.data(), sizeof(PageFileHeader));
+			const size_t pixelsSize = size_t(header.width) * size_t(header.height) * PAGE_NUM_CHANNELS;
+			if (memcmp(header.magic, PAGE_FILE_MAGIC, sizeof(PAGE_FILE_MAGIC)) != 0
+				|| header.numChannels != PAGE_NUM_CHANNELS
+				|| header.width <= 0 || header.height <= 0
+				|| bytes.size() != sizeof(PageFileHeader) + pixelsSize)
+			{
+				PK_LOG_ERROR("Failed to load texture atlas page. File is not a valid atlas page: " << pageFilepath, "Pekan");
+				clear();
+				return false;
+			}
+
+			Page page;
+			page.width = header.width;
+			page.height = header.height;
+			page.pixels.assign(bytes.begin() + sizeof(PageFileHeader), bytes.end());
+			m_pages.push_back(std::move(page));
+		}
+
+		// Load regions of all images
+		for (const auto& [name, regionData] : itRegions->items())
+		{
+			TextureAtlasRegion region;
+			if (!regionData.is_object()
+				|| !readRegionField(regionData, "page", region.pageIndex)
+				|| !readRegionField(regionData, "x", region.x)
+				|| !readRegionField(regionData, "y", region.y)
+				|| !readRegionField(regionData, "width", region.width)
+				|| !readRegionField(regionData, "height", region.height))
+			{
+				PK_LOG_ERROR("Failed to load texture atlas. Region \"" << name << "\" is invalid in index file: " << indexFilepath, "Pekan");
+				clear();
+				return false;
+			}
+			if (region.pageIndex < 0 || region.pageIndex >= int(m_pages.size()))
+			{
+				PK_LOG_ERROR("Failed to load texture atlas. Region \"" << name << "\" references a non-existent page in index file: " << indexFilepath, "Pekan");
+				clear();
+				return false;
+			}
+			const Page& page = m_pages[region.pageIndex];
+			if (region.x < 0 || region.y < 0 || region.width <= 0 || region.height <= 0
+				|| region.width > page.width - region.x || region.height > page.height - region.y)
+			{
+				PK_LOG_ERROR("Failed to load texture atlas. Region \"" << name << "\" is outside of its page in index file: " << indexFilepath, "Pekan");
+				clear();
+				return false;
+			}
+
+			m_regionIndices[name] = m_regions.size();
+			m_regions.push_back(region);
+		}
+
+		computeTextureCoordinates();
+		createPageTextures();
+
+		return true;
+	}
+
+	void TextureAtlas::clear()
+	{
+		m_pendingImages.clear();
+		m_pages.clear();
+		m_regions.clear();
+		m_regionIndices.clear();
+	}
+
+	const TextureAtlasRegion* TextureAtlas::getRegion(const std::string& name) const
+	{
+		const auto it = m_regionIndices.find(name);
+		if (it == m_regionIndices.end())
+		{
+			return nullptr;
+		}
+		return &m_regions[it->second];
+	}
+
+	Graphics::Texture2D_ConstPtr TextureAtlas::getPageTexture(int pageIndex) const
+	{
+		PK_ASSERT(pageIndex >= 0 && pageIndex < int(m_pages.size()), "Trying to get a texture of a non-existent texture atlas page.", "Pekan");
+		return m_pages[pageIndex].texture;
+	}
+
+	bool TextureAtlas::applyToSprite(const std::string& name, SpriteComponent& sprite) const
+	{
+		const TextureAtlasRegion* region = getRegion(name);
+		if (region == nullptr)
+		{
+			PK_LOG_ERROR("Trying to apply a non-existent image \"" << name << "\" from a texture atlas to a sprite.", "Pekan");
+			return false;
+		}
+
+		sprite.texture = m_pages[region->pageIndex].texture;
+		sprite.textureCoordinatesMin = region->textureCoordinatesMin;
+		sprite.textureCoordinatesMax = region->textureCoordinatesMax;
+		return true;
+	}
+
+	void TextureAtlas::createPageTextures()
+	{
+		for (Page& page : m_pages)
+		{
+			if (page.texture != nullptr)
+			{
+				continue;
+			}
+			const Graphics::Image pageImage(page.pixels.data(), page.width, page.height, PAGE_NUM_CHANNELS);
+			page.texture = std::make_shared<Graphics::Texture2D>();
+			page.texture->create(pageImage);
+		}
+	}
+
+	void TextureAtlas::computeTextureCoordinates()
+	{
+		for (TextureAtlasRegion& region : m_regions)
+		{
+			const Page& page = m_pages[region.pageIndex];
+			region.textureCoordinatesMin = { float(region.x) / float(page.width), float(region.y) / float(page.height) };
+			region.textureCoordinatesMax = { float(region.x + region.width) / float(page.width), float(region.y + region.height) / float(page.height) };
+		}
+	}
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Texture2D.h"
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace Pekan
+{
+namespace Graphics
+{
+	class Image;
+}
+namespace Renderer2D
+{
+	struct SpriteComponent;
+
+	// A region of a texture atlas, containing a single packed image
+	struct TextureAtlasRegion
+	{
+		// Index of the atlas page containing the region
+		int pageIndex = -1;
+
+		// Position and size of the region inside of its page, in pixels
+		int x = 0;
+		int y = 0;
+		int width = 0;
+		int height = 0;
+
+		// Texture coordinates of the region inside of its page.
+		// Can be directly used as SpriteComponent's textureCoordinatesMin/Max.
+		glm::vec2 textureCoordinatesMin = { 0.0f, 0.0f };
+		glm::vec2 textureCoordinatesMax = { 1.0f, 1.0f };
+	};
+
+	// Properties used for building a texture atlas
+	struct TextureAtlasProperties
+	{
+		// Size of each atlas page, in pixels
+		int pageWidth = 2048;
+		int pageHeight = 2048;
+
+		// Number of pixels of empty space left around each image in the atlas,
+		// so that sampling near the edge of an image doesn't bleed into neighbouring images.
+		int padding = 2;
+
+		// If true, padding around each image will be filled by repeating image's edge pixels,
+		// instead of being left transparent. This avoids seams when sampling with linear filtering.
+		bool extrudeEdges = true;
+	};
+
+	// A class representing a texture atlas - a set of images packed together into one or more large textures (pages).
+	//
+	// Sprites using images from the same atlas page share one texture,
+	// so they can be rendered without switching textures between them.
+	//
+	// Usage:
+	//   1. Add images with addImage()
+	//   2. Pack them with build()
+	//   3. Use getRegion() or applyToSprite() to point sprites to their images inside of the atlas
+	//
+	// A built atlas can be saved to disk with save() and later loaded with load(),
+	// so that the cost of packing can be paid offline.
+	class TextureAtlas
+	{
+	public:
+
+		// Adds an image to be packed into the atlas with the next call to build().
+		// Image's pixel data is copied, so the image doesn't need to outlive this call.
+		// Returns false if the image is invalid or if there is already an image with the same name.
+		bool addImage(const std::string& name, const Graphics::Image& image);
+
+		// Packs all images added since the last call to build() into new atlas pages
+		// and creates a texture for each new page. Already existing pages are left untouched.
+		// Returns true on success.
+		bool build(const TextureAtlasProperties& properties = {});
+
+		// Saves a built atlas to disk.
+		// An index file is written at the given path, containing the regions of all images,
+		// and each page is written as a separate cooked binary file next to it.
+		// Returns true on success.
+		bool save(const char* indexFilepath) const;
+
+		// Loads an atlas previously saved with save() and creates a texture for each page.
+		// Returns true on success.
+		bool load(const char* indexFilepath);
+
+		// Clears all images, regions and pages of the atlas
+		void clear();
+
+		// Returns the region of an image with the given name,
+		// or a null pointer if there is no such image in the atlas.
+		const TextureAtlasRegion* getRegion(const std::string& name) const;
+
+		// Returns the texture of the page with the given index
+		Graphics::Texture2D_ConstPtr getPageTexture(int pageIndex) const;
+
+		int getPagesCount() const { return int(m_pages.size()); }
+		int getRegionsCount() const { return int(m_regions.size()); }
+
+		// Sets texture and texture coordinates of a given sprite
+		// so that it displays the image with the given name from the atlas.
+		// Returns false if there is no such image in the atlas.
+		bool applyToSprite(const std::string& name, SpriteComponent& sprite) const;
+
+		// Checks if atlas is built, meaning that it has at least one page ready to be used
+		bool isBuilt() const { return !m_pages.empty(); }
+
+	private: /* functions */
+
+		// Creates a texture for each page from page's pixel data
+		void createPageTextures();
+
+		// Computes texture coordinates of all regions from their pixel positions and the size of their pages
+		void computeTextureCoordinates();
+
+	private: /* variables */
+
+		// An image added to the atlas, waiting to be packed
+		struct PendingImage
+		{
+			std::string name;
+			int width = 0;
+			int height = 0;
+			// Pixel data of the image, always in RGBA format
+			std::vector<unsigned char> pixels;
+		};
+
+		// A single page of the atlas
+		struct Page
+		{
+			int width = 0;
+			int height = 0;
+			// Pixel data of the page, always in RGBA format
+			std::vector<unsigned char> pixels;
+			Graphics::Texture2D_Ptr texture;
+		};
+
+		// Images added since the last call to build()
+		std::vector<PendingImage> m_pendingImages;
+
+		// Pages of the atlas
+		std::vector<Page> m_pages;
+
+		// Regions of all packed images, and a map from image name to an index into the list of regions
+		std::vector<TextureAtlasRegion> m_regions;
+		std::unordered_map<std::string, size_t> m_regionIndices;
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// A component marking an entity as static, meaning that it doesn't move or change after being baked.
+	//
+	// Static entities are NOT rendered individually each frame.
+	// Instead, their world-space vertices are merged into bake groups (one per material/texture and layer/depth)
+	// which are rendered by the StaticRenderSystem with a single draw call per group.
+	//
+	// NOTE: Either use StaticRenderSystem::makeStatic(), or add this component to entities
+	//       and then call StaticRenderSystem::bake() once they are all set up.
+	struct StaticRenderComponent
+	{
+		// Index of the bake group containing the entity. Managed by the StaticRenderSystem.
+		int bakeGroup = -1;
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,539 @@
+#include "StaticRenderSystem.h"
+
+#include "StaticRenderComponent.h"
+#include "TransformComponent2D.h"
+#include "CameraComponent2D.h"
+#include "SpriteComponent.h"
+#include "SpriteSystem.h"
+#include "SpriteVertex.h"
+#include "RectangleGeometryComponent.h"
+#include "RectangleGeometrySystem.h"
+#include "LineGeometryComponent.h"
+#include "LineGeometrySystem.h"
+#include "CircleGeometryComponent.h"
+#include "CircleGeometrySystem.h"
+#include "TriangleGeometryComponent.h"
+#include "TriangleGeometrySystem.h"
+#include "PolygonGeometryComponent.h"
+#include "PolygonGeometrySystem.h"
+#include "SolidColorMaterialComponent.h"
+#include "RenderOrderComponent2D.h"
+#include "RenderQueue2D.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "RenderCommands.h"
+#include "VertexPacking.h"
+#include "Utils/FileUtils.h"
+#include "PekanLogger.h"
+#include "Entity/DisabledComponent.h"
+
+#include <algorithm>
+
+using namespace Pekan::Graphics;
+
+#define SHAPE_VERTEX_SHADER_FILEPATH PEKAN_RENDERER2D_ROOT_DIR "/Shaders/2D_Shape_SolidColorMaterial_VertexShader.glsl"
+#define SHAPE_FRAGMENT_SHADER_FILEPATH PEKAN_RENDERER2D_ROOT_DIR "/Shaders/2D_Shape_SolidColorMaterial_FragmentShader.glsl"
+#define SPRITE_VERTEX_SHADER_FILEPATH PEKAN_RENDERER2D_ROOT_DIR "/Shaders/2D_Sprite_VertexShader.glsl"
+#define SPRITE_FRAGMENT_SHADER_FILEPATH PEKAN_RENDERER2D_ROOT_DIR "/Shaders/2D_Sprite_FragmentShader.glsl"
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// Texture slot used for the texture of sprite bake groups
+	constexpr int TEXTURE_SLOT = 0;
+
+	// Structure defining the layout of a vertex of a shape with solid color material
+	struct ShapeVertex
+	{
+		glm::vec2 position = { 0.0f, 0.0f };
+		PackedColor color;
+	};
+
+	// Kinds of bake groups, each with its own vertex layout and shader
+	enum class BakeGroupKind
+	{
+		SolidColorShapes,
+		Sprites
+	};
+
+	// Merged mesh of a bake group on the GPU
+	struct BakeGroupMesh
+	{
+		VertexArray vertexArray;
+		VertexBuffer vertexBuffer;
+		IndexBuffer indexBuffer;
+
+		// Number of indices in the index buffer
+		unsigned indicesCount = 0;
+	};
+
+	// Properties that all entities of a bake group share
+	struct BakeGroupKey
+	{
+		BakeGroupKind kind = BakeGroupKind::SolidColorShapes;
+		// Texture shared by all entities in the group. Used only by sprite groups.
+		Texture2D_ConstPtr texture;
+		// Layer and depth shared by all entities in the group (see RenderOrderComponent2D)
+		int layer = 0;
+		float depth = 0.0f;
+		// Blend mode with which the group is rendered.
+		// Sprites are always transparent, and shapes are transparent if their color is.
+		RenderQueueBlendMode blendMode = RenderQueueBlendMode::Opaque;
+
+		bool operator==(const BakeGroupKey& other) const
+		{
+			return kind == other.kind && texture == other.texture && layer == other.layer && depth == other.depth && blendMode == other.blendMode;
+		}
+	};
+
+	// A group of static entities that are rendered together with a single draw call
+	struct BakeGroup
+	{
+		BakeGroupKey key;
+
+		// Entities in the group
+		std::vector<entt::entity> entities;
+
+		// Group's merged mesh, cached here and rebuilt when group is invalidated
+		mutable std::shared_ptr<BakeGroupMesh> mesh;
+		// A flag indicating if group's mesh needs to be rebuilt
+		mutable bool isDirty = true;
+	};
+
+	// All bake groups of a registry. Stored in registry's context.
+	struct StaticRenderBakeGroups
+	{
+		std::vector<BakeGroup> groups;
+	};
+
+	// Shaders shared by all bake groups of each kind
+	static Shader g_shapeShader;
+	static Shader g_spriteShader;
+
+	// Returns the bake groups of a given registry, creating them if they don't exist yet
+	static StaticRenderBakeGroups& getBakeGroups(entt::registry& registry)
+	{
+		if (StaticRenderBakeGroups* bakeGroups = registry.ctx().find<StaticRenderBakeGroups>())
+		{
+			return *bakeGroups;
+		}
+		return registry.ctx().emplace<StaticRenderBakeGroups>();
+	}
+
+	// Checks if a given entity has any of the supported shape geometry components
+	static bool hasShapeGeometry(const entt::registry& registry, entt::entity entity)
+	{
+		return registry.any_of
+		<
+			RectangleGeometryComponent,
+			TriangleGeometryComponent,
+			CircleGeometryComponent,
+			LineGeometryComponent,
+			PolygonGeometryComponent
+		>(entity);
+	}
+
+	// Determines the key of the bake group that a given entity belongs to.
+	// Returns false if entity can't be baked.
+	static bool getBakeGroupKey(const entt::registry& registry, entt::entity entity, BakeGroupKey& key)
+	{
+		if (const SpriteComponent* sprite = registry.try_get<SpriteComponent>(entity))
+		{
+			if (sprite->texture == nullptr || !sprite->texture->isValid())
+			{
+				return false;
+			}
+			key.kind = BakeGroupKind::Sprites;
+			key.texture = sprite->texture;
+			key.blendMode = sprite->texture->isOpaque() ? RenderQueueBlendMode::Opaque : RenderQueueBlendMode::Transparent;
+		}
+		else if (registry.all_of<SolidColorMaterialComponent>(entity) && hasShapeGeometry(registry, entity))
+		{
+			key.kind = BakeGroupKind::SolidColorShapes;
+			key.texture = nullptr;
+			const bool isTransparent = registry.get<SolidColorMaterialComponent>(entity).color.a < 1.0f;
+			key.blendMode = isTransparent ? RenderQueueBlendMode::Transparent : RenderQueueBlendMode::Opaque;
+		}
+		else
+		{
+			return false;
+		}
+
+		const RenderOrderComponent2D* renderOrder = registry.try_get<RenderOrderComponent2D>(entity);
+		key.layer = (renderOrder != nullptr) ? renderOrder->layer : 0;
+		key.depth = (renderOrder != nullptr) ? renderOrder->depth : 0.0f;
+		return true;
+	}
+
+	// Returns the index of the bake group with a given key, creating the group if it doesn't exist
+	static int findOrCreateBakeGroup(StaticRenderBakeGroups& bakeGroups, const BakeGroupKey& key)
+	{
+		for (size_t i = 0; i < bakeGroups.groups.size(); i++)
+		{
+			if (bakeGroups.groups[i].key == key)
+			{
+				return int(i);
+			}
+		}
+		BakeGroup group;
+		group.key = key;
+		bakeGroups.groups.push_back(std::move(group));
+		return int(bakeGroups.groups.size() - 1);
+	}
+
+	// Removes a given entity from a given bake group
+	static void removeFromBakeGroup(BakeGroup& group, entt::entity entity)
+	{
+		const auto it = std::find(group.entities.begin(), group.entities.end(), entity);
+		if (it != group.entities.end())
+		{
+			group.entities.erase(it);
+		}
+		group.isDirty = true;
+	}
+
+	// Appends world-space vertices and indices of a given entity with a shape geometry and a solid color material
+	static void appendShapeVertices(const entt::registry& registry, entt::entity entity, std::vector<ShapeVertex>& vertices, std::vector<unsigned>& indices)
+	{
+		const bool hasTransform = registry.all_of<TransformComponent2D>(entity);
+		const size_t firstVertex = vertices.size();
+		const int vertexSize = sizeof(ShapeVertex);
+		const int positionOffset = offsetof(ShapeVertex, position);
+
+		int verticesCount = 0;
+		std::vector<unsigned> shapeIndices;
+		if (registry.all_of<RectangleGeometryComponent>(entity))
+		{
+			verticesCount = 4;
+			vertices.resize(firstVertex + verticesCount);
+			const auto getter = hasTransform ? RectangleGeometrySystem::getVertexPositionsWorld : RectangleGeometrySystem::getVertexPositionsLocal;
+			getter(registry, entity, vertices.data() + firstVertex, vertexSize, positionOffset);
+			shapeIndices = { 0, 1, 2, 0, 2, 3 };
+		}
+		else if (registry.all_of<TriangleGeometryComponent>(entity))
+		{
+			verticesCount = 3;
+			vertices.resize(firstVertex + verticesCount);
+			const auto getter = hasTransform ? TriangleGeometrySystem::getVertexPositionsWorld : TriangleGeometrySystem::getVertexPositionsLocal;
+			getter(registry, entity, vertices.data() + firstVertex, vertexSize, positionOffset);
+			shapeIndices = { 0, 1, 2 };
+		}
+		else if (registry.all_of<LineGeometryComponent>(entity))
+		{
+			// Lines are rendered as thin rectangles
+			verticesCount = 4;
+			vertices.resize(firstVertex + verticesCount);
+			const auto getter = hasTransform ? LineGeometrySystem::getVertexPositionsWorld : LineGeometrySystem::getVertexPositionsLocal;
+			getter(registry, entity, vertices.data() + firstVertex, vertexSize, positionOffset);
+			shapeIndices = { 0, 1, 2, 0, 2, 3 };
+		}
+		else if (registry.all_of<CircleGeometryComponent>(entity))
+		{
+			// Number of vertices is equal to number of segments
+			verticesCount = registry.get<CircleGeometryComponent>(entity).segmentsCount;
+			vertices.resize(firstVertex + verticesCount);
+			const auto getter = hasTransform ? CircleGeometrySystem::getVertexPositionsAndIndicesWorld : CircleGeometrySystem::getVertexPositionsAndIndicesLocal;
+			getter(registry, entity, vertices.data() + firstVertex, verticesCount, vertexSize, positionOffset, shapeIndices);
+		}
+		else if (registry.all_of<PolygonGeometryComponent>(entity))
+		{
+			verticesCount = int(registry.get<PolygonGeometryComponent>(entity).vertexPositions.size());
+			vertices.resize(firstVertex + verticesCount);
+			const auto getter = hasTransform ? PolygonGeometrySystem::getVertexPositionsAndIndicesWorld : PolygonGeometrySystem::getVertexPositionsAndIndicesLocal;
+			getter(registry, entity, vertices.data() + firstVertex, verticesCount, vertexSize, positionOffset, shapeIndices);
+		}
+		else
+		{
+			return;
+		}
+
+		// Set vertex colors using entity's material
+		const SolidColorMaterialComponent& material = registry.get<SolidColorMaterialComponent>(entity);
+		material.getVertexColors(vertices.data() + firstVertex, verticesCount, vertexSize, offsetof(ShapeVertex, color));
+
+		// Append shape's indices, offset by the index of shape's first vertex in the merged mesh
+		for (unsigned index : shapeIndices)
+		{
+			indices.push_back(unsigned(firstVertex) + index);
+		}
+	}
+
+	// Uploads given vertices and indices to a given bake group's mesh, creating the mesh if it doesn't exist yet
+	template<typename VertexType>
+	static void uploadMesh(const BakeGroup& group, const std::vector<VertexType>& vertices, const std::vector<unsigned>& indices, const VertexBufferLayout& layout)
+	{
+		if (group.mesh == nullptr)
+		{
+			group.mesh = std::make_shared<BakeGroupMesh>();
+			group.mesh->vertexArray.create();
+			group.mesh->vertexBuffer.create(vertices.data(), sizeof(VertexType) * vertices.size(), BufferDataUsage::StaticDraw);
+			group.mesh->vertexArray.addVertexBuffer(group.mesh->vertexBuffer, layout);
+			group.mesh->indexBuffer.create();
+			group.mesh->indexBuffer.setIndices(indices.data(), indices.size(), BufferDataUsage::StaticDraw);
+		}
+		else
+		{
+			group.mesh->vertexArray.bind();
+			group.mesh->vertexBuffer.setData(vertices.data(), sizeof(VertexType) * vertices.size(), BufferDataUsage::StaticDraw);
+			group.mesh->indexBuffer.setIndices(indices.data(), indices.size(), BufferDataUsage::StaticDraw);
+		}
+		group.mesh->indicesCount = unsigned(indices.size());
+	}
+
+	// Checks if a given entity of a bake group should be included in group's mesh
+	static bool shouldBeBaked(const entt::registry& registry, entt::entity entity)
+	{
+		return registry.valid(entity) && !registry.all_of<DisabledComponent>(entity) && registry.all_of<StaticRenderComponent>(entity);
+	}
+
+	// Rebuilds the merged mesh of a given bake group from its entities
+	static void rebuildBakeGroup(const entt::registry& registry, const BakeGroup& group)
+	{
+		std::vector<unsigned> indices;
+		if (group.key.kind == BakeGroupKind::SolidColorShapes)
+		{
+			std::vector<ShapeVertex> vertices;
+			for (entt::entity entity : group.entities)
+			{
+				if (shouldBeBaked(registry, entity) && registry.all_of<SolidColorMaterialComponent>(entity))
+				{
+					appendShapeVertices(registry, entity, vertices, indices);
+				}
+			}
+			uploadMesh(group, vertices, indices, { { ShaderDataType::Float2, "position" }, { ShaderDataType::UByte4Normalized, "color" } });
+		}
+		else
+		{
+			std::vector<SpriteVertex> vertices;
+			vertices.reserve(group.entities.size() * 4);
+			indices.reserve(group.entities.size() * 6);
+			for (entt::entity entity : group.entities)
+			{
+				if (!shouldBeBaked(registry, entity) || !registry.all_of<SpriteComponent>(entity))
+				{
+					continue;
+				}
+				const unsigned firstVertex = unsigned(vertices.size());
+				vertices.resize(vertices.size() + 4);
+				SpriteSystem::getVertices(registry, entity, vertices.data() + firstVertex);
+				indices.insert(indices.end(), { firstVertex + 0, firstVertex + 1, firstVertex + 2, firstVertex + 0, firstVertex + 2, firstVertex + 3 });
+			}
+			uploadMesh(group, vertices, indices, { { ShaderDataType::Float2, "position" }, { ShaderDataType::Float2, "textureCoordinates" } });
+		}
+
+		group.isDirty = false;
+	}
+
+	// Adds a given entity to the bake group it belongs to. Returns false if entity can't be baked.
+	static bool addToBakeGroup(entt::registry& registry, StaticRenderBakeGroups& bakeGroups, entt::entity entity)
+	{
+		BakeGroupKey key;
+		if (!getBakeGroupKey(registry, entity, key))
+		{
+			return false;
+		}
+
+		const int groupIndex = findOrCreateBakeGroup(bakeGroups, key);
+		BakeGroup& group = bakeGroups.groups[groupIndex];
+		group.entities.push_back(entity);
+		group.isDirty = true;
+
+		registry.emplace_or_replace<StaticRenderComponent>(entity, StaticRenderComponent{ groupIndex });
+		return true;
+	}
+
+	void StaticRenderSystem::bake(entt::registry& registry)
+	{
+		StaticRenderBakeGroups& bakeGroups = getBakeGroups(registry);
+		for (BakeGroup& group : bakeGroups.groups)
+		{
+			group.entities.clear();
+			group.isDirty = true;
+		}
+
+		// Collect entities first, since adding them to groups replaces their StaticRenderComponent
+		std::vector<entt::entity> entities;
+		const auto view = registry.view<StaticRenderComponent>();
+		entities.assign(view.begin(), view.end());
+
+		for (entt::entity entity : entities)
+		{
+			if (!addToBakeGroup(registry, bakeGroups, entity))
+			{
+				PK_LOG_WARNING("An entity with StaticRenderComponent cannot be baked, so it will be rendered as a dynamic entity.", "Pekan");
+				registry.remove<StaticRenderComponent>(entity);
+			}
+		}
+	}
+
+	bool StaticRenderSystem::makeStatic(entt::registry& registry, entt::entity entity)
+	{
+		PK_ASSERT(registry.valid(entity), "Trying to make static an entity that doesn't exist.", "Pekan");
+
+		if (registry.all_of<StaticRenderComponent>(entity))
+		{
+			invalidate(registry, entity);
+			return true;
+		}
+
+		StaticRenderBakeGroups& bakeGroups = getBakeGroups(registry);
+		if (!addToBakeGroup(registry, bakeGroups, entity))
+		{
+			PK_LOG_ERROR("Trying to make static an entity that is neither a sprite with a valid texture nor a shape with a solid color material.", "Pekan");
+			return false;
+		}
+		return true;
+	}
+
+	void StaticRenderSystem::makeDynamic(entt::registry& registry, entt::entity entity)
+	{
+		const StaticRenderComponent* staticRender = registry.try_get<StaticRenderComponent>(entity);
+		if (staticRender == nullptr)
+		{
+			return;
+		}
+
+		StaticRenderBakeGroups& bakeGroups = getBakeGroups(registry);
+		if (staticRender->bakeGroup >= 0 && staticRender->bakeGroup < int(bakeGroups.groups.size()))
+		{
+			removeFromBakeGroup(bakeGroups.groups[staticRender->bakeGroup], entity);
+		}
+		registry.remove<StaticRenderComponent>(entity);
+	}
+
+	void StaticRenderSystem::invalidate(entt::registry& registry, entt::entity entity)
+	{
+		const StaticRenderComponent* staticRender = registry.try_get<StaticRenderComponent>(entity);
+		if (staticRender == nullptr)
+		{
+			PK_LOG_WARNING("Trying to invalidate an entity that is not static.", "Pekan");
+			return;
+		}
+
+		StaticRenderBakeGroups& bakeGroups = getBakeGroups(registry);
+		const int oldGroupIndex = staticRender->bakeGroup;
+		PK_ASSERT(oldGroupIndex >= 0 && oldGroupIndex < int(bakeGroups.groups.size()), "A static entity has an invalid bake group.", "Pekan");
+
+		// Check if entity still belongs to the same group
+		BakeGroupKey key;
+		if (getBakeGroupKey(registry, entity, key))
+		{
+			const BakeGroup& oldGroup = bakeGroups.groups[oldGroupIndex];
+			if (oldGroup.key == key)
+			{
+				oldGroup.isDirty = true;
+				return;
+			}
+		}
+
+		// Entity doesn't belong to its group anymore, so move it to the group it belongs to now
+		removeFromBakeGroup(bakeGroups.groups[oldGroupIndex], entity);
+		if (!addToBakeGroup(registry, bakeGroups, entity))
+		{
+			PK_LOG_WARNING("A static entity cannot be baked anymore, so it will be rendered as a dynamic entity.", "Pekan");
+			registry.remove<StaticRenderComponent>(entity);
+		}
+	}
+
+	// Renders the bake group of a given static entity at a given clip-space depth. Called by the render queue.
+	static void renderBakeGroup(const entt::registry& registry, entt::entity entity, float depth)
+	{
+		const StaticRenderBakeGroups& bakeGroups = registry.ctx().get<StaticRenderBakeGroups>();
+		const BakeGroup& group = bakeGroups.groups[registry.get<StaticRenderComponent>(entity).bakeGroup];
+
+		if (group.key.kind == BakeGroupKind::Sprites)
+		{
+			g_spriteShader.bind();
+			g_spriteShader.setUniform1f("uDepth", depth);
+			group.key.texture->bind(TEXTURE_SLOT);
+		}
+		else
+		{
+			g_shapeShader.bind();
+			g_shapeShader.setUniform1f("uDepth", depth);
+		}
+		group.mesh->vertexArray.bind();
+		group.mesh->indexBuffer.bind();
+		RenderCommands::drawIndexed(group.mesh->indicesCount, DrawMode::Triangles, group.mesh->indexBuffer.getIndexType());
+	}
+
+	void StaticRenderSystem::submit(const entt::registry& registry, const CameraComponent2D* camera, RenderQueue2D& renderQueue)
+	{
+		PK_ASSERT(camera != nullptr, "Cannot render static entities without a camera.", "Pekan");
+
+		const StaticRenderBakeGroups* bakeGroups = registry.ctx().find<StaticRenderBakeGroups>();
+		if (bakeGroups == nullptr)
+		{
+			return;
+		}
+
+		if (!g_shapeShader.isValid())
+		{
+			g_shapeShader.create
+			(
+				FileUtils::readTextFileToString(SHAPE_VERTEX_SHADER_FILEPATH).c_str(),
+				FileUtils::readTextFileToString(SHAPE_FRAGMENT_SHADER_FILEPATH).c_str()
+			);
+		}
+		if (!g_spriteShader.isValid())
+		{
+			g_spriteShader.create
+			(
+				FileUtils::readTextFileToString(SPRITE_VERTEX_SHADER_FILEPATH).c_str(),
+				FileUtils::readTextFileToString(SPRITE_FRAGMENT_SHADER_FILEPATH).c_str()
+			);
+		}
+		const glm::mat4 viewProjectionMatrix = camera->getViewProjectionMatrix();
+		g_shapeShader.setUniformMatrix4fv("uViewProjectionMatrix", viewProjectionMatrix);
+		g_spriteShader.setUniformMatrix4fv("uViewProjectionMatrix", viewProjectionMatrix);
+		g_spriteShader.setUniform1i("uTexture", TEXTURE_SLOT);
+
+		for (const BakeGroup& group : bakeGroups->groups)
+		{
+			if (group.entities.empty())
+			{
+				continue;
+			}
+			if (group.isDirty || group.mesh == nullptr)
+			{
+				rebuildBakeGroup(registry, group);
+			}
+			if (group.mesh->indicesCount == 0)
+			{
+				continue;
+			}
+
+			// Submit group through one of its entities. All of them share group's layer and depth,
+			// so the render queue renders the whole group at their depth.
+			const auto itEntity = std::find_if
+			(
+				group.entities.begin(), group.entities.end(),
+				[&registry](entt::entity entity) { return shouldBeBaked(registry, entity); }
+			);
+			if (itEntity == group.entities.end())
+			{
+				continue;
+			}
+			const RenderQueueShader shader = (group.key.kind == BakeGroupKind::Sprites) ? RenderQueueShader::StaticSprites : RenderQueueShader::StaticShapes;
+			renderQueue.submit(registry, *itEntity, renderBakeGroup, group.key.blendMode, shader, group.key.texture.get());
+		}
+	}
+
+	void StaticRenderSystem::exit()
+	{
+		if (g_shapeShader.isValid())
+		{
+			g_shapeShader.destroy();
+		}
+		if (g_spriteShader.isValid())
+		{
+			g_spriteShader.destroy();
+		}
+	}
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+	struct CameraComponent2D;
+	class RenderQueue2D;
+
+	// A system for baking static entities into a few merged meshes.
+	//
+	// Supported entities are sprites, and shapes (rectangle, triangle, circle, line and polygon geometry)
+	// with a solid color material. Static shapes are grouped by their layer and depth (see RenderOrderComponent2D),
+	// and static sprites by their texture, layer and depth, so that each group is rendered at a single depth.
+	// A bake group's mesh is rebuilt only when the group is invalidated.
+	class StaticRenderSystem
+	{
+	public:
+
+		// Marks all entities that have a StaticRenderComponent as static and (re)builds all bake groups.
+		// Can be used as a scene-level bake step after loading a scene.
+		static void bake(entt::registry& registry);
+
+		// Marks a given entity as static, adding it to the appropriate bake group.
+		// Returns false if the entity is not of a supported kind.
+		static bool makeStatic(entt::registry& registry, entt::entity entity);
+		// Marks a given static entity as dynamic again, removing it from its bake group.
+		static void makeDynamic(entt::registry& registry, entt::entity entity);
+
+		// Invalidates the bake group of a given static entity, so that it's rebuilt the next time it's rendered.
+		// Must be called after modifying a static entity in any way, including enabling/disabling it.
+		// Before destroying a static entity, call makeDynamic() on it instead.
+		// If the entity now belongs to a different bake group (for example its texture was changed),
+		// it is moved there and both groups are invalidated.
+		static void invalidate(entt::registry& registry, entt::entity entity);
+
+		// Submits all bake groups of the given registry to a given render queue, rebuilding invalidated ones first,
+		// so that each group is rendered at its layer and depth, ordered together with dynamic entities.
+		static void submit(const entt::registry& registry, const CameraComponent2D* camera, RenderQueue2D& renderQueue);
+
+		// Releases GPU resources shared by all bake groups
+		static void exit();
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
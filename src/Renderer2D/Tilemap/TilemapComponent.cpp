@@ -0,0 +1,121 @@
+#include "TilemapComponent.h"
+
+#include "PekanLogger.h"
+
+#include <algorithm>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// Returns number of chunks needed to cover a given number of tiles
+	static int getChunksCountFor(int tilesCount)
+	{
+		return (tilesCount + TILEMAP_CHUNK_SIZE - 1) / TILEMAP_CHUNK_SIZE;
+	}
+
+	void TilemapComponent::resize(int width, int height)
+	{
+		PK_ASSERT(width >= 0 && height >= 0, "Trying to resize a tilemap to a negative size.", "Pekan");
+
+		const int chunksCountX = getChunksCountFor(width);
+		const int chunksCountY = getChunksCountFor(height);
+
+		// Move already existing chunks that remain inside of the new size to their new place
+		std::vector<TilemapChunk> chunks(size_t(chunksCountX) * size_t(chunksCountY));
+		for (int chunkY = 0; chunkY < std::min(chunksCountY, m_chunksCountY); chunkY++)
+		{
+			for (int chunkX = 0; chunkX < std::min(chunksCountX, m_chunksCountX); chunkX++)
+			{
+				chunks[chunkY * chunksCountX + chunkX] = std::move(m_chunks[chunkY * m_chunksCountX + chunkX]);
+			}
+		}
+		m_chunks = std::move(chunks);
+		m_chunksCountX = chunksCountX;
+		m_chunksCountY = chunksCountY;
+
+		// Clear tiles that end up outside of the new size but inside of a preserved chunk
+		const int oldWidth = m_width;
+		const int oldHeight = m_height;
+		m_width = width;
+		m_height = height;
+		for (int y = 0; y < m_chunksCountY * TILEMAP_CHUNK_SIZE; y++)
+		{
+			for (int x = 0; x < m_chunksCountX * TILEMAP_CHUNK_SIZE; x++)
+			{
+				const bool wasInside = x < oldWidth && y < oldHeight;
+				const bool isInside = x < width && y < height;
+				if (wasInside && !isInside)
+				{
+					TilemapChunk& chunk = m_chunks[(y / TILEMAP_CHUNK_SIZE) * m_chunksCountX + (x / TILEMAP_CHUNK_SIZE)];
+					chunk.tiles[(y % TILEMAP_CHUNK_SIZE) * TILEMAP_CHUNK_SIZE + (x % TILEMAP_CHUNK_SIZE)] = EMPTY_TILE;
+					chunk.isMeshDirty = true;
+				}
+			}
+		}
+	}
+
+	void TilemapComponent::setTile(int x, int y, TileID tile)
+	{
+		PK_ASSERT(tile == EMPTY_TILE || (tile >= 0 && tile < int(tileTextureCoordinates.size())), "Trying to set an unknown tile ID to a tilemap.", "Pekan");
+
+		int tileIndexInChunk = 0;
+		TilemapChunk& chunk = getChunkOfTile(x, y, tileIndexInChunk);
+		if (chunk.tiles[tileIndexInChunk] != tile)
+		{
+			chunk.tiles[tileIndexInChunk] = tile;
+			chunk.isMeshDirty = true;
+		}
+	}
+
+	TileID TilemapComponent::getTile(int x, int y) const
+	{
+		PK_ASSERT(x >= 0 && x < m_width && y >= 0 && y < m_height, "Trying to get a tile outside of a tilemap.", "Pekan");
+
+		const TilemapChunk& chunk = m_chunks[(y / TILEMAP_CHUNK_SIZE) * m_chunksCountX + (x / TILEMAP_CHUNK_SIZE)];
+		return chunk.tiles[(y % TILEMAP_CHUNK_SIZE) * TILEMAP_CHUNK_SIZE + (x % TILEMAP_CHUNK_SIZE)];
+	}
+
+	void TilemapComponent::fill(TileID tile)
+	{
+		for (int y = 0; y < m_height; y++)
+		{
+			for (int x = 0; x < m_width; x++)
+			{
+				setTile(x, y, tile);
+			}
+		}
+	}
+
+	TileID TilemapComponent::addTileType(glm::vec2 textureCoordinatesMin, glm::vec2 textureCoordinatesMax)
+	{
+		tileTextureCoordinates.push_back({ textureCoordinatesMin, textureCoordinatesMax });
+		return TileID(tileTextureCoordinates.size() - 1);
+	}
+
+	void TilemapComponent::invalidate()
+	{
+		for (TilemapChunk& chunk : m_chunks)
+		{
+			chunk.isMeshDirty = true;
+		}
+	}
+
+	const TilemapChunk& TilemapComponent::getChunk(int chunkX, int chunkY) const
+	{
+		PK_ASSERT(chunkX >= 0 && chunkX < m_chunksCountX && chunkY >= 0 && chunkY < m_chunksCountY, "Trying to get a chunk outside of a tilemap.", "Pekan");
+
+		return m_chunks[chunkY * m_chunksCountX + chunkX];
+	}
+
+	TilemapChunk& TilemapComponent::getChunkOfTile(int x, int y, int& tileIndexInChunk)
+	{
+		PK_ASSERT(x >= 0 && x < m_width && y >= 0 && y < m_height, "Trying to access a tile outside of a tilemap.", "Pekan");
+
+		tileIndexInChunk = (y % TILEMAP_CHUNK_SIZE) * TILEMAP_CHUNK_SIZE + (x % TILEMAP_CHUNK_SIZE);
+		return m_chunks[(y / TILEMAP_CHUNK_SIZE) * m_chunksCountX + (x / TILEMAP_CHUNK_SIZE)];
+	}
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
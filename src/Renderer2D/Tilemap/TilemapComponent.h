@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Texture2D.h"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// ID of a tile inside of a tilemap. It is an index into tilemap's list of tile texture coordinates.
+	typedef int TileID;
+	// Tile ID of an empty tile, which is not rendered
+	constexpr TileID EMPTY_TILE = -1;
+
+	// Number of tiles along each side of a tilemap chunk
+	constexpr int TILEMAP_CHUNK_SIZE = 32;
+
+	// Mesh of a tilemap chunk on the GPU. Defined and managed by the TilemapSystem.
+	struct TilemapChunkMesh;
+
+	// A square block of TILEMAP_CHUNK_SIZE x TILEMAP_CHUNK_SIZE tiles of a tilemap.
+	// Each chunk is rendered from its own static mesh, which is rebuilt only when a tile in the chunk changes.
+	struct TilemapChunk
+	{
+		TilemapChunk() = default;
+		// A copied chunk gets its own mesh, so that changing the copy doesn't affect the original
+		TilemapChunk(const TilemapChunk& other) : tiles(other.tiles) {}
+		TilemapChunk& operator=(const TilemapChunk& other)
+		{
+			tiles = other.tiles;
+			mesh = nullptr;
+			isMeshDirty = true;
+			return *this;
+		}
+		TilemapChunk(TilemapChunk&& other) = default;
+		TilemapChunk& operator=(TilemapChunk&& other) = default;
+
+		// Tile IDs of chunk's tiles, row by row, starting from the bottom-left tile
+		std::vector<TileID> tiles = std::vector<TileID>(TILEMAP_CHUNK_SIZE * TILEMAP_CHUNK_SIZE, EMPTY_TILE);
+
+		// Chunk's mesh, cached here by the TilemapSystem
+		mutable std::shared_ptr<TilemapChunkMesh> mesh;
+		// A flag indicating if chunk's mesh needs to be rebuilt because a tile in the chunk has changed
+		mutable bool isMeshDirty = true;
+	};
+
+	// Texture coordinates of a tile type inside of tilemap's texture
+	struct TileTextureCoordinates
+	{
+		glm::vec2 min = { 0.0f, 0.0f };
+		glm::vec2 max = { 1.0f, 1.0f };
+	};
+
+	// A component for a grid of tiles, rendered with a few draw calls instead of one entity per tile.
+	//
+	// Tile (0, 0) is at the local origin and tiles extend towards positive X and Y.
+	// If the entity has a transform, it is applied to the whole tilemap.
+	struct TilemapComponent
+	{
+	/* data */
+
+		// Size of a single tile, in local space
+		float tileWidth = 1.0f;
+		float tileHeight = 1.0f;
+
+		// Texture containing the images of all tile types, usually a texture atlas page
+		Graphics::Texture2D_ConstPtr texture;
+
+		// Texture coordinates of each tile type inside of the texture.
+		// A tile ID is an index into this list.
+		//
+		// NOTE: If you change this list or the tile size after tiles have been rendered,
+		//       call invalidate() so that all chunks are rebuilt.
+		std::vector<TileTextureCoordinates> tileTextureCoordinates;
+
+	/* functions */
+
+		// Resizes the tilemap to a given number of tiles in each direction.
+		// Tiles that remain inside of the new size are preserved, and new tiles are empty.
+		void resize(int width, int height);
+
+		// Sets the tile at a given position in the tilemap, marking its chunk as needing a rebuild
+		void setTile(int x, int y, TileID tile);
+		// Returns the tile at a given position in the tilemap
+		TileID getTile(int x, int y) const;
+
+		// Sets all tiles of the tilemap to a given tile
+		void fill(TileID tile);
+
+		// Adds a new tile type with given texture coordinates, and returns its tile ID
+		TileID addTileType(glm::vec2 textureCoordinatesMin, glm::vec2 textureCoordinatesMax);
+
+		// Marks all chunks as needing a rebuild
+		void invalidate();
+
+		// Returns size of the tilemap, in tiles
+		int getWidth() const { return m_width; }
+		int getHeight() const { return m_height; }
+
+		// Returns number of chunks in each direction
+		int getChunksCountX() const { return m_chunksCountX; }
+		int getChunksCountY() const { return m_chunksCountY; }
+
+		// Returns the chunk at a given chunk position
+		const TilemapChunk& getChunk(int chunkX, int chunkY) const;
+
+	private: /* functions */
+
+		// Returns the chunk containing the tile at a given position, and the index of the tile inside of the chunk
+		TilemapChunk& getChunkOfTile(int x, int y, int& tileIndexInChunk);
+
+	private: /* variables */
+
+		// Size of the tilemap, in tiles
+		int m_width = 0;
+		int m_height = 0;
+
+		// Number of chunks in each direction
+		int m_chunksCountX = 0;
+		int m_chunksCountY = 0;
+
+		// Chunks of the tilemap, row by row, starting from the bottom-left chunk
+		std::vector<TilemapChunk> m_chunks;
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
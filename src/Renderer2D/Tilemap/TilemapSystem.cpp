@@ -0,0 +1,267 @@
+#include "TilemapSystem.h"
+
+#include "TilemapComponent.h"
+#include "TransformComponent2D.h"
+#include "TransformSystem2D.h"
+#include "CameraComponent2D.h"
+#include "RenderQueue2D.h"
+#include "SpriteVertex.h"
+#include "VertexArray.h"
+#include "VertexBuffer.h"
+#include "IndexBuffer.h"
+#include "Shader.h"
+#include "RenderCommands.h"
+#include "Utils/FileUtils.h"
+#include "PekanLogger.h"
+#include "Entity/DisabledComponent.h"
+
+#include <algorithm>
+
+using namespace Pekan::Graphics;
+
+#define VERTEX_SHADER_FILEPATH PEKAN_RENDERER2D_ROOT_DIR "/Shaders/2D_Tilemap_VertexShader.glsl"
+#define FRAGMENT_SHADER_FILEPATH PEKAN_RENDERER2D_ROOT_DIR "/Shaders/2D_Sprite_FragmentShader.glsl"
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+
+	// Texture slot used for tilemap's texture
+	constexpr int TEXTURE_SLOT = 0;
+
+	// Mesh of a tilemap chunk on the GPU, containing a quad for each non-empty tile of the chunk
+	struct TilemapChunkMesh
+	{
+		VertexArray vertexArray;
+		VertexBuffer vertexBuffer;
+		IndexBuffer indexBuffer;
+
+		// Number of indices in the index buffer
+		unsigned indicesCount = 0;
+	};
+
+	// Shader shared by all tilemaps
+	static Shader g_shader;
+
+	// An axis-aligned bounding box in world space
+	struct BoundingBox
+	{
+		glm::vec2 min;
+		glm::vec2 max;
+	};
+
+	// Bounding box of the area visible by current camera, cached here when tilemaps are submitted for rendering
+	static BoundingBox g_cameraBox = { glm::vec2(0.0f), glm::vec2(0.0f) };
+
+	// Returns a 4x4 matrix doing the same 2D transformation as a given 3x3 matrix
+	static glm::mat4 toMat4(const glm::mat3& matrix)
+	{
+		glm::mat4 result(1.0f);
+		result[0] = glm::vec4(matrix[0].x, matrix[0].y, 0.0f, 0.0f);
+		result[1] = glm::vec4(matrix[1].x, matrix[1].y, 0.0f, 0.0f);
+		result[3] = glm::vec4(matrix[2].x, matrix[2].y, 0.0f, 1.0f);
+		return result;
+	}
+
+	// Returns the bounding box of a given rectangle in local space, after being transformed by a given world matrix
+	static BoundingBox getWorldBoundingBox(glm::vec2 localMin, glm::vec2 localMax, const glm::mat3& worldMatrix)
+	{
+		const glm::vec2 corners[4] =
+		{
+			glm::vec2(worldMatrix * glm::vec3(localMin.x, localMin.y, 1.0f)),
+			glm::vec2(worldMatrix * glm::vec3(localMax.x, localMin.y, 1.0f)),
+			glm::vec2(worldMatrix * glm::vec3(localMax.x, localMax.y, 1.0f)),
+			glm::vec2(worldMatrix * glm::vec3(localMin.x, localMax.y, 1.0f))
+		};
+		BoundingBox box = { corners[0], corners[0] };
+		for (int i = 1; i < 4; i++)
+		{
+			box.min = glm::min(box.min, corners[i]);
+			box.max = glm::max(box.max, corners[i]);
+		}
+		return box;
+	}
+
+	// Returns the bounding box of the area visible by a given camera, in world space
+	static BoundingBox getCameraBoundingBox(const CameraComponent2D& camera)
+	{
+		const glm::vec2 corners[4] =
+		{
+			camera.ndcToWorldPosition({ -1.0f, -1.0f }),
+			camera.ndcToWorldPosition({ 1.0f, -1.0f }),
+			camera.ndcToWorldPosition({ 1.0f, 1.0f }),
+			camera.ndcToWorldPosition({ -1.0f, 1.0f })
+		};
+		BoundingBox box = { corners[0], corners[0] };
+		for (int i = 1; i < 4; i++)
+		{
+			box.min = glm::min(box.min, corners[i]);
+			box.max = glm::max(box.max, corners[i]);
+		}
+		return box;
+	}
+
+	// Checks if two given bounding boxes overlap
+	static bool doOverlap(const BoundingBox& a, const BoundingBox& b)
+	{
+		return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+	}
+
+	// Rebuilds the mesh of a given chunk of a given tilemap from chunk's tiles, in tilemap's local space
+	static void rebuildChunkMesh(const TilemapComponent& tilemap, const TilemapChunk& chunk, int chunkX, int chunkY)
+	{
+		std::vector<SpriteVertex> vertices;
+		std::vector<unsigned> indices;
+		vertices.reserve(chunk.tiles.size() * 4);
+		indices.reserve(chunk.tiles.size() * 6);
+
+		const int tilesCount = int(tilemap.tileTextureCoordinates.size());
+		for (int tileY = 0; tileY < TILEMAP_CHUNK_SIZE; tileY++)
+		{
+			for (int tileX = 0; tileX < TILEMAP_CHUNK_SIZE; tileX++)
+			{
+				const TileID tile = chunk.tiles[tileY * TILEMAP_CHUNK_SIZE + tileX];
+				if (tile == EMPTY_TILE || tile < 0 || tile >= tilesCount)
+				{
+					continue;
+				}
+				const TileTextureCoordinates& uv = tilemap.tileTextureCoordinates[tile];
+
+				// Position of tile's bottom-left corner in tilemap's local space
+				const float x = float(chunkX * TILEMAP_CHUNK_SIZE + tileX) * tilemap.tileWidth;
+				const float y = float(chunkY * TILEMAP_CHUNK_SIZE + tileY) * tilemap.tileHeight;
+
+				const unsigned firstVertex = unsigned(vertices.size());
+				vertices.push_back({ { x, y }, { uv.min.x, uv.min.y } });
+				vertices.push_back({ { x + tilemap.tileWidth, y }, { uv.max.x, uv.min.y } });
+				vertices.push_back({ { x + tilemap.tileWidth, y + tilemap.tileHeight }, { uv.max.x, uv.max.y } });
+				vertices.push_back({ { x, y + tilemap.tileHeight }, { uv.min.x, uv.max.y } });
+				indices.insert(indices.end(), { firstVertex + 0, firstVertex + 1, firstVertex + 2, firstVertex + 0, firstVertex + 2, firstVertex + 3 });
+			}
+		}
+
+		// Create chunk's mesh the first time it's built, and after that only replace its data
+		if (chunk.mesh == nullptr)
+		{
+			chunk.mesh = std::make_shared<TilemapChunkMesh>();
+			chunk.mesh->vertexArray.create();
+			chunk.mesh->vertexBuffer.create(vertices.data(), sizeof(SpriteVertex) * vertices.size(), BufferDataUsage::StaticDraw);
+			chunk.mesh->vertexArray.addVertexBuffer
+			(
+				chunk.mesh->vertexBuffer,
+				{
+					{ ShaderDataType::Float2, "position" },
+					{ ShaderDataType::Float2, "textureCoordinates" }
+				}
+			);
+			chunk.mesh->indexBuffer.create();
+			chunk.mesh->indexBuffer.setIndices(indices.data(), indices.size(), BufferDataUsage::StaticDraw);
+		}
+		else
+		{
+			chunk.mesh->vertexArray.bind();
+			chunk.mesh->vertexBuffer.setData(vertices.data(), sizeof(SpriteVertex) * vertices.size(), BufferDataUsage::StaticDraw);
+			chunk.mesh->indexBuffer.setIndices(indices.data(), indices.size(), BufferDataUsage::StaticDraw);
+		}
+		chunk.mesh->indicesCount = unsigned(indices.size());
+
+		chunk.isMeshDirty = false;
+	}
+
+	// Renders all visible chunks of a given tilemap with a given world matrix, at a given clip-space depth
+	static void renderTilemap(const TilemapComponent& tilemap, const glm::mat3& worldMatrix, const BoundingBox& cameraBox, float depth)
+	{
+		if (tilemap.texture == nullptr || !tilemap.texture->isValid())
+		{
+			return;
+		}
+
+		g_shader.setUniformMatrix4fv("uWorldMatrix", toMat4(worldMatrix));
+		g_shader.setUniform1f("uDepth", depth);
+		tilemap.texture->bind(TEXTURE_SLOT);
+
+		const glm::vec2 chunkSize = { tilemap.tileWidth * TILEMAP_CHUNK_SIZE, tilemap.tileHeight * TILEMAP_CHUNK_SIZE };
+		for (int chunkY = 0; chunkY < tilemap.getChunksCountY(); chunkY++)
+		{
+			for (int chunkX = 0; chunkX < tilemap.getChunksCountX(); chunkX++)
+			{
+				// Skip chunks outside of camera's view
+				const glm::vec2 chunkMin = glm::vec2(float(chunkX), float(chunkY)) * chunkSize;
+				const BoundingBox chunkBox = getWorldBoundingBox(chunkMin, chunkMin + chunkSize, worldMatrix);
+				if (!doOverlap(chunkBox, cameraBox))
+				{
+					continue;
+				}
+
+				const TilemapChunk& chunk = tilemap.getChunk(chunkX, chunkY);
+				if (chunk.isMeshDirty || chunk.mesh == nullptr)
+				{
+					rebuildChunkMesh(tilemap, chunk, chunkX, chunkY);
+				}
+				if (chunk.mesh->indicesCount == 0)
+				{
+					continue;
+				}
+
+				g_shader.bind();
+				chunk.mesh->vertexArray.bind();
+				chunk.mesh->indexBuffer.bind();
+				RenderCommands::drawIndexed(chunk.mesh->indicesCount, DrawMode::Triangles, chunk.mesh->indexBuffer.getIndexType());
+			}
+		}
+	}
+
+	// Renders a given tilemap entity at a given clip-space depth. Called by the render queue.
+	static void renderTilemapEntity(const entt::registry& registry, entt::entity entity, float depth)
+	{
+		const TilemapComponent& tilemap = registry.get<TilemapComponent>(entity);
+		const TransformComponent2D* transform = registry.try_get<TransformComponent2D>(entity);
+		const glm::mat3 worldMatrix = (transform != nullptr) ? TransformSystem2D::getWorldMatrix(registry, *transform) : glm::mat3(1.0f);
+		renderTilemap(tilemap, worldMatrix, g_cameraBox, depth);
+	}
+
+	void TilemapSystem::submit(const entt::registry& registry, const CameraComponent2D* camera, RenderQueue2D& renderQueue)
+	{
+		PK_ASSERT(camera != nullptr, "Cannot render tilemaps without a camera.", "Pekan");
+
+		const auto view = registry.view<TilemapComponent>(entt::exclude<DisabledComponent>);
+		if (view.begin() == view.end())
+		{
+			return;
+		}
+
+		if (!g_shader.isValid())
+		{
+			g_shader.create
+			(
+				FileUtils::readTextFileToString(VERTEX_SHADER_FILEPATH).c_str(),
+				FileUtils::readTextFileToString(FRAGMENT_SHADER_FILEPATH).c_str()
+			);
+		}
+		g_shader.setUniformMatrix4fv("uViewProjectionMatrix", camera->getViewProjectionMatrix());
+		g_shader.setUniform1i("uTexture", TEXTURE_SLOT);
+
+		g_cameraBox = getCameraBoundingBox(*camera);
+		for (auto [entity, tilemap] : view.each())
+		{
+			if (tilemap.texture == nullptr || !tilemap.texture->isValid())
+			{
+				continue;
+			}
+			// Tilemaps need blending only if their texture has translucent texels
+			const RenderQueueBlendMode blendMode = tilemap.texture->isOpaque() ? RenderQueueBlendMode::Opaque : RenderQueueBlendMode::Transparent;
+			renderQueue.submit(registry, entity, renderTilemapEntity, blendMode, RenderQueueShader::Tilemap, tilemap.texture.get());
+		}
+	}
+
+	void TilemapSystem::exit()
+	{
+		if (g_shader.isValid())
+		{
+			g_shader.destroy();
+		}
+	}
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file
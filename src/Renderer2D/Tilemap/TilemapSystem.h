@@ -0,0 +1,28 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+namespace Pekan
+{
+namespace Renderer2D
+{
+	struct CameraComponent2D;
+	class RenderQueue2D;
+
+	class TilemapSystem
+	{
+	public:
+
+		// Submits all tilemaps in the given registry to a given render queue,
+		// so that they are rendered at their layer and depth (see RenderOrderComponent2D), like any other entity.
+		// When rendered, each visible chunk is rendered with one draw call from its static mesh,
+		// rebuilding the mesh first only if a tile in the chunk has changed.
+		// Chunks outside of camera's view are skipped.
+		static void submit(const entt::registry& registry, const CameraComponent2D* camera, RenderQueue2D& renderQueue);
+
+		// Releases GPU resources shared by all tilemaps
+		static void exit();
+	};
+
+} // namespace Renderer2D
+} // namespace Pekan
\ No newline at end of file